@@ -48,14 +48,23 @@ void WideRGBATo16(uint8_t *src, uint32_t srcStride, uint16_t *dst, uint32_t dstS
 
 /**
  * Saturate 10 bit image to 8 bit, faster that dynamic version where bit depth comes into a parameter
+ * @param dither - ordered dithering instead of truncation, alpha is never dithered
  */
 void SaturateRGBA10To8(const uint16_t *src, uint32_t srcStride,
                        uint8_t *dst, uint32_t dstStride,
                        uint32_t width, uint32_t height);
+void SaturateRGBA10To8(const uint16_t *src, uint32_t srcStride,
+                       uint8_t *dst, uint32_t dstStride,
+                       uint32_t width, uint32_t height,
+                       SparkYuvDither dither);
 
 void SaturateRGB10To8(const uint16_t *src, uint32_t srcStride,
                       uint8_t *dst, uint32_t dstStride,
                       uint32_t width, uint32_t height);
+void SaturateRGB10To8(const uint16_t *src, uint32_t srcStride,
+                      uint8_t *dst, uint32_t dstStride,
+                      uint32_t width, uint32_t height,
+                      SparkYuvDither dither);
 
 /**
  * Saturate 12 bit image to 8 bit, faster that dynamic version where bit depth comes into a parameter
@@ -63,10 +72,18 @@ void SaturateRGB10To8(const uint16_t *src, uint32_t srcStride,
 void SaturateRGBA12To8(const uint16_t *src, uint32_t srcStride,
                        uint8_t *dst, uint32_t dstStride,
                        uint32_t width, uint32_t height);
+void SaturateRGBA12To8(const uint16_t *src, uint32_t srcStride,
+                       uint8_t *dst, uint32_t dstStride,
+                       uint32_t width, uint32_t height,
+                       SparkYuvDither dither);
 
 void SaturateRGB12To8(const uint16_t *src, uint32_t srcStride,
                       uint8_t *dst, uint32_t dstStride,
                       uint32_t width, uint32_t height);
+void SaturateRGB12To8(const uint16_t *src, uint32_t srcStride,
+                      uint8_t *dst, uint32_t dstStride,
+                      uint32_t width, uint32_t height,
+                      SparkYuvDither dither);
 
 /**
  * Saturate 16 bit image to 8 bit, faster that dynamic version where bit depth comes into a parameter
@@ -74,10 +91,18 @@ void SaturateRGB12To8(const uint16_t *src, uint32_t srcStride,
 void SaturateRGBA16To8(const uint16_t *src, uint32_t srcStride,
                        uint8_t *dst, uint32_t dstStride,
                        uint32_t width, uint32_t height);
+void SaturateRGBA16To8(const uint16_t *src, uint32_t srcStride,
+                       uint8_t *dst, uint32_t dstStride,
+                       uint32_t width, uint32_t height,
+                       SparkYuvDither dither);
 
 void SaturateRGB16To8(const uint16_t *src, uint32_t srcStride,
                       uint8_t *dst, uint32_t dstStride,
                       uint32_t width, uint32_t height);
+void SaturateRGB16To8(const uint16_t *src, uint32_t srcStride,
+                      uint8_t *dst, uint32_t dstStride,
+                      uint32_t width, uint32_t height,
+                      SparkYuvDither dither);
 
 /**
  * Wide 8 bit image to provided bit depth
@@ -97,15 +122,24 @@ void WideRGB8(uint8_t *src, uint32_t srcStride,
 
 /**
  * Saturate uint16_t storage image with bit depth from param to 8
+ * @param dither - ordered dithering instead of truncation, alpha is never dithered
  */
 
 void SaturateRGBATo8(const uint16_t *src, uint32_t srcStride,
                      uint8_t *dst, uint32_t dstStride,
                      uint32_t width, uint32_t height, int bitDepth);
+void SaturateRGBATo8(const uint16_t *src, uint32_t srcStride,
+                     uint8_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height, int bitDepth,
+                     SparkYuvDither dither);
 
 void SaturateRGBTo8(const uint16_t *src, uint32_t srcStride,
                     uint8_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height, int bitDepth);
+void SaturateRGBTo8(const uint16_t *src, uint32_t srcStride,
+                    uint8_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height, int bitDepth,
+                    SparkYuvDither dither);
 
 /**
  * Alpha multiplication
@@ -330,6 +364,61 @@ void CopyChannel16(const uint16_t *src, uint32_t srcStride,
                    uint16_t *dst, uint32_t dstStride,
                    uint32_t width, uint32_t height);
 
+/**
+ * Pyramid
+ * Builds `levelsCount` levels of 2x box reduced images, level n has size ((size of n - 1) + 1) / 2,
+ * level 0 is the source. All levels are computed in one pass over the source.
+ */
+
+void BuildPyramidRGBA(const uint8_t *src, uint32_t srcStride,
+                      uint32_t width, uint32_t height,
+                      uint8_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidRGB(const uint8_t *src, uint32_t srcStride,
+                     uint32_t width, uint32_t height,
+                     uint8_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidChannel(const uint8_t *src, uint32_t srcStride,
+                         uint32_t width, uint32_t height,
+                         uint8_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidRGBA1010102(const uint8_t *src, uint32_t srcStride,
+                             uint32_t width, uint32_t height,
+                             uint8_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidRGBA16(const uint16_t *src, uint32_t srcStride,
+                        uint32_t width, uint32_t height,
+                        uint16_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidRGB16(const uint16_t *src, uint32_t srcStride,
+                       uint32_t width, uint32_t height,
+                       uint16_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidChannel16(const uint16_t *src, uint32_t srcStride,
+                           uint32_t width, uint32_t height,
+                           uint16_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidRGBAF16(const uint16_t *src, uint32_t srcStride,
+                         uint32_t width, uint32_t height,
+                         uint16_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidRGBF16(const uint16_t *src, uint32_t srcStride,
+                        uint32_t width, uint32_t height,
+                        uint16_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidChannelF16(const uint16_t *src, uint32_t srcStride,
+                            uint32_t width, uint32_t height,
+                            uint16_t **levels, const uint32_t *levelStrides, uint32_t levelsCount);
+
+void BuildPyramidYCbCr420(const uint8_t *ySrc, uint32_t yStride,
+                          const uint8_t *uSrc, uint32_t uStride,
+                          const uint8_t *vSrc, uint32_t vStride,
+                          uint32_t width, uint32_t height,
+                          uint8_t **yLevels, const uint32_t *yLevelStrides,
+                          uint8_t **uLevels, const uint32_t *uLevelStrides,
+                          uint8_t **vLevels, const uint32_t *vLevelStrides,
+                          uint32_t levelsCount);
+
 /**
  * Rotate
  */
@@ -456,7 +545,8 @@ void FastGaussianNextBlurBGRF16(uint16_t *data, uint32_t stride, uint32_t width,
  */
 
 /**
-* @brief Converts an image to F16 type, channel order is preserved
+* @brief Converts an image to F16 type, channel order is preserved.
+* Values are only rescaled to [0, 1], use LinearizeRGBAToRGBAF16 to decode sRGB or Rec.709 into linear light
 * @param depth Bit depth of the image
 */
 void RGBAToRGBAF16(const uint8_t *src, uint32_t srcStride,
@@ -521,27 +611,39 @@ void Channel16ToChannelF16(const uint16_t *src, uint32_t srcStride,
 
 /**
 * @brief Converts an image from F16 (float16) type to uint8_t 8 bit, channel order is preserved
-* @param depth Bit depth of the image
+* @param dither Ordered dithering instead of truncation, alpha is never dithered
 */
 void RGBAF16ToRGBA(const uint16_t *src, uint32_t srcStride,
                    uint8_t *dst, uint32_t dstStride,
                    uint32_t width, uint32_t height);
+void RGBAF16ToRGBA(const uint16_t *src, uint32_t srcStride,
+                   uint8_t *dst, uint32_t dstStride,
+                   uint32_t width, uint32_t height,
+                   SparkYuvDither dither);
 
 /**
 * @brief Converts an image from F16 (float16) type to uint8_t 8 bit, channel order is preserved
-* @param depth Bit depth of the image
+* @param dither Ordered dithering instead of truncation, alpha is never dithered
 */
 void RGBF16ToRGB(const uint16_t *src, uint32_t srcStride,
                  uint8_t *dst, uint32_t dstStride,
                  uint32_t width, uint32_t height);
+void RGBF16ToRGB(const uint16_t *src, uint32_t srcStride,
+                 uint8_t *dst, uint32_t dstStride,
+                 uint32_t width, uint32_t height,
+                 SparkYuvDither dither);
 
 /**
 * @brief Converts an image from F16 (float16) type to uint8_t 8 bit, channel order is preserved
-* @param depth Bit depth of the image
+* @param dither Ordered dithering instead of truncation, alpha is never dithered
 */
 void ChannelF16ToChannel(const uint16_t *src, uint32_t srcStride,
                          uint8_t *dst, uint32_t dstStride,
                          uint32_t width, uint32_t height);
+void ChannelF16ToChannel(const uint16_t *src, uint32_t srcStride,
+                         uint8_t *dst, uint32_t dstStride,
+                         uint32_t width, uint32_t height,
+                         SparkYuvDither dither);
 
 /**
 * @brief Converts an image from F16 (float16) type to uint8_t 8 bit, channel order is preserved
@@ -0,0 +1,160 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+#include "sparkyuv-eotf.h"
+#include "sparkyuv-gamut.h"
+
+namespace sparkyuv {
+
+enum SparkYuvColorModel {
+  COLOR_MODEL_XYZ = 1, // CIE 1931 XYZ, reference white has Y = 1
+  COLOR_MODEL_LAB = 2, // CIE L*a*b* relative to white point of the primaries, L* in [0, 100]
+  COLOR_MODEL_OKLAB = 3 // Oklab, L in [0, 1]
+};
+
+/**
+ * @brief Color model conversion decodes RGBA with the transfer function, moves linear light of `primaries`
+ * into XYZ, CIE Lab or Oklab and back. Accuracy selects how transfer function is evaluated, cube roots are always
+ * vectorized Newton iterations.
+ * Interleaved images store three components and alpha per pixel, planar images store three planes,
+ * alpha is dropped by planar forward conversion and written opaque by planar inverse one.
+ * F16 components are stored as IEEE half bits, Lab values fit F16 range without scaling.
+ * @param depth Bit depth of 16-bit image
+ */
+
+// MARK: Color Model Forward Declarations
+
+void RGBAToColorModelF32(const uint8_t *src, uint32_t srcStride,
+                         float *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                         SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                         SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBAToColorModelF16(const uint8_t *src, uint32_t srcStride,
+                         uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                         SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                         SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBAToColorModelPlanarF32(const uint8_t *src, uint32_t srcStride,
+                               float *c0, uint32_t c0Stride, float *c1, uint32_t c1Stride,
+                               float *c2, uint32_t c2Stride, uint32_t width, uint32_t height,
+                               SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                               SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBAToColorModelPlanarF16(const uint8_t *src, uint32_t srcStride,
+                               uint16_t *c0, uint32_t c0Stride, uint16_t *c1, uint32_t c1Stride,
+                               uint16_t *c2, uint32_t c2Stride, uint32_t width, uint32_t height,
+                               SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                               SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+void RGBA16ToColorModelF32(const uint16_t *src, uint32_t srcStride,
+                           float *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                           SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                           SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBA16ToColorModelF16(const uint16_t *src, uint32_t srcStride,
+                           uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                           SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                           SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBA16ToColorModelPlanarF32(const uint16_t *src, uint32_t srcStride,
+                                 float *c0, uint32_t c0Stride, float *c1, uint32_t c1Stride,
+                                 float *c2, uint32_t c2Stride, uint32_t width, uint32_t height, int depth,
+                                 SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBA16ToColorModelPlanarF16(const uint16_t *src, uint32_t srcStride,
+                                 uint16_t *c0, uint32_t c0Stride, uint16_t *c1, uint32_t c1Stride,
+                                 uint16_t *c2, uint32_t c2Stride, uint32_t width, uint32_t height, int depth,
+                                 SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+void RGBAF16ToColorModelF32(const uint16_t *src, uint32_t srcStride,
+                            float *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                            SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                            SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBAF16ToColorModelF16(const uint16_t *src, uint32_t srcStride,
+                            uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                            SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                            SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBAF16ToColorModelPlanarF32(const uint16_t *src, uint32_t srcStride,
+                                  float *c0, uint32_t c0Stride, float *c1, uint32_t c1Stride,
+                                  float *c2, uint32_t c2Stride, uint32_t width, uint32_t height,
+                                  SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                  SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void RGBAF16ToColorModelPlanarF16(const uint16_t *src, uint32_t srcStride,
+                                  uint16_t *c0, uint32_t c0Stride, uint16_t *c1, uint32_t c1Stride,
+                                  uint16_t *c2, uint32_t c2Stride, uint32_t width, uint32_t height,
+                                  SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                  SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+// MARK: Color Model Inverse Declarations
+
+void ColorModelF32ToRGBA(const float *src, uint32_t srcStride,
+                         uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                         SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                         SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelF16ToRGBA(const uint16_t *src, uint32_t srcStride,
+                         uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                         SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                         SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelPlanarF32ToRGBA(const float *c0, uint32_t c0Stride, const float *c1, uint32_t c1Stride,
+                               const float *c2, uint32_t c2Stride,
+                               uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                               SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                               SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelPlanarF16ToRGBA(const uint16_t *c0, uint32_t c0Stride, const uint16_t *c1, uint32_t c1Stride,
+                               const uint16_t *c2, uint32_t c2Stride,
+                               uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                               SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                               SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+void ColorModelF32ToRGBA16(const float *src, uint32_t srcStride,
+                           uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                           SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                           SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelF16ToRGBA16(const uint16_t *src, uint32_t srcStride,
+                           uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                           SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                           SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelPlanarF32ToRGBA16(const float *c0, uint32_t c0Stride, const float *c1, uint32_t c1Stride,
+                                 const float *c2, uint32_t c2Stride,
+                                 uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                                 SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelPlanarF16ToRGBA16(const uint16_t *c0, uint32_t c0Stride, const uint16_t *c1, uint32_t c1Stride,
+                                 const uint16_t *c2, uint32_t c2Stride,
+                                 uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                                 SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+void ColorModelF32ToRGBAF16(const float *src, uint32_t srcStride,
+                            uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                            SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                            SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelF16ToRGBAF16(const uint16_t *src, uint32_t srcStride,
+                            uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                            SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                            SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelPlanarF32ToRGBAF16(const float *c0, uint32_t c0Stride, const float *c1, uint32_t c1Stride,
+                                  const float *c2, uint32_t c2Stride,
+                                  uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                  SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                  SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void ColorModelPlanarF16ToRGBAF16(const uint16_t *c0, uint32_t c0Stride, const uint16_t *c1, uint32_t c1Stride,
+                                  const uint16_t *c2, uint32_t c2Stride,
+                                  uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                  SparkYuvColorModel model, SparkYuvPrimaries primaries,
+                                  SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+}
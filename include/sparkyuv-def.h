@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace sparkyuv {
 enum SparkYuvColorRange {
   YUV_RANGE_TV = 1,
@@ -46,4 +48,81 @@ enum SparkYuvRotation {
   sRotate180 = 180,
   sRotate270 = 270
 };
+
+/**
+ * Dithering applied when samples are narrowed to a lower bit depth,
+ * Bayer 8x8 replaces truncation with an ordered threshold to break banding on gradients
+ */
+enum SparkYuvDither {
+  DITHER_NONE = 0,
+  DITHER_BAYER8X8 = 1
+};
+
+/**
+ * Fixed point precision of YCbCr decoding, fast keeps 6-bit coefficients,
+ * high splits coefficients into integer and Q15 parts and rounds the result to nearest
+ */
+enum SparkYuvPrecision {
+  YUV_PRECISION_FAST = 1,
+  YUV_PRECISION_HIGH = 2
+};
+
+enum SparkYuvTensorLayout {
+  TENSOR_CHW = 1,
+  TENSOR_HWC = 2
+};
+
+/**
+ * Per channel RGB normalization of tensor values as (x / 255 - mean) / std
+ */
+struct SparkYuvTensorNormalization {
+  float mean[3];
+  float std[3];
+};
+
+/**
+ * Row-major 3x3 matrix, rows are applied to produce the first, second and third output components
+ */
+struct SparkYuvTransformMatrix {
+  float Y1;
+  float Y2;
+  float Y3;
+  float U1;
+  float U2;
+  float U3;
+  float V1;
+  float V2;
+  float V3;
+};
+
+/**
+ * Rectangle inside of the source image
+ */
+struct SparkYuvRegion {
+  uint32_t x;
+  uint32_t y;
+  uint32_t width;
+  uint32_t height;
+};
+
+/**
+ * 8-bit RGBA color, for example border of the letterbox
+ */
+struct SparkYuvColor {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  uint8_t a;
+};
+
+/**
+ * Source region together with destination image where it should be converted and scaled into
+ */
+struct SparkYuvRegionTarget {
+  SparkYuvRegion region;
+  uint8_t *dst;
+  uint32_t dstStride;
+  uint32_t dstWidth;
+  uint32_t dstHeight;
+};
 }
\ No newline at end of file
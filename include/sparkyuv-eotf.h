@@ -17,6 +17,8 @@
 #ifndef YUV_INCLUDE_SPARKYUV_EOTF_H_
 #define YUV_INCLUDE_SPARKYUV_EOTF_H_
 
+#include <cstdint>
+
 namespace sparkyuv {
 enum SparkYuvTransferFunction {
   TransferBT709 = 1, // BT.709
@@ -36,6 +38,75 @@ enum SparkYuvTransferFunction {
   TransferSMPTE428, // SMPTE ST 428-1
   TransferHLG // ARIB STD-B67 (HLG)
 };
+
+enum SparkYuvTransferAccuracy {
+  TRANSFER_ACCURACY_EXACT = 1, // libm powf/logf per sample
+  TRANSFER_ACCURACY_FAST = 2, // Vectorized polynomial approximations (FastPowf)
+  TRANSFER_ACCURACY_LUT = 3 // Tables, exact for integer sources, interpolated for float ones
+};
+
+/**
+ * @brief Linearize converts gamma-encoded RGBA image into linear light RGBA F32 or F16 ( stored as IEEE half bits ),
+ * delinearize does the reverse. Alpha is only rescaled to [0, 1] and back.
+ * PQ linear light is relative to SDR reference white of 203 nits, so it may exceed 1.
+ * 8-bit sources are always decoded through the exact 256 entries table, in TRANSFER_ACCURACY_LUT
+ * 8-bit destinations are encoded with a single lookup of a 4096 entries code table.
+ * @param depth Bit depth of 16-bit image
+ */
+
+// MARK: Linearize Declarations
+
+void LinearizeRGBAToRGBAF32(const uint8_t *src, uint32_t srcStride,
+                            float *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                            SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBAToRGBAF16(const uint8_t *src, uint32_t srcStride,
+                            uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                            SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBA16ToRGBAF32(const uint16_t *src, uint32_t srcStride,
+                              float *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                              SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBA16ToRGBAF16(const uint16_t *src, uint32_t srcStride,
+                              uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                              SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBA1010102ToRGBAF32(const uint8_t *src, uint32_t srcStride,
+                                   float *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                   SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBA1010102ToRGBAF16(const uint8_t *src, uint32_t srcStride,
+                                   uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                   SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBAF16ToRGBAF32(const uint16_t *src, uint32_t srcStride,
+                               float *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                               SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void LinearizeRGBAF16ToRGBAF16(const uint16_t *src, uint32_t srcStride,
+                               uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                               SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+
+// MARK: Delinearize Declarations
+
+void DelinearizeRGBAF32ToRGBA(const float *src, uint32_t srcStride,
+                              uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                              SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF16ToRGBA(const uint16_t *src, uint32_t srcStride,
+                              uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                              SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF32ToRGBA16(const float *src, uint32_t srcStride,
+                                uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                                SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF16ToRGBA16(const uint16_t *src, uint32_t srcStride,
+                                uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                                SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF32ToRGBA1010102(const float *src, uint32_t srcStride,
+                                     uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                     SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF16ToRGBA1010102(const uint16_t *src, uint32_t srcStride,
+                                     uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                     SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF32ToRGBAF16(const float *src, uint32_t srcStride,
+                                 uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
+void DelinearizeRGBAF16ToRGBAF16(const uint16_t *src, uint32_t srcStride,
+                                 uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvTransferAccuracy accuracy);
 }
 
 #endif //YUV_INCLUDE_SPARKYUV_EOTF_H_
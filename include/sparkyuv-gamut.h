@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+#include "sparkyuv-eotf.h"
+
+namespace sparkyuv {
+
+enum SparkYuvPrimaries {
+  PRIMARIES_BT709 = 1, // BT.709, sRGB
+  PRIMARIES_BT2020 = 2, // BT.2020, BT.2100
+  PRIMARIES_DISPLAY_P3 = 3 // Display P3, D65 white point
+};
+
+enum SparkYuvGamutClipping {
+  GAMUT_CLIP_CLAMP = 1, // Each negative component is clipped to zero, may shift hue
+  GAMUT_CLIP_DESATURATE = 2 // Out of gamut colors are moved towards their luminance, hue is preserved
+};
+
+/**
+ * @brief Returns linear light RGB matrix converting `from` primaries into `to` primaries, white point is preserved
+ */
+SparkYuvTransformMatrix ComputeGamutConversionMatrix(SparkYuvPrimaries from, SparkYuvPrimaries to);
+
+/**
+ * @brief Luminance weights of the primaries, they are suitable as `kr`, `kb` for gamut conversion
+ */
+void ComputePrimariesLuminance(SparkYuvPrimaries primaries, float &kr, float &kb);
+
+/**
+ * @brief Gamut conversion decodes each pixel with source transfer function, applies 3x3 matrix in linear light,
+ * clips out of gamut values and encodes with destination transfer function in one pass. Alpha is kept as is.
+ * @param kr, kb Luminance weights of destination primaries, used by GAMUT_CLIP_DESATURATE
+ * @param depth Bit depth of 16-bit image
+ */
+
+// MARK: Gamut Conversion Declarations
+
+void ConvertGamutRGBA(const uint8_t *src, uint32_t srcStride,
+                      uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                      const SparkYuvTransformMatrix &matrix, float kr, float kb,
+                      SparkYuvTransferFunction srcTransferFunction, SparkYuvTransferFunction dstTransferFunction,
+                      SparkYuvTransferAccuracy accuracy, SparkYuvGamutClipping clipping);
+void ConvertGamutRGBA16(const uint16_t *src, uint32_t srcStride,
+                        uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                        const SparkYuvTransformMatrix &matrix, float kr, float kb,
+                        SparkYuvTransferFunction srcTransferFunction, SparkYuvTransferFunction dstTransferFunction,
+                        SparkYuvTransferAccuracy accuracy, SparkYuvGamutClipping clipping);
+void ConvertGamutRGBA1010102(const uint8_t *src, uint32_t srcStride,
+                             uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                             const SparkYuvTransformMatrix &matrix, float kr, float kb,
+                             SparkYuvTransferFunction srcTransferFunction,
+                             SparkYuvTransferFunction dstTransferFunction,
+                             SparkYuvTransferAccuracy accuracy, SparkYuvGamutClipping clipping);
+void ConvertGamutRGBAF16(const uint16_t *src, uint32_t srcStride,
+                         uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                         const SparkYuvTransformMatrix &matrix, float kr, float kb,
+                         SparkYuvTransferFunction srcTransferFunction, SparkYuvTransferFunction dstTransferFunction,
+                         SparkYuvTransferAccuracy accuracy, SparkYuvGamutClipping clipping);
+
+}
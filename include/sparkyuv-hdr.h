@@ -0,0 +1,227 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+#include "sparkyuv-eotf.h"
+
+namespace sparkyuv {
+
+enum SparkYuvToneMapper {
+  TONEMAP_REINHARD_EXTENDED = 1,
+  TONEMAP_HABLE = 2,
+  TONEMAP_BT2390 = 3 // ITU-R BT.2390 EETF, applied in PQ domain
+};
+
+struct SparkYuvToneMapping {
+  SparkYuvToneMapper toneMapper;
+  float contentMaxNits; // Content peak, MaxCLL or mastering display peak, nominal HLG peak is 1000
+  float displayMaxNits; // SDR display peak, is mapped into maximum code value
+  SparkYuvTransferFunction sdrTransferFunction; // Usually TransferSRGB or TransferBT709
+};
+
+/**
+ * @brief Tone mapping decodes BT.2020 10-bit YCbCr 4:2:0 with PQ or HLG transfer, maps luminance into SDR display
+ * range preserving chroma ratios, converts BT.2020 primaries into BT.709 with soft clipping by desaturation
+ * and encodes with SDR transfer function, everything is done in one pass.
+ * Linear light is relative to 203 nits reference white as everywhere in the library.
+ * NV12 output is encoded with BT.709 coefficients and the same color range as the source.
+ * @param transferFunction TransferPQ or TransferHLG
+ */
+
+// MARK: Tone Mapping Declarations
+
+void YCbCr420P10ToRGBAToneMapped(uint8_t *dst, uint32_t dstStride,
+                                 uint32_t width, uint32_t height,
+                                 const uint16_t *yPlane, uint32_t yStride,
+                                 const uint16_t *uPlane, uint32_t uStride,
+                                 const uint16_t *vPlane, uint32_t vStride,
+                                 float kr, float kb, SparkYuvColorRange colorRange,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                 SparkYuvTransferAccuracy accuracy);
+void YCbCr420P10ToRGBToneMapped(uint8_t *dst, uint32_t dstStride,
+                                uint32_t width, uint32_t height,
+                                const uint16_t *yPlane, uint32_t yStride,
+                                const uint16_t *uPlane, uint32_t uStride,
+                                const uint16_t *vPlane, uint32_t vStride,
+                                float kr, float kb, SparkYuvColorRange colorRange,
+                                SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                SparkYuvTransferAccuracy accuracy);
+#if SPARKYUV_FULL_CHANNELS
+void YCbCr420P10ToARGBToneMapped(uint8_t *dst, uint32_t dstStride,
+                                 uint32_t width, uint32_t height,
+                                 const uint16_t *yPlane, uint32_t yStride,
+                                 const uint16_t *uPlane, uint32_t uStride,
+                                 const uint16_t *vPlane, uint32_t vStride,
+                                 float kr, float kb, SparkYuvColorRange colorRange,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                 SparkYuvTransferAccuracy accuracy);
+void YCbCr420P10ToABGRToneMapped(uint8_t *dst, uint32_t dstStride,
+                                 uint32_t width, uint32_t height,
+                                 const uint16_t *yPlane, uint32_t yStride,
+                                 const uint16_t *uPlane, uint32_t uStride,
+                                 const uint16_t *vPlane, uint32_t vStride,
+                                 float kr, float kb, SparkYuvColorRange colorRange,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                 SparkYuvTransferAccuracy accuracy);
+void YCbCr420P10ToBGRAToneMapped(uint8_t *dst, uint32_t dstStride,
+                                 uint32_t width, uint32_t height,
+                                 const uint16_t *yPlane, uint32_t yStride,
+                                 const uint16_t *uPlane, uint32_t uStride,
+                                 const uint16_t *vPlane, uint32_t vStride,
+                                 float kr, float kb, SparkYuvColorRange colorRange,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                 SparkYuvTransferAccuracy accuracy);
+void YCbCr420P10ToBGRToneMapped(uint8_t *dst, uint32_t dstStride,
+                                uint32_t width, uint32_t height,
+                                const uint16_t *yPlane, uint32_t yStride,
+                                const uint16_t *uPlane, uint32_t uStride,
+                                const uint16_t *vPlane, uint32_t vStride,
+                                float kr, float kb, SparkYuvColorRange colorRange,
+                                SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                SparkYuvTransferAccuracy accuracy);
+#endif
+
+void YCbCr420P10ToNV12ToneMapped(uint8_t *yDst, uint32_t yDstStride,
+                                 uint8_t *uvDst, uint32_t uvDstStride,
+                                 uint32_t width, uint32_t height,
+                                 const uint16_t *yPlane, uint32_t yStride,
+                                 const uint16_t *uPlane, uint32_t uStride,
+                                 const uint16_t *vPlane, uint32_t vStride,
+                                 float kr, float kb, SparkYuvColorRange colorRange,
+                                 SparkYuvTransferFunction transferFunction, SparkYuvToneMapping mapping,
+                                 SparkYuvTransferAccuracy accuracy);
+
+enum SparkYuvGainMapChannels {
+  GAIN_MAP_LUMINANCE = 1, // One byte per pixel, the same gain is applied to every channel
+  GAIN_MAP_RGB = 3 // RGBA8 pixels, alpha is ignored, gain is applied per channel
+};
+
+/**
+ * ISO 21496-1 gain map metadata, gain map min/max and HDR capacity are in log2 domain,
+ * gamma and offsets are linear. Values are per channel, for luminance gain map only the first one is used
+ */
+struct SparkYuvGainMapMetadata {
+  float gainMapMin[3];
+  float gainMapMax[3];
+  float gamma[3];
+  float offsetSdr[3];
+  float offsetHdr[3];
+  float hdrCapacityMin;
+  float hdrCapacityMax;
+};
+
+/**
+ * @brief Gain map application reconstructs HDR from SDR base and lower resolution gain map upsampled bilinearly:
+ * HDR = (SDR + offsetSdr) * 2^(mix(gainMapMin, gainMapMax, gain^(1/gamma)) * weight) - offsetHdr,
+ * weight is derived from `displayBoost` (linear HDR headroom of the display) and HDR capacity.
+ * HDR linear light is relative to SDR white, F16 output is stored as is,
+ * RGBA1010102 output is encoded with `hdrTransferFunction` PQ ( SDR white at 203 nits ) or HLG ( normalized by
+ * `displayBoost` ). YCbCr420 base is 8-bit.
+ * Gain map computation averages linear SDR (RGBA8) and HDR (F16, relative to SDR white) over footprint
+ * of every gain map pixel and encodes log2 ratio with the given metadata, luminance is computed with `kr`, `kb`.
+ */
+
+// MARK: Gain Map Declarations
+
+void ApplyGainMapRGBAToRGBAF16(const uint8_t *src, uint32_t srcStride,
+                               uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                               const uint8_t *gainMap, uint32_t gainMapStride,
+                               uint32_t gainMapWidth, uint32_t gainMapHeight, SparkYuvGainMapChannels channels,
+                               const SparkYuvGainMapMetadata &metadata, float displayBoost,
+                               SparkYuvTransferFunction sdrTransferFunction);
+void ApplyGainMapRGBAToRGBA1010102(const uint8_t *src, uint32_t srcStride,
+                                   uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                   const uint8_t *gainMap, uint32_t gainMapStride,
+                                   uint32_t gainMapWidth, uint32_t gainMapHeight, SparkYuvGainMapChannels channels,
+                                   const SparkYuvGainMapMetadata &metadata, float displayBoost,
+                                   SparkYuvTransferFunction sdrTransferFunction,
+                                   SparkYuvTransferFunction hdrTransferFunction);
+void ApplyGainMapYCbCr420ToRGBAF16(uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                   const uint8_t *yPlane, uint32_t yStride,
+                                   const uint8_t *uPlane, uint32_t uStride,
+                                   const uint8_t *vPlane, uint32_t vStride,
+                                   float kr, float kb, SparkYuvColorRange colorRange,
+                                   const uint8_t *gainMap, uint32_t gainMapStride,
+                                   uint32_t gainMapWidth, uint32_t gainMapHeight, SparkYuvGainMapChannels channels,
+                                   const SparkYuvGainMapMetadata &metadata, float displayBoost,
+                                   SparkYuvTransferFunction sdrTransferFunction);
+void ApplyGainMapYCbCr420ToRGBA1010102(uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                                       const uint8_t *yPlane, uint32_t yStride,
+                                       const uint8_t *uPlane, uint32_t uStride,
+                                       const uint8_t *vPlane, uint32_t vStride,
+                                       float kr, float kb, SparkYuvColorRange colorRange,
+                                       const uint8_t *gainMap, uint32_t gainMapStride,
+                                       uint32_t gainMapWidth, uint32_t gainMapHeight,
+                                       SparkYuvGainMapChannels channels,
+                                       const SparkYuvGainMapMetadata &metadata, float displayBoost,
+                                       SparkYuvTransferFunction sdrTransferFunction,
+                                       SparkYuvTransferFunction hdrTransferFunction);
+
+void ComputeGainMapRGBA(const uint8_t *sdr, uint32_t sdrStride,
+                        const uint16_t *hdr, uint32_t hdrStride, uint32_t width, uint32_t height,
+                        uint8_t *gainMap, uint32_t gainMapStride,
+                        uint32_t gainMapWidth, uint32_t gainMapHeight, SparkYuvGainMapChannels channels,
+                        const SparkYuvGainMapMetadata &metadata, float kr, float kb,
+                        SparkYuvTransferFunction sdrTransferFunction);
+
+/**
+ * Content light levels of one frame in nits, HDR10 MaxCLL is the maximum of `maxLight`
+ * and MaxFALL is the maximum of `averageLight` over all frames
+ */
+struct SparkYuvContentLight {
+  float maxLight; // Maximum of max(R, G, B) over the frame
+  float averageLight; // Frame average of max(R, G, B)
+};
+
+/**
+ * @brief Content light statistics decode every pixel with PQ, HLG or linear transfer and reduce it in one read pass,
+ * no linear frame is stored. PQ and linear light is relative to 203 nits reference white, HLG scene light is scaled
+ * to `hlgPeakNits` ( nominal 1000 ). Alpha is ignored.
+ * Optional histogram counts luminance computed with `kr`, `kb`, `histogramBins` bins are uniform in log2 of nits
+ * over [0.0001, 10000], values outside go to the edge bins. Pass nullptr and 0 bins to skip it.
+ * @param depth Bit depth of 16-bit image, YCbCr420P16 is usually P10 or P12
+ */
+
+// MARK: Content Light Declarations
+
+SparkYuvContentLight ComputeContentLightYCbCr420P16(const uint16_t *yPlane, uint32_t yStride,
+                                                    const uint16_t *uPlane, uint32_t uStride,
+                                                    const uint16_t *vPlane, uint32_t vStride,
+                                                    uint32_t width, uint32_t height, int depth,
+                                                    float kr, float kb, SparkYuvColorRange colorRange,
+                                                    SparkYuvTransferFunction transferFunction,
+                                                    SparkYuvTransferAccuracy accuracy, float hlgPeakNits,
+                                                    uint32_t *histogram, uint32_t histogramBins);
+SparkYuvContentLight ComputeContentLightRGBA16(const uint16_t *src, uint32_t srcStride,
+                                               uint32_t width, uint32_t height, int depth, float kr, float kb,
+                                               SparkYuvTransferFunction transferFunction,
+                                               SparkYuvTransferAccuracy accuracy, float hlgPeakNits,
+                                               uint32_t *histogram, uint32_t histogramBins);
+SparkYuvContentLight ComputeContentLightRGBA1010102(const uint8_t *src, uint32_t srcStride,
+                                                    uint32_t width, uint32_t height, float kr, float kb,
+                                                    SparkYuvTransferFunction transferFunction,
+                                                    SparkYuvTransferAccuracy accuracy, float hlgPeakNits,
+                                                    uint32_t *histogram, uint32_t histogramBins);
+SparkYuvContentLight ComputeContentLightRGBAF16(const uint16_t *src, uint32_t srcStride,
+                                                uint32_t width, uint32_t height, float kr, float kb,
+                                                SparkYuvTransferFunction transferFunction,
+                                                SparkYuvTransferAccuracy accuracy, float hlgPeakNits,
+                                                uint32_t *histogram, uint32_t histogramBins);
+
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+
+namespace sparkyuv {
+
+/**
+ * @brief HSV and HSL conversion of gamma-encoded RGBA, no transfer function is applied.
+ * Planar F32/F16 images store hue in degrees [0, 360), saturation and value or lightness in [0, 1],
+ * F16 planes are stored as IEEE half bits. Planar forward conversion drops alpha, planar inverse writes it opaque.
+ * Packed 8-bit images store H, S, V (or L) and alpha interleaved, hue is scaled from [0, 360) into [0, 255].
+ * @param depth Bit depth of 16-bit image
+ */
+
+// MARK: HSV Declarations
+
+void RGBAToHSVPlanarF32(const uint8_t *src, uint32_t srcStride,
+                        float *h, uint32_t hStride, float *s, uint32_t sStride, float *v, uint32_t vStride,
+                        uint32_t width, uint32_t height);
+void RGBAToHSVPlanarF16(const uint8_t *src, uint32_t srcStride,
+                        uint16_t *h, uint32_t hStride, uint16_t *s, uint32_t sStride, uint16_t *v, uint32_t vStride,
+                        uint32_t width, uint32_t height);
+void RGBA16ToHSVPlanarF32(const uint16_t *src, uint32_t srcStride,
+                          float *h, uint32_t hStride, float *s, uint32_t sStride, float *v, uint32_t vStride,
+                          uint32_t width, uint32_t height, int depth);
+void RGBA16ToHSVPlanarF16(const uint16_t *src, uint32_t srcStride,
+                          uint16_t *h, uint32_t hStride, uint16_t *s, uint32_t sStride, uint16_t *v, uint32_t vStride,
+                          uint32_t width, uint32_t height, int depth);
+void RGBAToHSVA(const uint8_t *src, uint32_t srcStride,
+                uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+
+void HSVPlanarF32ToRGBA(const float *h, uint32_t hStride, const float *s, uint32_t sStride,
+                        const float *v, uint32_t vStride,
+                        uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+void HSVPlanarF16ToRGBA(const uint16_t *h, uint32_t hStride, const uint16_t *s, uint32_t sStride,
+                        const uint16_t *v, uint32_t vStride,
+                        uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+void HSVPlanarF32ToRGBA16(const float *h, uint32_t hStride, const float *s, uint32_t sStride,
+                          const float *v, uint32_t vStride,
+                          uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth);
+void HSVPlanarF16ToRGBA16(const uint16_t *h, uint32_t hStride, const uint16_t *s, uint32_t sStride,
+                          const uint16_t *v, uint32_t vStride,
+                          uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth);
+void HSVAToRGBA(const uint8_t *src, uint32_t srcStride,
+                uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+
+// MARK: HSL Declarations
+
+void RGBAToHSLPlanarF32(const uint8_t *src, uint32_t srcStride,
+                        float *h, uint32_t hStride, float *s, uint32_t sStride, float *l, uint32_t lStride,
+                        uint32_t width, uint32_t height);
+void RGBAToHSLPlanarF16(const uint8_t *src, uint32_t srcStride,
+                        uint16_t *h, uint32_t hStride, uint16_t *s, uint32_t sStride, uint16_t *l, uint32_t lStride,
+                        uint32_t width, uint32_t height);
+void RGBA16ToHSLPlanarF32(const uint16_t *src, uint32_t srcStride,
+                          float *h, uint32_t hStride, float *s, uint32_t sStride, float *l, uint32_t lStride,
+                          uint32_t width, uint32_t height, int depth);
+void RGBA16ToHSLPlanarF16(const uint16_t *src, uint32_t srcStride,
+                          uint16_t *h, uint32_t hStride, uint16_t *s, uint32_t sStride, uint16_t *l, uint32_t lStride,
+                          uint32_t width, uint32_t height, int depth);
+void RGBAToHSLA(const uint8_t *src, uint32_t srcStride,
+                uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+
+void HSLPlanarF32ToRGBA(const float *h, uint32_t hStride, const float *s, uint32_t sStride,
+                        const float *l, uint32_t lStride,
+                        uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+void HSLPlanarF16ToRGBA(const uint16_t *h, uint32_t hStride, const uint16_t *s, uint32_t sStride,
+                        const uint16_t *l, uint32_t lStride,
+                        uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+void HSLPlanarF32ToRGBA16(const float *h, uint32_t hStride, const float *s, uint32_t sStride,
+                          const float *l, uint32_t lStride,
+                          uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth);
+void HSLPlanarF16ToRGBA16(const uint16_t *h, uint32_t hStride, const uint16_t *s, uint32_t sStride,
+                          const uint16_t *l, uint32_t lStride,
+                          uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth);
+void HSLAToRGBA(const uint8_t *src, uint32_t srcStride,
+                uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height);
+
+/**
+ * @brief Hue/saturation adjustment in one pass, HSV or HSL components never leave registers.
+ * Hue is rotated by `hueShift` degrees, saturation and value (lightness for HSL) are multiplied by
+ * `saturation` and `value` and clamped to [0, 1]. Alpha is kept as is, `src` and `dst` may be the same image.
+ * @param depth Bit depth of 16-bit image
+ */
+
+// MARK: Hue Adjustment Declarations
+
+void AdjustHSVRGBA(const uint8_t *src, uint32_t srcStride, uint8_t *dst, uint32_t dstStride,
+                   uint32_t width, uint32_t height, float hueShift, float saturation, float value);
+void AdjustHSVRGBA16(const uint16_t *src, uint32_t srcStride, uint16_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height, int depth, float hueShift, float saturation, float value);
+void AdjustHSLRGBA(const uint8_t *src, uint32_t srcStride, uint8_t *dst, uint32_t dstStride,
+                   uint32_t width, uint32_t height, float hueShift, float saturation, float lightness);
+void AdjustHSLRGBA16(const uint16_t *src, uint32_t srcStride, uint16_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height, int depth, float hueShift, float saturation, float lightness);
+
+}
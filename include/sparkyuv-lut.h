@@ -0,0 +1,121 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "sparkyuv-def.h"
+
+namespace sparkyuv {
+
+enum SparkYuvLutInterpolation {
+  LUT_INTERPOLATION_TRILINEAR = 1, // 8 lattice points per pixel
+  LUT_INTERPOLATION_TETRAHEDRAL = 2 // 4 lattice points per pixel, preserves neutral axis
+};
+
+/**
+ * 3D LUT in packed layout: every lattice point is stored as R, G, B, padding floats so one point never
+ * crosses a cache line, red index changes fastest as in .cube files
+ */
+struct SparkYuvLut3D {
+  uint32_t size = 0;
+  float domainMin[3] = {0.f, 0.f, 0.f};
+  float domainMax[3] = {1.f, 1.f, 1.f};
+  std::vector<float> table;
+};
+
+/**
+ * @brief Parses Adobe/Resolve .cube text with LUT_3D_SIZE, DOMAIN_MIN and DOMAIN_MAX keywords,
+ * throws std::runtime_error on malformed data
+ */
+SparkYuvLut3D ParseCubeLut3D(const char *data, size_t length);
+
+/**
+ * @brief Packs RGB triplets of size x size x size lattice with red changing fastest
+ */
+SparkYuvLut3D MakeLut3D(const float *rgb, uint32_t size);
+
+/**
+ * @brief Applies 3D LUT to gamma-encoded image, alpha is kept as is.
+ * Fused YCbCr420 variants decode 8-bit YCbCr, apply the LUT and store 8-bit pixels in one pass.
+ * @param depth Bit depth of 16-bit image
+ */
+
+// MARK: 3D LUT Declarations
+
+void ApplyLut3DRGBA(const uint8_t *src, uint32_t srcStride,
+                    uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                    const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void ApplyLut3DRGBA16(const uint16_t *src, uint32_t srcStride,
+                      uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, int depth,
+                      const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void ApplyLut3DRGBA1010102(const uint8_t *src, uint32_t srcStride,
+                           uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                           const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void ApplyLut3DRGBAF16(const uint16_t *src, uint32_t srcStride,
+                       uint16_t *dst, uint32_t dstStride, uint32_t width, uint32_t height,
+                       const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+
+// MARK: YCbCr420 3D LUT Declarations
+
+void YCbCr420ToRGBALut3D(uint8_t *dst, uint32_t dstStride,
+                         uint32_t width, uint32_t height,
+                         const uint8_t *yPlane, uint32_t yStride,
+                         const uint8_t *uPlane, uint32_t uStride,
+                         const uint8_t *vPlane, uint32_t vStride,
+                         float kr, float kb, SparkYuvColorRange colorRange,
+                         const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void YCbCr420ToRGBLut3D(uint8_t *dst, uint32_t dstStride,
+                        uint32_t width, uint32_t height,
+                        const uint8_t *yPlane, uint32_t yStride,
+                        const uint8_t *uPlane, uint32_t uStride,
+                        const uint8_t *vPlane, uint32_t vStride,
+                        float kr, float kb, SparkYuvColorRange colorRange,
+                        const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+#if SPARKYUV_FULL_CHANNELS
+void YCbCr420ToARGBLut3D(uint8_t *dst, uint32_t dstStride,
+                         uint32_t width, uint32_t height,
+                         const uint8_t *yPlane, uint32_t yStride,
+                         const uint8_t *uPlane, uint32_t uStride,
+                         const uint8_t *vPlane, uint32_t vStride,
+                         float kr, float kb, SparkYuvColorRange colorRange,
+                         const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void YCbCr420ToABGRLut3D(uint8_t *dst, uint32_t dstStride,
+                         uint32_t width, uint32_t height,
+                         const uint8_t *yPlane, uint32_t yStride,
+                         const uint8_t *uPlane, uint32_t uStride,
+                         const uint8_t *vPlane, uint32_t vStride,
+                         float kr, float kb, SparkYuvColorRange colorRange,
+                         const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void YCbCr420ToBGRALut3D(uint8_t *dst, uint32_t dstStride,
+                         uint32_t width, uint32_t height,
+                         const uint8_t *yPlane, uint32_t yStride,
+                         const uint8_t *uPlane, uint32_t uStride,
+                         const uint8_t *vPlane, uint32_t vStride,
+                         float kr, float kb, SparkYuvColorRange colorRange,
+                         const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+void YCbCr420ToBGRLut3D(uint8_t *dst, uint32_t dstStride,
+                        uint32_t width, uint32_t height,
+                        const uint8_t *yPlane, uint32_t yStride,
+                        const uint8_t *uPlane, uint32_t uStride,
+                        const uint8_t *vPlane, uint32_t vStride,
+                        float kr, float kb, SparkYuvColorRange colorRange,
+                        const SparkYuvLut3D &lut, SparkYuvLutInterpolation interpolation);
+#endif
+
+}
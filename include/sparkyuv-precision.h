@@ -0,0 +1,116 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+
+namespace sparkyuv {
+
+/**
+ * @brief YCbCr 444/422/420 8-bit and 10/12-bit decoding with selectable precision.
+ * YUV_PRECISION_FAST is the same as overload without precision, 6-bit fixed point coefficients.
+ * YUV_PRECISION_HIGH keeps samples at 14 bits and applies coefficients as integer part plus Q15 fraction,
+ * result is rounded to nearest, it is close to float reference at the cost of a few more multiplications.
+ */
+
+#define YCbCr8ToXXXX_PRECISION_GEN(yuvname, pixelType) \
+void yuvname##To##pixelType(uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                            const uint8_t *yPlane, uint32_t yStride,\
+                            const uint8_t *uPlane, uint32_t uStride,\
+                            const uint8_t *vPlane, uint32_t vStride,\
+                            float kr, float kb, SparkYuvColorRange colorRange, SparkYuvPrecision precision);
+
+#define YCbCr16ToXXXX_PRECISION_GEN(yuvname, pixelType, bit) \
+void yuvname##P##bit##To##pixelType##bit(uint16_t *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                                         const uint16_t *yPlane, uint32_t yStride,\
+                                         const uint16_t *uPlane, uint32_t uStride,\
+                                         const uint16_t *vPlane, uint32_t vStride,\
+                                         float kr, float kb, SparkYuvColorRange colorRange,\
+                                         SparkYuvPrecision precision);
+
+#define YCbCrToXXXX_PRECISION_GEN(pixelType) \
+    YCbCr8ToXXXX_PRECISION_GEN(YCbCr444, pixelType) \
+    YCbCr8ToXXXX_PRECISION_GEN(YCbCr422, pixelType) \
+    YCbCr8ToXXXX_PRECISION_GEN(YCbCr420, pixelType) \
+    YCbCr16ToXXXX_PRECISION_GEN(YCbCr444, pixelType, 10) \
+    YCbCr16ToXXXX_PRECISION_GEN(YCbCr422, pixelType, 10) \
+    YCbCr16ToXXXX_PRECISION_GEN(YCbCr420, pixelType, 10) \
+    YCbCr16ToXXXX_PRECISION_GEN(YCbCr444, pixelType, 12) \
+    YCbCr16ToXXXX_PRECISION_GEN(YCbCr422, pixelType, 12) \
+    YCbCr16ToXXXX_PRECISION_GEN(YCbCr420, pixelType, 12)
+
+YCbCrToXXXX_PRECISION_GEN(RGBA)
+YCbCrToXXXX_PRECISION_GEN(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCrToXXXX_PRECISION_GEN(ARGB)
+YCbCrToXXXX_PRECISION_GEN(ABGR)
+YCbCrToXXXX_PRECISION_GEN(BGRA)
+YCbCrToXXXX_PRECISION_GEN(BGR)
+#endif
+
+#undef YCbCrToXXXX_PRECISION_GEN
+#undef YCbCr16ToXXXX_PRECISION_GEN
+#undef YCbCr8ToXXXX_PRECISION_GEN
+
+/**
+ * @brief YCbCr 444/422/420 8-bit and 10/12-bit encoding with selectable precision.
+ * YUV_PRECISION_FAST is the same as overload without precision, 8-bit fixed point coefficients.
+ * YUV_PRECISION_HIGH keeps samples at 14 bits and applies coefficients as Q15 fractions,
+ * subsampled chroma is averaged before rounding, it is close to float reference.
+ */
+
+#define XXXXToYCbCr8_PRECISION_GEN(yuvname, pixelType) \
+void pixelType##To##yuvname(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                            uint8_t *yPlane, uint32_t yStride,\
+                            uint8_t *uPlane, uint32_t uStride,\
+                            uint8_t *vPlane, uint32_t vStride,\
+                            float kr, float kb, SparkYuvColorRange colorRange, SparkYuvPrecision precision);
+
+#define XXXXToYCbCr16_PRECISION_GEN(yuvname, pixelType, bit) \
+void pixelType##bit##To##yuvname##P##bit(const uint16_t *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                                         uint16_t *yPlane, uint32_t yStride,\
+                                         uint16_t *uPlane, uint32_t uStride,\
+                                         uint16_t *vPlane, uint32_t vStride,\
+                                         float kr, float kb, SparkYuvColorRange colorRange,\
+                                         SparkYuvPrecision precision);
+
+#define XXXXToYCbCr_PRECISION_GEN(pixelType) \
+    XXXXToYCbCr8_PRECISION_GEN(YCbCr444, pixelType) \
+    XXXXToYCbCr8_PRECISION_GEN(YCbCr422, pixelType) \
+    XXXXToYCbCr8_PRECISION_GEN(YCbCr420, pixelType) \
+    XXXXToYCbCr16_PRECISION_GEN(YCbCr444, pixelType, 10) \
+    XXXXToYCbCr16_PRECISION_GEN(YCbCr422, pixelType, 10) \
+    XXXXToYCbCr16_PRECISION_GEN(YCbCr420, pixelType, 10) \
+    XXXXToYCbCr16_PRECISION_GEN(YCbCr444, pixelType, 12) \
+    XXXXToYCbCr16_PRECISION_GEN(YCbCr422, pixelType, 12) \
+    XXXXToYCbCr16_PRECISION_GEN(YCbCr420, pixelType, 12)
+
+XXXXToYCbCr_PRECISION_GEN(RGBA)
+XXXXToYCbCr_PRECISION_GEN(RGB)
+#if SPARKYUV_FULL_CHANNELS
+XXXXToYCbCr_PRECISION_GEN(ARGB)
+XXXXToYCbCr_PRECISION_GEN(ABGR)
+XXXXToYCbCr_PRECISION_GEN(BGRA)
+XXXXToYCbCr_PRECISION_GEN(BGR)
+#endif
+
+#undef XXXXToYCbCr_PRECISION_GEN
+#undef XXXXToYCbCr16_PRECISION_GEN
+#undef XXXXToYCbCr8_PRECISION_GEN
+
+}
@@ -0,0 +1,377 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+
+namespace sparkyuv {
+/**
+ * @brief Region conversion crops `region` from the source image, converts it to RGB and scales it into destination
+ * in one strip pass. Only source rows which are sampled by destination are converted.
+ * Supported samplers are `bilinear` and `nearest`. Batched `Regions` form converts many regions of the same frame.
+ */
+
+// MARK: NV21 Region Declarations
+
+void NV21RegionToRGBA(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionsToRGBA(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionToRGB(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height, SparkYuvRegion region,
+                     float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionsToRGB(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#if SPARKYUV_FULL_CHANNELS
+void NV21RegionToARGB(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionsToARGB(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionToABGR(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionsToABGR(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionToBGRA(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionsToBGRA(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionToBGR(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height, SparkYuvRegion region,
+                     float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV21RegionsToBGR(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#endif
+
+// MARK: NV12 Region Declarations
+
+void NV12RegionToRGBA(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionsToRGBA(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionToRGB(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height, SparkYuvRegion region,
+                     float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionsToRGB(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#if SPARKYUV_FULL_CHANNELS
+void NV12RegionToARGB(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionsToARGB(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionToABGR(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionsToABGR(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionToBGRA(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height, SparkYuvRegion region,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionsToBGRA(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                       const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                       uint32_t width, uint32_t height,
+                       float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionToBGR(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height, SparkYuvRegion region,
+                     float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void NV12RegionsToBGR(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#endif
+
+// MARK: YCbCr420 Region Declarations
+
+void YCbCr420RegionToRGBA(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                          const uint8_t *ySrc, uint32_t yPlaneStride,
+                          const uint8_t *uSrc, uint32_t uPlaneStride,
+                          const uint8_t *vSrc, uint32_t vPlaneStride,
+                          uint32_t width, uint32_t height, SparkYuvRegion region,
+                          float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionsToRGBA(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                           const uint8_t *ySrc, uint32_t yPlaneStride,
+                           const uint8_t *uSrc, uint32_t uPlaneStride,
+                           const uint8_t *vSrc, uint32_t vPlaneStride,
+                           uint32_t width, uint32_t height,
+                           float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionToRGB(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                         const uint8_t *ySrc, uint32_t yPlaneStride,
+                         const uint8_t *uSrc, uint32_t uPlaneStride,
+                         const uint8_t *vSrc, uint32_t vPlaneStride,
+                         uint32_t width, uint32_t height, SparkYuvRegion region,
+                         float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionsToRGB(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                          const uint8_t *ySrc, uint32_t yPlaneStride,
+                          const uint8_t *uSrc, uint32_t uPlaneStride,
+                          const uint8_t *vSrc, uint32_t vPlaneStride,
+                          uint32_t width, uint32_t height,
+                          float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#if SPARKYUV_FULL_CHANNELS
+void YCbCr420RegionToARGB(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                          const uint8_t *ySrc, uint32_t yPlaneStride,
+                          const uint8_t *uSrc, uint32_t uPlaneStride,
+                          const uint8_t *vSrc, uint32_t vPlaneStride,
+                          uint32_t width, uint32_t height, SparkYuvRegion region,
+                          float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionsToARGB(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                           const uint8_t *ySrc, uint32_t yPlaneStride,
+                           const uint8_t *uSrc, uint32_t uPlaneStride,
+                           const uint8_t *vSrc, uint32_t vPlaneStride,
+                           uint32_t width, uint32_t height,
+                           float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionToABGR(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                          const uint8_t *ySrc, uint32_t yPlaneStride,
+                          const uint8_t *uSrc, uint32_t uPlaneStride,
+                          const uint8_t *vSrc, uint32_t vPlaneStride,
+                          uint32_t width, uint32_t height, SparkYuvRegion region,
+                          float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionsToABGR(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                           const uint8_t *ySrc, uint32_t yPlaneStride,
+                           const uint8_t *uSrc, uint32_t uPlaneStride,
+                           const uint8_t *vSrc, uint32_t vPlaneStride,
+                           uint32_t width, uint32_t height,
+                           float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionToBGRA(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                          const uint8_t *ySrc, uint32_t yPlaneStride,
+                          const uint8_t *uSrc, uint32_t uPlaneStride,
+                          const uint8_t *vSrc, uint32_t vPlaneStride,
+                          uint32_t width, uint32_t height, SparkYuvRegion region,
+                          float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionsToBGRA(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                           const uint8_t *ySrc, uint32_t yPlaneStride,
+                           const uint8_t *uSrc, uint32_t uPlaneStride,
+                           const uint8_t *vSrc, uint32_t vPlaneStride,
+                           uint32_t width, uint32_t height,
+                           float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionToBGR(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                         const uint8_t *ySrc, uint32_t yPlaneStride,
+                         const uint8_t *uSrc, uint32_t uPlaneStride,
+                         const uint8_t *vSrc, uint32_t vPlaneStride,
+                         uint32_t width, uint32_t height, SparkYuvRegion region,
+                         float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420RegionsToBGR(const SparkYuvRegionTarget *targets, uint32_t targetsCount,
+                          const uint8_t *ySrc, uint32_t yPlaneStride,
+                          const uint8_t *uSrc, uint32_t uPlaneStride,
+                          const uint8_t *vSrc, uint32_t vPlaneStride,
+                          uint32_t width, uint32_t height,
+                          float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#endif
+
+/**
+ * @brief Scaled conversion decimates luma and chroma planes into destination size and converts only them to RGB,
+ * full resolution RGB frame is never materialized. Box reduction is used when both luma and chroma planes
+ * have exact integer factors, any other sizes resample both planes with bilinear.
+ */
+
+// MARK: NV21 Scaled Declarations
+
+void NV21ToRGBAScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV21ToRGBScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+#if SPARKYUV_FULL_CHANNELS
+void NV21ToARGBScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV21ToABGRScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV21ToBGRAScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV21ToBGRScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+#endif
+
+// MARK: NV12 Scaled Declarations
+
+void NV12ToRGBAScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV12ToRGBScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+#if SPARKYUV_FULL_CHANNELS
+void NV12ToARGBScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV12ToABGRScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV12ToBGRAScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                      const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                      uint32_t width, uint32_t height,
+                      float kr, float kb, SparkYuvColorRange colorRange);
+void NV12ToBGRScaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                     const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+#endif
+
+
+/**
+ * @brief Letterbox conversion writes image into `content` rectangle of a fixed size destination and fills
+ * the rest with border color in the same pass, border rows are written with non-temporal stores.
+ * Decoders resample the image with `sampler` when content size differs from the image size,
+ * encoders don't resample, so content size must match the image size, border is given in YCbCr
+ * and content origin must be even.
+ */
+
+// MARK: YCbCr420 Letterbox Declarations
+
+void YCbCr420ToRGBALetterbox(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                             SparkYuvRegion content,
+                             const uint8_t *ySrc, uint32_t yPlaneStride,
+                             const uint8_t *uSrc, uint32_t uPlaneStride,
+                             const uint8_t *vSrc, uint32_t vPlaneStride,
+                             uint32_t width, uint32_t height, SparkYuvColor border,
+                             float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420ToRGBLetterbox(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                            SparkYuvRegion content,
+                            const uint8_t *ySrc, uint32_t yPlaneStride,
+                            const uint8_t *uSrc, uint32_t uPlaneStride,
+                            const uint8_t *vSrc, uint32_t vPlaneStride,
+                            uint32_t width, uint32_t height, SparkYuvColor border,
+                            float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#if SPARKYUV_FULL_CHANNELS
+void YCbCr420ToARGBLetterbox(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                             SparkYuvRegion content,
+                             const uint8_t *ySrc, uint32_t yPlaneStride,
+                             const uint8_t *uSrc, uint32_t uPlaneStride,
+                             const uint8_t *vSrc, uint32_t vPlaneStride,
+                             uint32_t width, uint32_t height, SparkYuvColor border,
+                             float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420ToABGRLetterbox(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                             SparkYuvRegion content,
+                             const uint8_t *ySrc, uint32_t yPlaneStride,
+                             const uint8_t *uSrc, uint32_t uPlaneStride,
+                             const uint8_t *vSrc, uint32_t vPlaneStride,
+                             uint32_t width, uint32_t height, SparkYuvColor border,
+                             float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420ToBGRALetterbox(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                             SparkYuvRegion content,
+                             const uint8_t *ySrc, uint32_t yPlaneStride,
+                             const uint8_t *uSrc, uint32_t uPlaneStride,
+                             const uint8_t *vSrc, uint32_t vPlaneStride,
+                             uint32_t width, uint32_t height, SparkYuvColor border,
+                             float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+void YCbCr420ToBGRLetterbox(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+                            SparkYuvRegion content,
+                            const uint8_t *ySrc, uint32_t yPlaneStride,
+                            const uint8_t *uSrc, uint32_t uPlaneStride,
+                            const uint8_t *vSrc, uint32_t vPlaneStride,
+                            uint32_t width, uint32_t height, SparkYuvColor border,
+                            float kr, float kb, SparkYuvColorRange colorRange, SparkYuvSampler sampler);
+#endif
+
+void RGBAToYCbCr420Letterbox(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                             uint8_t *yPlane, uint32_t yStride,
+                             uint8_t *uPlane, uint32_t uStride,
+                             uint8_t *vPlane, uint32_t vStride,
+                             uint32_t dstWidth, uint32_t dstHeight, SparkYuvRegion content,
+                             uint8_t borderY, uint8_t borderCb, uint8_t borderCr,
+                             float kr, float kb, SparkYuvColorRange colorRange);
+void RGBToYCbCr420Letterbox(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                            uint8_t *yPlane, uint32_t yStride,
+                            uint8_t *uPlane, uint32_t uStride,
+                            uint8_t *vPlane, uint32_t vStride,
+                            uint32_t dstWidth, uint32_t dstHeight, SparkYuvRegion content,
+                            uint8_t borderY, uint8_t borderCb, uint8_t borderCr,
+                            float kr, float kb, SparkYuvColorRange colorRange);
+#if SPARKYUV_FULL_CHANNELS
+void ARGBToYCbCr420Letterbox(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                             uint8_t *yPlane, uint32_t yStride,
+                             uint8_t *uPlane, uint32_t uStride,
+                             uint8_t *vPlane, uint32_t vStride,
+                             uint32_t dstWidth, uint32_t dstHeight, SparkYuvRegion content,
+                             uint8_t borderY, uint8_t borderCb, uint8_t borderCr,
+                             float kr, float kb, SparkYuvColorRange colorRange);
+void ABGRToYCbCr420Letterbox(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                             uint8_t *yPlane, uint32_t yStride,
+                             uint8_t *uPlane, uint32_t uStride,
+                             uint8_t *vPlane, uint32_t vStride,
+                             uint32_t dstWidth, uint32_t dstHeight, SparkYuvRegion content,
+                             uint8_t borderY, uint8_t borderCb, uint8_t borderCr,
+                             float kr, float kb, SparkYuvColorRange colorRange);
+void BGRAToYCbCr420Letterbox(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                             uint8_t *yPlane, uint32_t yStride,
+                             uint8_t *uPlane, uint32_t uStride,
+                             uint8_t *vPlane, uint32_t vStride,
+                             uint32_t dstWidth, uint32_t dstHeight, SparkYuvRegion content,
+                             uint8_t borderY, uint8_t borderCb, uint8_t borderCr,
+                             float kr, float kb, SparkYuvColorRange colorRange);
+void BGRToYCbCr420Letterbox(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                            uint8_t *yPlane, uint32_t yStride,
+                            uint8_t *uPlane, uint32_t uStride,
+                            uint8_t *vPlane, uint32_t vStride,
+                            uint32_t dstWidth, uint32_t dstHeight, SparkYuvRegion content,
+                            uint8_t borderY, uint8_t borderCb, uint8_t borderCr,
+                            float kr, float kb, SparkYuvColorRange colorRange);
+#endif
+
+}
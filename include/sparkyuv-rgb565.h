@@ -18,65 +18,145 @@
 
 namespace sparkyuv {
 
+/**
+ * Packing into RGB565 truncates to 5 and 6 bits,
+ * DITHER_BAYER8X8 adds ordered thresholds before truncation to avoid banding
+ */
 void RGBToRGB565(const uint8_t *src, uint32_t srcStride,
                  uint16_t *dst, uint32_t dstStride,
                  uint32_t width, uint32_t height);
+void RGBToRGB565(const uint8_t *src, uint32_t srcStride,
+                 uint16_t *dst, uint32_t dstStride,
+                 uint32_t width, uint32_t height,
+                 SparkYuvDither dither);
 void BGRToRGB565(const uint8_t *src, uint32_t srcStride,
                  uint16_t *dst, uint32_t dstStride,
                  uint32_t width, uint32_t height);
+void BGRToRGB565(const uint8_t *src, uint32_t srcStride,
+                 uint16_t *dst, uint32_t dstStride,
+                 uint32_t width, uint32_t height,
+                 SparkYuvDither dither);
 void RGBAToRGB565(const uint8_t *src, uint32_t srcStride,
                   uint16_t *dst, uint32_t dstStride,
                   uint32_t width, uint32_t height);
+void RGBAToRGB565(const uint8_t *src, uint32_t srcStride,
+                  uint16_t *dst, uint32_t dstStride,
+                  uint32_t width, uint32_t height,
+                  SparkYuvDither dither);
 void BGRAToRGB565(const uint8_t *src, uint32_t srcStride,
                   uint16_t *dst, uint32_t dstStride,
                   uint32_t width, uint32_t height);
+void BGRAToRGB565(const uint8_t *src, uint32_t srcStride,
+                  uint16_t *dst, uint32_t dstStride,
+                  uint32_t width, uint32_t height,
+                  SparkYuvDither dither);
 void ABGRToRGB565(const uint8_t *src, uint32_t srcStride,
                   uint16_t *dst, uint32_t dstStride,
                   uint32_t width, uint32_t height);
+void ABGRToRGB565(const uint8_t *src, uint32_t srcStride,
+                  uint16_t *dst, uint32_t dstStride,
+                  uint32_t width, uint32_t height,
+                  SparkYuvDither dither);
 void ARGBToRGB565(const uint8_t *src, uint32_t srcStride,
                   uint16_t *dst, uint32_t dstStride,
                   uint32_t width, uint32_t height);
+void ARGBToRGB565(const uint8_t *src, uint32_t srcStride,
+                  uint16_t *dst, uint32_t dstStride,
+                  uint32_t width, uint32_t height,
+                  SparkYuvDither dither);
 void RGBA1010102ToRGB565(const uint8_t *src, uint32_t srcStride,
                          uint16_t *dst, uint32_t dstStride,
                          uint32_t width, uint32_t height);
+void RGBA1010102ToRGB565(const uint8_t *src, uint32_t srcStride,
+                         uint16_t *dst, uint32_t dstStride,
+                         uint32_t width, uint32_t height,
+                         SparkYuvDither dither);
 
 void RGBF16ToRGB565(const uint16_t *src, uint32_t srcStride,
                     uint16_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height);
+void RGBF16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                    uint16_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height,
+                    SparkYuvDither dither);
 void BGRF16ToRGB565(const uint16_t *src, uint32_t srcStride,
                     uint16_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height);
+void BGRF16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                    uint16_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height,
+                    SparkYuvDither dither);
 void RGBAF16ToRGB565(const uint16_t *src, uint32_t srcStride,
                      uint16_t *dst, uint32_t dstStride,
                      uint32_t width, uint32_t height);
+void RGBAF16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                     uint16_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height,
+                     SparkYuvDither dither);
 void BGRAF16ToRGB565(const uint16_t *src, uint32_t srcStride,
                      uint16_t *dst, uint32_t dstStride,
                      uint32_t width, uint32_t height);
+void BGRAF16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                     uint16_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height,
+                     SparkYuvDither dither);
 void ABGRF16ToRGB565(const uint16_t *src, uint32_t srcStride,
                      uint16_t *dst, uint32_t dstStride,
                      uint32_t width, uint32_t height);
+void ABGRF16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                     uint16_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height,
+                     SparkYuvDither dither);
 void ARGBF16ToRGB565(const uint16_t *src, uint32_t srcStride,
                      uint16_t *dst, uint32_t dstStride,
                      uint32_t width, uint32_t height);
+void ARGBF16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                     uint16_t *dst, uint32_t dstStride,
+                     uint32_t width, uint32_t height,
+                     SparkYuvDither dither);
 
 void RGB16ToRGB565(const uint16_t *src, uint32_t srcStride,
                    uint16_t *dst, uint32_t dstStride,
                    uint32_t width, uint32_t height, int bitDepth);
+void RGB16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                   uint16_t *dst, uint32_t dstStride,
+                   uint32_t width, uint32_t height, int bitDepth,
+                   SparkYuvDither dither);
 void BGR16ToRGB565(const uint16_t *src, uint32_t srcStride,
                    uint16_t *dst, uint32_t dstStride,
                    uint32_t width, uint32_t height, int bitDepth);
+void BGR16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                   uint16_t *dst, uint32_t dstStride,
+                   uint32_t width, uint32_t height, int bitDepth,
+                   SparkYuvDither dither);
 void RGBA16ToRGB565(const uint16_t *src, uint32_t srcStride,
                     uint16_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height, int bitDepth);
+void RGBA16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                    uint16_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height, int bitDepth,
+                    SparkYuvDither dither);
 void BGRA16ToRGB565(const uint16_t *src, uint32_t srcStride,
                     uint16_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height, int bitDepth);
+void BGRA16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                    uint16_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height, int bitDepth,
+                    SparkYuvDither dither);
 void ABGR16ToRGB565(const uint16_t *src, uint32_t srcStride,
                     uint16_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height, int bitDepth);
+void ABGR16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                    uint16_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height, int bitDepth,
+                    SparkYuvDither dither);
 void ARGB16ToRGB565(const uint16_t *src, uint32_t srcStride,
                     uint16_t *dst, uint32_t dstStride,
                     uint32_t width, uint32_t height, int bitDepth);
+void ARGB16ToRGB565(const uint16_t *src, uint32_t srcStride,
+                    uint16_t *dst, uint32_t dstStride,
+                    uint32_t width, uint32_t height, int bitDepth,
+                    SparkYuvDither dither);
 
 void RGB565ToRGB(const uint16_t *src, uint32_t srcStride,
                  uint8_t *dst, uint32_t dstStride,
@@ -0,0 +1,130 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "sparkyuv-def.h"
+
+namespace sparkyuv {
+/**
+ * @brief Tensor conversion decodes image and writes RGB tensor normalized as (x / 255 - mean) / std
+ * in planar `TENSOR_CHW` or interleaved `TENSOR_HWC` layout, alpha is dropped.
+ * F16 tensors are stored as IEEE half bits, I8 tensors are quantized as round(v / quantizationScale) + zeroPoint
+ * with saturation. Tensors are contiguous: 3 x height x width or height x width x 3.
+ */
+
+// MARK: RGBX Tensor Declarations
+
+void RGBAToTensorF32(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void RGBAToTensorF16(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void RGBAToTensorI8(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                    float quantizationScale, int32_t zeroPoint);
+void RGBToTensorF32(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void RGBToTensorF16(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void RGBToTensorI8(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                   int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                   float quantizationScale, int32_t zeroPoint);
+#if SPARKYUV_FULL_CHANNELS
+void ARGBToTensorF32(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void ARGBToTensorF16(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void ARGBToTensorI8(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                    float quantizationScale, int32_t zeroPoint);
+void ABGRToTensorF32(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void ABGRToTensorF16(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void ABGRToTensorI8(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                    float quantizationScale, int32_t zeroPoint);
+void BGRAToTensorF32(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void BGRAToTensorF16(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                     uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void BGRAToTensorI8(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                    float quantizationScale, int32_t zeroPoint);
+void BGRToTensorF32(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void BGRToTensorF16(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                    uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization);
+void BGRToTensorI8(const uint8_t *src, uint32_t srcStride, uint32_t width, uint32_t height,
+                   int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                   float quantizationScale, int32_t zeroPoint);
+#endif
+
+// MARK: NV21 Tensor Declarations
+
+void NV21ToTensorF32(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+void NV21ToTensorF16(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+void NV21ToTensorI8(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                    uint32_t width, uint32_t height,
+                    int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                    float quantizationScale, int32_t zeroPoint,
+                    float kr, float kb, SparkYuvColorRange colorRange);
+
+// MARK: NV12 Tensor Declarations
+
+void NV12ToTensorF32(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+void NV12ToTensorF16(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                     uint32_t width, uint32_t height,
+                     uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                     float kr, float kb, SparkYuvColorRange colorRange);
+void NV12ToTensorI8(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride,
+                    uint32_t width, uint32_t height,
+                    int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                    float quantizationScale, int32_t zeroPoint,
+                    float kr, float kb, SparkYuvColorRange colorRange);
+
+// MARK: YCbCr420 Tensor Declarations
+
+void YCbCr420ToTensorF32(const uint8_t *ySrc, uint32_t yPlaneStride,
+                         const uint8_t *uSrc, uint32_t uPlaneStride,
+                         const uint8_t *vSrc, uint32_t vPlaneStride,
+                         uint32_t width, uint32_t height,
+                         float *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                         float kr, float kb, SparkYuvColorRange colorRange);
+void YCbCr420ToTensorF16(const uint8_t *ySrc, uint32_t yPlaneStride,
+                         const uint8_t *uSrc, uint32_t uPlaneStride,
+                         const uint8_t *vSrc, uint32_t vPlaneStride,
+                         uint32_t width, uint32_t height,
+                         uint16_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                         float kr, float kb, SparkYuvColorRange colorRange);
+void YCbCr420ToTensorI8(const uint8_t *ySrc, uint32_t yPlaneStride,
+                        const uint8_t *uSrc, uint32_t uPlaneStride,
+                        const uint8_t *vSrc, uint32_t vPlaneStride,
+                        uint32_t width, uint32_t height,
+                        int8_t *tensor, SparkYuvTensorLayout layout, SparkYuvTensorNormalization normalization,
+                        float quantizationScale, int32_t zeroPoint,
+                        float kr, float kb, SparkYuvColorRange colorRange);
+}
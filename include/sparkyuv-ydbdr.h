@@ -773,5 +773,49 @@ void YDbDr420P8ToBGR8(uint8_t *src, uint32_t srcStride,
                       const uint8_t *vPlane, uint32_t vStride,
                       SparkYuvColorRange colorRange);
 #endif
+
+/**
+ * @brief YDbDr decoding with selectable precision, YUV_PRECISION_FAST is the same as overload without precision.
+ * YUV_PRECISION_HIGH evaluates decoding matrix in f32 with FMA and rounds to nearest, so tiny Db, Dr coefficients
+ * are not lost and TV range is reformatted per component.
+ */
+
+#define YDbDrToXXXX_PRECISION_GEN(T, pixelType, bit) \
+void YDbDr444P##bit##To##pixelType##bit(T *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                                        const T *yPlane, uint32_t yStride, const T *uPlane, uint32_t uStride,\
+                                        const T *vPlane, uint32_t vStride,\
+                                        SparkYuvColorRange colorRange, SparkYuvPrecision precision);\
+void YDbDr422P##bit##To##pixelType##bit(T *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                                        const T *yPlane, uint32_t yStride, const T *uPlane, uint32_t uStride,\
+                                        const T *vPlane, uint32_t vStride,\
+                                        SparkYuvColorRange colorRange, SparkYuvPrecision precision);\
+void YDbDr420P##bit##To##pixelType##bit(T *src, uint32_t srcStride, uint32_t width, uint32_t height,\
+                                        const T *yPlane, uint32_t yStride, const T *uPlane, uint32_t uStride,\
+                                        const T *vPlane, uint32_t vStride,\
+                                        SparkYuvColorRange colorRange, SparkYuvPrecision precision);
+
+YDbDrToXXXX_PRECISION_GEN(uint8_t, RGBA, 8)
+YDbDrToXXXX_PRECISION_GEN(uint8_t, RGB, 8)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, RGBA, 10)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, RGB, 10)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, RGBA, 12)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, RGB, 12)
+#if SPARKYUV_FULL_CHANNELS
+YDbDrToXXXX_PRECISION_GEN(uint8_t, BGRA, 8)
+YDbDrToXXXX_PRECISION_GEN(uint8_t, ABGR, 8)
+YDbDrToXXXX_PRECISION_GEN(uint8_t, ARGB, 8)
+YDbDrToXXXX_PRECISION_GEN(uint8_t, BGR, 8)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, BGRA, 10)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, ABGR, 10)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, ARGB, 10)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, BGR, 10)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, BGRA, 12)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, ABGR, 12)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, ARGB, 12)
+YDbDrToXXXX_PRECISION_GEN(uint16_t, BGR, 12)
+#endif
+
+#undef YDbDrToXXXX_PRECISION_GEN
+
 }
 #endif //YUV_INCLUDE_SPARKYUV_YDBDR_H_
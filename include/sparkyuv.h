@@ -30,6 +30,14 @@
 #include "sparkyuv-yiq.h"
 #include "sparkyuv-ydbdr.h"
 #include "sparkyuv-ycbcr.h"
+#include "sparkyuv-region.h"
+#include "sparkyuv-tensor.h"
+#include "sparkyuv-hdr.h"
+#include "sparkyuv-gamut.h"
+#include "sparkyuv-lut.h"
+#include "sparkyuv-colormodel.h"
+#include "sparkyuv-hsv.h"
+#include "sparkyuv-precision.h"
 
 namespace sparkyuv {
 
@@ -772,20 +780,20 @@ void BGR12ToYCbCr420P12(const uint16_t *src, uint32_t srcStride,
                         float kr, float kb, SparkYuvColorRange colorRange);
 #endif
 
-#define YCbCr420ToGEN(pixelType, name, kr, kb, range) \
-    static void YCbCr420##name##To##pixelType(uint8_t * dst, \
-                                            uint32_t rgbaStride, uint32_t width, uint32_t height,\
-                                            const uint8_t * ySrc, uint32_t yPlaneStride,\
-                                            const uint8_t * uSrc, uint32_t uPlaneStride,\
-                                            const uint8_t * vSrc, uint32_t vPlaneStride) {\
-         YCbCr420To##pixelType(dst, rgbaStride, width, height,\
-                             ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,\
-                             kr, kb, range);\
-    }
+/**
+ * BT.601, BT.709 and BT.2020 TV range decoders are compiled with constexpr fixed-point coefficients,
+ * output is bit-exact with the generic function called with the same kr/kb
+ */
+#define YCbCr420ToGEN(pixelType, name) \
+    void YCbCr420##name##To##pixelType(uint8_t * dst, \
+                                     uint32_t rgbaStride, uint32_t width, uint32_t height,\
+                                     const uint8_t * ySrc, uint32_t yPlaneStride,\
+                                     const uint8_t * uSrc, uint32_t uPlaneStride,\
+                                     const uint8_t * vSrc, uint32_t vPlaneStride);
 
 // MARK: YCbCr420 BT.601
 
-#define YCbCr420ToGEN601(pixelType) YCbCr420ToGEN(pixelType, BT601, 0.299f, 0.114f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr420ToGEN601(pixelType) YCbCr420ToGEN(pixelType, BT601)
 
 YCbCr420ToGEN601(RGBA)
 YCbCr420ToGEN601(RGB)
@@ -800,7 +808,7 @@ YCbCr420ToGEN601(BGR)
 
 // MARK: YCbCr422 BT.709
 
-#define YCbCr420ToGEN709(pixelType) YCbCr420ToGEN(pixelType, BT709, 0.2126f, 0.0722f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr420ToGEN709(pixelType) YCbCr420ToGEN(pixelType, BT709)
 
 YCbCr420ToGEN709(RGBA)
 YCbCr420ToGEN709(RGB)
@@ -815,7 +823,7 @@ YCbCr420ToGEN709(BGR)
 
 // MARK: YCbCr420 BT.2020
 
-#define YCbCr420ToGEN2020(pixelType) YCbCr420ToGEN(pixelType, BT2020, 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr420ToGEN2020(pixelType) YCbCr420ToGEN(pixelType, BT2020)
 
 YCbCr420ToGEN2020(RGBA)
 YCbCr420ToGEN2020(RGB)
@@ -829,20 +837,16 @@ YCbCr420ToGEN2020(BGR)
 #undef YCbCr420ToGEN2020
 #undef YCbCr420ToGEN
 
-#define YCbCr422ToGEN(pixelType, name, kr, kb, range) \
-    static void YCbCr422##name##To##pixelType(uint8_t * dst, \
-                                            uint32_t rgbaStride, uint32_t width, uint32_t height,\
-                                            const uint8_t * ySrc, uint32_t yPlaneStride,\
-                                            const uint8_t * uSrc, uint32_t uPlaneStride,\
-                                            const uint8_t * vSrc, uint32_t vPlaneStride) {  \
-         YCbCr422To##pixelType(dst, rgbaStride, width, height,\
-                             ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,\
-                             kr, kb, range); \
-    }
+#define YCbCr422ToGEN(pixelType, name) \
+    void YCbCr422##name##To##pixelType(uint8_t * dst, \
+                                     uint32_t rgbaStride, uint32_t width, uint32_t height,\
+                                     const uint8_t * ySrc, uint32_t yPlaneStride,\
+                                     const uint8_t * uSrc, uint32_t uPlaneStride,\
+                                     const uint8_t * vSrc, uint32_t vPlaneStride);
 
 // MARK: YCbCr422 BT.601
 
-#define YCbCr422ToGEN601(pixelType) YCbCr422ToGEN(pixelType, BT601, 0.299f, 0.114f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr422ToGEN601(pixelType) YCbCr422ToGEN(pixelType, BT601)
 
 YCbCr422ToGEN601(RGBA)
 YCbCr422ToGEN601(RGB)
@@ -857,7 +861,7 @@ YCbCr422ToGEN601(BGR)
 
 // MARK: YCbCr422 BT.709
 
-#define YCbCr422ToGEN709(pixelType) YCbCr422ToGEN(pixelType, BT709, 0.2126f, 0.0722f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr422ToGEN709(pixelType) YCbCr422ToGEN(pixelType, BT709)
 
 YCbCr422ToGEN709(RGBA)
 YCbCr422ToGEN709(RGB)
@@ -872,7 +876,7 @@ YCbCr422ToGEN709(BGR)
 
 // MARK: YCbCr422 BT.2020
 
-#define YCbCr422ToGEN2020(pixelType) YCbCr422ToGEN(pixelType, BT2020, 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr422ToGEN2020(pixelType) YCbCr422ToGEN(pixelType, BT2020)
 
 YCbCr422ToGEN2020(RGBA)
 YCbCr422ToGEN2020(RGB)
@@ -888,20 +892,16 @@ YCbCr422ToGEN2020(BGR)
 
 //MARK: YCbCr444 To RGBX
 
-#define YCbCr444ToGEN(pixelType, name, kr, kb, range) \
-    static void YCbCr444##name##To##pixelType(uint8_t* dst, \
-                                            uint32_t rgbaStride, uint32_t width, uint32_t height,\
-                                            const uint8_t * ySrc, uint32_t yPlaneStride,\
-                                            const uint8_t * uSrc, uint32_t uPlaneStride,\
-                                            const uint8_t * vSrc, uint32_t vPlaneStride) {  \
-         YCbCr444To##pixelType(dst, rgbaStride, width, height,\
-                             ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,\
-                             kr, kb, range); \
-    }
+#define YCbCr444ToGEN(pixelType, name) \
+    void YCbCr444##name##To##pixelType(uint8_t * dst, \
+                                     uint32_t rgbaStride, uint32_t width, uint32_t height,\
+                                     const uint8_t * ySrc, uint32_t yPlaneStride,\
+                                     const uint8_t * uSrc, uint32_t uPlaneStride,\
+                                     const uint8_t * vSrc, uint32_t vPlaneStride);
 
 // MARK: YCbCr444 BT.601
 
-#define YCbCr444ToGEN601(pixelType) YCbCr444ToGEN(pixelType, BT601, 0.299f, 0.114f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr444ToGEN601(pixelType) YCbCr444ToGEN(pixelType, BT601)
 
 YCbCr444ToGEN601(RGBA)
 YCbCr444ToGEN601(RGB)
@@ -916,7 +916,7 @@ YCbCr444ToGEN601(BGR)
 
 // MARK: YCbCr444 BT.709
 
-#define YCbCr444ToGEN709(pixelType) YCbCr444ToGEN(pixelType, BT709, 0.2126f, 0.0722f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr444ToGEN709(pixelType) YCbCr444ToGEN(pixelType, BT709)
 
 YCbCr444ToGEN709(RGBA)
 YCbCr444ToGEN709(RGB)
@@ -931,7 +931,7 @@ YCbCr444ToGEN709(BGR)
 
 // MARK: YCbCr444 BT.2020
 
-#define YCbCr444ToGEN2020(pixelType) YCbCr444ToGEN(pixelType, BT2020, 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV)
+#define YCbCr444ToGEN2020(pixelType) YCbCr444ToGEN(pixelType, BT2020)
 
 YCbCr444ToGEN2020(RGBA)
 YCbCr444ToGEN2020(RGB)
@@ -81,10 +81,18 @@ HWY_EXPORT(SaturateRGBA16HWY);
 HWY_EXPORT(SaturateRGB16HWY);
 
 #define SaturateXXXXFrom8ToN_DECLARATION_E(pixelType, sourceBitDepth) \
+HWY_DLLEXPORT void Saturate##pixelType##sourceBitDepth##To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride, \
+                                                            uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                                            const uint32_t width, const uint32_t height,\
+                                                            const SparkYuvDither dither) {\
+    HWY_DYNAMIC_DISPATCH(Saturate##pixelType##sourceBitDepth##To8HWY)(src, srcStride, dst, dstStride, width, height,\
+                                                                      dither);\
+  }\
 HWY_DLLEXPORT void Saturate##pixelType##sourceBitDepth##To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride, \
                                                             uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                                             const uint32_t width, const uint32_t height) {\
-    HWY_DYNAMIC_DISPATCH(Saturate##pixelType##sourceBitDepth##To8HWY)(src, srcStride, dst, dstStride, width, height);\
+    HWY_DYNAMIC_DISPATCH(Saturate##pixelType##sourceBitDepth##To8HWY)(src, srcStride, dst, dstStride, width, height,\
+                                                                      DITHER_NONE);\
   }
 
 SaturateXXXXFrom8ToN_DECLARATION_E(RGBA, 10)
@@ -99,10 +107,18 @@ SaturateXXXXFrom8ToN_DECLARATION_E(RGB, 16)
 #undef SaturateXXXXFrom8ToN_DECLARATION_E
 
 #define SATURATE_XXXX16_DYNAMIC_E(pixelType) \
+HWY_DLLEXPORT void Saturate##pixelType##To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride, \
+                                            uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                            const uint32_t width, const uint32_t height, const int bitDepth,\
+                                            const SparkYuvDither dither) {\
+    HWY_DYNAMIC_DISPATCH(Saturate##pixelType##16##HWY)(src, srcStride, dst, dstStride, width, height, bitDepth,\
+                                                       dither);\
+  }\
 HWY_DLLEXPORT void Saturate##pixelType##To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride, \
                                             uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                             const uint32_t width, const uint32_t height, const int bitDepth) {\
-    HWY_DYNAMIC_DISPATCH(Saturate##pixelType##16##HWY)(src, srcStride, dst, dstStride, width, height, bitDepth);\
+    HWY_DYNAMIC_DISPATCH(Saturate##pixelType##16##HWY)(src, srcStride, dst, dstStride, width, height, bitDepth,\
+                                                       DITHER_NONE);\
   }
 
 SATURATE_XXXX16_DYNAMIC_E(RGBA)
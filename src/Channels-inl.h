@@ -25,6 +25,7 @@
 #include "yuv-inl.h"
 #include "sparkyuv-internal.h"
 #include "TypeSupport.h"
+#include "Dither-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
@@ -40,7 +41,8 @@ template<class T, SparkYuvSurfaceChannels Surface = sparkyuv::SURFACE_CHANNEL>
 void
 ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                       T *SPARKYUV_RESTRICT dst, const uint32_t newStride,
-                      const uint32_t width, const uint32_t height, const int bitDepth) {
+                      const uint32_t width, const uint32_t height, const int bitDepth,
+                      const SparkYuvDither dither) {
   const ScalableTag<uint16_t> d16;
   using VU = Vec<decltype(d16)>;
   const RebindToSigned<decltype(d16)> di16;
@@ -70,6 +72,17 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
   const VF32 vAlpha1010102Scale = Set(f32, 3.f);
 #endif
 
+  // Ordered threshold is added before truncation, alpha and RGBA1010102 are never dithered
+  const bool useDither = dither != DITHER_NONE && Surface != SURFACE_RGBA1010102;
+#if SPARKYUV_ALLOW_FLOAT16
+  HWY_ALIGN hwy::float16_t ditherRow[HWY_MAX_BYTES / sizeof(uint16_t) + kDitherRowPeriod];
+  VF vDither = Zero(f16);
+#else
+  HWY_ALIGN float ditherRow[HWY_MAX_BYTES / sizeof(uint16_t) + kDitherRowPeriod];
+  VF32 vDitherLow = Zero(f32);
+  VF32 vDitherHigh = Zero(f32);
+#endif
+
 #if SPARKYUV_ALLOW_ACCELERATE_RGB1010102
   const bool useHWY = true;
 #else
@@ -92,6 +105,10 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
 
     uint32_t x = 0;
 
+    if (useDither) {
+      FillDitherRow(ditherRow, y, lanes + kDitherRowPeriod, dither);
+    }
+
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "Simplify"
@@ -100,6 +117,15 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
       for (; x + lanes < width; x += lanes) {
         VF in1, in2, in3, in4;
 
+        if (useDither) {
+#if SPARKYUV_ALLOW_FLOAT16
+          vDither = LoadU(f16, ditherRow + (x & 7));
+#else
+          vDitherLow = LoadU(f32, ditherRow + (x & 7));
+          vDitherHigh = LoadU(f32, ditherRow + (x & 7) + halfLanes);
+#endif
+        }
+
 #if SPARKYUV_ALLOW_FLOAT16
         auto castedSource = reinterpret_cast<const hwy::float16_t *>(srcPixels);
         switch (Surface) {
@@ -119,22 +145,22 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
 
         }
         VU out1, out2, out3, out4;
-        out1 = ConvertTo(d16, Mul(in1, vScale));
+        out1 = ConvertTo(d16, MulAdd(in1, vScale, vDither));
         switch (Surface) {
           case SURFACE_CHANNELS_3: {
-            out2 = ConvertTo(d16, Mul(in2, vScale));
-            out3 = ConvertTo(d16, Mul(in3, vScale));
+            out2 = ConvertTo(d16, MulAdd(in2, vScale, vDither));
+            out3 = ConvertTo(d16, MulAdd(in3, vScale, vDither));
           }
             break;
           case SURFACE_CHANNELS_4: {
-            out2 = ConvertTo(d16, Mul(in2, vScale));
-            out3 = ConvertTo(d16, Mul(in3, vScale));
+            out2 = ConvertTo(d16, MulAdd(in2, vScale, vDither));
+            out3 = ConvertTo(d16, MulAdd(in3, vScale, vDither));
             out4 = ConvertTo(d16, Mul(in4, vScale));
           }
             break;
           case SURFACE_RGBA1010102: {
-            out2 = ConvertTo(d16, Mul(in2, vScale));
-            out3 = ConvertTo(d16, Mul(in3, vScale));
+            out2 = ConvertTo(d16, MulAdd(in2, vScale, vDither));
+            out3 = ConvertTo(d16, MulAdd(in3, vScale, vDither));
             out4 = ConvertTo(d16, Mul(in4, vAlpha1010102Scale));
           }
             break;
@@ -166,8 +192,8 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
             break;
         }
 
-        const VF32 in1l = Mul(PromoteLowerTo(f32, in1), vScale);
-        const VF32 in1h = Mul(PromoteUpperTo(f32, in1), vScale);
+        const VF32 in1l = MulAdd(PromoteLowerTo(f32, in1), vScale, vDitherLow);
+        const VF32 in1h = MulAdd(PromoteUpperTo(f32, in1), vScale, vDitherHigh);
         VU out1, out2, out3, out4;
 
         const auto uout1l = DemoteTo(dhi16, ConvertTo(di32, in1l));
@@ -177,15 +203,15 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
 
         switch (Surface) {
           case SURFACE_CHANNELS_3: {
-            const VF32 in2l = Mul(PromoteLowerTo(f32, in2), vScale);
-            const VF32 in2h = Mul(PromoteUpperTo(f32, in2), vScale);
+            const VF32 in2l = MulAdd(PromoteLowerTo(f32, in2), vScale, vDitherLow);
+            const VF32 in2h = MulAdd(PromoteUpperTo(f32, in2), vScale, vDitherHigh);
 
             const auto uout2l = DemoteTo(dhi16, ConvertTo(di32, in2l));
             const auto uout2h = DemoteTo(dhi16, ConvertTo(di32, in2h));
             out2 = Combine(d16, BitCast(dh16, uout2h), BitCast(dh16, uout2l));
 
-            const VF32 in3l = Mul(PromoteLowerTo(f32, in3), vScale);
-            const VF32 in3h = Mul(PromoteUpperTo(f32, in3), vScale);
+            const VF32 in3l = MulAdd(PromoteLowerTo(f32, in3), vScale, vDitherLow);
+            const VF32 in3h = MulAdd(PromoteUpperTo(f32, in3), vScale, vDitherHigh);
 
             const auto uout3l = DemoteTo(dhi16, ConvertTo(di32, in3l));
             const auto uout3h = DemoteTo(dhi16, ConvertTo(di32, in3h));
@@ -193,15 +219,15 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
           }
             break;
           case SURFACE_CHANNELS_4: {
-            const VF32 in2l = Mul(PromoteLowerTo(f32, in2), vScale);
-            const VF32 in2h = Mul(PromoteUpperTo(f32, in2), vScale);
+            const VF32 in2l = MulAdd(PromoteLowerTo(f32, in2), vScale, vDitherLow);
+            const VF32 in2h = MulAdd(PromoteUpperTo(f32, in2), vScale, vDitherHigh);
 
             const auto uout2l = DemoteTo(dhi16, ConvertTo(di32, in2l));
             const auto uout2h = DemoteTo(dhi16, ConvertTo(di32, in2h));
             out2 = Combine(d16, BitCast(dh16, uout2h), BitCast(dh16, uout2l));
 
-            const VF32 in3l = Mul(PromoteLowerTo(f32, in3), vScale);
-            const VF32 in3h = Mul(PromoteUpperTo(f32, in3), vScale);
+            const VF32 in3l = MulAdd(PromoteLowerTo(f32, in3), vScale, vDitherLow);
+            const VF32 in3h = MulAdd(PromoteUpperTo(f32, in3), vScale, vDitherHigh);
 
             const auto uout3l = DemoteTo(dhi16, ConvertTo(di32, in3l));
             const auto uout3h = DemoteTo(dhi16, ConvertTo(di32, in3h));
@@ -216,14 +242,14 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
           }
             break;
           case SURFACE_RGBA1010102: {
-            const VF32 in2l = Mul(PromoteLowerTo(f32, in2), vScale);
-            const VF32 in2h = Mul(PromoteUpperTo(f32, in2), vScale);
+            const VF32 in2l = MulAdd(PromoteLowerTo(f32, in2), vScale, vDitherLow);
+            const VF32 in2h = MulAdd(PromoteUpperTo(f32, in2), vScale, vDitherHigh);
             const auto uout2l = DemoteTo(dhi16, ConvertTo(di32, in2l));
             const auto uout2h = DemoteTo(dhi16, ConvertTo(di32, in2h));
             out2 = Combine(d16, BitCast(dh16, uout2h), BitCast(dh16, uout2l));
 
-            const VF32 in3l = Mul(PromoteLowerTo(f32, in3), vScale);
-            const VF32 in3h = Mul(PromoteUpperTo(f32, in3), vScale);
+            const VF32 in3l = MulAdd(PromoteLowerTo(f32, in3), vScale, vDitherLow);
+            const VF32 in3h = MulAdd(PromoteUpperTo(f32, in3), vScale, vDitherHigh);
             const auto uout3l = DemoteTo(dhi16, ConvertTo(di32, in3l));
             const auto uout3h = DemoteTo(dhi16, ConvertTo(di32, in3h));
             out3 = Combine(d16, BitCast(dh16, uout3h), BitCast(dh16, uout3l));
@@ -321,28 +347,29 @@ ReformatSurfaceF16ToU(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcS
       uint16_t out0, out1, out2, out3;
 
       auto f16Source = reinterpret_cast<const hwy::float16_t*>(srcPixels);
+      const float threshold = useDither ? BayerThreshold(x, y) : 0.f;
 
       switch (Surface) {
         case SURFACE_CHANNEL: {
-          r = LoadFloat(&f16Source[0]) * scale;
+          r = LoadFloat(&f16Source[0]) * scale + threshold;
           out0 = static_cast<uint16_t>(r);
         }
           break;
         case SURFACE_CHANNELS_3: {
-          r = LoadFloat(&f16Source[0]) * scale;
+          r = LoadFloat(&f16Source[0]) * scale + threshold;
           out0 = static_cast<uint16_t>(r);
-          g = LoadFloat(&f16Source[1]) * scale;
+          g = LoadFloat(&f16Source[1]) * scale + threshold;
           out1 = static_cast<uint16_t>(g);
-          b = LoadFloat(&f16Source[2]) * scale;
+          b = LoadFloat(&f16Source[2]) * scale + threshold;
           out2 = static_cast<uint16_t>(b);
         }
           break;
         case SURFACE_CHANNELS_4: {
-          r = LoadFloat(&f16Source[0]) * scale;
+          r = LoadFloat(&f16Source[0]) * scale + threshold;
           out0 = static_cast<uint16_t>(r);
-          g = LoadFloat(&f16Source[1]) * scale;
+          g = LoadFloat(&f16Source[1]) * scale + threshold;
           out1 = static_cast<uint16_t>(g);
-          b = LoadFloat(&f16Source[2]) * scale;
+          b = LoadFloat(&f16Source[2]) * scale + threshold;
           out2 = static_cast<uint16_t>(b);
           a = LoadFloat(&f16Source[3]) * scale;
           out3 = static_cast<uint16_t>(a);
@@ -1326,10 +1353,11 @@ CHANNEL_XXX_REFORMAT16_TO_F16_DECLARATION(Channel16, uint16_t, CHANNEL)
 #define CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION(srcPixel, dstPixel, storageType, surfaceType) \
     void srcPixel##F16To##dstPixel##HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                        storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
-                                       const uint32_t width, const uint32_t height) {  \
+                                       const uint32_t width, const uint32_t height,\
+                                       const SparkYuvDither dither) {  \
         const int depth = sparkyuv::SURFACE_##surfaceType == sparkyuv::SURFACE_RGBA1010102 ? 10 : 8; \
         ReformatSurfaceF16ToU<storageType, sparkyuv::SURFACE_##surfaceType>(src, srcStride, dst, dstStride,\
-                                                                            width, height, depth); \
+                                                                            width, height, depth, dither); \
     }
 
 CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION(RGBA, RGBA, uint8_t, CHANNELS_4)
@@ -1344,7 +1372,7 @@ CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION(Channel, Channel, uint8_t, CHANNEL)
                                           storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                           const uint32_t width, const uint32_t height, const int depth) {\
         ReformatSurfaceF16ToU<storageType, sparkyuv::SURFACE_##surfaceType>(src, srcStride, dst, dstStride,\
-                                                                           width, height, depth); \
+                                                                           width, height, depth, DITHER_NONE); \
     }
 
 CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION(RGBA16, uint16_t, CHANNELS_4)
@@ -266,20 +266,32 @@ CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_HWY(Channel16, Channel16)
 #undef CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_HWY
 
 #define CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_E(srcPixel, dstPixel, storageType) \
+    void srcPixel##F16To##dstPixel(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                     storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                     const uint32_t width, const uint32_t height,\
+                                     const SparkYuvDither dither) {\
+        HWY_DYNAMIC_DISPATCH(srcPixel##F16To##dstPixel##HWY)(src, srcStride, dst, dstStride,\
+                                                               width, height, dither); \
+    }\
     void srcPixel##F16To##dstPixel(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                      storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                      const uint32_t width, const uint32_t height) {\
         HWY_DYNAMIC_DISPATCH(srcPixel##F16To##dstPixel##HWY)(src, srcStride, dst, dstStride,\
-                                                               width, height); \
+                                                               width, height, DITHER_NONE); \
     }
 
-CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_E(RGBA, RGBA1010102, uint8_t)
 CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_E(RGBA, RGBA, uint8_t)
 CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_E(RGB, RGB, uint8_t)
 CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_E(Channel, Channel, uint8_t)
 
 #undef CHANNEL_XXX_REFORMAT_F16_TO_U_DECLARATION_E
 
+void RGBAF16ToRGBA1010102(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                          uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                          const uint32_t width, const uint32_t height) {
+  HWY_DYNAMIC_DISPATCH(RGBAF16ToRGBA1010102HWY)(src, srcStride, dst, dstStride, width, height, DITHER_NONE);
+}
+
 #define CHANNEL_XXX_REFORMAT_F16_TO_U16_DECLARATION_E(pixelType, declareType, storageType) \
     void declareType##F16To##pixelType(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                        storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
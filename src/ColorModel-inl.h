@@ -0,0 +1,208 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_COLOR_MODEL_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_COLOR_MODEL_INL_H
+#undef SPARKYUV_COLOR_MODEL_INL_H
+#else
+#define SPARKYUV_COLOR_MODEL_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "sparkyuv-colormodel.h"
+#include "Gamut-inl.h"
+#include "math/fast_math-inl.h"
+#include <cmath>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+/**
+ * Oklab matrices by Björn Ottosson, CIE XYZ with D65 white to cone response and
+ * cube roots of cone response to Lab
+ */
+static constexpr GamutMatrix3 kOklabXyzToLms = {{
+                                                    {0.8189330101, 0.3618667424, -0.1288597137},
+                                                    {0.0329845436, 0.9293118715, 0.0361456387},
+                                                    {0.0482003018, 0.2643662691, 0.6338517070}
+                                                }};
+
+static constexpr float kOklabLmsToLab[3][3] = {{0.2104542553f, 0.7936177850f, -0.0040720468f},
+                                               {1.9779984951f, -2.4285922050f, 0.4505937099f},
+                                               {0.0259040371f, 0.7827717662f, -0.8086757660f}};
+
+static constexpr float kOklabLabToLms[3][3] = {{1.f, 0.3963377774f, 0.2158037573f},
+                                               {1.f, -0.1055613458f, -0.0638541728f},
+                                               {1.f, -0.0894841775f, -1.2914855480f}};
+
+/**
+ * CIE Lab companding is linear below (6/29)^3
+ */
+static constexpr float kLabEpsilon = 216.f / 24389.f;
+static constexpr float kLabDelta = 6.f / 29.f;
+static constexpr float kLabSlope = 24389.f / 3132.f;
+static constexpr float kLabOffset = 4.f / 29.f;
+
+/**
+ * Linear RGB matrix of the first stage: XYZ for COLOR_MODEL_XYZ, XYZ divided by reference white
+ * for COLOR_MODEL_LAB and cone response for COLOR_MODEL_OKLAB
+ */
+static GamutMatrix3 ComputeColorModelStage(const GamutPrimaries &primaries, const SparkYuvColorModel model) {
+  GamutMatrix3 m = ComputeRgbToXyz(primaries);
+  if (model == COLOR_MODEL_LAB) {
+    // Row sums are XYZ of reference white
+    for (int i = 0; i < 3; ++i) {
+      const double white = m.m[i][0] + m.m[i][1] + m.m[i][2];
+      for (int j = 0; j < 3; ++j) {
+        m.m[i][j] /= white;
+      }
+    }
+  } else if (model == COLOR_MODEL_OKLAB) {
+    m = MultiplyGamutMatrix(kOklabXyzToLms, m);
+  }
+  return m;
+}
+
+static SparkYuvTransformMatrix ComputeColorModelForwardMatrix(const GamutPrimaries &primaries,
+                                                              const SparkYuvColorModel model) {
+  return ToTransformMatrix(ComputeColorModelStage(primaries, model));
+}
+
+static SparkYuvTransformMatrix ComputeColorModelInverseMatrix(const GamutPrimaries &primaries,
+                                                              const SparkYuvColorModel model) {
+  return ToTransformMatrix(InvertGamutMatrix(ComputeColorModelStage(primaries, model)));
+}
+
+/**
+ * Cube root keeping the sign, cone responses of out of gamut colors may be negative
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_INLINE V SignedCubeRoot(D d, V x) {
+  return CopySign(CubeRootAndAdd(Abs(x), Zero(d)), x);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_INLINE V LabCompand(D d, V t) {
+  const V linear = MulAdd(t, Set(d, kLabSlope), Set(d, kLabOffset));
+  return IfThenElse(Gt(t, Set(d, kLabEpsilon)), CubeRootAndAdd(Max(t, Zero(d)), Zero(d)), linear);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_INLINE V LabExpand(D d, V f) {
+  const V linear = Mul(Sub(f, Set(d, kLabOffset)), Set(d, 1.f / kLabSlope));
+  return IfThenElse(Gt(f, Set(d, kLabDelta)), Mul(Mul(f, f), f), linear);
+}
+
+/**
+ * Finishes forward conversion, inputs are outputs of the forward matrix
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_INLINE void ColorModelForward(D d, V &c0, V &c1, V &c2, const SparkYuvColorModel model) {
+  if (model == COLOR_MODEL_LAB) {
+    const V fx = LabCompand(d, c0);
+    const V fy = LabCompand(d, c1);
+    const V fz = LabCompand(d, c2);
+    c0 = MulSub(fy, Set(d, 116.f), Set(d, 16.f));
+    c1 = Mul(Sub(fx, fy), Set(d, 500.f));
+    c2 = Mul(Sub(fy, fz), Set(d, 200.f));
+  } else if (model == COLOR_MODEL_OKLAB) {
+    const V l = SignedCubeRoot(d, c0);
+    const V m = SignedCubeRoot(d, c1);
+    const V s = SignedCubeRoot(d, c2);
+    const auto &k = kOklabLmsToLab;
+    c0 = MulAdd(Set(d, k[0][0]), l, MulAdd(Set(d, k[0][1]), m, Mul(Set(d, k[0][2]), s)));
+    c1 = MulAdd(Set(d, k[1][0]), l, MulAdd(Set(d, k[1][1]), m, Mul(Set(d, k[1][2]), s)));
+    c2 = MulAdd(Set(d, k[2][0]), l, MulAdd(Set(d, k[2][1]), m, Mul(Set(d, k[2][2]), s)));
+  }
+}
+
+/**
+ * Undoes the non-linear stage, outputs are ready for the inverse matrix
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_INLINE void ColorModelInverse(D d, V &c0, V &c1, V &c2, const SparkYuvColorModel model) {
+  if (model == COLOR_MODEL_LAB) {
+    const V fy = Mul(Add(c0, Set(d, 16.f)), Set(d, 1.f / 116.f));
+    const V fx = MulAdd(c1, Set(d, 1.f / 500.f), fy);
+    const V fz = NegMulAdd(c2, Set(d, 1.f / 200.f), fy);
+    c0 = LabExpand(d, fx);
+    c1 = LabExpand(d, fy);
+    c2 = LabExpand(d, fz);
+  } else if (model == COLOR_MODEL_OKLAB) {
+    const auto &k = kOklabLabToLms;
+    const V l = MulAdd(Set(d, k[0][1]), c1, MulAdd(Set(d, k[0][2]), c2, c0));
+    const V m = MulAdd(Set(d, k[1][1]), c1, MulAdd(Set(d, k[1][2]), c2, c0));
+    const V s = MulAdd(Set(d, k[2][1]), c1, MulAdd(Set(d, k[2][2]), c2, c0));
+    c0 = Mul(Mul(l, l), l);
+    c1 = Mul(Mul(m, m), m);
+    c2 = Mul(Mul(s, s), s);
+  }
+}
+
+SPARKYUV_INLINE static float LabCompand(const float t) {
+  return t > kLabEpsilon ? std::cbrt(t) : t * kLabSlope + kLabOffset;
+}
+
+SPARKYUV_INLINE static float LabExpand(const float f) {
+  return f > kLabDelta ? f * f * f : (f - kLabOffset) * (1.f / kLabSlope);
+}
+
+SPARKYUV_INLINE static void ColorModelForward(float &c0, float &c1, float &c2, const SparkYuvColorModel model) {
+  if (model == COLOR_MODEL_LAB) {
+    const float fx = LabCompand(c0);
+    const float fy = LabCompand(c1);
+    const float fz = LabCompand(c2);
+    c0 = fy * 116.f - 16.f;
+    c1 = (fx - fy) * 500.f;
+    c2 = (fy - fz) * 200.f;
+  } else if (model == COLOR_MODEL_OKLAB) {
+    const float l = std::cbrt(c0);
+    const float m = std::cbrt(c1);
+    const float s = std::cbrt(c2);
+    const auto &k = kOklabLmsToLab;
+    c0 = k[0][0] * l + k[0][1] * m + k[0][2] * s;
+    c1 = k[1][0] * l + k[1][1] * m + k[1][2] * s;
+    c2 = k[2][0] * l + k[2][1] * m + k[2][2] * s;
+  }
+}
+
+SPARKYUV_INLINE static void ColorModelInverse(float &c0, float &c1, float &c2, const SparkYuvColorModel model) {
+  if (model == COLOR_MODEL_LAB) {
+    const float fy = (c0 + 16.f) * (1.f / 116.f);
+    const float fx = fy + c1 * (1.f / 500.f);
+    const float fz = fy - c2 * (1.f / 200.f);
+    c0 = LabExpand(fx);
+    c1 = LabExpand(fy);
+    c2 = LabExpand(fz);
+  } else if (model == COLOR_MODEL_OKLAB) {
+    const auto &k = kOklabLabToLms;
+    const float l = c0 + k[0][1] * c1 + k[0][2] * c2;
+    const float m = c0 + k[1][1] * c1 + k[1][2] * c2;
+    const float s = c0 + k[2][1] * c1 + k[2][2] * c2;
+    c0 = l * l * l;
+    c1 = m * m * m;
+    c2 = s * s * s;
+  }
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
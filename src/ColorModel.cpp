@@ -0,0 +1,438 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/ColorModel.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Eotf-inl.h"
+#include "TransferLut-inl.h"
+#include "TransferSurface-inl.h"
+#include "Gamut-inl.h"
+#include "ColorModel-inl.h"
+#include "concurrency.hpp"
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE VF LoadColorModelPlane(DF df, const float *SPARKYUV_RESTRICT src) {
+  return LoadU(df, src);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE VF LoadColorModelPlane(DF df, const hwy::float16_t *SPARKYUV_RESTRICT src) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  return PromoteTo(df, BitCast(df16, LoadU(du16, reinterpret_cast<const uint16_t *>(src))));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreColorModelPlane(DF df, VF v, float *SPARKYUV_RESTRICT dst) {
+  StoreU(v, df, dst);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreColorModelPlane(DF df, VF v, hwy::float16_t *SPARKYUV_RESTRICT dst) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  StoreU(BitCast(du16, DemoteTo(df16, v)), du16, reinterpret_cast<uint16_t *>(dst));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadColorModel(DF df, const float *SPARKYUV_RESTRICT src, VF &c0, VF &c1, VF &c2, VF &a) {
+  LoadInterleaved4(df, src, c0, c1, c2, a);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadColorModel(DF df, const hwy::float16_t *SPARKYUV_RESTRICT src, VF &c0, VF &c1, VF &c2, VF &a) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  Vec<decltype(du16)> h0, h1, h2, h3;
+  LoadInterleaved4(du16, reinterpret_cast<const uint16_t *>(src), h0, h1, h2, h3);
+  c0 = PromoteTo(df, BitCast(df16, h0));
+  c1 = PromoteTo(df, BitCast(df16, h1));
+  c2 = PromoteTo(df, BitCast(df16, h2));
+  a = PromoteTo(df, BitCast(df16, h3));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreColorModel(DF df, VF c0, VF c1, VF c2, VF a, float *SPARKYUV_RESTRICT dst) {
+  StoreInterleaved4(c0, c1, c2, a, df, dst);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreColorModel(DF df, VF c0, VF c1, VF c2, VF a, hwy::float16_t *SPARKYUV_RESTRICT dst) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  StoreInterleaved4(BitCast(du16, DemoteTo(df16, c0)), BitCast(du16, DemoteTo(df16, c1)),
+                    BitCast(du16, DemoteTo(df16, c2)), BitCast(du16, DemoteTo(df16, a)),
+                    du16, reinterpret_cast<uint16_t *>(dst));
+}
+
+template<typename L>
+SPARKYUV_INLINE static L *ColorModelRow(L *plane, const uint32_t stride, const uint32_t y) {
+  return reinterpret_cast<L *>(reinterpret_cast<uint8_t *>(plane) + static_cast<size_t>(y) * stride);
+}
+
+template<typename L>
+SPARKYUV_INLINE static const L *ColorModelRow(const L *plane, const uint32_t stride, const uint32_t y) {
+  return reinterpret_cast<const L *>(reinterpret_cast<const uint8_t *>(plane) + static_cast<size_t>(y) * stride);
+}
+
+/**
+ * Interleaved destinations use only `c0`, planar destinations have a plane for each component
+ */
+template<TransferSurface Surface, typename L, bool Planar>
+void ColorModelForwardHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                          L *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,
+                          L *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,
+                          L *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,
+                          const uint32_t width, const int bitDepth,
+                          const SparkYuvColorModel model, const SparkYuvTransformMatrix matrix,
+                          const SparkYuvTransferFunction transferFunction, const SparkYuvTransferAccuracy accuracy,
+                          const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+
+  const int maxColors = (1 << bitDepth) - 1;
+  const float scale = 1.f / static_cast<float>(maxColors);
+  const TransferLut *lut = GetTransferLutFor(accuracy, transferFunction,
+                                             Surface == TRANSFER_SURFACE_RGBAF16 ? 8 : bitDepth);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    L *d0 = ColorModelRow(c0, c0Stride, y);
+    L *d1 = Planar ? ColorModelRow(c1, c1Stride, y) : nullptr;
+    L *d2 = Planar ? ColorModelRow(c2, c2Stride, y) : nullptr;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+      r = LinearizeVector<Surface>(df, r, transferFunction, accuracy, lut);
+      g = LinearizeVector<Surface>(df, g, transferFunction, accuracy, lut);
+      b = LinearizeVector<Surface>(df, b, transferFunction, accuracy, lut);
+      ApplyGamutMatrix(df, r, g, b, matrix);
+      ColorModelForward(df, r, g, b, model);
+      if (Planar) {
+        StoreColorModelPlane(df, r, d0 + x);
+        StoreColorModelPlane(df, g, d1 + x);
+        StoreColorModelPlane(df, b, d2 + x);
+      } else {
+        StoreColorModel(df, r, g, b, a, d0 + x * 4);
+      }
+      mSrc += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      r = LinearizeValue<Surface>(r, transferFunction, accuracy, lut);
+      g = LinearizeValue<Surface>(g, transferFunction, accuracy, lut);
+      b = LinearizeValue<Surface>(b, transferFunction, accuracy, lut);
+      ApplyGamutMatrix(r, g, b, matrix);
+      ColorModelForward(r, g, b, model);
+      if (Planar) {
+        StoreFloat(d0 + x, r);
+        StoreFloat(d1 + x, g);
+        StoreFloat(d2 + x, b);
+      } else {
+        StoreFloat(d0 + x * 4, r);
+        StoreFloat(d0 + x * 4 + 1, g);
+        StoreFloat(d0 + x * 4 + 2, b);
+        StoreFloat(d0 + x * 4 + 3, a);
+      }
+      mSrc += pixelSize;
+    }
+  }
+}
+
+/**
+ * Interleaved sources use only `c0`, alpha of planar sources is opaque
+ */
+template<TransferSurface Surface, typename L, bool Planar>
+void ColorModelInverseHWY(const L *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,
+                          const L *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,
+                          const L *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,
+                          uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                          const uint32_t width, const int bitDepth,
+                          const SparkYuvColorModel model, const SparkYuvTransformMatrix matrix,
+                          const SparkYuvTransferFunction transferFunction, const SparkYuvTransferAccuracy accuracy,
+                          const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+
+  const int maxColors = (1 << bitDepth) - 1;
+  const TransferLut *lut = GetTransferLutFor(accuracy, transferFunction,
+                                             Surface == TRANSFER_SURFACE_RGBAF16 ? 8 : bitDepth);
+  const VF zeros = Zero(df);
+  const VF ones = Set(df, 1.f);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    const L *s0 = ColorModelRow(c0, c0Stride, y);
+    const L *s1 = Planar ? ColorModelRow(c1, c1Stride, y) : nullptr;
+    const L *s2 = Planar ? ColorModelRow(c2, c2Stride, y) : nullptr;
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      if (Planar) {
+        r = LoadColorModelPlane(df, s0 + x);
+        g = LoadColorModelPlane(df, s1 + x);
+        b = LoadColorModelPlane(df, s2 + x);
+        a = ones;
+      } else {
+        LoadColorModel(df, s0 + x * 4, r, g, b, a);
+      }
+      ColorModelInverse(df, r, g, b, model);
+      ApplyGamutMatrix(df, r, g, b, matrix);
+      r = ApplyOetf(df, Max(r, zeros), transferFunction, accuracy, lut);
+      g = ApplyOetf(df, Max(g, zeros), transferFunction, accuracy, lut);
+      b = ApplyOetf(df, Max(b, zeros), transferFunction, accuracy, lut);
+      StoreTransferSurface<Surface>(df, mDst, r, g, b, a, maxColors);
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a;
+      if (Planar) {
+        r = LoadFloat(s0 + x);
+        g = LoadFloat(s1 + x);
+        b = LoadFloat(s2 + x);
+        a = 1.f;
+      } else {
+        r = LoadFloat(s0 + x * 4);
+        g = LoadFloat(s0 + x * 4 + 1);
+        b = LoadFloat(s0 + x * 4 + 2);
+        a = LoadFloat(s0 + x * 4 + 3);
+      }
+      ColorModelInverse(r, g, b, model);
+      ApplyGamutMatrix(r, g, b, matrix);
+      r = ApplyOetf(std::max(r, 0.f), transferFunction, accuracy, lut);
+      g = ApplyOetf(std::max(g, 0.f), transferFunction, accuracy, lut);
+      b = ApplyOetf(std::max(b, 0.f), transferFunction, accuracy, lut);
+      StoreTransferPixel<Surface>(mDst, r, g, b, a, maxColors);
+      mDst += pixelSize;
+    }
+  }
+}
+
+#define COLOR_MODEL_FORWARD_DECLARATION_R(srcName, surface, srcType, dstName, dstType, linearType, planar) \
+void srcName##ToColorModel##dstName##HWY(const srcType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                         dstType *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,\
+                                         dstType *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,\
+                                         dstType *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,\
+                                         const uint32_t width, const int bitDepth,\
+                                         const SparkYuvColorModel model, const SparkYuvTransformMatrix matrix,\
+                                         const SparkYuvTransferFunction transferFunction,\
+                                         const SparkYuvTransferAccuracy accuracy,\
+                                         const uint32_t startRow, const uint32_t endRow) {\
+  ColorModelForwardHWY<surface, linearType, planar>(reinterpret_cast<const uint8_t *>(src), srcStride,\
+                                                    reinterpret_cast<linearType *>(c0), c0Stride,\
+                                                    reinterpret_cast<linearType *>(c1), c1Stride,\
+                                                    reinterpret_cast<linearType *>(c2), c2Stride,\
+                                                    width, bitDepth, model, matrix, transferFunction, accuracy,\
+                                                    startRow, endRow);\
+}
+
+#define COLOR_MODEL_INVERSE_DECLARATION_R(srcName, srcType, linearType, planar, dstName, surface, dstType) \
+void ColorModel##srcName##To##dstName##HWY(const srcType *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,\
+                                           const srcType *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,\
+                                           const srcType *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,\
+                                           dstType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                           const uint32_t width, const int bitDepth,\
+                                           const SparkYuvColorModel model, const SparkYuvTransformMatrix matrix,\
+                                           const SparkYuvTransferFunction transferFunction,\
+                                           const SparkYuvTransferAccuracy accuracy,\
+                                           const uint32_t startRow, const uint32_t endRow) {\
+  ColorModelInverseHWY<surface, linearType, planar>(reinterpret_cast<const linearType *>(c0), c0Stride,\
+                                                    reinterpret_cast<const linearType *>(c1), c1Stride,\
+                                                    reinterpret_cast<const linearType *>(c2), c2Stride,\
+                                                    reinterpret_cast<uint8_t *>(dst), dstStride,\
+                                                    width, bitDepth, model, matrix, transferFunction, accuracy,\
+                                                    startRow, endRow);\
+}
+
+#define COLOR_MODEL_DECLARATION_R(name, surface, storageType) \
+        COLOR_MODEL_FORWARD_DECLARATION_R(name, surface, storageType, F32, float, float, false) \
+        COLOR_MODEL_FORWARD_DECLARATION_R(name, surface, storageType, F16, uint16_t, hwy::float16_t, false) \
+        COLOR_MODEL_FORWARD_DECLARATION_R(name, surface, storageType, PlanarF32, float, float, true) \
+        COLOR_MODEL_FORWARD_DECLARATION_R(name, surface, storageType, PlanarF16, uint16_t, hwy::float16_t, true) \
+        COLOR_MODEL_INVERSE_DECLARATION_R(F32, float, float, false, name, surface, storageType) \
+        COLOR_MODEL_INVERSE_DECLARATION_R(F16, uint16_t, hwy::float16_t, false, name, surface, storageType) \
+        COLOR_MODEL_INVERSE_DECLARATION_R(PlanarF32, float, float, true, name, surface, storageType) \
+        COLOR_MODEL_INVERSE_DECLARATION_R(PlanarF16, uint16_t, hwy::float16_t, true, name, surface, storageType)
+
+COLOR_MODEL_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t)
+COLOR_MODEL_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t)
+COLOR_MODEL_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+
+#undef COLOR_MODEL_DECLARATION_R
+#undef COLOR_MODEL_INVERSE_DECLARATION_R
+#undef COLOR_MODEL_FORWARD_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+#define COLOR_MODEL_DECLARATION_HWY(name) \
+        HWY_EXPORT(name##ToColorModelF32HWY); \
+        HWY_EXPORT(name##ToColorModelF16HWY); \
+        HWY_EXPORT(name##ToColorModelPlanarF32HWY); \
+        HWY_EXPORT(name##ToColorModelPlanarF16HWY); \
+        HWY_EXPORT(ColorModelF32To##name##HWY); \
+        HWY_EXPORT(ColorModelF16To##name##HWY); \
+        HWY_EXPORT(ColorModelPlanarF32To##name##HWY); \
+        HWY_EXPORT(ColorModelPlanarF16To##name##HWY);
+
+COLOR_MODEL_DECLARATION_HWY(RGBA)
+COLOR_MODEL_DECLARATION_HWY(RGBA16)
+COLOR_MODEL_DECLARATION_HWY(RGBAF16)
+
+#undef COLOR_MODEL_DECLARATION_HWY
+
+static void ValidateColorModel(const SparkYuvColorModel model, const SparkYuvTransferAccuracy accuracy,
+                               const int depth) {
+  if (model != COLOR_MODEL_XYZ && model != COLOR_MODEL_LAB && model != COLOR_MODEL_OKLAB) {
+    throw std::runtime_error("Unsupported color model");
+  }
+  if (accuracy != TRANSFER_ACCURACY_EXACT && accuracy != TRANSFER_ACCURACY_FAST && accuracy != TRANSFER_ACCURACY_LUT) {
+    throw std::runtime_error("Unsupported transfer accuracy");
+  }
+  if (depth < 1 || depth > 16) {
+    throw std::runtime_error("Bit depth must be in range [1, 16]");
+  }
+}
+
+/**
+ * Variadic arguments carry extra public parameters with trailing comma, RGBA16 passes its bit-depth this way
+ */
+#define COLOR_MODEL_FORWARD_DECLARATION_E(srcName, srcType, dstName, dstType, depth, ...) \
+    void srcName##ToColorModel##dstName(const srcType *src, const uint32_t srcStride,\
+                                        dstType *dst, const uint32_t dstStride,\
+                                        const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                        const SparkYuvColorModel model, const SparkYuvPrimaries primaries,\
+                                        const SparkYuvTransferFunction transferFunction,\
+                                        const SparkYuvTransferAccuracy accuracy) {\
+      ValidateColorModel(model, accuracy, depth);\
+      const SparkYuvTransformMatrix matrix =\
+          HWY_NAMESPACE::ComputeColorModelForwardMatrix(HWY_NAMESPACE::GetGamutPrimaries(primaries), model);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(srcName##ToColorModel##dstName##HWY)(src, srcStride, dst, dstStride,\
+                                                                  nullptr, 0, nullptr, 0, width, depth,\
+                                                                  model, matrix, transferFunction, accuracy,\
+                                                                  start, end);\
+      });\
+    }
+
+#define COLOR_MODEL_FORWARD_PLANAR_DECLARATION_E(srcName, srcType, dstName, dstType, depth, ...) \
+    void srcName##ToColorModel##dstName(const srcType *src, const uint32_t srcStride,\
+                                        dstType *c0, const uint32_t c0Stride, dstType *c1, const uint32_t c1Stride,\
+                                        dstType *c2, const uint32_t c2Stride,\
+                                        const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                        const SparkYuvColorModel model, const SparkYuvPrimaries primaries,\
+                                        const SparkYuvTransferFunction transferFunction,\
+                                        const SparkYuvTransferAccuracy accuracy) {\
+      ValidateColorModel(model, accuracy, depth);\
+      const SparkYuvTransformMatrix matrix =\
+          HWY_NAMESPACE::ComputeColorModelForwardMatrix(HWY_NAMESPACE::GetGamutPrimaries(primaries), model);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(srcName##ToColorModel##dstName##HWY)(src, srcStride, c0, c0Stride,\
+                                                                  c1, c1Stride, c2, c2Stride, width, depth,\
+                                                                  model, matrix, transferFunction, accuracy,\
+                                                                  start, end);\
+      });\
+    }
+
+#define COLOR_MODEL_INVERSE_DECLARATION_E(srcName, srcType, dstName, dstType, depth, ...) \
+    void ColorModel##srcName##To##dstName(const srcType *src, const uint32_t srcStride,\
+                                          dstType *dst, const uint32_t dstStride,\
+                                          const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                          const SparkYuvColorModel model, const SparkYuvPrimaries primaries,\
+                                          const SparkYuvTransferFunction transferFunction,\
+                                          const SparkYuvTransferAccuracy accuracy) {\
+      ValidateColorModel(model, accuracy, depth);\
+      const SparkYuvTransformMatrix matrix =\
+          HWY_NAMESPACE::ComputeColorModelInverseMatrix(HWY_NAMESPACE::GetGamutPrimaries(primaries), model);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(ColorModel##srcName##To##dstName##HWY)(src, srcStride, nullptr, 0, nullptr, 0,\
+                                                                    dst, dstStride, width, depth,\
+                                                                    model, matrix, transferFunction, accuracy,\
+                                                                    start, end);\
+      });\
+    }
+
+#define COLOR_MODEL_INVERSE_PLANAR_DECLARATION_E(srcName, srcType, dstName, dstType, depth, ...) \
+    void ColorModel##srcName##To##dstName(const srcType *c0, const uint32_t c0Stride,\
+                                          const srcType *c1, const uint32_t c1Stride,\
+                                          const srcType *c2, const uint32_t c2Stride,\
+                                          dstType *dst, const uint32_t dstStride,\
+                                          const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                          const SparkYuvColorModel model, const SparkYuvPrimaries primaries,\
+                                          const SparkYuvTransferFunction transferFunction,\
+                                          const SparkYuvTransferAccuracy accuracy) {\
+      ValidateColorModel(model, accuracy, depth);\
+      const SparkYuvTransformMatrix matrix =\
+          HWY_NAMESPACE::ComputeColorModelInverseMatrix(HWY_NAMESPACE::GetGamutPrimaries(primaries), model);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(ColorModel##srcName##To##dstName##HWY)(c0, c0Stride, c1, c1Stride, c2, c2Stride,\
+                                                                    dst, dstStride, width, depth,\
+                                                                    model, matrix, transferFunction, accuracy,\
+                                                                    start, end);\
+      });\
+    }
+
+#define COLOR_MODEL_DECLARATION_E(name, storageType, depth, ...) \
+        COLOR_MODEL_FORWARD_DECLARATION_E(name, storageType, F32, float, depth, __VA_ARGS__) \
+        COLOR_MODEL_FORWARD_DECLARATION_E(name, storageType, F16, uint16_t, depth, __VA_ARGS__) \
+        COLOR_MODEL_FORWARD_PLANAR_DECLARATION_E(name, storageType, PlanarF32, float, depth, __VA_ARGS__) \
+        COLOR_MODEL_FORWARD_PLANAR_DECLARATION_E(name, storageType, PlanarF16, uint16_t, depth, __VA_ARGS__) \
+        COLOR_MODEL_INVERSE_DECLARATION_E(F32, float, name, storageType, depth, __VA_ARGS__) \
+        COLOR_MODEL_INVERSE_DECLARATION_E(F16, uint16_t, name, storageType, depth, __VA_ARGS__) \
+        COLOR_MODEL_INVERSE_PLANAR_DECLARATION_E(PlanarF32, float, name, storageType, depth, __VA_ARGS__) \
+        COLOR_MODEL_INVERSE_PLANAR_DECLARATION_E(PlanarF16, uint16_t, name, storageType, depth, __VA_ARGS__)
+
+COLOR_MODEL_DECLARATION_E(RGBA, uint8_t, 8)
+COLOR_MODEL_DECLARATION_E(RGBA16, uint16_t, depth, const int depth,)
+COLOR_MODEL_DECLARATION_E(RGBAF16, uint16_t, 16)
+
+#undef COLOR_MODEL_DECLARATION_E
+#undef COLOR_MODEL_INVERSE_PLANAR_DECLARATION_E
+#undef COLOR_MODEL_INVERSE_DECLARATION_E
+#undef COLOR_MODEL_FORWARD_PLANAR_DECLARATION_E
+#undef COLOR_MODEL_FORWARD_DECLARATION_E
+
+}
+#endif
@@ -0,0 +1,396 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/ContentLight.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Eotf-inl.h"
+#include "TransferLut-inl.h"
+#include "TransferSurface-inl.h"
+#include "math/fast_math-inl.h"
+#include "concurrency.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+/**
+ * Histogram covers PQ range [0.0001, 10000] nits, bins are uniform in log2 of luminance
+ */
+static constexpr float kContentLightHistogramMinNits = 0.0001f;
+static constexpr float kContentLightHistogramMaxNits = 10000.f;
+
+struct ContentLightParams {
+  float nitsScale;
+  float kr, kg, kb;
+  float log2Min;
+  float binScale;
+  int32_t maxBin;
+  uint32_t *histogram;
+};
+
+static ContentLightParams MakeContentLightParams(const float nitsScale, const float kr, const float kb,
+                                                 uint32_t *histogram, const uint32_t histogramBins) {
+  ContentLightParams p{};
+  p.nitsScale = nitsScale;
+  p.kr = kr;
+  p.kb = kb;
+  p.kg = 1.f - kr - kb;
+  p.log2Min = std::log2(kContentLightHistogramMinNits);
+  const float log2Max = std::log2(kContentLightHistogramMaxNits);
+  p.binScale = histogramBins > 0 ? static_cast<float>(histogramBins) / (log2Max - p.log2Min) : 0.f;
+  p.maxBin = static_cast<int32_t>(histogramBins) - 1;
+  p.histogram = histogramBins > 0 ? histogram : nullptr;
+  return p;
+}
+
+/**
+ * Max of RGB feeds MaxCLL and frame average, luminance feeds histogram.
+ * Bin indices are computed in vectors, only the increments are scalar.
+ */
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void AccumulateContentLight(DF df, VF r, VF g, VF b, const ContentLightParams &p, VF &vMax, VF &vSum) {
+  const VF vScale = Set(df, p.nitsScale);
+  const VF light = Mul(ZeroIfNegative(Max(r, Max(g, b))), vScale);
+  vMax = Max(vMax, light);
+  vSum = Add(vSum, light);
+  if (p.histogram != nullptr) {
+    const RebindToSigned<decltype(df)> di32;
+    const VF luminance = Mul(MulAdd(Set(df, p.kr), r, MulAdd(Set(df, p.kg), g, Mul(Set(df, p.kb), b))), vScale);
+    const VF logLuminance = FastLog2f(df, Max(luminance, Set(df, kContentLightHistogramMinNits)));
+    const VF position = Mul(Sub(logLuminance, Set(df, p.log2Min)), Set(df, p.binScale));
+    const auto bins = Min(ConvertTo(di32, ZeroIfNegative(position)), Set(di32, p.maxBin));
+    HWY_ALIGN int32_t indices[HWY_MAX_BYTES / sizeof(int32_t)];
+    Store(bins, di32, indices);
+    for (size_t i = 0; i < Lanes(di32); ++i) {
+      p.histogram[indices[i]] += 1;
+    }
+  }
+}
+
+SPARKYUV_INLINE static void AccumulateContentLight(const float r, const float g, const float b,
+                                                   const ContentLightParams &p, float &maxLight, double &sumLight) {
+  const float light = std::max(std::max(r, std::max(g, b)), 0.f) * p.nitsScale;
+  maxLight = std::max(maxLight, light);
+  sumLight += light;
+  if (p.histogram != nullptr) {
+    const float luminance = (p.kr * r + p.kg * g + p.kb * b) * p.nitsScale;
+    const float position = (std::log2(std::max(luminance, kContentLightHistogramMinNits)) - p.log2Min) * p.binScale;
+    const int32_t bin = std::min(static_cast<int32_t>(std::max(position, 0.f)), p.maxBin);
+    p.histogram[bin] += 1;
+  }
+}
+
+template<TransferSurface Surface>
+void ContentLightSurfaceHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                            const uint32_t width, const int bitDepth,
+                            const SparkYuvTransferFunction transferFunction, const SparkYuvTransferAccuracy accuracy,
+                            const float nitsScale, const float kr, const float kb,
+                            const uint32_t startRow, const uint32_t endRow,
+                            float *maxLight, double *sumLight, uint32_t *histogram, const uint32_t histogramBins) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const float scale = 1.f / static_cast<float>((1 << bitDepth) - 1);
+  const TransferLut *lut = GetTransferLutFor(accuracy, transferFunction,
+                                             Surface == TRANSFER_SURFACE_RGBAF16 ? 8 : bitDepth);
+  const ContentLightParams p = MakeContentLightParams(nitsScale, kr, kb, histogram, histogramBins);
+
+  VF vMax = Zero(df);
+  float maximum = 0.f;
+  double sum = 0.0;
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    // Row sums stay in float lanes, frame sum is kept in double
+    VF vSum = Zero(df);
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+      r = LinearizeVector<Surface>(df, r, transferFunction, accuracy, lut);
+      g = LinearizeVector<Surface>(df, g, transferFunction, accuracy, lut);
+      b = LinearizeVector<Surface>(df, b, transferFunction, accuracy, lut);
+      AccumulateContentLight(df, r, g, b, p, vMax, vSum);
+      mSrc += lanes * pixelSize;
+    }
+
+    sum += static_cast<double>(GetLane(SumOfLanes(df, vSum)));
+
+    for (; x < width; ++x) {
+      float r, g, b, a;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      r = LinearizeValue<Surface>(r, transferFunction, accuracy, lut);
+      g = LinearizeValue<Surface>(g, transferFunction, accuracy, lut);
+      b = LinearizeValue<Surface>(b, transferFunction, accuracy, lut);
+      AccumulateContentLight(r, g, b, p, maximum, sum);
+      mSrc += pixelSize;
+    }
+  }
+
+  *maxLight = std::max(maximum, GetLane(MaxOfLanes(df, vMax)));
+  *sumLight = sum;
+}
+
+/**
+ * Chroma is upsampled by nearest neighbour into one row per chroma line, only the luma plane is read per row
+ */
+void ContentLightYCbCr420P16HWY(const uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                const uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                const uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                const uint32_t width, const int bitDepth,
+                                const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                const SparkYuvTransferFunction transferFunction,
+                                const SparkYuvTransferAccuracy accuracy, const float nitsScale,
+                                const uint32_t startRow, const uint32_t endRow,
+                                float *maxLight, double *sumLight, uint32_t *histogram, const uint32_t histogramBins) {
+  const ScalableTag<float> df;
+  const Rebind<uint16_t, decltype(df)> du16;
+  const RebindToSigned<decltype(df)> di32;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const TransferLut *lut = GetTransferLutFor(accuracy, transferFunction, bitDepth);
+  const ContentLightParams p = MakeContentLightParams(nitsScale, kr, kb, histogram, histogramBins);
+
+  uint16_t biasY, biasUV, rangeY, rangeUV;
+  GetYUVRange(colorRange, bitDepth, biasY, biasUV, rangeY, rangeUV);
+  const float kg = 1.f - kr - kb;
+  const float scaleY = 1.f / static_cast<float>(rangeY);
+  const float scaleUV = 1.f / static_cast<float>(rangeUV);
+  const float crR = 2.f * (1.f - kr) * scaleUV;
+  const float cbB = 2.f * (1.f - kb) * scaleUV;
+  const float crG = 2.f * kr * (1.f - kr) / kg * scaleUV;
+  const float cbG = 2.f * kb * (1.f - kb) / kg * scaleUV;
+  const VF zeros = Zero(df);
+  const VF ones = Set(df, 1.f);
+  const VF vBiasY = Set(df, static_cast<float>(biasY));
+  const VF vBiasUV = Set(df, static_cast<float>(biasUV));
+
+  std::vector<uint16_t> cbRow(width + 1);
+  std::vector<uint16_t> crRow(width + 1);
+
+  VF vMax = zeros;
+  float maximum = 0.f;
+  double sum = 0.0;
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    if (y == startRow || (y & 1) == 0) {
+      const size_t chromaOffset = static_cast<size_t>(y / 2);
+      UpsampleChromaRow2x(reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(uPlane)
+                              + chromaOffset * uStride), cbRow.data(), width);
+      UpsampleChromaRow2x(reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(vPlane)
+                              + chromaOffset * vStride), crRow.data(), width);
+    }
+    auto ySrc = reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(yPlane)
+        + static_cast<size_t>(y) * yStride);
+    VF vSum = zeros;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      const VF Y = Mul(Sub(ConvertTo(df, PromoteTo(di32, LoadU(du16, ySrc + x))), vBiasY), Set(df, scaleY));
+      const VF Cb = Sub(ConvertTo(df, PromoteTo(di32, LoadU(du16, cbRow.data() + x))), vBiasUV);
+      const VF Cr = Sub(ConvertTo(df, PromoteTo(di32, LoadU(du16, crRow.data() + x))), vBiasUV);
+      VF r = Clamp(MulAdd(Set(df, crR), Cr, Y), zeros, ones);
+      VF g = Clamp(NegMulAdd(Set(df, crG), Cr, NegMulAdd(Set(df, cbG), Cb, Y)), zeros, ones);
+      VF b = Clamp(MulAdd(Set(df, cbB), Cb, Y), zeros, ones);
+      r = ApplyEotf(df, r, transferFunction, accuracy, lut);
+      g = ApplyEotf(df, g, transferFunction, accuracy, lut);
+      b = ApplyEotf(df, b, transferFunction, accuracy, lut);
+      AccumulateContentLight(df, r, g, b, p, vMax, vSum);
+    }
+
+    sum += static_cast<double>(GetLane(SumOfLanes(df, vSum)));
+
+    for (; x < width; ++x) {
+      const float Y = (static_cast<float>(ySrc[x]) - static_cast<float>(biasY)) * scaleY;
+      const float Cb = static_cast<float>(cbRow[x]) - static_cast<float>(biasUV);
+      const float Cr = static_cast<float>(crRow[x]) - static_cast<float>(biasUV);
+      const float r = ApplyEotf(std::clamp(Y + crR * Cr, 0.f, 1.f), transferFunction, accuracy, lut);
+      const float g = ApplyEotf(std::clamp(Y - crG * Cr - cbG * Cb, 0.f, 1.f), transferFunction, accuracy, lut);
+      const float b = ApplyEotf(std::clamp(Y + cbB * Cb, 0.f, 1.f), transferFunction, accuracy, lut);
+      AccumulateContentLight(r, g, b, p, maximum, sum);
+    }
+  }
+
+  *maxLight = std::max(maximum, GetLane(MaxOfLanes(df, vMax)));
+  *sumLight = sum;
+}
+
+#define CONTENT_LIGHT_DECLARATION_R(name, surface, storageType) \
+void ContentLight##name##HWY(const storageType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                             const uint32_t width, const int bitDepth,\
+                             const SparkYuvTransferFunction transferFunction,\
+                             const SparkYuvTransferAccuracy accuracy,\
+                             const float nitsScale, const float kr, const float kb,\
+                             const uint32_t startRow, const uint32_t endRow,\
+                             float *maxLight, double *sumLight, uint32_t *histogram,\
+                             const uint32_t histogramBins) {\
+  ContentLightSurfaceHWY<surface>(reinterpret_cast<const uint8_t *>(src), srcStride, width, bitDepth,\
+                                  transferFunction, accuracy, nitsScale, kr, kb, startRow, endRow,\
+                                  maxLight, sumLight, histogram, histogramBins);\
+}
+
+CONTENT_LIGHT_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t)
+CONTENT_LIGHT_DECLARATION_R(RGBA1010102, TRANSFER_SURFACE_RGBA1010102, uint8_t)
+CONTENT_LIGHT_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+
+#undef CONTENT_LIGHT_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+HWY_EXPORT(ContentLightRGBA16HWY);
+HWY_EXPORT(ContentLightRGBA1010102HWY);
+HWY_EXPORT(ContentLightRGBAF16HWY);
+HWY_EXPORT(ContentLightYCbCr420P16HWY);
+
+/**
+ * Linear light of the library is relative to 203 nits reference white, HLG scene light is scaled to its nominal peak
+ */
+static float ContentLightNitsScale(const SparkYuvTransferFunction transferFunction, const float hlgPeakNits) {
+  switch (transferFunction) {
+    case TransferPQ:
+    case TransferLinear:return 203.f;
+    case TransferHLG:return hlgPeakNits;
+    default:throw std::runtime_error("Content light supports only PQ, HLG and linear transfer functions");
+  }
+}
+
+static void ValidateContentLight(const SparkYuvTransferAccuracy accuracy, const int depth,
+                                 const uint32_t *histogram, const uint32_t histogramBins, const float hlgPeakNits) {
+  if (accuracy != TRANSFER_ACCURACY_EXACT && accuracy != TRANSFER_ACCURACY_FAST && accuracy != TRANSFER_ACCURACY_LUT) {
+    throw std::runtime_error("Unsupported transfer accuracy");
+  }
+  if (depth < 1 || depth > 16) {
+    throw std::runtime_error("Bit depth must be in range [1, 16]");
+  }
+  if (histogram == nullptr && histogramBins != 0) {
+    throw std::runtime_error("Histogram must be provided when histogram bins are requested");
+  }
+  if (!(hlgPeakNits > 0.f)) {
+    throw std::runtime_error("HLG peak must be positive");
+  }
+}
+
+/**
+ * Each segment reduces into its own state, segments are merged under the lock once
+ */
+struct ContentLightReduction {
+  std::mutex lock;
+  float maxLight = 0.f;
+  double sumLight = 0.0;
+  uint32_t *histogram;
+  uint32_t histogramBins;
+
+  template<typename Function>
+  void Run(const uint32_t start, const uint32_t end, Function &&reduce) {
+    std::vector<uint32_t> localHistogram(histogramBins);
+    float localMax = 0.f;
+    double localSum = 0.0;
+    reduce(start, end, &localMax, &localSum, histogramBins > 0 ? localHistogram.data() : nullptr);
+    std::lock_guard<std::mutex> guard(lock);
+    maxLight = std::max(maxLight, localMax);
+    sumLight += localSum;
+    for (uint32_t i = 0; i < histogramBins; ++i) {
+      histogram[i] += localHistogram[i];
+    }
+  }
+
+  SparkYuvContentLight Result(const uint32_t width, const uint32_t height) const {
+    const double pixels = static_cast<double>(width) * static_cast<double>(height);
+    return SparkYuvContentLight{.maxLight = maxLight,
+        .averageLight = pixels > 0 ? static_cast<float>(sumLight / pixels) : 0.f};
+  }
+};
+
+/**
+ * Variadic arguments carry extra public parameters with trailing comma, RGBA16 passes its bit-depth this way
+ */
+#define CONTENT_LIGHT_DECLARATION_E(name, storageType, depth, ...) \
+    SparkYuvContentLight ComputeContentLight##name(const storageType *src, const uint32_t srcStride,\
+                                                   const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                                   const float kr, const float kb,\
+                                                   const SparkYuvTransferFunction transferFunction,\
+                                                   const SparkYuvTransferAccuracy accuracy, const float hlgPeakNits,\
+                                                   uint32_t *histogram, const uint32_t histogramBins) {\
+      ValidateContentLight(accuracy, depth, histogram, histogramBins, hlgPeakNits);\
+      const float nitsScale = ContentLightNitsScale(transferFunction, hlgPeakNits);\
+      if (histogramBins > 0) {\
+        std::fill(histogram, histogram + histogramBins, 0u);\
+      }\
+      ContentLightReduction reduction{.histogram = histogram, .histogramBins = histogramBins};\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        reduction.Run(start, end, [&](uint32_t s, uint32_t e, float *maxLight, double *sumLight, uint32_t *bins) {\
+          HWY_DYNAMIC_DISPATCH(ContentLight##name##HWY)(src, srcStride, width, depth, transferFunction, accuracy,\
+                                                        nitsScale, kr, kb, s, e, maxLight, sumLight,\
+                                                        bins, histogramBins);\
+        });\
+      });\
+      return reduction.Result(width, height);\
+    }
+
+CONTENT_LIGHT_DECLARATION_E(RGBA16, uint16_t, depth, const int depth,)
+CONTENT_LIGHT_DECLARATION_E(RGBA1010102, uint8_t, 10)
+CONTENT_LIGHT_DECLARATION_E(RGBAF16, uint16_t, 16)
+
+#undef CONTENT_LIGHT_DECLARATION_E
+
+SparkYuvContentLight ComputeContentLightYCbCr420P16(const uint16_t *yPlane, const uint32_t yStride,
+                                                    const uint16_t *uPlane, const uint32_t uStride,
+                                                    const uint16_t *vPlane, const uint32_t vStride,
+                                                    const uint32_t width, const uint32_t height, const int depth,
+                                                    const float kr, const float kb,
+                                                    const SparkYuvColorRange colorRange,
+                                                    const SparkYuvTransferFunction transferFunction,
+                                                    const SparkYuvTransferAccuracy accuracy, const float hlgPeakNits,
+                                                    uint32_t *histogram, const uint32_t histogramBins) {
+  ValidateContentLight(accuracy, depth, histogram, histogramBins, hlgPeakNits);
+  ValidateYCbCrParameters(kr, kb, colorRange);
+  const float nitsScale = ContentLightNitsScale(transferFunction, hlgPeakNits);
+  if (histogramBins > 0) {
+    std::fill(histogram, histogram + histogramBins, 0u);
+  }
+  ContentLightReduction reduction{.histogram = histogram, .histogramBins = histogramBins};
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {
+    reduction.Run(start, end, [&](uint32_t s, uint32_t e, float *maxLight, double *sumLight, uint32_t *bins) {
+      HWY_DYNAMIC_DISPATCH(ContentLightYCbCr420P16HWY)(yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                                       width, depth, kr, kb, colorRange, transferFunction, accuracy,
+                                                       nitsScale, s, e, maxLight, sumLight, bins, histogramBins);
+    });
+  });
+  return reduction.Result(width, height);
+}
+
+}
+#endif
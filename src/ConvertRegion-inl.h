@@ -0,0 +1,377 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_CONVERT_REGION_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_CONVERT_REGION_INL_H
+#undef SPARKYUV_CONVERT_REGION_INL_H
+#else
+#define SPARKYUV_CONVERT_REGION_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-def.h"
+#include "sparkyuv-internal.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+/**
+ * Computes source sample positions for each destination pixel with pixel centers aligned.
+ * Weights are 8-bit fixed point in [0, 256] and points to the second sample
+ */
+static void ComputeRegionSamples(const uint32_t srcSize, const uint32_t dstSize, const SparkYuvSampler sampler,
+                                 uint32_t *SPARKYUV_RESTRICT first, uint32_t *SPARKYUV_RESTRICT second,
+                                 uint16_t *SPARKYUV_RESTRICT weights) {
+  const float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+  const auto maxIndex = static_cast<int>(srcSize) - 1;
+  for (uint32_t i = 0; i < dstSize; ++i) {
+    if (sampler == nearest) {
+      const int index = std::min(static_cast<int>((static_cast<float>(i) + 0.5f) * scale), maxIndex);
+      first[i] = index;
+      second[i] = index;
+      weights[i] = 0;
+      continue;
+    }
+    const float position = std::clamp((static_cast<float>(i) + 0.5f) * scale - 0.5f,
+                                      0.f, static_cast<float>(maxIndex));
+    const int index = static_cast<int>(position);
+    first[i] = index;
+    second[i] = std::min(index + 1, maxIndex);
+    weights[i] = static_cast<uint16_t>(::roundf((position - static_cast<float>(index)) * 256.f));
+  }
+}
+
+/**
+ * Vertical linear interpolation of two rows, weight is 8-bit fixed point in [0, 256]
+ */
+SPARKYUV_INLINE static void BlendRows8(const uint8_t *SPARKYUV_RESTRICT top,
+                                       const uint8_t *SPARKYUV_RESTRICT bottom,
+                                       uint8_t *SPARKYUV_RESTRICT dst,
+                                       const uint32_t length, const uint16_t weight) {
+  const ScalableTag<uint8_t> du8;
+  const Half<decltype(du8)> du8h;
+  const RepartitionToWide<decltype(du8)> du16;
+
+  const auto vWeight = Set(du16, weight);
+  const auto vInvWeight = Set(du16, static_cast<uint16_t>(256 - weight));
+  const auto vRounding = Set(du16, 128);
+
+  const uint32_t lanes = Lanes(du8);
+  uint32_t x = 0;
+
+  for (; x + lanes <= length; x += lanes) {
+    const auto t = LoadU(du8, top + x);
+    const auto b = LoadU(du8, bottom + x);
+    const auto lo = ShiftRight<8>(Add(Add(Mul(PromoteLowerTo(du16, t), vInvWeight),
+                                          Mul(PromoteLowerTo(du16, b), vWeight)), vRounding));
+    const auto hi = ShiftRight<8>(Add(Add(Mul(PromoteUpperTo(du16, t), vInvWeight),
+                                          Mul(PromoteUpperTo(du16, b), vWeight)), vRounding));
+    StoreU(Combine(du8, DemoteTo(du8h, hi), DemoteTo(du8h, lo)), du8, dst + x);
+  }
+
+  for (; x < length; ++x) {
+    dst[x] = static_cast<uint8_t>((static_cast<int>(top[x]) * (256 - weight)
+        + static_cast<int>(bottom[x]) * weight + 128) >> 8);
+  }
+}
+
+/**
+ * Copies both source pixels of every destination pixel into two contiguous rows,
+ * pixel size is compile time constant so each copy is a single load and store
+ */
+template<int components>
+SPARKYUV_INLINE static void GatherPixels8(const uint8_t *SPARKYUV_RESTRICT src,
+                                          uint8_t *SPARKYUV_RESTRICT row0, uint8_t *SPARKYUV_RESTRICT row1,
+                                          const uint32_t dstWidth,
+                                          const uint32_t *SPARKYUV_RESTRICT first,
+                                          const uint32_t *SPARKYUV_RESTRICT second) {
+  for (uint32_t x = 0; x < dstWidth; ++x) {
+    std::memcpy(row0 + x * components, src + first[x] * components, components);
+    std::memcpy(row1 + x * components, src + second[x] * components, components);
+  }
+}
+
+/**
+ * Horizontal linear interpolation, source pixels are gathered into `gathered` of `2 * dstWidth * components`
+ * and then blended in 16-bit as in BlendRows8. `weights` holds 8-bit fixed point weight of every channel
+ */
+SPARKYUV_INLINE static void ResampleRow8(const uint8_t *SPARKYUV_RESTRICT src, uint8_t *SPARKYUV_RESTRICT dst,
+                                         const uint32_t dstWidth, const int components,
+                                         const uint32_t *SPARKYUV_RESTRICT first,
+                                         const uint32_t *SPARKYUV_RESTRICT second,
+                                         const uint16_t *SPARKYUV_RESTRICT weights,
+                                         uint8_t *SPARKYUV_RESTRICT gathered) {
+  const uint32_t length = dstWidth * components;
+  uint8_t *row0 = gathered;
+  uint8_t *row1 = gathered + length;
+
+  switch (components) {
+    case 1:
+      GatherPixels8<1>(src, row0, row1, dstWidth, first, second);
+      break;
+    case 2:
+      GatherPixels8<2>(src, row0, row1, dstWidth, first, second);
+      break;
+    case 3:
+      GatherPixels8<3>(src, row0, row1, dstWidth, first, second);
+      break;
+    case 4:
+      GatherPixels8<4>(src, row0, row1, dstWidth, first, second);
+      break;
+    default:
+      for (uint32_t x = 0; x < dstWidth; ++x) {
+        std::memcpy(row0 + x * components, src + first[x] * components, components);
+        std::memcpy(row1 + x * components, src + second[x] * components, components);
+      }
+      break;
+  }
+
+  const ScalableTag<uint8_t> du8;
+  const Half<decltype(du8)> du8h;
+  const RepartitionToWide<decltype(du8)> du16;
+
+  const auto vMaxWeight = Set(du16, 256);
+  const auto vRounding = Set(du16, 128);
+
+  const uint32_t lanes = Lanes(du8);
+  const uint32_t halfLanes = Lanes(du16);
+  uint32_t x = 0;
+
+  for (; x + lanes <= length; x += lanes) {
+    const auto t = LoadU(du8, row0 + x);
+    const auto b = LoadU(du8, row1 + x);
+    const auto wLo = LoadU(du16, weights + x);
+    const auto wHi = LoadU(du16, weights + x + halfLanes);
+    const auto lo = ShiftRight<8>(Add(Add(Mul(PromoteLowerTo(du16, t), Sub(vMaxWeight, wLo)),
+                                          Mul(PromoteLowerTo(du16, b), wLo)), vRounding));
+    const auto hi = ShiftRight<8>(Add(Add(Mul(PromoteUpperTo(du16, t), Sub(vMaxWeight, wHi)),
+                                          Mul(PromoteUpperTo(du16, b), wHi)), vRounding));
+    StoreU(Combine(du8, DemoteTo(du8h, hi), DemoteTo(du8h, lo)), du8, dst + x);
+  }
+
+  for (; x < length; ++x) {
+    dst[x] = static_cast<uint8_t>((static_cast<int>(row0[x]) * (256 - weights[x])
+        + static_cast<int>(row1[x]) * weights[x] + 128) >> 8);
+  }
+}
+
+/**
+ * Vertical accumulation of source row into 16-bit sums
+ */
+SPARKYUV_INLINE static void AccumulateRow16(const uint8_t *SPARKYUV_RESTRICT src, uint16_t *SPARKYUV_RESTRICT sums,
+                                            const uint32_t length) {
+  const ScalableTag<uint8_t> du8;
+  const RepartitionToWide<decltype(du8)> du16;
+  const uint32_t lanes = Lanes(du8);
+  const uint32_t halfLanes = Lanes(du16);
+  uint32_t x = 0;
+
+  for (; x + lanes <= length; x += lanes) {
+    const auto v = LoadU(du8, src + x);
+    StoreU(Add(LoadU(du16, sums + x), PromoteLowerTo(du16, v)), du16, sums + x);
+    StoreU(Add(LoadU(du16, sums + x + halfLanes), PromoteUpperTo(du16, v)), du16, sums + x + halfLanes);
+  }
+
+  for (; x < length; ++x) {
+    sums[x] += src[x];
+  }
+}
+
+/**
+ * Adds neighbouring pixels of `components` 16-bit channels pairwise, pixels are reinterpreted as
+ * 16, 32 or 64-bit lanes so even and odd ones can be split with ConcatEven/ConcatOdd
+ */
+template<class D, class V>
+SPARKYUV_INLINE static V FoldPixelPairs16(D du16, const int components, V hi, V lo) {
+  if (components == 1) {
+    return Add(ConcatEven(du16, hi, lo), ConcatOdd(du16, hi, lo));
+  } else if (components == 2) {
+    const Repartition<uint32_t, D> du32;
+    return Add(BitCast(du16, ConcatEven(du32, BitCast(du32, hi), BitCast(du32, lo))),
+               BitCast(du16, ConcatOdd(du32, BitCast(du32, hi), BitCast(du32, lo))));
+  }
+  const Repartition<uint64_t, D> du64;
+  return Add(BitCast(du16, ConcatEven(du64, BitCast(du64, hi), BitCast(du64, lo))),
+             BitCast(du16, ConcatOdd(du64, BitCast(du64, hi), BitCast(du64, lo))));
+}
+
+/**
+ * Horizontal fold of vertical box sums into destination pixels with rounding division by box area.
+ * Factors 2 and 4 of 1, 2 or 4 channels are folded with vectors while whole box fits 16 bits,
+ * division is done as floor((total + area / 2 + 0.5) / area) in f32, which is exact for area up to 257
+ * since the nearest representable quotient is never closer than 0.5 / area to an integer.
+ * Any other factors, channel counts and the row tail are folded by scalar loop.
+ */
+SPARKYUV_INLINE static void FoldBoxRow8(const uint16_t *SPARKYUV_RESTRICT sums, uint8_t *SPARKYUV_RESTRICT dst,
+                                        const uint32_t dstWidth, const int components,
+                                        const uint32_t factorX, const uint32_t area) {
+  const uint32_t length = dstWidth * components;
+  uint32_t x = 0;
+
+  if ((factorX == 2 || factorX == 4) && (components == 1 || components == 2 || components == 4)
+      && area * 255 <= 65535) {
+    const ScalableTag<uint16_t> du16;
+    const RepartitionToWide<decltype(du16)> du32;
+    const Rebind<int32_t, decltype(du32)> di32;
+    const Rebind<float, decltype(du32)> df32;
+    const Rebind<uint8_t, decltype(du32)> du8;
+    const uint32_t lanes = Lanes(du16);
+    const uint32_t halfLanes = Lanes(du32);
+    const auto vBias = Set(df32, static_cast<float>(area / 2) + 0.5f);
+    const auto vScale = Set(df32, 1.f / static_cast<float>(area));
+
+    for (; x + lanes <= length; x += lanes) {
+      const uint16_t *src = sums + x * factorX;
+      auto folded = FoldPixelPairs16(du16, components, LoadU(du16, src + lanes), LoadU(du16, src));
+      if (factorX == 4) {
+        const auto next = FoldPixelPairs16(du16, components, LoadU(du16, src + lanes * 3),
+                                           LoadU(du16, src + lanes * 2));
+        folded = FoldPixelPairs16(du16, components, next, folded);
+      }
+      const auto lo = ConvertTo(df32, BitCast(di32, PromoteLowerTo(du32, folded)));
+      const auto hi = ConvertTo(df32, BitCast(di32, PromoteUpperTo(du32, folded)));
+      StoreU(DemoteTo(du8, ConvertTo(di32, Mul(Add(lo, vBias), vScale))), du8, dst + x);
+      StoreU(DemoteTo(du8, ConvertTo(di32, Mul(Add(hi, vBias), vScale))), du8, dst + x + halfLanes);
+    }
+  }
+
+  for (; x < length; ++x) {
+    const uint32_t pixel = x / components;
+    const uint32_t c = x % components;
+    const uint16_t *sum = sums + static_cast<size_t>(pixel) * factorX * components + c;
+    uint32_t total = 0;
+    for (uint32_t j = 0; j < factorX; ++j) {
+      total += sum[j * components];
+    }
+    dst[x] = static_cast<uint8_t>((total + area / 2) / area);
+  }
+}
+
+/**
+ * Strip-mined scaler of 8-bit rows with `components` interleaved channels.
+ * Only source rows that destination actually samples are fetched, each of them exactly once:
+ * `convertRow(row, buffer)` makes region row available, using `buffer` if it has to convert anything,
+ * and returns pointer to the first region pixel.
+ * For bilinear and nearest row is resampled horizontally and kept in two rows cache,
+ * from which destination rows are interpolated vertically. Box requires integer factors,
+ * source rows are accumulated vertically in 16-bit and then folded horizontally.
+ * Only destination rows in [dstRowStart, dstRowEnd) are produced, `dst` points to row `dstRowStart`.
+ */
+template<typename RowConverter>
+void ScaleRowsStrip(RowConverter &&convertRow, const uint32_t rowLength, const int components,
+                    const uint32_t regionWidth, const uint32_t regionHeight,
+                    uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                    const uint32_t dstWidth, const uint32_t dstHeight,
+                    const uint32_t dstRowStart, const uint32_t dstRowEnd,
+                    const SparkYuvSampler sampler) {
+  if (sampler != bilinear && sampler != nearest && sampler != box) {
+    throw std::runtime_error("Only bilinear, nearest and box samplers are supported");
+  }
+
+  std::vector<uint8_t> sourceRow(rowLength * components);
+  auto mDst = reinterpret_cast<uint8_t *>(dst);
+
+  if (sampler == box) {
+    if (regionWidth % dstWidth != 0 || regionHeight % dstHeight != 0) {
+      throw std::runtime_error("Box sampler requires integer scale factors");
+    }
+    const uint32_t factorX = regionWidth / dstWidth;
+    const uint32_t factorY = regionHeight / dstHeight;
+    if (factorY > 256) {
+      throw std::runtime_error("Box sampler supports vertical factor up to 256");
+    }
+    const uint32_t area = factorX * factorY;
+    const uint32_t sumsLength = regionWidth * components;
+    std::vector<uint16_t> sums(sumsLength);
+
+    for (uint32_t y = dstRowStart; y < dstRowEnd; ++y) {
+      std::fill(sums.begin(), sums.end(), 0);
+      for (uint32_t i = 0; i < factorY; ++i) {
+        AccumulateRow16(convertRow(y * factorY + i, sourceRow.data()), sums.data(), sumsLength);
+      }
+      FoldBoxRow8(sums.data(), mDst, dstWidth, components, factorX, area);
+      mDst += dstStride;
+    }
+    return;
+  }
+
+  std::vector<uint32_t> xFirst(dstWidth), xSecond(dstWidth);
+  std::vector<uint16_t> xWeights(dstWidth);
+  ComputeRegionSamples(regionWidth, dstWidth, sampler, xFirst.data(), xSecond.data(), xWeights.data());
+  std::vector<uint16_t> xChannelWeights(static_cast<size_t>(dstWidth) * components);
+  for (uint32_t x = 0; x < dstWidth; ++x) {
+    std::fill(xChannelWeights.begin() + x * components, xChannelWeights.begin() + (x + 1) * components, xWeights[x]);
+  }
+
+  std::vector<uint32_t> yFirst(dstHeight), ySecond(dstHeight);
+  std::vector<uint16_t> yWeights(dstHeight);
+  ComputeRegionSamples(regionHeight, dstHeight, sampler, yFirst.data(), ySecond.data(), yWeights.data());
+
+  const uint32_t cacheRowLength = dstWidth * components;
+  std::vector<uint8_t> cache(cacheRowLength * 2);
+  std::vector<uint8_t> gathered(cacheRowLength * 2);
+  int64_t cachedRows[2] = {-1, -1};
+
+  auto fetchRow = [&](const uint32_t row, const uint32_t keepRow) -> const uint8_t * {
+    for (int i = 0; i < 2; ++i) {
+      if (cachedRows[i] == row) {
+        return cache.data() + i * cacheRowLength;
+      }
+    }
+    const int slot = cachedRows[0] == keepRow ? 1 : 0;
+    const uint8_t *region = convertRow(row, sourceRow.data());
+    uint8_t *slotRow = cache.data() + slot * cacheRowLength;
+    ResampleRow8(region, slotRow, dstWidth, components, xFirst.data(), xSecond.data(), xChannelWeights.data(),
+                 gathered.data());
+    cachedRows[slot] = row;
+    return slotRow;
+  };
+
+  for (uint32_t y = dstRowStart; y < dstRowEnd; ++y) {
+    const uint8_t *top = fetchRow(yFirst[y], ySecond[y]);
+    if (yWeights[y] == 0) {
+      std::copy(top, top + cacheRowLength, mDst);
+    } else {
+      const uint8_t *bottom = fetchRow(ySecond[y], yFirst[y]);
+      BlendRows8(top, bottom, mDst, cacheRowLength, yWeights[y]);
+    }
+    mDst += dstStride;
+  }
+}
+
+/**
+ * Region and sampler are validated by the public wrapper before work is split between threads
+ */
+template<SparkYuvDefaultPixelType PixelType, typename RowConverter>
+void ConvertRegionStrip(RowConverter &&convertRow, const uint32_t rowLength,
+                        const uint32_t regionWidth, const uint32_t regionHeight,
+                        uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                        const uint32_t dstWidth, const uint32_t dstHeight,
+                        const SparkYuvSampler sampler) {
+  ScaleRowsStrip(convertRow, rowLength, getPixelTypeComponents(PixelType), regionWidth, regionHeight,
+                 dst, dstStride, dstWidth, dstHeight, 0, dstHeight, sampler);
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_DITHER_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_DITHER_INL_H
+#undef SPARKYUV_DITHER_INL_H
+#else
+#define SPARKYUV_DITHER_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "sparkyuv-internal.h"
+#include "sparkyuv-def.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+static const uint8_t kBayer8x8[64] = {
+    0, 32, 8, 40, 2, 34, 10, 42,
+    48, 16, 56, 24, 50, 18, 58, 26,
+    12, 44, 4, 36, 14, 46, 6, 38,
+    60, 28, 52, 20, 62, 30, 54, 22,
+    3, 35, 11, 43, 1, 33, 9, 41,
+    51, 19, 59, 27, 49, 17, 57, 25,
+    15, 47, 7, 39, 13, 45, 5, 37,
+    63, 31, 55, 23, 61, 29, 53, 21,
+};
+
+/**
+ * Dither rows hold one vector of thresholds plus a full period,
+ * so a vector for column x is loaded from row + (x & 7)
+ */
+static constexpr int kDitherRowPeriod = 8;
+
+/**
+ * Integer threshold in [0, 2^shift) added before a right shift by `shift`
+ */
+SPARKYUV_INLINE static uint16_t BayerThreshold(const uint32_t x, const uint32_t y, const int shift) {
+  return static_cast<uint16_t>((static_cast<uint32_t>(kBayer8x8[((y & 7) << 3) | (x & 7)]) << shift) >> 6);
+}
+
+/**
+ * Fractional threshold in (0, 1) added before truncation
+ */
+SPARKYUV_INLINE static float BayerThreshold(const uint32_t x, const uint32_t y) {
+  return (static_cast<float>(kBayer8x8[((y & 7) << 3) | (x & 7)]) + 0.5f) * (1.f / 64.f);
+}
+
+/**
+ * Fills `count` thresholds for row y, zeros when dithering is disabled
+ */
+SPARKYUV_INLINE static void FillDitherRow(uint16_t *row, const uint32_t y, const uint32_t count,
+                                          const int shift, const SparkYuvDither dither) {
+  for (uint32_t i = 0; i < count; ++i) {
+    row[i] = dither == DITHER_BAYER8X8 ? BayerThreshold(i, y, shift) : 0;
+  }
+}
+
+SPARKYUV_INLINE static void FillDitherRow(float *row, const uint32_t y, const uint32_t count,
+                                          const SparkYuvDither dither) {
+  for (uint32_t i = 0; i < count; ++i) {
+    row[i] = dither == DITHER_BAYER8X8 ? BayerThreshold(i, y) : 0.f;
+  }
+}
+
+SPARKYUV_INLINE static void FillDitherRow(hwy::float16_t *row, const uint32_t y, const uint32_t count,
+                                          const SparkYuvDither dither) {
+  for (uint32_t i = 0; i < count; ++i) {
+    row[i] = hwy::F16FromF32(dither == DITHER_BAYER8X8 ? BayerThreshold(i, y) : 0.f);
+  }
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
@@ -23,9 +23,301 @@
 #include "hwy/highway.h"
 #include "yuv-inl.h"
 #include "Eotf-inl.h"
+#include "TransferLut-inl.h"
+#include "TransferSurface-inl.h"
+#include "TypeSupport.h"
+#include "concurrency.hpp"
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadLinear(DF df, const float *SPARKYUV_RESTRICT src, VF &r, VF &g, VF &b, VF &a) {
+  LoadInterleaved4(df, src, r, g, b, a);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadLinear(DF df, const hwy::float16_t *SPARKYUV_RESTRICT src, VF &r, VF &g, VF &b, VF &a) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  Vec<decltype(du16)> r16, g16, b16, a16;
+  LoadInterleaved4(du16, reinterpret_cast<const uint16_t *>(src), r16, g16, b16, a16);
+  r = PromoteTo(df, BitCast(df16, r16));
+  g = PromoteTo(df, BitCast(df16, g16));
+  b = PromoteTo(df, BitCast(df16, b16));
+  a = PromoteTo(df, BitCast(df16, a16));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreLinear(DF df, VF r, VF g, VF b, VF a, float *SPARKYUV_RESTRICT dst) {
+  StoreInterleaved4(r, g, b, a, df, dst);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreLinear(DF df, VF r, VF g, VF b, VF a, hwy::float16_t *SPARKYUV_RESTRICT dst) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  StoreInterleaved4(BitCast(du16, DemoteTo(df16, r)), BitCast(du16, DemoteTo(df16, g)),
+                    BitCast(du16, DemoteTo(df16, b)), BitCast(du16, DemoteTo(df16, a)),
+                    du16, reinterpret_cast<uint16_t *>(dst));
+}
+
+/**
+ * 8-bit samples index the exact table directly, without a float round trip
+ */
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LinearizeRGBA8(DF df, const uint8_t *SPARKYUV_RESTRICT src, const TransferLut &lut,
+                               VF &r, VF &g, VF &b, VF &a) {
+  const Rebind<uint8_t, decltype(df)> du8;
+  const RebindToSigned<decltype(df)> di32;
+  Vec<decltype(du8)> r8, g8, b8, a8;
+  LoadInterleaved4(du8, src, r8, g8, b8, a8);
+  r = TransferLutEotf(df, lut, PromoteTo(di32, r8));
+  g = TransferLutEotf(df, lut, PromoteTo(di32, g8));
+  b = TransferLutEotf(df, lut, PromoteTo(di32, b8));
+  a = Mul(ConvertTo(df, PromoteTo(di32, a8)), Set(df, 1.f / 255.f));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void DelinearizeRGBA8(DF df, VF r, VF g, VF b, VF a, const TransferLut &lut,
+                                 uint8_t *SPARKYUV_RESTRICT dst) {
+  const Rebind<uint8_t, decltype(df)> du8;
+  StoreInterleaved4(DemoteTo(du8, TransferLutOetf8(df, lut, r)), DemoteTo(du8, TransferLutOetf8(df, lut, g)),
+                    DemoteTo(du8, TransferLutOetf8(df, lut, b)), DemoteTo(du8, NearestInt(Mul(a, Set(df, 255.f)))),
+                    du8, dst);
+}
+
+template<TransferSurface Surface, typename L>
+void LinearizeHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                  L *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                  const uint32_t width, const int bitDepth,
+                  const SparkYuvTransferFunction transferFunction, const SparkYuvTransferAccuracy accuracy,
+                  const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+
+  const int maxColors = (1 << bitDepth) - 1;
+  const float scale = 1.f / static_cast<float>(maxColors);
+  // Table of 8-bit samples is exact, so it is used whatever accuracy is requested
+  const TransferLut *lut = Surface == TRANSFER_SURFACE_RGBA8
+                           ? &GetTransferLut(transferFunction, 8)
+                           : GetTransferLutFor(accuracy, transferFunction,
+                                               Surface == TRANSFER_SURFACE_RGBAF16 ? 8 : bitDepth);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    auto mDst = reinterpret_cast<L *>(reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride);
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      if (Surface == TRANSFER_SURFACE_RGBA8) {
+        LinearizeRGBA8(df, mSrc, *lut, r, g, b, a);
+      } else {
+        LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+        r = LinearizeVector<Surface>(df, r, transferFunction, accuracy, lut);
+        g = LinearizeVector<Surface>(df, g, transferFunction, accuracy, lut);
+        b = LinearizeVector<Surface>(df, b, transferFunction, accuracy, lut);
+      }
+      StoreLinear(df, r, g, b, a, mDst);
+      mSrc += lanes * pixelSize;
+      mDst += lanes * 4;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      if (Surface == TRANSFER_SURFACE_RGBA8) {
+        r = TransferLutEotf(*lut, mSrc[0]);
+        g = TransferLutEotf(*lut, mSrc[1]);
+        b = TransferLutEotf(*lut, mSrc[2]);
+      } else {
+        r = LinearizeValue<Surface>(r, transferFunction, accuracy, lut);
+        g = LinearizeValue<Surface>(g, transferFunction, accuracy, lut);
+        b = LinearizeValue<Surface>(b, transferFunction, accuracy, lut);
+      }
+      StoreFloat(mDst, r);
+      StoreFloat(mDst + 1, g);
+      StoreFloat(mDst + 2, b);
+      StoreFloat(mDst + 3, a);
+      mSrc += pixelSize;
+      mDst += 4;
+    }
+  }
+}
+
+template<TransferSurface Surface, typename L>
+void DelinearizeHWY(const L *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                    uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                    const uint32_t width, const int bitDepth,
+                    const SparkYuvTransferFunction transferFunction, const SparkYuvTransferAccuracy accuracy,
+                    const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+
+  const int maxColors = (1 << bitDepth) - 1;
+  const TransferLut *lut = GetTransferLutFor(accuracy, transferFunction,
+                                             Surface == TRANSFER_SURFACE_RGBAF16 ? 8 : bitDepth);
+  // 8-bit destinations read ready codes from the table in the LUT tier
+  const bool encodeRGBA8 = Surface == TRANSFER_SURFACE_RGBA8 && accuracy == TRANSFER_ACCURACY_LUT;
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const L *>(reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride);
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      LoadLinear(df, mSrc, r, g, b, a);
+      if (encodeRGBA8) {
+        DelinearizeRGBA8(df, r, g, b, a, *lut, mDst);
+      } else {
+        r = ApplyOetf(df, r, transferFunction, accuracy, lut);
+        g = ApplyOetf(df, g, transferFunction, accuracy, lut);
+        b = ApplyOetf(df, b, transferFunction, accuracy, lut);
+        StoreTransferSurface<Surface>(df, mDst, r, g, b, a, maxColors);
+      }
+      mSrc += lanes * 4;
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      if (encodeRGBA8) {
+        mDst[0] = static_cast<uint8_t>(TransferLutOetf8(*lut, LoadFloat(mSrc)));
+        mDst[1] = static_cast<uint8_t>(TransferLutOetf8(*lut, LoadFloat(mSrc + 1)));
+        mDst[2] = static_cast<uint8_t>(TransferLutOetf8(*lut, LoadFloat(mSrc + 2)));
+        mDst[3] = static_cast<uint8_t>(std::clamp(::roundf(LoadFloat(mSrc + 3) * 255.f), 0.f, 255.f));
+      } else {
+        const float r = ApplyOetf(LoadFloat(mSrc), transferFunction, accuracy, lut);
+        const float g = ApplyOetf(LoadFloat(mSrc + 1), transferFunction, accuracy, lut);
+        const float b = ApplyOetf(LoadFloat(mSrc + 2), transferFunction, accuracy, lut);
+        StoreTransferPixel<Surface>(mDst, r, g, b, LoadFloat(mSrc + 3), maxColors);
+      }
+      mSrc += 4;
+      mDst += pixelSize;
+    }
+  }
+}
+
+#define LINEARIZE_DECLARATION_R(srcName, surface, srcType, dstName, dstType, linearType) \
+void Linearize##srcName##To##dstName##HWY(const srcType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                         dstType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                         const uint32_t width, const int bitDepth,\
+                                         const SparkYuvTransferFunction transferFunction,\
+                                         const SparkYuvTransferAccuracy accuracy,\
+                                         const uint32_t startRow, const uint32_t endRow) {\
+  LinearizeHWY<surface, linearType>(reinterpret_cast<const uint8_t *>(src), srcStride,\
+                                    reinterpret_cast<linearType *>(dst), dstStride, width, bitDepth,\
+                                    transferFunction, accuracy, startRow, endRow);\
+}
+
+#define DELINEARIZE_DECLARATION_R(srcName, srcType, linearType, dstName, surface, dstType) \
+void Delinearize##srcName##To##dstName##HWY(const srcType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                           dstType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                           const uint32_t width, const int bitDepth,\
+                                           const SparkYuvTransferFunction transferFunction,\
+                                           const SparkYuvTransferAccuracy accuracy,\
+                                           const uint32_t startRow, const uint32_t endRow) {\
+  DelinearizeHWY<surface, linearType>(reinterpret_cast<const linearType *>(src), srcStride,\
+                                      reinterpret_cast<uint8_t *>(dst), dstStride, width, bitDepth,\
+                                      transferFunction, accuracy, startRow, endRow);\
+}
+
+#define TRANSFER_SURFACE_DECLARATION_R(name, surface, storageType) \
+        LINEARIZE_DECLARATION_R(name, surface, storageType, RGBAF32, float, float) \
+        LINEARIZE_DECLARATION_R(name, surface, storageType, RGBAF16, uint16_t, hwy::float16_t) \
+        DELINEARIZE_DECLARATION_R(RGBAF32, float, float, name, surface, storageType) \
+        DELINEARIZE_DECLARATION_R(RGBAF16, uint16_t, hwy::float16_t, name, surface, storageType)
+
+TRANSFER_SURFACE_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t)
+TRANSFER_SURFACE_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t)
+TRANSFER_SURFACE_DECLARATION_R(RGBA1010102, TRANSFER_SURFACE_RGBA1010102, uint8_t)
+TRANSFER_SURFACE_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+
+#undef TRANSFER_SURFACE_DECLARATION_R
+#undef DELINEARIZE_DECLARATION_R
+#undef LINEARIZE_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
 
 #if HWY_ONCE
 namespace sparkyuv {
 
+#define TRANSFER_SURFACE_DECLARATION_HWY(name) \
+        HWY_EXPORT(Linearize##name##ToRGBAF32HWY); \
+        HWY_EXPORT(Linearize##name##ToRGBAF16HWY); \
+        HWY_EXPORT(DelinearizeRGBAF32To##name##HWY); \
+        HWY_EXPORT(DelinearizeRGBAF16To##name##HWY);
+
+TRANSFER_SURFACE_DECLARATION_HWY(RGBA)
+TRANSFER_SURFACE_DECLARATION_HWY(RGBA16)
+TRANSFER_SURFACE_DECLARATION_HWY(RGBA1010102)
+TRANSFER_SURFACE_DECLARATION_HWY(RGBAF16)
+
+#undef TRANSFER_SURFACE_DECLARATION_HWY
+
+static void ValidateTransfer(const SparkYuvTransferAccuracy accuracy, const int depth) {
+  if (accuracy != TRANSFER_ACCURACY_EXACT && accuracy != TRANSFER_ACCURACY_FAST && accuracy != TRANSFER_ACCURACY_LUT) {
+    throw std::runtime_error("Unsupported transfer accuracy");
+  }
+  if (depth < 1 || depth > 16) {
+    throw std::runtime_error("Bit depth must be in range [1, 16]");
+  }
+}
+
+/**
+ * Variadic arguments carry extra public parameters with trailing comma, RGBA16 passes its bit-depth this way
+ */
+#define LINEARIZE_DECLARATION_E(srcName, srcType, dstName, dstType, depth, ...) \
+    void Linearize##srcName##To##dstName(const srcType *src, const uint32_t srcStride,\
+                                         dstType *dst, const uint32_t dstStride,\
+                                         const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                         const SparkYuvTransferFunction transferFunction,\
+                                         const SparkYuvTransferAccuracy accuracy) {\
+      ValidateTransfer(accuracy, depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(Linearize##srcName##To##dstName##HWY)(src, srcStride, dst, dstStride, width, depth,\
+                                                                 transferFunction, accuracy, start, end);\
+      });\
+    }
+
+#define DELINEARIZE_DECLARATION_E(srcName, srcType, dstName, dstType, depth, ...) \
+    void Delinearize##srcName##To##dstName(const srcType *src, const uint32_t srcStride,\
+                                           dstType *dst, const uint32_t dstStride,\
+                                           const uint32_t width, const uint32_t height, __VA_ARGS__\
+                                           const SparkYuvTransferFunction transferFunction,\
+                                           const SparkYuvTransferAccuracy accuracy) {\
+      ValidateTransfer(accuracy, depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(Delinearize##srcName##To##dstName##HWY)(src, srcStride, dst, dstStride, width, depth,\
+                                                                   transferFunction, accuracy, start, end);\
+      });\
+    }
+
+#define TRANSFER_SURFACE_DECLARATION_E(name, storageType, depth, ...) \
+        LINEARIZE_DECLARATION_E(name, storageType, RGBAF32, float, depth, __VA_ARGS__) \
+        LINEARIZE_DECLARATION_E(name, storageType, RGBAF16, uint16_t, depth, __VA_ARGS__) \
+        DELINEARIZE_DECLARATION_E(RGBAF32, float, name, storageType, depth, __VA_ARGS__) \
+        DELINEARIZE_DECLARATION_E(RGBAF16, uint16_t, name, storageType, depth, __VA_ARGS__)
+
+TRANSFER_SURFACE_DECLARATION_E(RGBA, uint8_t, 8)
+TRANSFER_SURFACE_DECLARATION_E(RGBA16, uint16_t, depth, const int depth,)
+TRANSFER_SURFACE_DECLARATION_E(RGBA1010102, uint8_t, 10)
+TRANSFER_SURFACE_DECLARATION_E(RGBAF16, uint16_t, 16)
+
+#undef TRANSFER_SURFACE_DECLARATION_E
+#undef DELINEARIZE_DECLARATION_E
+#undef LINEARIZE_DECLARATION_E
+
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,686 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/GainMap.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Eotf-inl.h"
+#include "TransferLut-inl.h"
+#include "TransferSurface-inl.h"
+#include "math/fast_math-inl.h"
+#include "concurrency.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+enum GainMapSource {
+  GAIN_MAP_SOURCE_RGBA,
+  GAIN_MAP_SOURCE_YCBCR420
+};
+
+/**
+ * Gain map metadata prepared for the kernels, log boost is already scaled by display weight
+ */
+struct GainMapContext {
+  int channels;
+  float logMin[3];
+  float logRange[3];
+  float invGamma[3];
+  float offsetSdr[3];
+  float offsetHdr[3];
+  float weight;
+};
+
+static GainMapContext MakeGainMapContext(const SparkYuvGainMapMetadata &metadata,
+                                         const SparkYuvGainMapChannels channels, const float displayBoost) {
+  GainMapContext c{};
+  c.channels = channels == GAIN_MAP_RGB ? 3 : 1;
+  const float logBoost = std::log2(std::max(displayBoost, 1.f));
+  const float capacityRange = metadata.hdrCapacityMax - metadata.hdrCapacityMin;
+  if (capacityRange > 0.f) {
+    c.weight = std::clamp((logBoost - metadata.hdrCapacityMin) / capacityRange, 0.f, 1.f);
+  } else {
+    c.weight = logBoost >= metadata.hdrCapacityMax ? 1.f : 0.f;
+  }
+  for (int i = 0; i < 3; ++i) {
+    c.logMin[i] = metadata.gainMapMin[i] * c.weight;
+    c.logRange[i] = (metadata.gainMapMax[i] - metadata.gainMapMin[i]) * c.weight;
+    c.invGamma[i] = 1.f / metadata.gamma[i];
+    c.offsetSdr[i] = metadata.offsetSdr[i];
+    c.offsetHdr[i] = metadata.offsetHdr[i];
+  }
+  return c;
+}
+
+/**
+ * Recovered weighted log2 boost of normalized gain map samples
+ */
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE VF GainMapLogBoost(DF df, VF gain, const GainMapContext &c, const int channel) {
+  if (c.invGamma[channel] != 1.f) {
+    gain = FastPowf(df, Max(gain, Set(df, 1e-7f)), Set(df, c.invGamma[channel]));
+  }
+  return MulAdd(gain, Set(df, c.logRange[channel]), Set(df, c.logMin[channel]));
+}
+
+SPARKYUV_INLINE static float GainMapLogBoost(float gain, const GainMapContext &c, const int channel) {
+  if (c.invGamma[channel] != 1.f) {
+    gain = FastPowf(std::max(gain, 1e-7f), c.invGamma[channel]);
+  }
+  return gain * c.logRange[channel] + c.logMin[channel];
+}
+
+/**
+ * Vertical part of bilinear upsampling: both gain map rows are recovered into log boost
+ * and blended, rows have one extra entry so horizontal interpolation may read `index + 1` unconditionally
+ */
+static void PrepareGainMapRow(const uint8_t *SPARKYUV_RESTRICT gainMap, const uint32_t gainMapStride,
+                              const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                              const uint32_t height, const uint32_t y, const GainMapContext &c,
+                              std::vector<float> *boost) {
+  const ScalableTag<float> df;
+  const Rebind<uint8_t, decltype(df)> du8;
+  const RebindToSigned<decltype(df)> di32;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+
+  const float maxPosition = static_cast<float>(gainMapHeight - 1);
+  const float position = std::clamp((static_cast<float>(y) + 0.5f) * static_cast<float>(gainMapHeight)
+                                         / static_cast<float>(height) - 0.5f, 0.f, maxPosition);
+  const auto y0 = static_cast<uint32_t>(position);
+  const uint32_t y1 = std::min(y0 + 1, gainMapHeight - 1);
+  const float fy = position - static_cast<float>(y0);
+  const uint8_t *row0 = gainMap + static_cast<size_t>(y0) * gainMapStride;
+  const uint8_t *row1 = gainMap + static_cast<size_t>(y1) * gainMapStride;
+
+  const VF vScale = Set(df, 1.f / 255.f);
+  const VF vFy = Set(df, fy);
+
+  uint32_t x = 0;
+  for (; x + lanes <= gainMapWidth; x += lanes) {
+    if (c.channels == 1) {
+      const VF g0 = GainMapLogBoost(df, Mul(ConvertTo(df, PromoteTo(di32, LoadU(du8, row0 + x))), vScale), c, 0);
+      const VF g1 = GainMapLogBoost(df, Mul(ConvertTo(df, PromoteTo(di32, LoadU(du8, row1 + x))), vScale), c, 0);
+      StoreU(MulAdd(Sub(g1, g0), vFy, g0), df, boost[0].data() + x);
+    } else {
+      Vec<decltype(du8)> s0[4], s1[4];
+      LoadInterleaved4(du8, row0 + x * 4, s0[0], s0[1], s0[2], s0[3]);
+      LoadInterleaved4(du8, row1 + x * 4, s1[0], s1[1], s1[2], s1[3]);
+      for (int i = 0; i < 3; ++i) {
+        const VF g0 = GainMapLogBoost(df, Mul(ConvertTo(df, PromoteTo(di32, s0[i])), vScale), c, i);
+        const VF g1 = GainMapLogBoost(df, Mul(ConvertTo(df, PromoteTo(di32, s1[i])), vScale), c, i);
+        StoreU(MulAdd(Sub(g1, g0), vFy, g0), df, boost[i].data() + x);
+      }
+    }
+  }
+
+  for (; x < gainMapWidth; ++x) {
+    const int pixelSize = c.channels == 1 ? 1 : 4;
+    for (int i = 0; i < c.channels; ++i) {
+      const float g0 = GainMapLogBoost(static_cast<float>(row0[x * pixelSize + i]) * (1.f / 255.f), c, i);
+      const float g1 = GainMapLogBoost(static_cast<float>(row1[x * pixelSize + i]) * (1.f / 255.f), c, i);
+      boost[i][x] = (g1 - g0) * fy + g0;
+    }
+  }
+
+  for (int i = 0; i < c.channels; ++i) {
+    boost[i][gainMapWidth] = boost[i][gainMapWidth - 1];
+  }
+}
+
+/**
+ * Linearizes one SDR row into planar float rows, alpha is normalized to [0, 1]
+ */
+template<GainMapSource Source>
+static void LinearizeGainMapBase(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                                 const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                 const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                 const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                 const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                 const uint32_t width, const uint32_t y, const TransferLut &lut,
+                                 uint8_t *SPARKYUV_RESTRICT cbRow, uint8_t *SPARKYUV_RESTRICT crRow,
+                                 const bool updateChroma, std::vector<float> *base) {
+  const ScalableTag<float> df;
+  const Rebind<uint8_t, decltype(df)> du8;
+  const RebindToSigned<decltype(df)> di32;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  float *rRow = base[0].data();
+  float *gRow = base[1].data();
+  float *bRow = base[2].data();
+  float *aRow = base[3].data();
+
+  if (Source == GAIN_MAP_SOURCE_RGBA) {
+    auto mSrc = src + static_cast<size_t>(y) * srcStride;
+    const VF alphaScale = Set(df, 1.f / 255.f);
+    uint32_t x = 0;
+    for (; x + lanes <= width; x += lanes) {
+      Vec<decltype(du8)> r8, g8, b8, a8;
+      LoadInterleaved4(du8, mSrc + x * 4, r8, g8, b8, a8);
+      StoreU(TransferLutEotf(df, lut, PromoteTo(di32, r8)), df, rRow + x);
+      StoreU(TransferLutEotf(df, lut, PromoteTo(di32, g8)), df, gRow + x);
+      StoreU(TransferLutEotf(df, lut, PromoteTo(di32, b8)), df, bRow + x);
+      StoreU(Mul(ConvertTo(df, PromoteTo(di32, a8)), alphaScale), df, aRow + x);
+    }
+    for (; x < width; ++x) {
+      rRow[x] = TransferLutEotf(lut, mSrc[x * 4]);
+      gRow[x] = TransferLutEotf(lut, mSrc[x * 4 + 1]);
+      bRow[x] = TransferLutEotf(lut, mSrc[x * 4 + 2]);
+      aRow[x] = static_cast<float>(mSrc[x * 4 + 3]) * (1.f / 255.f);
+    }
+    return;
+  }
+
+  if (updateChroma) {
+    const size_t chromaOffset = static_cast<size_t>(y / 2);
+    UpsampleChromaRow2x(uPlane + chromaOffset * uStride, cbRow, width);
+    UpsampleChromaRow2x(vPlane + chromaOffset * vStride, crRow, width);
+  }
+
+  uint16_t biasY, biasUV, rangeY, rangeUV;
+  GetYUVRange(colorRange, 8, biasY, biasUV, rangeY, rangeUV);
+  const float kg = 1.f - kr - kb;
+  const float scaleY = 1.f / static_cast<float>(rangeY);
+  const float scaleUV = 1.f / static_cast<float>(rangeUV);
+  const float crR = 2.f * (1.f - kr) * scaleUV;
+  const float cbB = 2.f * (1.f - kb) * scaleUV;
+  const float crG = 2.f * kr * (1.f - kr) / kg * scaleUV;
+  const float cbG = 2.f * kb * (1.f - kb) / kg * scaleUV;
+  const VF zeros = Zero(df);
+  const VF ones = Set(df, 1.f);
+  const VF vBiasY = Set(df, static_cast<float>(biasY));
+  const VF vBiasUV = Set(df, static_cast<float>(biasUV));
+
+  auto ySrc = yPlane + static_cast<size_t>(y) * yStride;
+  uint32_t x = 0;
+  for (; x + lanes <= width; x += lanes) {
+    const VF Y = Mul(Sub(ConvertTo(df, PromoteTo(di32, LoadU(du8, ySrc + x))), vBiasY), Set(df, scaleY));
+    const VF Cb = Sub(ConvertTo(df, PromoteTo(di32, LoadU(du8, cbRow + x))), vBiasUV);
+    const VF Cr = Sub(ConvertTo(df, PromoteTo(di32, LoadU(du8, crRow + x))), vBiasUV);
+    const VF r = Clamp(MulAdd(Set(df, crR), Cr, Y), zeros, ones);
+    const VF g = Clamp(NegMulAdd(Set(df, crG), Cr, NegMulAdd(Set(df, cbG), Cb, Y)), zeros, ones);
+    const VF b = Clamp(MulAdd(Set(df, cbB), Cb, Y), zeros, ones);
+    StoreU(TransferLutEotfCurve(df, lut, r), df, rRow + x);
+    StoreU(TransferLutEotfCurve(df, lut, g), df, gRow + x);
+    StoreU(TransferLutEotfCurve(df, lut, b), df, bRow + x);
+    StoreU(ones, df, aRow + x);
+  }
+  for (; x < width; ++x) {
+    const float Y = (static_cast<float>(ySrc[x]) - static_cast<float>(biasY)) * scaleY;
+    const float Cb = static_cast<float>(cbRow[x]) - static_cast<float>(biasUV);
+    const float Cr = static_cast<float>(crRow[x]) - static_cast<float>(biasUV);
+    rRow[x] = TransferLutEotfCurve(lut, std::clamp(Y + crR * Cr, 0.f, 1.f));
+    gRow[x] = TransferLutEotfCurve(lut, std::clamp(Y - crG * Cr - cbG * Cb, 0.f, 1.f));
+    bRow[x] = TransferLutEotfCurve(lut, std::clamp(Y + cbB * Cb, 0.f, 1.f));
+    aRow[x] = 1.f;
+  }
+}
+
+template<GainMapSource Source, TransferSurface Surface>
+void ApplyGainMapHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                     const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                     const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                     const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                     const float kr, const float kb, const SparkYuvColorRange colorRange,
+                     uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                     const uint32_t width, const uint32_t height,
+                     const uint8_t *SPARKYUV_RESTRICT gainMap, const uint32_t gainMapStride,
+                     const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                     const SparkYuvGainMapChannels channels, const SparkYuvGainMapMetadata &metadata,
+                     const float displayBoost, const SparkYuvTransferFunction sdrTransferFunction,
+                     const SparkYuvTransferFunction hdrTransferFunction,
+                     const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  const RebindToSigned<decltype(df)> di32;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const GainMapContext context = MakeGainMapContext(metadata, channels, displayBoost);
+  const TransferLut &lut = GetTransferLut(sdrTransferFunction, 8);
+  const float encodeScale = hdrTransferFunction == TransferHLG ? 1.f / std::max(displayBoost, 1.f) : 1.f;
+
+  // Horizontal part of bilinear upsampling is the same for every row
+  std::vector<int32_t> columns(width);
+  std::vector<float> fractions(width);
+  const float maxColumn = static_cast<float>(gainMapWidth - 1);
+  for (uint32_t x = 0; x < width; ++x) {
+    const float position = std::clamp((static_cast<float>(x) + 0.5f) * static_cast<float>(gainMapWidth)
+                                          / static_cast<float>(width) - 0.5f, 0.f, maxColumn);
+    columns[x] = static_cast<int32_t>(position);
+    fractions[x] = position - static_cast<float>(columns[x]);
+  }
+
+  std::vector<float> boost[3];
+  for (auto &row : boost) {
+    row.resize(gainMapWidth + 1);
+  }
+  std::vector<float> base[4];
+  for (auto &row : base) {
+    row.resize(width);
+  }
+  std::vector<uint8_t> cbRow(Source == GAIN_MAP_SOURCE_YCBCR420 ? width : 0);
+  std::vector<uint8_t> crRow(Source == GAIN_MAP_SOURCE_YCBCR420 ? width : 0);
+
+  const VF oSdr[3] = {Set(df, context.offsetSdr[0]), Set(df, context.offsetSdr[1]), Set(df, context.offsetSdr[2])};
+  const VF oHdr[3] = {Set(df, context.offsetHdr[0]), Set(df, context.offsetHdr[1]), Set(df, context.offsetHdr[2])};
+  const VF vEncodeScale = Set(df, encodeScale);
+  const VF zeros = Zero(df);
+  const int maxColors = Surface == TRANSFER_SURFACE_RGBA1010102 ? 1023 : 1;
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    LinearizeGainMapBase<Source>(src, srcStride, yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                 kr, kb, colorRange, width, y, lut, cbRow.data(), crRow.data(),
+                                 y == startRow || (y & 1) == 0, base);
+    PrepareGainMapRow(gainMap, gainMapStride, gainMapWidth, gainMapHeight, height, y, context, boost);
+
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+    for (; x + lanes <= width; x += lanes) {
+      const auto index = LoadU(di32, columns.data() + x);
+      const VF fraction = LoadU(df, fractions.data() + x);
+      VF rgb[3];
+      for (int i = 0; i < 3; ++i) {
+        const float *row = boost[context.channels == 1 ? 0 : i].data();
+        if (i == 0 || context.channels == 3) {
+          const VF low = GatherIndex(df, row, index);
+          const VF high = GatherIndex(df, row + 1, index);
+          rgb[i] = FastPow2f(df, MulAdd(Sub(high, low), fraction, low));
+        } else {
+          rgb[i] = rgb[0];
+        }
+      }
+      for (int i = 0; i < 3; ++i) {
+        rgb[i] = MulSub(Add(LoadU(df, base[i].data() + x), oSdr[i]), rgb[i], oHdr[i]);
+        if (Surface == TRANSFER_SURFACE_RGBA1010102) {
+          rgb[i] = Oetf(df, Mul(Max(rgb[i], zeros), vEncodeScale), hdrTransferFunction);
+        }
+      }
+      StoreTransferSurface<Surface>(df, mDst, rgb[0], rgb[1], rgb[2], LoadU(df, base[3].data() + x), maxColors);
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float rgb[3];
+      const int32_t column = columns[x];
+      for (int i = 0; i < 3; ++i) {
+        const float *row = boost[context.channels == 1 ? 0 : i].data();
+        const float logBoost = (row[column + 1] - row[column]) * fractions[x] + row[column];
+        rgb[i] = (base[i][x] + context.offsetSdr[i]) * FastPow2f(logBoost) - context.offsetHdr[i];
+        if (Surface == TRANSFER_SURFACE_RGBA1010102) {
+          rgb[i] = Oetf(std::max(rgb[i], 0.f) * encodeScale, hdrTransferFunction);
+        }
+      }
+      StoreTransferPixel<Surface>(mDst, rgb[0], rgb[1], rgb[2], base[3][x], maxColors);
+      mDst += pixelSize;
+    }
+  }
+}
+
+#define APPLY_GAIN_MAP_RGBA_DECLARATION_R(dstName, surface, dstType) \
+void ApplyGainMapRGBATo##dstName##HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                      dstType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                      const uint32_t width, const uint32_t height,\
+                                      const uint8_t *SPARKYUV_RESTRICT gainMap, const uint32_t gainMapStride,\
+                                      const uint32_t gainMapWidth, const uint32_t gainMapHeight,\
+                                      const SparkYuvGainMapChannels channels,\
+                                      const SparkYuvGainMapMetadata &metadata, const float displayBoost,\
+                                      const SparkYuvTransferFunction sdrTransferFunction,\
+                                      const SparkYuvTransferFunction hdrTransferFunction,\
+                                      const uint32_t startRow, const uint32_t endRow) {\
+  ApplyGainMapHWY<GAIN_MAP_SOURCE_RGBA, surface>(src, srcStride, nullptr, 0, nullptr, 0, nullptr, 0,\
+                                                 0.f, 0.f, YUV_RANGE_PC,\
+                                                 reinterpret_cast<uint8_t *>(dst), dstStride, width, height,\
+                                                 gainMap, gainMapStride, gainMapWidth, gainMapHeight,\
+                                                 channels, metadata, displayBoost,\
+                                                 sdrTransferFunction, hdrTransferFunction, startRow, endRow);\
+}
+
+#define APPLY_GAIN_MAP_YCBCR420_DECLARATION_R(dstName, surface, dstType) \
+void ApplyGainMapYCbCr420To##dstName##HWY(dstType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                          const uint32_t width, const uint32_t height,\
+                                          const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                          const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                          const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                          const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                          const uint8_t *SPARKYUV_RESTRICT gainMap, const uint32_t gainMapStride,\
+                                          const uint32_t gainMapWidth, const uint32_t gainMapHeight,\
+                                          const SparkYuvGainMapChannels channels,\
+                                          const SparkYuvGainMapMetadata &metadata, const float displayBoost,\
+                                          const SparkYuvTransferFunction sdrTransferFunction,\
+                                          const SparkYuvTransferFunction hdrTransferFunction,\
+                                          const uint32_t startRow, const uint32_t endRow) {\
+  ApplyGainMapHWY<GAIN_MAP_SOURCE_YCBCR420, surface>(nullptr, 0, yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                     kr, kb, colorRange,\
+                                                     reinterpret_cast<uint8_t *>(dst), dstStride, width, height,\
+                                                     gainMap, gainMapStride, gainMapWidth, gainMapHeight,\
+                                                     channels, metadata, displayBoost,\
+                                                     sdrTransferFunction, hdrTransferFunction, startRow, endRow);\
+}
+
+APPLY_GAIN_MAP_RGBA_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+APPLY_GAIN_MAP_RGBA_DECLARATION_R(RGBA1010102, TRANSFER_SURFACE_RGBA1010102, uint8_t)
+APPLY_GAIN_MAP_YCBCR420_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+APPLY_GAIN_MAP_YCBCR420_DECLARATION_R(RGBA1010102, TRANSFER_SURFACE_RGBA1010102, uint8_t)
+
+#undef APPLY_GAIN_MAP_YCBCR420_DECLARATION_R
+#undef APPLY_GAIN_MAP_RGBA_DECLARATION_R
+
+/**
+ * Each gain map pixel covers rows and columns [i * size / gainMapSize, (i + 1) * size / gainMapSize),
+ * at least one source pixel
+ */
+SPARKYUV_INLINE static void GainMapFootprint(const uint32_t i, const uint32_t size, const uint32_t gainMapSize,
+                                             uint32_t &start, uint32_t &end) {
+  start = static_cast<uint32_t>(static_cast<uint64_t>(i) * size / gainMapSize);
+  end = std::max(static_cast<uint32_t>(static_cast<uint64_t>(i + 1) * size / gainMapSize), start + 1);
+}
+
+void ComputeGainMapRGBAHWY(const uint8_t *SPARKYUV_RESTRICT sdr, const uint32_t sdrStride,
+                           const uint16_t *SPARKYUV_RESTRICT hdr, const uint32_t hdrStride,
+                           const uint32_t width, const uint32_t height,
+                           uint8_t *SPARKYUV_RESTRICT gainMap, const uint32_t gainMapStride,
+                           const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                           const SparkYuvGainMapChannels channels, const SparkYuvGainMapMetadata &metadata,
+                           const float kr, const float kb, const SparkYuvTransferFunction sdrTransferFunction,
+                           const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  const Rebind<uint8_t, decltype(df)> du8;
+  const RebindToSigned<decltype(df)> di32;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const TransferLut &lut = GetTransferLut(sdrTransferFunction, 8);
+  const int gainChannels = channels == GAIN_MAP_RGB ? 3 : 1;
+  const float kg = 1.f - kr - kb;
+
+  float logMin[3], invLogRange[3];
+  for (int i = 0; i < 3; ++i) {
+    logMin[i] = metadata.gainMapMin[i];
+    const float range = metadata.gainMapMax[i] - metadata.gainMapMin[i];
+    invLogRange[i] = range > 0.f ? 1.f / range : 0.f;
+  }
+
+  // Column sums of linear light over footprint rows, then footprint averages per gain map pixel
+  std::vector<float> sdrSum[3], hdrSum[3], sdrAverage[3], hdrAverage[3];
+  for (int i = 0; i < gainChannels; ++i) {
+    sdrSum[i].resize(width);
+    hdrSum[i].resize(width);
+    sdrAverage[i].resize(gainMapWidth);
+    hdrAverage[i].resize(gainMapWidth);
+  }
+
+  const VF vKr = Set(df, kr);
+  const VF vKg = Set(df, kg);
+  const VF vKb = Set(df, kb);
+
+  for (uint32_t gy = startRow; gy < endRow; ++gy) {
+    uint32_t y0, y1;
+    GainMapFootprint(gy, height, gainMapHeight, y0, y1);
+    for (int i = 0; i < gainChannels; ++i) {
+      std::fill(sdrSum[i].begin(), sdrSum[i].end(), 0.f);
+      std::fill(hdrSum[i].begin(), hdrSum[i].end(), 0.f);
+    }
+
+    for (uint32_t y = y0; y < y1; ++y) {
+      auto mSdr = sdr + static_cast<size_t>(y) * sdrStride;
+      auto mHdr = reinterpret_cast<const uint8_t *>(hdr) + static_cast<size_t>(y) * hdrStride;
+      uint32_t x = 0;
+      for (; x + lanes <= width; x += lanes) {
+        Vec<decltype(du8)> r8, g8, b8, a8;
+        LoadInterleaved4(du8, mSdr + x * 4, r8, g8, b8, a8);
+        VF s[3] = {TransferLutEotf(df, lut, PromoteTo(di32, r8)), TransferLutEotf(df, lut, PromoteTo(di32, g8)),
+                   TransferLutEotf(df, lut, PromoteTo(di32, b8))};
+        VF h[3], alpha;
+        LoadTransferSurface<TRANSFER_SURFACE_RGBAF16>(df, mHdr + x * 8, h[0], h[1], h[2], alpha, 1.f);
+        if (gainChannels == 1) {
+          s[0] = MulAdd(vKr, s[0], MulAdd(vKg, s[1], Mul(vKb, s[2])));
+          h[0] = MulAdd(vKr, h[0], MulAdd(vKg, h[1], Mul(vKb, h[2])));
+        }
+        for (int i = 0; i < gainChannels; ++i) {
+          StoreU(Add(LoadU(df, sdrSum[i].data() + x), s[i]), df, sdrSum[i].data() + x);
+          StoreU(Add(LoadU(df, hdrSum[i].data() + x), h[i]), df, hdrSum[i].data() + x);
+        }
+      }
+      for (; x < width; ++x) {
+        float s[3] = {TransferLutEotf(lut, mSdr[x * 4]), TransferLutEotf(lut, mSdr[x * 4 + 1]),
+                      TransferLutEotf(lut, mSdr[x * 4 + 2])};
+        float h[3], alpha;
+        LoadTransferPixel<TRANSFER_SURFACE_RGBAF16>(mHdr + x * 8, h[0], h[1], h[2], alpha, 1.f);
+        if (gainChannels == 1) {
+          s[0] = kr * s[0] + kg * s[1] + kb * s[2];
+          h[0] = kr * h[0] + kg * h[1] + kb * h[2];
+        }
+        for (int i = 0; i < gainChannels; ++i) {
+          sdrSum[i][x] += s[i];
+          hdrSum[i][x] += h[i];
+        }
+      }
+    }
+
+    for (uint32_t gx = 0; gx < gainMapWidth; ++gx) {
+      uint32_t x0, x1;
+      GainMapFootprint(gx, width, gainMapWidth, x0, x1);
+      const float scale = 1.f / static_cast<float>((x1 - x0) * (y1 - y0));
+      for (int i = 0; i < gainChannels; ++i) {
+        float s = 0.f, h = 0.f;
+        for (uint32_t x = x0; x < x1; ++x) {
+          s += sdrSum[i][x];
+          h += hdrSum[i][x];
+        }
+        sdrAverage[i][gx] = s * scale;
+        hdrAverage[i][gx] = h * scale;
+      }
+    }
+
+    auto mGainMap = gainMap + static_cast<size_t>(gy) * gainMapStride;
+    const VF zeros = Zero(df);
+    const VF ones = Set(df, 1.f);
+    const VF vMaxColors = Set(df, 255.f);
+    const VF minimumRatio = Set(df, 1e-7f);
+    uint32_t gx = 0;
+    for (; gx + lanes <= gainMapWidth; gx += lanes) {
+      Vec<decltype(du8)> q[3];
+      for (int i = 0; i < gainChannels; ++i) {
+        const VF s = Add(LoadU(df, sdrAverage[i].data() + gx), Set(df, metadata.offsetSdr[i]));
+        const VF h = Add(LoadU(df, hdrAverage[i].data() + gx), Set(df, metadata.offsetHdr[i]));
+        const VF logRatio = FastLog2f(df, Max(Div(h, Max(s, minimumRatio)), minimumRatio));
+        VF v = Clamp(Mul(Sub(logRatio, Set(df, logMin[i])), Set(df, invLogRange[i])), zeros, ones);
+        if (metadata.gamma[i] != 1.f) {
+          v = FastPowf(df, Max(v, minimumRatio), Set(df, metadata.gamma[i]));
+        }
+        q[i] = DemoteTo(du8, NearestInt(Mul(v, vMaxColors)));
+      }
+      if (gainChannels == 1) {
+        StoreU(q[0], du8, mGainMap + gx);
+      } else {
+        StoreInterleaved4(q[0], q[1], q[2], Set(du8, 255), du8, mGainMap + gx * 4);
+      }
+    }
+    for (; gx < gainMapWidth; ++gx) {
+      for (int i = 0; i < gainChannels; ++i) {
+        const float s = sdrAverage[i][gx] + metadata.offsetSdr[i];
+        const float h = hdrAverage[i][gx] + metadata.offsetHdr[i];
+        const float logRatio = FastLog2f(std::max(h / std::max(s, 1e-7f), 1e-7f));
+        float v = std::clamp((logRatio - logMin[i]) * invLogRange[i], 0.f, 1.f);
+        if (metadata.gamma[i] != 1.f) {
+          v = FastPowf(std::max(v, 1e-7f), metadata.gamma[i]);
+        }
+        const auto q = static_cast<uint8_t>(std::clamp(::roundf(v * 255.f), 0.f, 255.f));
+        if (gainChannels == 1) {
+          mGainMap[gx] = q;
+        } else {
+          mGainMap[gx * 4 + i] = q;
+        }
+      }
+      if (gainChannels == 3) {
+        mGainMap[gx * 4 + 3] = 255;
+      }
+    }
+  }
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+HWY_EXPORT(ApplyGainMapRGBAToRGBAF16HWY);
+HWY_EXPORT(ApplyGainMapRGBAToRGBA1010102HWY);
+HWY_EXPORT(ApplyGainMapYCbCr420ToRGBAF16HWY);
+HWY_EXPORT(ApplyGainMapYCbCr420ToRGBA1010102HWY);
+HWY_EXPORT(ComputeGainMapRGBAHWY);
+
+static void ValidateGainMap(const uint32_t width, const uint32_t height,
+                            const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                            const SparkYuvGainMapChannels channels, const SparkYuvGainMapMetadata &metadata) {
+  if (gainMapWidth == 0 || gainMapHeight == 0 || gainMapWidth > width || gainMapHeight > height) {
+    throw std::runtime_error("Gain map must be not empty and not larger than the image");
+  }
+  if (channels != GAIN_MAP_LUMINANCE && channels != GAIN_MAP_RGB) {
+    throw std::runtime_error("Unsupported gain map channels");
+  }
+  const int count = channels == GAIN_MAP_RGB ? 3 : 1;
+  for (int i = 0; i < count; ++i) {
+    if (!(metadata.gamma[i] > 0.f)) {
+      throw std::runtime_error("Gain map gamma must be positive");
+    }
+  }
+}
+
+static void ValidateHdrTransfer(const SparkYuvTransferFunction hdrTransferFunction) {
+  if (hdrTransferFunction != TransferPQ && hdrTransferFunction != TransferHLG) {
+    throw std::runtime_error("RGBA1010102 HDR output supports only PQ and HLG transfer functions");
+  }
+}
+
+void ApplyGainMapRGBAToRGBAF16(const uint8_t *src, const uint32_t srcStride,
+                               uint16_t *dst, const uint32_t dstStride, const uint32_t width, const uint32_t height,
+                               const uint8_t *gainMap, const uint32_t gainMapStride,
+                               const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                               const SparkYuvGainMapChannels channels,
+                               const SparkYuvGainMapMetadata &metadata, const float displayBoost,
+                               const SparkYuvTransferFunction sdrTransferFunction) {
+  ValidateGainMap(width, height, gainMapWidth, gainMapHeight, channels, metadata);
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(ApplyGainMapRGBAToRGBAF16HWY)(src, srcStride, dst, dstStride, width, height,
+                                                       gainMap, gainMapStride, gainMapWidth, gainMapHeight,
+                                                       channels, metadata, displayBoost,
+                                                       sdrTransferFunction, TransferLinear, start, end);
+  });
+}
+
+void ApplyGainMapRGBAToRGBA1010102(const uint8_t *src, const uint32_t srcStride,
+                                   uint8_t *dst, const uint32_t dstStride,
+                                   const uint32_t width, const uint32_t height,
+                                   const uint8_t *gainMap, const uint32_t gainMapStride,
+                                   const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                                   const SparkYuvGainMapChannels channels,
+                                   const SparkYuvGainMapMetadata &metadata, const float displayBoost,
+                                   const SparkYuvTransferFunction sdrTransferFunction,
+                                   const SparkYuvTransferFunction hdrTransferFunction) {
+  ValidateGainMap(width, height, gainMapWidth, gainMapHeight, channels, metadata);
+  ValidateHdrTransfer(hdrTransferFunction);
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(ApplyGainMapRGBAToRGBA1010102HWY)(src, srcStride, dst, dstStride, width, height,
+                                                           gainMap, gainMapStride, gainMapWidth, gainMapHeight,
+                                                           channels, metadata, displayBoost,
+                                                           sdrTransferFunction, hdrTransferFunction, start, end);
+  });
+}
+
+void ApplyGainMapYCbCr420ToRGBAF16(uint16_t *dst, const uint32_t dstStride,
+                                   const uint32_t width, const uint32_t height,
+                                   const uint8_t *yPlane, const uint32_t yStride,
+                                   const uint8_t *uPlane, const uint32_t uStride,
+                                   const uint8_t *vPlane, const uint32_t vStride,
+                                   const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                   const uint8_t *gainMap, const uint32_t gainMapStride,
+                                   const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                                   const SparkYuvGainMapChannels channels,
+                                   const SparkYuvGainMapMetadata &metadata, const float displayBoost,
+                                   const SparkYuvTransferFunction sdrTransferFunction) {
+  ValidateGainMap(width, height, gainMapWidth, gainMapHeight, channels, metadata);
+  ValidateYCbCrParameters(kr, kb, colorRange);
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(ApplyGainMapYCbCr420ToRGBAF16HWY)(dst, dstStride, width, height,
+                                                           yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                                           kr, kb, colorRange,
+                                                           gainMap, gainMapStride, gainMapWidth, gainMapHeight,
+                                                           channels, metadata, displayBoost,
+                                                           sdrTransferFunction, TransferLinear,
+                                                           start * 2, std::min(static_cast<uint32_t>(end * 2), height));
+  });
+}
+
+void ApplyGainMapYCbCr420ToRGBA1010102(uint8_t *dst, const uint32_t dstStride,
+                                       const uint32_t width, const uint32_t height,
+                                       const uint8_t *yPlane, const uint32_t yStride,
+                                       const uint8_t *uPlane, const uint32_t uStride,
+                                       const uint8_t *vPlane, const uint32_t vStride,
+                                       const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                       const uint8_t *gainMap, const uint32_t gainMapStride,
+                                       const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                                       const SparkYuvGainMapChannels channels,
+                                       const SparkYuvGainMapMetadata &metadata, const float displayBoost,
+                                       const SparkYuvTransferFunction sdrTransferFunction,
+                                       const SparkYuvTransferFunction hdrTransferFunction) {
+  ValidateGainMap(width, height, gainMapWidth, gainMapHeight, channels, metadata);
+  ValidateHdrTransfer(hdrTransferFunction);
+  ValidateYCbCrParameters(kr, kb, colorRange);
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(ApplyGainMapYCbCr420ToRGBA1010102HWY)(dst, dstStride, width, height,
+                                                               yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                                               kr, kb, colorRange,
+                                                               gainMap, gainMapStride, gainMapWidth, gainMapHeight,
+                                                               channels, metadata, displayBoost,
+                                                               sdrTransferFunction, hdrTransferFunction,
+                                                               start * 2,
+                                                               std::min(static_cast<uint32_t>(end * 2), height));
+  });
+}
+
+void ComputeGainMapRGBA(const uint8_t *sdr, const uint32_t sdrStride,
+                        const uint16_t *hdr, const uint32_t hdrStride, const uint32_t width, const uint32_t height,
+                        uint8_t *gainMap, const uint32_t gainMapStride,
+                        const uint32_t gainMapWidth, const uint32_t gainMapHeight,
+                        const SparkYuvGainMapChannels channels,
+                        const SparkYuvGainMapMetadata &metadata, const float kr, const float kb,
+                        const SparkYuvTransferFunction sdrTransferFunction) {
+  ValidateGainMap(width, height, gainMapWidth, gainMapHeight, channels, metadata);
+  const int threadCount = concurrency::getThreadCounts(gainMapWidth, gainMapHeight);
+  concurrency::parallel_for_segment(threadCount, gainMapHeight, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(ComputeGainMapRGBAHWY)(sdr, sdrStride, hdr, hdrStride, width, height,
+                                                gainMap, gainMapStride, gainMapWidth, gainMapHeight,
+                                                channels, metadata, kr, kb, sdrTransferFunction, start, end);
+  });
+}
+
+}
+#endif
@@ -0,0 +1,193 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_GAMUT_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_GAMUT_INL_H
+#undef SPARKYUV_GAMUT_INL_H
+#else
+#define SPARKYUV_GAMUT_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "sparkyuv-gamut.h"
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+/**
+ * CIE 1931 xy chromaticities of red, green, blue primaries and white point
+ */
+struct GamutPrimaries {
+  double rx, ry;
+  double gx, gy;
+  double bx, by;
+  double wx, wy;
+};
+
+static constexpr GamutPrimaries kBT709Primaries = {0.640, 0.330, 0.300, 0.600, 0.150, 0.060, 0.3127, 0.3290};
+static constexpr GamutPrimaries kBT2020Primaries = {0.708, 0.292, 0.170, 0.797, 0.131, 0.046, 0.3127, 0.3290};
+static constexpr GamutPrimaries kDisplayP3Primaries = {0.680, 0.320, 0.265, 0.690, 0.150, 0.060, 0.3127, 0.3290};
+
+static const GamutPrimaries &GetGamutPrimaries(const SparkYuvPrimaries primaries) {
+  switch (primaries) {
+    case PRIMARIES_BT709:return kBT709Primaries;
+    case PRIMARIES_BT2020:return kBT2020Primaries;
+    case PRIMARIES_DISPLAY_P3:return kDisplayP3Primaries;
+  }
+  throw std::runtime_error("Unsupported primaries");
+}
+
+struct GamutMatrix3 {
+  double m[3][3];
+};
+
+static GamutMatrix3 MultiplyGamutMatrix(const GamutMatrix3 &a, const GamutMatrix3 &b) {
+  GamutMatrix3 r{};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j];
+    }
+  }
+  return r;
+}
+
+static GamutMatrix3 InvertGamutMatrix(const GamutMatrix3 &a) {
+  const auto &m = a.m;
+  const double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+      - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+      + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  if (det == 0.0) {
+    throw std::runtime_error("Gamut matrix is not invertible");
+  }
+  const double invDet = 1.0 / det;
+  GamutMatrix3 r{};
+  r.m[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * invDet;
+  r.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+  r.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+  r.m[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * invDet;
+  r.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+  r.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+  r.m[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * invDet;
+  r.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+  r.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+  return r;
+}
+
+/**
+ * Linear RGB to CIE XYZ with white point normalized to Y = 1
+ */
+static GamutMatrix3 ComputeRgbToXyz(const GamutPrimaries &p) {
+  const GamutMatrix3 primaries = {{
+                                      {p.rx / p.ry, p.gx / p.gy, p.bx / p.by},
+                                      {1.0, 1.0, 1.0},
+                                      {(1.0 - p.rx - p.ry) / p.ry, (1.0 - p.gx - p.gy) / p.gy,
+                                       (1.0 - p.bx - p.by) / p.by}
+                                  }};
+  const double white[3] = {p.wx / p.wy, 1.0, (1.0 - p.wx - p.wy) / p.wy};
+  const GamutMatrix3 inverse = InvertGamutMatrix(primaries);
+  double s[3];
+  for (int i = 0; i < 3; ++i) {
+    s[i] = inverse.m[i][0] * white[0] + inverse.m[i][1] * white[1] + inverse.m[i][2] * white[2];
+  }
+  GamutMatrix3 r{};
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      r.m[i][j] = primaries.m[i][j] * s[j];
+    }
+  }
+  return r;
+}
+
+static SparkYuvTransformMatrix ToTransformMatrix(const GamutMatrix3 &m) {
+  return SparkYuvTransformMatrix{
+      .Y1 = static_cast<float>(m.m[0][0]), .Y2 = static_cast<float>(m.m[0][1]), .Y3 = static_cast<float>(m.m[0][2]),
+      .U1 = static_cast<float>(m.m[1][0]), .U2 = static_cast<float>(m.m[1][1]), .U3 = static_cast<float>(m.m[1][2]),
+      .V1 = static_cast<float>(m.m[2][0]), .V2 = static_cast<float>(m.m[2][1]), .V3 = static_cast<float>(m.m[2][2])};
+}
+
+/**
+ * Linear RGB conversion matrix from one set of primaries into another, rows are output R, G, B
+ */
+static SparkYuvTransformMatrix ComputeGamutMatrix(const GamutPrimaries &from, const GamutPrimaries &to) {
+  return ToTransformMatrix(MultiplyGamutMatrix(InvertGamutMatrix(ComputeRgbToXyz(to)), ComputeRgbToXyz(from)));
+}
+
+/**
+ * Luminance weights of primaries, second row of RGB to XYZ matrix
+ */
+static void ComputeGamutLuminance(const GamutPrimaries &p, float &kr, float &kg, float &kb) {
+  const GamutMatrix3 m = ComputeRgbToXyz(p);
+  kr = static_cast<float>(m.m[1][0]);
+  kg = static_cast<float>(m.m[1][1]);
+  kb = static_cast<float>(m.m[1][2]);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void ApplyGamutMatrix(D d, V &r, V &g, V &b, const SparkYuvTransformMatrix &m) {
+  const V nr = MulAdd(Set(d, m.Y1), r, MulAdd(Set(d, m.Y2), g, Mul(Set(d, m.Y3), b)));
+  const V ng = MulAdd(Set(d, m.U1), r, MulAdd(Set(d, m.U2), g, Mul(Set(d, m.U3), b)));
+  const V nb = MulAdd(Set(d, m.V1), r, MulAdd(Set(d, m.V2), g, Mul(Set(d, m.V3), b)));
+  r = nr;
+  g = ng;
+  b = nb;
+}
+
+SPARKYUV_INLINE static void ApplyGamutMatrix(float &r, float &g, float &b, const SparkYuvTransformMatrix &m) {
+  const float nr = m.Y1 * r + m.Y2 * g + m.Y3 * b;
+  const float ng = m.U1 * r + m.U2 * g + m.U3 * b;
+  const float nb = m.V1 * r + m.V2 * g + m.V3 * b;
+  r = nr;
+  g = ng;
+  b = nb;
+}
+
+/**
+ * Soft clipping of out of gamut colors: negative components are removed by desaturating towards
+ * luminance of the pixel instead of clipping each channel, so hue is preserved
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void DesaturateOutOfGamut(D d, V &r, V &g, V &b, const float kr, const float kg, const float kb) {
+  const auto zeros = Zero(d);
+  const V luma = MulAdd(Set(d, kr), r, MulAdd(Set(d, kg), g, Mul(Set(d, kb), b)));
+  const V minimum = Min(Min(r, g), b);
+  const auto outOfGamut = And(Lt(minimum, zeros), Gt(luma, zeros));
+  const V t = Div(luma, Max(Sub(luma, minimum), Set(d, 1e-6f)));
+  r = IfThenElse(outOfGamut, MulAdd(Sub(r, luma), t, luma), r);
+  g = IfThenElse(outOfGamut, MulAdd(Sub(g, luma), t, luma), g);
+  b = IfThenElse(outOfGamut, MulAdd(Sub(b, luma), t, luma), b);
+}
+
+SPARKYUV_INLINE static void DesaturateOutOfGamut(float &r, float &g, float &b,
+                                                 const float kr, const float kg, const float kb) {
+  const float luma = kr * r + kg * g + kb * b;
+  const float minimum = std::min(std::min(r, g), b);
+  if (minimum < 0.f && luma > 0.f) {
+    const float t = luma / std::max(luma - minimum, 1e-6f);
+    r = (r - luma) * t + luma;
+    g = (g - luma) * t + luma;
+    b = (b - luma) * t + luma;
+  }
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
@@ -0,0 +1,185 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/Gamut.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Eotf-inl.h"
+#include "TransferLut-inl.h"
+#include "TransferSurface-inl.h"
+#include "Gamut-inl.h"
+#include "concurrency.hpp"
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+template<TransferSurface Surface>
+void ConvertGamutHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                     uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                     const uint32_t width, const int bitDepth,
+                     const SparkYuvTransformMatrix matrix, const float kr, const float kb,
+                     const SparkYuvTransferFunction srcTransferFunction,
+                     const SparkYuvTransferFunction dstTransferFunction,
+                     const SparkYuvTransferAccuracy accuracy, const SparkYuvGamutClipping clipping,
+                     const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const float kg = 1.f - kr - kb;
+
+  const int maxColors = (1 << bitDepth) - 1;
+  const float scale = 1.f / static_cast<float>(maxColors);
+  const int lutDepth = Surface == TRANSFER_SURFACE_RGBAF16 ? 8 : bitDepth;
+  const TransferLut *srcLut = GetTransferLutFor(accuracy, srcTransferFunction, lutDepth);
+  const TransferLut *dstLut = GetTransferLutFor(accuracy, dstTransferFunction, lutDepth);
+  const VF zeros = Zero(df);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+      r = LinearizeVector<Surface>(df, r, srcTransferFunction, accuracy, srcLut);
+      g = LinearizeVector<Surface>(df, g, srcTransferFunction, accuracy, srcLut);
+      b = LinearizeVector<Surface>(df, b, srcTransferFunction, accuracy, srcLut);
+      ApplyGamutMatrix(df, r, g, b, matrix);
+      if (clipping == GAMUT_CLIP_DESATURATE) {
+        DesaturateOutOfGamut(df, r, g, b, kr, kg, kb);
+      }
+      r = ApplyOetf(df, Max(r, zeros), dstTransferFunction, accuracy, dstLut);
+      g = ApplyOetf(df, Max(g, zeros), dstTransferFunction, accuracy, dstLut);
+      b = ApplyOetf(df, Max(b, zeros), dstTransferFunction, accuracy, dstLut);
+      StoreTransferSurface<Surface>(df, mDst, r, g, b, a, maxColors);
+      mSrc += lanes * pixelSize;
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      r = LinearizeValue<Surface>(r, srcTransferFunction, accuracy, srcLut);
+      g = LinearizeValue<Surface>(g, srcTransferFunction, accuracy, srcLut);
+      b = LinearizeValue<Surface>(b, srcTransferFunction, accuracy, srcLut);
+      ApplyGamutMatrix(r, g, b, matrix);
+      if (clipping == GAMUT_CLIP_DESATURATE) {
+        DesaturateOutOfGamut(r, g, b, kr, kg, kb);
+      }
+      r = ApplyOetf(std::max(r, 0.f), dstTransferFunction, accuracy, dstLut);
+      g = ApplyOetf(std::max(g, 0.f), dstTransferFunction, accuracy, dstLut);
+      b = ApplyOetf(std::max(b, 0.f), dstTransferFunction, accuracy, dstLut);
+      StoreTransferPixel<Surface>(mDst, r, g, b, a, maxColors);
+      mSrc += pixelSize;
+      mDst += pixelSize;
+    }
+  }
+}
+
+#define CONVERT_GAMUT_DECLARATION_R(name, surface, storageType) \
+void ConvertGamut##name##HWY(const storageType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                             storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                             const uint32_t width, const int bitDepth,\
+                             const SparkYuvTransformMatrix matrix, const float kr, const float kb,\
+                             const SparkYuvTransferFunction srcTransferFunction,\
+                             const SparkYuvTransferFunction dstTransferFunction,\
+                             const SparkYuvTransferAccuracy accuracy, const SparkYuvGamutClipping clipping,\
+                             const uint32_t startRow, const uint32_t endRow) {\
+  ConvertGamutHWY<surface>(reinterpret_cast<const uint8_t *>(src), srcStride,\
+                           reinterpret_cast<uint8_t *>(dst), dstStride, width, bitDepth,\
+                           matrix, kr, kb, srcTransferFunction, dstTransferFunction, accuracy, clipping,\
+                           startRow, endRow);\
+}
+
+CONVERT_GAMUT_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t)
+CONVERT_GAMUT_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t)
+CONVERT_GAMUT_DECLARATION_R(RGBA1010102, TRANSFER_SURFACE_RGBA1010102, uint8_t)
+CONVERT_GAMUT_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+
+#undef CONVERT_GAMUT_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+HWY_EXPORT(ConvertGamutRGBAHWY);
+HWY_EXPORT(ConvertGamutRGBA16HWY);
+HWY_EXPORT(ConvertGamutRGBA1010102HWY);
+HWY_EXPORT(ConvertGamutRGBAF16HWY);
+
+SparkYuvTransformMatrix ComputeGamutConversionMatrix(const SparkYuvPrimaries from, const SparkYuvPrimaries to) {
+  return HWY_NAMESPACE::ComputeGamutMatrix(HWY_NAMESPACE::GetGamutPrimaries(from),
+                                           HWY_NAMESPACE::GetGamutPrimaries(to));
+}
+
+void ComputePrimariesLuminance(const SparkYuvPrimaries primaries, float &kr, float &kb) {
+  float kg;
+  HWY_NAMESPACE::ComputeGamutLuminance(HWY_NAMESPACE::GetGamutPrimaries(primaries), kr, kg, kb);
+}
+
+static void ValidateGamutConversion(const SparkYuvTransferAccuracy accuracy, const SparkYuvGamutClipping clipping,
+                                    const int depth) {
+  if (accuracy != TRANSFER_ACCURACY_EXACT && accuracy != TRANSFER_ACCURACY_FAST && accuracy != TRANSFER_ACCURACY_LUT) {
+    throw std::runtime_error("Unsupported transfer accuracy");
+  }
+  if (clipping != GAMUT_CLIP_CLAMP && clipping != GAMUT_CLIP_DESATURATE) {
+    throw std::runtime_error("Unsupported gamut clipping");
+  }
+  if (depth < 1 || depth > 16) {
+    throw std::runtime_error("Bit depth must be in range [1, 16]");
+  }
+}
+
+/**
+ * Variadic arguments carry extra public parameters with trailing comma, RGBA16 passes its bit-depth this way
+ */
+#define CONVERT_GAMUT_DECLARATION_E(name, storageType, depth, ...) \
+    void ConvertGamut##name(const storageType *src, const uint32_t srcStride,\
+                            storageType *dst, const uint32_t dstStride,\
+                            const uint32_t width, const uint32_t height, __VA_ARGS__\
+                            const SparkYuvTransformMatrix &matrix, const float kr, const float kb,\
+                            const SparkYuvTransferFunction srcTransferFunction,\
+                            const SparkYuvTransferFunction dstTransferFunction,\
+                            const SparkYuvTransferAccuracy accuracy, const SparkYuvGamutClipping clipping) {\
+      ValidateGamutConversion(accuracy, clipping, depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(ConvertGamut##name##HWY)(src, srcStride, dst, dstStride, width, depth,\
+                                                      matrix, kr, kb, srcTransferFunction, dstTransferFunction,\
+                                                      accuracy, clipping, start, end);\
+      });\
+    }
+
+CONVERT_GAMUT_DECLARATION_E(RGBA, uint8_t, 8)
+CONVERT_GAMUT_DECLARATION_E(RGBA16, uint16_t, depth, const int depth,)
+CONVERT_GAMUT_DECLARATION_E(RGBA1010102, uint8_t, 10)
+CONVERT_GAMUT_DECLARATION_E(RGBAF16, uint16_t, 16)
+
+#undef CONVERT_GAMUT_DECLARATION_E
+
+}
+#endif
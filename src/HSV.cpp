@@ -0,0 +1,607 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/HSV.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "TransferSurface-inl.h"
+#include "TypeSupport.h"
+#include "concurrency.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+enum HueModel {
+  HUE_MODEL_HSV,
+  HUE_MODEL_HSL
+};
+
+/**
+ * Packed 8-bit hue spans [0, 255] over [0, 360) degrees
+ */
+static constexpr float kHueToPacked = 255.f / 360.f;
+static constexpr float kPackedToHue = 360.f / 255.f;
+
+/**
+ * Hue in degrees [0, 360), saturation and value or lightness in [0, 1]
+ */
+template<HueModel Model, class D, typename V = Vec<D>>
+HWY_INLINE void RGBToHue(D d, V r, V g, V b, V &h, V &s, V &v) {
+  const auto zeros = Zero(d);
+  const V maximum = Max(r, Max(g, b));
+  const V minimum = Min(r, Min(g, b));
+  const V delta = Sub(maximum, minimum);
+  const auto chromatic = Gt(delta, zeros);
+  const V invDelta = IfThenElseZero(chromatic, Div(Set(d, 1.f), IfThenElse(chromatic, delta, Set(d, 1.f))));
+
+  const V hr = Mul(Sub(g, b), invDelta);
+  const V hg = MulAdd(Sub(b, r), invDelta, Set(d, 2.f));
+  const V hb = MulAdd(Sub(r, g), invDelta, Set(d, 4.f));
+  V hue = Mul(IfThenElse(Eq(maximum, r), hr, IfThenElse(Eq(maximum, g), hg, hb)), Set(d, 60.f));
+  h = IfThenElse(Lt(hue, zeros), Add(hue, Set(d, 360.f)), hue);
+
+  if (Model == HUE_MODEL_HSV) {
+    s = IfThenElseZero(Gt(maximum, zeros), Div(delta, IfThenElse(Gt(maximum, zeros), maximum, Set(d, 1.f))));
+    v = maximum;
+  } else {
+    const V lightness = Mul(Add(maximum, minimum), Set(d, 0.5f));
+    const V denominator = Sub(Set(d, 1.f), Abs(MulSub(lightness, Set(d, 2.f), Set(d, 1.f))));
+    s = IfThenElseZero(chromatic, Div(delta, Max(denominator, Set(d, 1e-6f))));
+    v = lightness;
+  }
+}
+
+template<class D, typename V = Vec<D>>
+HWY_INLINE V HueModulo(D d, V x, const float m) {
+  return NegMulAdd(Floor(Mul(x, Set(d, 1.f / m))), Set(d, m), x);
+}
+
+/**
+ * Branchless sector evaluation, hue outside of [0, 360) is wrapped
+ */
+template<HueModel Model, class D, typename V = Vec<D>>
+HWY_INLINE void HueToRGB(D d, V h, V s, V v, V &r, V &g, V &b) {
+  const auto zeros = Zero(d);
+  const auto ones = Set(d, 1.f);
+  if (Model == HUE_MODEL_HSV) {
+    const V sector = Mul(h, Set(d, 1.f / 60.f));
+    const V chroma = Mul(v, s);
+    const V kr = HueModulo(d, Add(sector, Set(d, 5.f)), 6.f);
+    const V kg = HueModulo(d, Add(sector, Set(d, 3.f)), 6.f);
+    const V kb = HueModulo(d, Add(sector, ones), 6.f);
+    const V four = Set(d, 4.f);
+    r = NegMulAdd(chroma, Clamp(Min(kr, Sub(four, kr)), zeros, ones), v);
+    g = NegMulAdd(chroma, Clamp(Min(kg, Sub(four, kg)), zeros, ones), v);
+    b = NegMulAdd(chroma, Clamp(Min(kb, Sub(four, kb)), zeros, ones), v);
+  } else {
+    const V sector = Mul(h, Set(d, 1.f / 30.f));
+    const V chroma = Mul(s, Min(v, Sub(ones, v)));
+    const V kr = HueModulo(d, sector, 12.f);
+    const V kg = HueModulo(d, Add(sector, Set(d, 8.f)), 12.f);
+    const V kb = HueModulo(d, Add(sector, Set(d, 4.f)), 12.f);
+    const V three = Set(d, 3.f);
+    const V nine = Set(d, 9.f);
+    const V minusOnes = Set(d, -1.f);
+    r = NegMulAdd(chroma, Clamp(Min(Sub(kr, three), Sub(nine, kr)), minusOnes, ones), v);
+    g = NegMulAdd(chroma, Clamp(Min(Sub(kg, three), Sub(nine, kg)), minusOnes, ones), v);
+    b = NegMulAdd(chroma, Clamp(Min(Sub(kb, three), Sub(nine, kb)), minusOnes, ones), v);
+  }
+}
+
+template<HueModel Model>
+SPARKYUV_INLINE static void RGBToHue(const float r, const float g, const float b, float &h, float &s, float &v) {
+  const float maximum = std::max(r, std::max(g, b));
+  const float minimum = std::min(r, std::min(g, b));
+  const float delta = maximum - minimum;
+  float hue = 0.f;
+  if (delta > 0.f) {
+    if (maximum == r) {
+      hue = (g - b) / delta;
+    } else if (maximum == g) {
+      hue = (b - r) / delta + 2.f;
+    } else {
+      hue = (r - g) / delta + 4.f;
+    }
+    hue *= 60.f;
+    if (hue < 0.f) {
+      hue += 360.f;
+    }
+  }
+  h = hue;
+  if (Model == HUE_MODEL_HSV) {
+    s = maximum > 0.f ? delta / maximum : 0.f;
+    v = maximum;
+  } else {
+    const float lightness = (maximum + minimum) * 0.5f;
+    s = delta > 0.f ? delta / std::max(1.f - std::abs(lightness * 2.f - 1.f), 1e-6f) : 0.f;
+    v = lightness;
+  }
+}
+
+SPARKYUV_INLINE static float HueModulo(const float x, const float m) {
+  return x - std::floor(x / m) * m;
+}
+
+template<HueModel Model>
+SPARKYUV_INLINE static void HueToRGB(const float h, const float s, const float v, float &r, float &g, float &b) {
+  if (Model == HUE_MODEL_HSV) {
+    const float sector = h * (1.f / 60.f);
+    const float chroma = v * s;
+    auto channel = [&](const float n) -> float {
+      const float k = HueModulo(sector + n, 6.f);
+      return v - chroma * std::clamp(std::min(k, 4.f - k), 0.f, 1.f);
+    };
+    r = channel(5.f);
+    g = channel(3.f);
+    b = channel(1.f);
+  } else {
+    const float sector = h * (1.f / 30.f);
+    const float chroma = s * std::min(v, 1.f - v);
+    auto channel = [&](const float n) -> float {
+      const float k = HueModulo(sector + n, 12.f);
+      return v - chroma * std::clamp(std::min(k - 3.f, 9.f - k), -1.f, 1.f);
+    };
+    r = channel(0.f);
+    g = channel(8.f);
+    b = channel(4.f);
+  }
+}
+
+// Planar F32 and F16 components, packed 8-bit stores H, S, V and alpha interleaved
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreHue(DF df, VF h, VF s, VF v, VF a, float *SPARKYUV_RESTRICT c0, float *SPARKYUV_RESTRICT c1,
+                         float *SPARKYUV_RESTRICT c2, const uint32_t x) {
+  (void) a;
+  StoreU(h, df, c0 + x);
+  StoreU(s, df, c1 + x);
+  StoreU(v, df, c2 + x);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreHue(DF df, VF h, VF s, VF v, VF a, hwy::float16_t *SPARKYUV_RESTRICT c0,
+                         hwy::float16_t *SPARKYUV_RESTRICT c1, hwy::float16_t *SPARKYUV_RESTRICT c2,
+                         const uint32_t x) {
+  (void) a;
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  StoreU(BitCast(du16, DemoteTo(df16, h)), du16, reinterpret_cast<uint16_t *>(c0 + x));
+  StoreU(BitCast(du16, DemoteTo(df16, s)), du16, reinterpret_cast<uint16_t *>(c1 + x));
+  StoreU(BitCast(du16, DemoteTo(df16, v)), du16, reinterpret_cast<uint16_t *>(c2 + x));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreHue(DF df, VF h, VF s, VF v, VF a, uint8_t *SPARKYUV_RESTRICT c0, uint8_t *, uint8_t *,
+                         const uint32_t x) {
+  const Rebind<uint8_t, decltype(df)> du8;
+  const auto vScale = Set(df, 255.f);
+  StoreInterleaved4(DemoteTo(du8, NearestInt(Mul(h, Set(df, kHueToPacked)))),
+                    DemoteTo(du8, NearestInt(Mul(s, vScale))),
+                    DemoteTo(du8, NearestInt(Mul(v, vScale))),
+                    DemoteTo(du8, NearestInt(Mul(a, vScale))), du8, c0 + x * 4);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadHue(DF df, const float *SPARKYUV_RESTRICT c0, const float *SPARKYUV_RESTRICT c1,
+                        const float *SPARKYUV_RESTRICT c2, const uint32_t x, VF &h, VF &s, VF &v, VF &a) {
+  h = LoadU(df, c0 + x);
+  s = LoadU(df, c1 + x);
+  v = LoadU(df, c2 + x);
+  a = Set(df, 1.f);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadHue(DF df, const hwy::float16_t *SPARKYUV_RESTRICT c0, const hwy::float16_t *SPARKYUV_RESTRICT c1,
+                        const hwy::float16_t *SPARKYUV_RESTRICT c2, const uint32_t x, VF &h, VF &s, VF &v, VF &a) {
+  const Rebind<uint16_t, decltype(df)> du16;
+  const Rebind<hwy::float16_t, decltype(df)> df16;
+  h = PromoteTo(df, BitCast(df16, LoadU(du16, reinterpret_cast<const uint16_t *>(c0 + x))));
+  s = PromoteTo(df, BitCast(df16, LoadU(du16, reinterpret_cast<const uint16_t *>(c1 + x))));
+  v = PromoteTo(df, BitCast(df16, LoadU(du16, reinterpret_cast<const uint16_t *>(c2 + x))));
+  a = Set(df, 1.f);
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadHue(DF df, const uint8_t *SPARKYUV_RESTRICT c0, const uint8_t *, const uint8_t *,
+                        const uint32_t x, VF &h, VF &s, VF &v, VF &a) {
+  const Rebind<uint8_t, decltype(df)> du8;
+  const RebindToSigned<decltype(df)> di32;
+  const auto vScale = Set(df, 1.f / 255.f);
+  Vec<decltype(du8)> h8, s8, v8, a8;
+  LoadInterleaved4(du8, c0 + x * 4, h8, s8, v8, a8);
+  h = Mul(ConvertTo(df, PromoteTo(di32, h8)), Set(df, kPackedToHue));
+  s = Mul(ConvertTo(df, PromoteTo(di32, s8)), vScale);
+  v = Mul(ConvertTo(df, PromoteTo(di32, v8)), vScale);
+  a = Mul(ConvertTo(df, PromoteTo(di32, a8)), vScale);
+}
+
+template<typename L>
+SPARKYUV_INLINE static void StoreHuePixel(const float h, const float s, const float v, const float,
+                                          L *c0, L *c1, L *c2, const uint32_t x) {
+  StoreFloat(c0 + x, h);
+  StoreFloat(c1 + x, s);
+  StoreFloat(c2 + x, v);
+}
+
+SPARKYUV_INLINE static void StoreHuePixel(const float h, const float s, const float v, const float a,
+                                          uint8_t *c0, uint8_t *, uint8_t *, const uint32_t x) {
+  auto quantize = [](const float value, const float scale) -> uint8_t {
+    return static_cast<uint8_t>(std::clamp(::roundf(value * scale), 0.f, 255.f));
+  };
+  c0[x * 4] = quantize(h, kHueToPacked);
+  c0[x * 4 + 1] = quantize(s, 255.f);
+  c0[x * 4 + 2] = quantize(v, 255.f);
+  c0[x * 4 + 3] = quantize(a, 255.f);
+}
+
+template<typename L>
+SPARKYUV_INLINE static void LoadHuePixel(const L *c0, const L *c1, const L *c2, const uint32_t x,
+                                         float &h, float &s, float &v, float &a) {
+  h = LoadFloat(c0 + x);
+  s = LoadFloat(c1 + x);
+  v = LoadFloat(c2 + x);
+  a = 1.f;
+}
+
+SPARKYUV_INLINE static void LoadHuePixel(const uint8_t *c0, const uint8_t *, const uint8_t *, const uint32_t x,
+                                         float &h, float &s, float &v, float &a) {
+  h = static_cast<float>(c0[x * 4]) * kPackedToHue;
+  s = static_cast<float>(c0[x * 4 + 1]) * (1.f / 255.f);
+  v = static_cast<float>(c0[x * 4 + 2]) * (1.f / 255.f);
+  a = static_cast<float>(c0[x * 4 + 3]) * (1.f / 255.f);
+}
+
+template<typename L>
+SPARKYUV_INLINE static L *HueRow(L *plane, const uint32_t stride, const uint32_t y) {
+  if (plane == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<L *>(reinterpret_cast<uint8_t *>(plane) + static_cast<size_t>(y) * stride);
+}
+
+template<typename L>
+SPARKYUV_INLINE static const L *HueRow(const L *plane, const uint32_t stride, const uint32_t y) {
+  if (plane == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<const L *>(reinterpret_cast<const uint8_t *>(plane) + static_cast<size_t>(y) * stride);
+}
+
+/**
+ * Packed destinations use only `c0`
+ */
+template<TransferSurface Surface, HueModel Model, typename L>
+void RGBAToHueHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                  L *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,
+                  L *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,
+                  L *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,
+                  const uint32_t width, const int bitDepth,
+                  const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const float scale = 1.f / static_cast<float>((1 << bitDepth) - 1);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    L *d0 = HueRow(c0, c0Stride, y);
+    L *d1 = HueRow(c1, c1Stride, y);
+    L *d2 = HueRow(c2, c2Stride, y);
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a, h, s, v;
+      LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+      RGBToHue<Model>(df, r, g, b, h, s, v);
+      StoreHue(df, h, s, v, a, d0, d1, d2, x);
+      mSrc += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a, h, s, v;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      RGBToHue<Model>(r, g, b, h, s, v);
+      StoreHuePixel(h, s, v, a, d0, d1, d2, x);
+      mSrc += pixelSize;
+    }
+  }
+}
+
+/**
+ * Packed sources use only `c0`, alpha of planar sources is opaque
+ */
+template<TransferSurface Surface, HueModel Model, typename L>
+void HueToRGBAHWY(const L *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,
+                  const L *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,
+                  const L *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,
+                  uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                  const uint32_t width, const int bitDepth,
+                  const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const int maxColors = (1 << bitDepth) - 1;
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    const L *s0 = HueRow(c0, c0Stride, y);
+    const L *s1 = HueRow(c1, c1Stride, y);
+    const L *s2 = HueRow(c2, c2Stride, y);
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a, h, s, v;
+      LoadHue(df, s0, s1, s2, x, h, s, v, a);
+      HueToRGB<Model>(df, h, s, v, r, g, b);
+      StoreTransferSurface<Surface>(df, mDst, r, g, b, a, maxColors);
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a, h, s, v;
+      LoadHuePixel(s0, s1, s2, x, h, s, v, a);
+      HueToRGB<Model>(h, s, v, r, g, b);
+      StoreTransferPixel<Surface>(mDst, r, g, b, a, maxColors);
+      mDst += pixelSize;
+    }
+  }
+}
+
+/**
+ * Hue is rotated by `hueShift` degrees, saturation and value or lightness are scaled and clamped,
+ * intermediate components never leave registers. Source and destination may be the same image.
+ */
+template<TransferSurface Surface, HueModel Model>
+void AdjustHueHWY(const uint8_t *src, const uint32_t srcStride,
+                  uint8_t *dst, const uint32_t dstStride,
+                  const uint32_t width, const int bitDepth,
+                  const float hueShift, const float saturation, const float value,
+                  const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const int maxColors = (1 << bitDepth) - 1;
+  const float scale = 1.f / static_cast<float>(maxColors);
+
+  const VF vHueShift = Set(df, hueShift);
+  const VF vSaturation = Set(df, saturation);
+  const VF vValue = Set(df, value);
+  const VF zeros = Zero(df);
+  const VF ones = Set(df, 1.f);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a, h, s, v;
+      LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+      RGBToHue<Model>(df, r, g, b, h, s, v);
+      h = Add(h, vHueShift);
+      s = Clamp(Mul(s, vSaturation), zeros, ones);
+      v = Clamp(Mul(v, vValue), zeros, ones);
+      HueToRGB<Model>(df, h, s, v, r, g, b);
+      StoreTransferSurface<Surface>(df, mDst, r, g, b, a, maxColors);
+      mSrc += lanes * pixelSize;
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a, h, s, v;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      RGBToHue<Model>(r, g, b, h, s, v);
+      h += hueShift;
+      s = std::clamp(s * saturation, 0.f, 1.f);
+      v = std::clamp(v * value, 0.f, 1.f);
+      HueToRGB<Model>(h, s, v, r, g, b);
+      StoreTransferPixel<Surface>(mDst, r, g, b, a, maxColors);
+      mSrc += pixelSize;
+      mDst += pixelSize;
+    }
+  }
+}
+
+#define HUE_FORWARD_DECLARATION_R(srcName, surface, srcType, modelName, model, dstName, dstType, hueType) \
+void srcName##To##modelName##dstName##HWY(const srcType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                          dstType *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,\
+                                          dstType *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,\
+                                          dstType *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,\
+                                          const uint32_t width, const int bitDepth,\
+                                          const uint32_t startRow, const uint32_t endRow) {\
+  RGBAToHueHWY<surface, model, hueType>(reinterpret_cast<const uint8_t *>(src), srcStride,\
+                                        reinterpret_cast<hueType *>(c0), c0Stride,\
+                                        reinterpret_cast<hueType *>(c1), c1Stride,\
+                                        reinterpret_cast<hueType *>(c2), c2Stride,\
+                                        width, bitDepth, startRow, endRow);\
+}
+
+#define HUE_INVERSE_DECLARATION_R(modelName, model, srcName, srcType, hueType, dstName, surface, dstType) \
+void modelName##srcName##To##dstName##HWY(const srcType *SPARKYUV_RESTRICT c0, const uint32_t c0Stride,\
+                                          const srcType *SPARKYUV_RESTRICT c1, const uint32_t c1Stride,\
+                                          const srcType *SPARKYUV_RESTRICT c2, const uint32_t c2Stride,\
+                                          dstType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                          const uint32_t width, const int bitDepth,\
+                                          const uint32_t startRow, const uint32_t endRow) {\
+  HueToRGBAHWY<surface, model, hueType>(reinterpret_cast<const hueType *>(c0), c0Stride,\
+                                        reinterpret_cast<const hueType *>(c1), c1Stride,\
+                                        reinterpret_cast<const hueType *>(c2), c2Stride,\
+                                        reinterpret_cast<uint8_t *>(dst), dstStride,\
+                                        width, bitDepth, startRow, endRow);\
+}
+
+#define HUE_ADJUST_DECLARATION_R(modelName, model, name, surface, storageType) \
+void Adjust##modelName##name##HWY(const storageType *src, const uint32_t srcStride,\
+                                  storageType *dst, const uint32_t dstStride,\
+                                  const uint32_t width, const int bitDepth,\
+                                  const float hueShift, const float saturation, const float value,\
+                                  const uint32_t startRow, const uint32_t endRow) {\
+  AdjustHueHWY<surface, model>(reinterpret_cast<const uint8_t *>(src), srcStride,\
+                               reinterpret_cast<uint8_t *>(dst), dstStride, width, bitDepth,\
+                               hueShift, saturation, value, startRow, endRow);\
+}
+
+#define HUE_DECLARATION_R(name, surface, storageType, modelName, model) \
+        HUE_FORWARD_DECLARATION_R(name, surface, storageType, modelName, model, PlanarF32, float, float) \
+        HUE_FORWARD_DECLARATION_R(name, surface, storageType, modelName, model, PlanarF16, uint16_t, hwy::float16_t) \
+        HUE_INVERSE_DECLARATION_R(modelName, model, PlanarF32, float, float, name, surface, storageType) \
+        HUE_INVERSE_DECLARATION_R(modelName, model, PlanarF16, uint16_t, hwy::float16_t, name, surface, storageType) \
+        HUE_ADJUST_DECLARATION_R(modelName, model, name, surface, storageType)
+
+HUE_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t, HSV, HUE_MODEL_HSV)
+HUE_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t, HSL, HUE_MODEL_HSL)
+HUE_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t, HSV, HUE_MODEL_HSV)
+HUE_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t, HSL, HUE_MODEL_HSL)
+
+HUE_FORWARD_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t, HSV, HUE_MODEL_HSV, A, uint8_t, uint8_t)
+HUE_FORWARD_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t, HSL, HUE_MODEL_HSL, A, uint8_t, uint8_t)
+HUE_INVERSE_DECLARATION_R(HSV, HUE_MODEL_HSV, A, uint8_t, uint8_t, RGBA, TRANSFER_SURFACE_RGBA8, uint8_t)
+HUE_INVERSE_DECLARATION_R(HSL, HUE_MODEL_HSL, A, uint8_t, uint8_t, RGBA, TRANSFER_SURFACE_RGBA8, uint8_t)
+
+#undef HUE_DECLARATION_R
+#undef HUE_ADJUST_DECLARATION_R
+#undef HUE_INVERSE_DECLARATION_R
+#undef HUE_FORWARD_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+#define HUE_DECLARATION_HWY(name, modelName) \
+        HWY_EXPORT(name##To##modelName##PlanarF32HWY); \
+        HWY_EXPORT(name##To##modelName##PlanarF16HWY); \
+        HWY_EXPORT(modelName##PlanarF32To##name##HWY); \
+        HWY_EXPORT(modelName##PlanarF16To##name##HWY); \
+        HWY_EXPORT(Adjust##modelName##name##HWY);
+
+HUE_DECLARATION_HWY(RGBA, HSV)
+HUE_DECLARATION_HWY(RGBA, HSL)
+HUE_DECLARATION_HWY(RGBA16, HSV)
+HUE_DECLARATION_HWY(RGBA16, HSL)
+
+#undef HUE_DECLARATION_HWY
+
+HWY_EXPORT(RGBAToHSVAHWY);
+HWY_EXPORT(RGBAToHSLAHWY);
+HWY_EXPORT(HSVAToRGBAHWY);
+HWY_EXPORT(HSLAToRGBAHWY);
+
+static void ValidateHueDepth(const int depth) {
+  if (depth < 1 || depth > 16) {
+    throw std::runtime_error("Bit depth must be in range [1, 16]");
+  }
+}
+
+/**
+ * Variadic arguments carry extra public parameters with leading comma, RGBA16 passes its bit-depth this way
+ */
+#define HUE_FORWARD_DECLARATION_E(srcName, srcType, modelName, dstName, dstType, depth, ...) \
+    void srcName##To##modelName##dstName(const srcType *src, const uint32_t srcStride,\
+                                         dstType *h, const uint32_t hStride, dstType *s, const uint32_t sStride,\
+                                         dstType *v, const uint32_t vStride,\
+                                         const uint32_t width, const uint32_t height __VA_ARGS__) {\
+      ValidateHueDepth(depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(srcName##To##modelName##dstName##HWY)(src, srcStride, h, hStride, s, sStride,\
+                                                                   v, vStride, width, depth, start, end);\
+      });\
+    }
+
+#define HUE_INVERSE_DECLARATION_E(modelName, srcName, srcType, dstName, dstType, depth, ...) \
+    void modelName##srcName##To##dstName(const srcType *h, const uint32_t hStride,\
+                                         const srcType *s, const uint32_t sStride,\
+                                         const srcType *v, const uint32_t vStride,\
+                                         dstType *dst, const uint32_t dstStride,\
+                                         const uint32_t width, const uint32_t height __VA_ARGS__) {\
+      ValidateHueDepth(depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(modelName##srcName##To##dstName##HWY)(h, hStride, s, sStride, v, vStride,\
+                                                                   dst, dstStride, width, depth, start, end);\
+      });\
+    }
+
+#define HUE_ADJUST_DECLARATION_E(modelName, name, storageType, depth, ...) \
+    void Adjust##modelName##name(const storageType *src, const uint32_t srcStride,\
+                                 storageType *dst, const uint32_t dstStride,\
+                                 const uint32_t width, const uint32_t height __VA_ARGS__,\
+                                 const float hueShift, const float saturation, const float value) {\
+      ValidateHueDepth(depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(Adjust##modelName##name##HWY)(src, srcStride, dst, dstStride, width, depth,\
+                                                           hueShift, saturation, value, start, end);\
+      });\
+    }
+
+#define HUE_DECLARATION_E(name, storageType, modelName, depth, ...) \
+        HUE_FORWARD_DECLARATION_E(name, storageType, modelName, PlanarF32, float, depth, __VA_ARGS__) \
+        HUE_FORWARD_DECLARATION_E(name, storageType, modelName, PlanarF16, uint16_t, depth, __VA_ARGS__) \
+        HUE_INVERSE_DECLARATION_E(modelName, PlanarF32, float, name, storageType, depth, __VA_ARGS__) \
+        HUE_INVERSE_DECLARATION_E(modelName, PlanarF16, uint16_t, name, storageType, depth, __VA_ARGS__) \
+        HUE_ADJUST_DECLARATION_E(modelName, name, storageType, depth, __VA_ARGS__)
+
+HUE_DECLARATION_E(RGBA, uint8_t, HSV, 8)
+HUE_DECLARATION_E(RGBA, uint8_t, HSL, 8)
+HUE_DECLARATION_E(RGBA16, uint16_t, HSV, depth, , const int depth)
+HUE_DECLARATION_E(RGBA16, uint16_t, HSL, depth, , const int depth)
+
+#define HUE_PACKED_DECLARATION_E(modelName) \
+    void RGBATo##modelName##A(const uint8_t *src, const uint32_t srcStride,\
+                              uint8_t *dst, const uint32_t dstStride, const uint32_t width, const uint32_t height) {\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(RGBATo##modelName##AHWY)(src, srcStride, dst, dstStride, nullptr, 0, nullptr, 0,\
+                                                      width, 8, start, end);\
+      });\
+    }\
+    void modelName##AToRGBA(const uint8_t *src, const uint32_t srcStride,\
+                            uint8_t *dst, const uint32_t dstStride, const uint32_t width, const uint32_t height) {\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(modelName##AToRGBAHWY)(src, srcStride, nullptr, 0, nullptr, 0, dst, dstStride,\
+                                                    width, 8, start, end);\
+      });\
+    }
+
+HUE_PACKED_DECLARATION_E(HSV)
+HUE_PACKED_DECLARATION_E(HSL)
+
+#undef HUE_PACKED_DECLARATION_E
+#undef HUE_DECLARATION_E
+#undef HUE_ADJUST_DECLARATION_E
+#undef HUE_INVERSE_DECLARATION_E
+#undef HUE_FORWARD_DECLARATION_E
+
+}
+#endif
@@ -0,0 +1,152 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_LETTERBOX_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_LETTERBOX_INL_H
+#undef SPARKYUV_LETTERBOX_INL_H
+#else
+#define SPARKYUV_LETTERBOX_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "hwy/cache_control.h"
+#include "yuv-inl.h"
+#include "sparkyuv-def.h"
+#include "sparkyuv-internal.h"
+#include <algorithm>
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+static void ValidateLetterbox(const uint32_t dstWidth, const uint32_t dstHeight,
+                              const uint32_t contentX, const uint32_t contentY,
+                              const uint32_t contentWidth, const uint32_t contentHeight) {
+  if (contentWidth == 0 || contentHeight == 0) {
+    throw std::runtime_error("Letterbox content size must not be zero");
+  }
+  if (contentX >= dstWidth || contentY >= dstHeight
+      || contentWidth > dstWidth - contentX || contentHeight > dstHeight - contentY) {
+    throw std::runtime_error("Letterbox content must lie inside of the destination image");
+  }
+}
+
+/**
+ * Fills `pixels` with repeated `components` bytes of `color`.
+ * When `stream` is set aligned part of the row is written with non-temporal stores, border rows are
+ * never read back by the converter so there is no point to bring them into the cache
+ */
+template<bool stream>
+SPARKYUV_INLINE static void FillRow8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t pixels,
+                                     const uint8_t *SPARKYUV_RESTRICT color, const int components) {
+  const ScalableTag<uint8_t> du8;
+  const uint32_t lanes = Lanes(du8);
+  const uint32_t length = pixels * components;
+
+  // Pattern long enough to load a vector of any phase
+  HWY_ALIGN uint8_t pattern[HWY_MAX_BYTES + 4];
+  for (uint32_t i = 0; i < lanes + components; ++i) {
+    pattern[i] = color[i % components];
+  }
+
+  uint32_t x = 0;
+  if (stream) {
+    const auto address = reinterpret_cast<uintptr_t>(dst);
+    const uint32_t bytes = lanes * sizeof(uint8_t);
+    const uint32_t head = std::min(length, static_cast<uint32_t>((bytes - address % bytes) % bytes));
+    for (; x < head; ++x) {
+      dst[x] = color[x % components];
+    }
+    for (; x + lanes <= length; x += lanes) {
+      Stream(LoadU(du8, pattern + x % components), du8, dst + x);
+    }
+  } else {
+    for (; x + lanes <= length; x += lanes) {
+      StoreU(LoadU(du8, pattern + x % components), du8, dst + x);
+    }
+  }
+
+  for (; x < length; ++x) {
+    dst[x] = color[x % components];
+  }
+}
+
+/**
+ * Writes border rows above and below of the content with non-temporal stores
+ */
+static void FillLetterboxRows8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                               const uint32_t dstWidth, const uint32_t dstHeight,
+                               const uint32_t contentY, const uint32_t contentHeight,
+                               const uint8_t *SPARKYUV_RESTRICT color, const int components) {
+  auto mDst = reinterpret_cast<uint8_t *>(dst);
+  for (uint32_t y = 0; y < dstHeight; ++y) {
+    if (y == contentY) {
+      y += contentHeight - 1;
+      continue;
+    }
+    FillRow8<true>(mDst + static_cast<size_t>(y) * dstStride, dstWidth, color, components);
+  }
+  hwy::FlushStream();
+}
+
+/**
+ * Writes left and right margins of the content rows in [startRow, endRow), they share cache lines with the
+ * content, so regular stores are used
+ */
+static void FillLetterboxMargins8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                                  const uint32_t dstWidth,
+                                  const uint32_t contentX, const uint32_t contentWidth,
+                                  const uint32_t startRow, const uint32_t endRow,
+                                  const uint8_t *SPARKYUV_RESTRICT color, const int components) {
+  const uint32_t rightStart = contentX + contentWidth;
+  if (contentX == 0 && rightStart == dstWidth) {
+    return;
+  }
+  auto mDst = reinterpret_cast<uint8_t *>(dst);
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    uint8_t *row = mDst + static_cast<size_t>(y) * dstStride;
+    FillRow8<false>(row, contentX, color, components);
+    FillRow8<false>(row + rightStart * components, dstWidth - rightStart, color, components);
+  }
+}
+
+/**
+ * Orders RGBA border color into storage layout of the pixel type
+ */
+template<SparkYuvDefaultPixelType PixelType>
+SPARKYUV_INLINE static void LetterboxPixelColor(const SparkYuvColor color, uint8_t *SPARKYUV_RESTRICT storage) {
+  switch (PixelType) {
+    case PIXEL_RGBA: storage[0] = color.r, storage[1] = color.g, storage[2] = color.b, storage[3] = color.a;
+      break;
+    case PIXEL_RGB: storage[0] = color.r, storage[1] = color.g, storage[2] = color.b;
+      break;
+    case PIXEL_BGRA: storage[0] = color.b, storage[1] = color.g, storage[2] = color.r, storage[3] = color.a;
+      break;
+    case PIXEL_BGR: storage[0] = color.b, storage[1] = color.g, storage[2] = color.r;
+      break;
+    case PIXEL_ARGB: storage[0] = color.a, storage[1] = color.r, storage[2] = color.g, storage[3] = color.b;
+      break;
+    case PIXEL_ABGR: storage[0] = color.a, storage[1] = color.b, storage[2] = color.g, storage[3] = color.r;
+      break;
+  }
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
@@ -0,0 +1,219 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_LUT3D_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_LUT3D_INL_H
+#undef SPARKYUV_LUT3D_INL_H
+#else
+#define SPARKYUV_LUT3D_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "sparkyuv-lut.h"
+#include <algorithm>
+#include <cmath>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+/**
+ * Lattice addressing of packed LUT, strides are in floats.
+ * Lattice position of value is v * scale + offset, clamped into [0, size - 1]
+ */
+struct Lut3DSampler {
+  const float *table;
+  int32_t maxIndex;
+  int32_t strideR, strideG, strideB;
+  float maxPosition;
+  float scale[3];
+  float offset[3];
+  SparkYuvLutInterpolation interpolation;
+};
+
+static Lut3DSampler MakeLut3DSampler(const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation) {
+  Lut3DSampler sampler{};
+  const auto size = static_cast<int32_t>(lut.size);
+  sampler.table = lut.table.data();
+  sampler.maxIndex = size - 2;
+  sampler.strideR = 4;
+  sampler.strideG = 4 * size;
+  sampler.strideB = 4 * size * size;
+  sampler.maxPosition = static_cast<float>(size - 1);
+  for (int i = 0; i < 3; ++i) {
+    sampler.scale[i] = sampler.maxPosition / (lut.domainMax[i] - lut.domainMin[i]);
+    sampler.offset[i] = -lut.domainMin[i] * sampler.scale[i];
+  }
+  sampler.interpolation = interpolation;
+  return sampler;
+}
+
+template<class DF, typename VF = Vec<DF>, typename VI = Vec<RebindToSigned<DF>>>
+HWY_INLINE void Lut3DPosition(DF df, VF v, const float scale, const float offset,
+                              const Lut3DSampler &sampler, VI &index, VF &fraction) {
+  const RebindToSigned<decltype(df)> di32;
+  VF position = MulAdd(v, Set(df, scale), Set(df, offset));
+  // NaN and negatives goes to the first lattice point
+  position = Min(IfThenElseZero(Gt(position, Zero(df)), position), Set(df, sampler.maxPosition));
+  index = Min(ConvertTo(di32, position), Set(di32, sampler.maxIndex));
+  fraction = Sub(position, ConvertTo(df, index));
+}
+
+template<class DF, typename VF = Vec<DF>, typename VI = Vec<RebindToSigned<DF>>>
+HWY_INLINE void Lut3DGather(DF df, const float *SPARKYUV_RESTRICT table, VI offset, VF &r, VF &g, VF &b) {
+  r = GatherIndex(df, table, offset);
+  g = GatherIndex(df, table + 1, offset);
+  b = GatherIndex(df, table + 2, offset);
+}
+
+/**
+ * Samples LUT in place, values are expected in LUT domain
+ */
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void SampleLut3D(DF df, const Lut3DSampler &sampler, VF &r, VF &g, VF &b) {
+  const RebindToSigned<decltype(df)> di32;
+  using VI = Vec<decltype(di32)>;
+  VI ir, ig, ib;
+  VF fr, fg, fb;
+  Lut3DPosition(df, r, sampler.scale[0], sampler.offset[0], sampler, ir, fr);
+  Lut3DPosition(df, g, sampler.scale[1], sampler.offset[1], sampler, ig, fg);
+  Lut3DPosition(df, b, sampler.scale[2], sampler.offset[2], sampler, ib, fb);
+
+  const VI sR = Set(di32, sampler.strideR);
+  const VI sG = Set(di32, sampler.strideG);
+  const VI sB = Set(di32, sampler.strideB);
+  const VI base = Add(Mul(ir, sR), Add(Mul(ig, sG), Mul(ib, sB)));
+  const float *table = sampler.table;
+
+  if (sampler.interpolation == LUT_INTERPOLATION_TETRAHEDRAL) {
+    // Tetrahedron is picked by ordering of fractions, walk goes from c000 to c111
+    // along the axis with the largest fraction first and the smallest last
+    const auto rIsMax = RebindMask(di32, And(Ge(fr, fg), Ge(fr, fb)));
+    const auto gIsMax = AndNot(rIsMax, RebindMask(di32, Ge(fg, fb)));
+    const VI offsetMax = IfThenElse(rIsMax, sR, IfThenElse(gIsMax, sG, sB));
+    const VI offsetMinIfRMax = IfThenElse(RebindMask(di32, Ge(fg, fb)), sB, sG);
+    const VI offsetMinIfGMax = IfThenElse(RebindMask(di32, Ge(fr, fb)), sB, sR);
+    const VI offsetMinIfBMax = IfThenElse(RebindMask(di32, Ge(fr, fg)), sG, sR);
+    const VI offsetMin = IfThenElse(rIsMax, offsetMinIfRMax, IfThenElse(gIsMax, offsetMinIfGMax, offsetMinIfBMax));
+    const VI sAll = Add(sR, Add(sG, sB));
+
+    const VF wMax = Max(fr, Max(fg, fb));
+    const VF wMin = Min(fr, Min(fg, fb));
+    const VF wMid = Sub(Add(fr, Add(fg, fb)), Add(wMax, wMin));
+
+    VF r0, g0, b0, r1, g1, b1, r2, g2, b2, r3, g3, b3;
+    Lut3DGather(df, table, base, r0, g0, b0);
+    Lut3DGather(df, table, Add(base, offsetMax), r1, g1, b1);
+    Lut3DGather(df, table, Sub(Add(base, sAll), offsetMin), r2, g2, b2);
+    Lut3DGather(df, table, Add(base, sAll), r3, g3, b3);
+
+    const VF w0 = Sub(Set(df, 1.f), wMax);
+    const VF w1 = Sub(wMax, wMid);
+    const VF w2 = Sub(wMid, wMin);
+    r = MulAdd(r0, w0, MulAdd(r1, w1, MulAdd(r2, w2, Mul(r3, wMin))));
+    g = MulAdd(g0, w0, MulAdd(g1, w1, MulAdd(g2, w2, Mul(g3, wMin))));
+    b = MulAdd(b0, w0, MulAdd(b1, w1, MulAdd(b2, w2, Mul(b3, wMin))));
+    return;
+  }
+
+  // Trilinear: interpolate along red on four edges, then green, then blue
+  VF rc[4], gc[4], bc[4];
+  const VI edges[4] = {base, Add(base, sG), Add(base, sB), Add(base, Add(sG, sB))};
+  for (int i = 0; i < 4; ++i) {
+    VF rl, gl, bl, rh, gh, bh;
+    Lut3DGather(df, table, edges[i], rl, gl, bl);
+    Lut3DGather(df, table, Add(edges[i], sR), rh, gh, bh);
+    rc[i] = MulAdd(Sub(rh, rl), fr, rl);
+    gc[i] = MulAdd(Sub(gh, gl), fr, gl);
+    bc[i] = MulAdd(Sub(bh, bl), fr, bl);
+  }
+  const VF r0 = MulAdd(Sub(rc[1], rc[0]), fg, rc[0]);
+  const VF g0 = MulAdd(Sub(gc[1], gc[0]), fg, gc[0]);
+  const VF b0 = MulAdd(Sub(bc[1], bc[0]), fg, bc[0]);
+  const VF r1 = MulAdd(Sub(rc[3], rc[2]), fg, rc[2]);
+  const VF g1 = MulAdd(Sub(gc[3], gc[2]), fg, gc[2]);
+  const VF b1 = MulAdd(Sub(bc[3], bc[2]), fg, bc[2]);
+  r = MulAdd(Sub(r1, r0), fb, r0);
+  g = MulAdd(Sub(g1, g0), fb, g0);
+  b = MulAdd(Sub(b1, b0), fb, b0);
+}
+
+SPARKYUV_INLINE static void Lut3DPosition(const float v, const float scale, const float offset,
+                                          const Lut3DSampler &sampler, int32_t &index, float &fraction) {
+  float position = v * scale + offset;
+  if (!(position > 0.f)) {
+    position = 0.f;
+  }
+  position = std::min(position, sampler.maxPosition);
+  index = std::min(static_cast<int32_t>(position), sampler.maxIndex);
+  fraction = position - static_cast<float>(index);
+}
+
+SPARKYUV_INLINE static void SampleLut3D(const Lut3DSampler &sampler, float &r, float &g, float &b) {
+  int32_t ir, ig, ib;
+  float fr, fg, fb;
+  Lut3DPosition(r, sampler.scale[0], sampler.offset[0], sampler, ir, fr);
+  Lut3DPosition(g, sampler.scale[1], sampler.offset[1], sampler, ig, fg);
+  Lut3DPosition(b, sampler.scale[2], sampler.offset[2], sampler, ib, fb);
+  const float *c000 = sampler.table + ir * sampler.strideR + ig * sampler.strideG + ib * sampler.strideB;
+  const int32_t sR = sampler.strideR, sG = sampler.strideG, sB = sampler.strideB;
+
+  if (sampler.interpolation == LUT_INTERPOLATION_TETRAHEDRAL) {
+    int32_t offsetMax, offsetMin;
+    if (fr >= fg && fr >= fb) {
+      offsetMax = sR;
+      offsetMin = fg >= fb ? sB : sG;
+    } else if (fg >= fb) {
+      offsetMax = sG;
+      offsetMin = fr >= fb ? sB : sR;
+    } else {
+      offsetMax = sB;
+      offsetMin = fr >= fg ? sG : sR;
+    }
+    const float wMax = std::max(fr, std::max(fg, fb));
+    const float wMin = std::min(fr, std::min(fg, fb));
+    const float wMid = fr + fg + fb - wMax - wMin;
+    const float *c1 = c000 + offsetMax;
+    const float *c2 = c000 + sR + sG + sB - offsetMin;
+    const float *c3 = c000 + sR + sG + sB;
+    const float w0 = 1.f - wMax, w1 = wMax - wMid, w2 = wMid - wMin;
+    r = c000[0] * w0 + c1[0] * w1 + c2[0] * w2 + c3[0] * wMin;
+    g = c000[1] * w0 + c1[1] * w1 + c2[1] * w2 + c3[1] * wMin;
+    b = c000[2] * w0 + c1[2] * w1 + c2[2] * w2 + c3[2] * wMin;
+    return;
+  }
+
+  float out[3];
+  for (int c = 0; c < 3; ++c) {
+    auto lerp = [](float a, float b, float t) { return (b - a) * t + a; };
+    const float e0 = lerp(c000[c], c000[sR + c], fr);
+    const float e1 = lerp(c000[sG + c], c000[sG + sR + c], fr);
+    const float e2 = lerp(c000[sB + c], c000[sB + sR + c], fr);
+    const float e3 = lerp(c000[sB + sG + c], c000[sB + sG + sR + c], fr);
+    out[c] = lerp(lerp(e0, e1, fg), lerp(e2, e3, fg), fb);
+  }
+  r = out[0];
+  g = out[1];
+  b = out[2];
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
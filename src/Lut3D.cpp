@@ -0,0 +1,376 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/Lut3D.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "TransferSurface-inl.h"
+#include "Lut3D-inl.h"
+#include "concurrency.hpp"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+template<TransferSurface Surface>
+void ApplyLut3DHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                   uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                   const uint32_t width, const int bitDepth,
+                   const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation,
+                   const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int pixelSize = TransferSurfacePixelSize(Surface);
+  const Lut3DSampler sampler = MakeLut3DSampler(lut, interpolation);
+
+  const int maxColors = (1 << bitDepth) - 1;
+  const float scale = 1.f / static_cast<float>(maxColors);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    auto mSrc = reinterpret_cast<const uint8_t *>(src) + static_cast<size_t>(y) * srcStride;
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      VF r, g, b, a;
+      LoadTransferSurface<Surface>(df, mSrc, r, g, b, a, scale);
+      SampleLut3D(df, sampler, r, g, b);
+      StoreTransferSurface<Surface>(df, mDst, r, g, b, a, maxColors);
+      mSrc += lanes * pixelSize;
+      mDst += lanes * pixelSize;
+    }
+
+    for (; x < width; ++x) {
+      float r, g, b, a;
+      LoadTransferPixel<Surface>(mSrc, r, g, b, a, scale);
+      SampleLut3D(sampler, r, g, b);
+      StoreTransferPixel<Surface>(mDst, r, g, b, a, maxColors);
+      mSrc += pixelSize;
+      mDst += pixelSize;
+    }
+  }
+}
+
+#define APPLY_LUT3D_DECLARATION_R(name, surface, storageType) \
+void ApplyLut3D##name##HWY(const storageType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                           storageType *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                           const uint32_t width, const int bitDepth,\
+                           const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation,\
+                           const uint32_t startRow, const uint32_t endRow) {\
+  ApplyLut3DHWY<surface>(reinterpret_cast<const uint8_t *>(src), srcStride,\
+                         reinterpret_cast<uint8_t *>(dst), dstStride, width, bitDepth,\
+                         lut, interpolation, startRow, endRow);\
+}
+
+APPLY_LUT3D_DECLARATION_R(RGBA, TRANSFER_SURFACE_RGBA8, uint8_t)
+APPLY_LUT3D_DECLARATION_R(RGBA16, TRANSFER_SURFACE_RGBA16, uint16_t)
+APPLY_LUT3D_DECLARATION_R(RGBA1010102, TRANSFER_SURFACE_RGBA1010102, uint8_t)
+APPLY_LUT3D_DECLARATION_R(RGBAF16, TRANSFER_SURFACE_RGBAF16, uint16_t)
+
+#undef APPLY_LUT3D_DECLARATION_R
+
+template<SparkYuvDefaultPixelType PixelType>
+void YCbCr420ToXXXXLut3DHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                            const uint32_t width, const uint32_t height,
+                            const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                            const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                            const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                            const float kr, const float kb, const SparkYuvColorRange colorRange,
+                            const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation,
+                            const uint32_t startRow, const uint32_t endRow) {
+  const ScalableTag<float> df;
+  const Rebind<uint8_t, decltype(df)> du8;
+  const RebindToSigned<decltype(df)> di32;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int components = getPixelTypeComponents(PixelType);
+  const Lut3DSampler sampler = MakeLut3DSampler(lut, interpolation);
+
+  uint16_t biasY, biasUV, rangeY, rangeUV;
+  GetYUVRange(colorRange, 8, biasY, biasUV, rangeY, rangeUV);
+  const float kg = 1.f - kr - kb;
+  const float scaleY = 1.f / static_cast<float>(rangeY);
+  const float scaleUV = 1.f / static_cast<float>(rangeUV);
+  const float crR = 2.f * (1.f - kr) * scaleUV;
+  const float cbB = 2.f * (1.f - kb) * scaleUV;
+  const float crG = 2.f * kr * (1.f - kr) / kg * scaleUV;
+  const float cbG = 2.f * kb * (1.f - kb) / kg * scaleUV;
+
+  const VF vBiasY = Set(df, static_cast<float>(biasY));
+  const VF vBiasUV = Set(df, static_cast<float>(biasUV));
+  const VF vScaleY = Set(df, scaleY);
+  const VF vCrR = Set(df, crR);
+  const VF vCbB = Set(df, cbB);
+  const VF vCrG = Set(df, crG);
+  const VF vCbG = Set(df, cbG);
+  const VF vMaxColors = Set(df, 255.f);
+  const auto alpha = Set(du8, 255);
+
+  std::vector<uint8_t> cbRow(width);
+  std::vector<uint8_t> crRow(width);
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    if (y == startRow || (y & 1) == 0) {
+      const size_t chromaOffset = static_cast<size_t>(y / 2);
+      UpsampleChromaRow2x(reinterpret_cast<const uint8_t *>(uPlane) + chromaOffset * uStride, cbRow.data(), width);
+      UpsampleChromaRow2x(reinterpret_cast<const uint8_t *>(vPlane) + chromaOffset * vStride, crRow.data(), width);
+    }
+
+    auto ySrc = reinterpret_cast<const uint8_t *>(yPlane) + static_cast<size_t>(y) * yStride;
+    auto store = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    uint32_t x = 0;
+
+    for (; x + lanes <= width; x += lanes) {
+      const VF Y = Mul(Sub(ConvertTo(df, PromoteTo(di32, LoadU(du8, ySrc + x))), vBiasY), vScaleY);
+      const VF Cb = Sub(ConvertTo(df, PromoteTo(di32, LoadU(du8, cbRow.data() + x))), vBiasUV);
+      const VF Cr = Sub(ConvertTo(df, PromoteTo(di32, LoadU(du8, crRow.data() + x))), vBiasUV);
+      VF r = MulAdd(vCrR, Cr, Y);
+      VF g = NegMulAdd(vCrG, Cr, NegMulAdd(vCbG, Cb, Y));
+      VF b = MulAdd(vCbB, Cb, Y);
+      SampleLut3D(df, sampler, r, g, b);
+      StoreRGBA<PixelType>(du8, store + x * components,
+                           DemoteTo(du8, NearestInt(Mul(r, vMaxColors))),
+                           DemoteTo(du8, NearestInt(Mul(g, vMaxColors))),
+                           DemoteTo(du8, NearestInt(Mul(b, vMaxColors))), alpha);
+    }
+
+    for (; x < width; ++x) {
+      const float Y = (static_cast<float>(ySrc[x]) - static_cast<float>(biasY)) * scaleY;
+      const float Cb = static_cast<float>(cbRow[x]) - static_cast<float>(biasUV);
+      const float Cr = static_cast<float>(crRow[x]) - static_cast<float>(biasUV);
+      float r = Y + crR * Cr;
+      float g = Y - crG * Cr - cbG * Cb;
+      float b = Y + cbB * Cb;
+      SampleLut3D(sampler, r, g, b);
+      auto quantize = [](const float v) -> uint8_t {
+        return static_cast<uint8_t>(std::clamp(::roundf(v * 255.f), 0.f, 255.f));
+      };
+      StoreRGBA<uint8_t, uint8_t, PixelType>(store + x * components, quantize(r), quantize(g), quantize(b), 255);
+    }
+  }
+}
+
+#define YCBCR420_LUT3D_DECLARATION_R(pixelType) \
+void YCbCr420To##pixelType##Lut3DHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                     const uint32_t width, const uint32_t height,\
+                                     const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                     const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                     const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                     const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                     const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation,\
+                                     const uint32_t startRow, const uint32_t endRow) {\
+  YCbCr420ToXXXXLut3DHWY<sparkyuv::PIXEL_##pixelType>(dst, dstStride, width, height,\
+                                                      yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                      kr, kb, colorRange, lut, interpolation, startRow, endRow);\
+}
+
+YCBCR420_LUT3D_DECLARATION_R(RGBA)
+YCBCR420_LUT3D_DECLARATION_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCBCR420_LUT3D_DECLARATION_R(ARGB)
+YCBCR420_LUT3D_DECLARATION_R(ABGR)
+YCBCR420_LUT3D_DECLARATION_R(BGRA)
+YCBCR420_LUT3D_DECLARATION_R(BGR)
+#endif
+
+#undef YCBCR420_LUT3D_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+HWY_EXPORT(ApplyLut3DRGBAHWY);
+HWY_EXPORT(ApplyLut3DRGBA16HWY);
+HWY_EXPORT(ApplyLut3DRGBA1010102HWY);
+HWY_EXPORT(ApplyLut3DRGBAF16HWY);
+
+#define YCBCR420_LUT3D_DECLARATION_HWY(pixelType) \
+        HWY_EXPORT(YCbCr420To##pixelType##Lut3DHWY);
+
+YCBCR420_LUT3D_DECLARATION_HWY(RGBA)
+YCBCR420_LUT3D_DECLARATION_HWY(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCBCR420_LUT3D_DECLARATION_HWY(ARGB)
+YCBCR420_LUT3D_DECLARATION_HWY(ABGR)
+YCBCR420_LUT3D_DECLARATION_HWY(BGRA)
+YCBCR420_LUT3D_DECLARATION_HWY(BGR)
+#endif
+
+#undef YCBCR420_LUT3D_DECLARATION_HWY
+
+SparkYuvLut3D MakeLut3D(const float *rgb, const uint32_t size) {
+  if (size < 2 || size > 256) {
+    throw std::runtime_error("3D LUT size must be in range [2, 256]");
+  }
+  SparkYuvLut3D lut;
+  lut.size = size;
+  const size_t points = static_cast<size_t>(size) * size * size;
+  lut.table.resize(points * 4);
+  for (size_t i = 0; i < points; ++i) {
+    lut.table[i * 4] = rgb[i * 3];
+    lut.table[i * 4 + 1] = rgb[i * 3 + 1];
+    lut.table[i * 4 + 2] = rgb[i * 3 + 2];
+    lut.table[i * 4 + 3] = 0.f;
+  }
+  return lut;
+}
+
+SparkYuvLut3D ParseCubeLut3D(const char *data, const size_t length) {
+  std::istringstream stream(std::string(data, length));
+  std::string line;
+  uint32_t size = 0;
+  float domainMin[3] = {0.f, 0.f, 0.f};
+  float domainMax[3] = {1.f, 1.f, 1.f};
+  std::vector<float> rgb;
+
+  while (std::getline(stream, line)) {
+    const size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string::npos || line[start] == '#') {
+      continue;
+    }
+    std::istringstream tokens(line.substr(start));
+    std::string keyword;
+    if (std::isalpha(static_cast<unsigned char>(line[start]))) {
+      tokens >> keyword;
+      if (keyword == "LUT_3D_SIZE") {
+        tokens >> size;
+      } else if (keyword == "DOMAIN_MIN") {
+        tokens >> domainMin[0] >> domainMin[1] >> domainMin[2];
+      } else if (keyword == "DOMAIN_MAX") {
+        tokens >> domainMax[0] >> domainMax[1] >> domainMax[2];
+      } else if (keyword == "LUT_1D_SIZE") {
+        throw std::runtime_error("1D .cube LUTs are not supported");
+      }
+      // TITLE, LUT_3D_INPUT_RANGE and vendor keywords are ignored
+      if (tokens.fail()) {
+        throw std::runtime_error("Malformed .cube keyword " + keyword);
+      }
+      continue;
+    }
+    float r, g, b;
+    if (!(tokens >> r >> g >> b)) {
+      throw std::runtime_error("Malformed .cube lattice point");
+    }
+    rgb.push_back(r);
+    rgb.push_back(g);
+    rgb.push_back(b);
+  }
+
+  if (size == 0) {
+    throw std::runtime_error(".cube file has no LUT_3D_SIZE");
+  }
+  if (rgb.size() != static_cast<size_t>(size) * size * size * 3) {
+    throw std::runtime_error(".cube lattice point count does not match LUT_3D_SIZE");
+  }
+  SparkYuvLut3D lut = MakeLut3D(rgb.data(), size);
+  for (int i = 0; i < 3; ++i) {
+    if (!(domainMax[i] > domainMin[i])) {
+      throw std::runtime_error(".cube DOMAIN_MAX must be greater than DOMAIN_MIN");
+    }
+    lut.domainMin[i] = domainMin[i];
+    lut.domainMax[i] = domainMax[i];
+  }
+  return lut;
+}
+
+static void ValidateLut3D(const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation, const int depth) {
+  if (lut.size < 2 || lut.table.size() != static_cast<size_t>(lut.size) * lut.size * lut.size * 4) {
+    throw std::runtime_error("3D LUT is not packed, it must be created by MakeLut3D or ParseCubeLut3D");
+  }
+  for (int i = 0; i < 3; ++i) {
+    if (!(lut.domainMax[i] > lut.domainMin[i])) {
+      throw std::runtime_error("3D LUT domain max must be greater than domain min");
+    }
+  }
+  if (interpolation != LUT_INTERPOLATION_TRILINEAR && interpolation != LUT_INTERPOLATION_TETRAHEDRAL) {
+    throw std::runtime_error("Unsupported 3D LUT interpolation");
+  }
+  if (depth < 1 || depth > 16) {
+    throw std::runtime_error("Bit depth must be in range [1, 16]");
+  }
+}
+
+/**
+ * Variadic arguments carry extra public parameters with trailing comma, RGBA16 passes its bit-depth this way
+ */
+#define APPLY_LUT3D_DECLARATION_E(name, storageType, depth, ...) \
+    void ApplyLut3D##name(const storageType *src, const uint32_t srcStride,\
+                          storageType *dst, const uint32_t dstStride,\
+                          const uint32_t width, const uint32_t height, __VA_ARGS__\
+                          const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation) {\
+      ValidateLut3D(lut, interpolation, depth);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(ApplyLut3D##name##HWY)(src, srcStride, dst, dstStride, width, depth,\
+                                                    lut, interpolation, start, end);\
+      });\
+    }
+
+APPLY_LUT3D_DECLARATION_E(RGBA, uint8_t, 8)
+APPLY_LUT3D_DECLARATION_E(RGBA16, uint16_t, depth, const int depth,)
+APPLY_LUT3D_DECLARATION_E(RGBA1010102, uint8_t, 10)
+APPLY_LUT3D_DECLARATION_E(RGBAF16, uint16_t, 16)
+
+#undef APPLY_LUT3D_DECLARATION_E
+
+#define YCBCR420_LUT3D_DECLARATION_E(pixelType) \
+    void YCbCr420To##pixelType##Lut3D(uint8_t *dst, const uint32_t dstStride,\
+                                      const uint32_t width, const uint32_t height,\
+                                      const uint8_t *yPlane, const uint32_t yStride,\
+                                      const uint8_t *uPlane, const uint32_t uStride,\
+                                      const uint8_t *vPlane, const uint32_t vStride,\
+                                      const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                      const SparkYuvLut3D &lut, const SparkYuvLutInterpolation interpolation) {\
+      ValidateLut3D(lut, interpolation, 8);\
+      ValidateYCbCrParameters(kr, kb, colorRange);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(YCbCr420To##pixelType##Lut3DHWY)(dst, dstStride, width, height,\
+                                                              yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                              kr, kb, colorRange, lut, interpolation,\
+                                                              start * 2,\
+                                                              std::min(static_cast<uint32_t>(end * 2), height));\
+      });\
+    }
+
+YCBCR420_LUT3D_DECLARATION_E(RGBA)
+YCBCR420_LUT3D_DECLARATION_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCBCR420_LUT3D_DECLARATION_E(ARGB)
+YCBCR420_LUT3D_DECLARATION_E(ABGR)
+YCBCR420_LUT3D_DECLARATION_E(BGRA)
+YCBCR420_LUT3D_DECLARATION_E(BGR)
+#endif
+
+#undef YCBCR420_LUT3D_DECLARATION_E
+
+}
+#endif
@@ -24,6 +24,10 @@
 #include "hwy/highway.h"
 #include "src/yuv-inl.h"
 #include "src/sparkyuv-internal.h"
+#include "src/ConvertRegion-inl.h"
+#include "src/Tensor-inl.h"
+#include "src/YCbCr420Wide-inl.h"
+#include <algorithm>
 
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
@@ -35,6 +39,11 @@ void NV21ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
                   const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride,
                   const float kr, const float kb,
                   const SparkYuvColorRange colorRange) {
+#if SPARKYUV_WIDE_420
+  YCbCr420ToXXXXWide<PixelType, true, LoadOrder>(dst, dstStride, width, height, yPlane, yStride,
+                                                 uvPlane, uvStride, uvPlane, uvStride,
+                                                 ComputeYCbCr8InverseCoefficients(kr, kb, colorRange));
+#else
   const ScalableTag<uint8_t> du8;
   const Half<decltype(du8)> du8h;
   const Rebind<int16_t, decltype(du8h)> di16;
@@ -102,10 +111,10 @@ void NV21ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
         LoadInterleaved2(du8h, uvSource, vlfh, ulfh);
       }
 
-      const auto luma8 = Sub(LoadU(du8, ySrc), uvCorrIY);
+      const auto luma8 = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
 
-      auto ulf = Combine(du8, InterleaveUpper(du8h, ulfh, ulfh), InterleaveLower(ulfh, ulfh));
-      auto vlf = Combine(du8, InterleaveUpper(du8h, vlfh, vlfh), InterleaveLower(vlfh, vlfh));
+      const auto ulf = DuplicateChroma(du8, ulfh);
+      const auto vlf = DuplicateChroma(du8, vlfh);
 
       const auto cbh = Sub(BitCast(di16, PromoteUpperTo(du16, ulf)), uvCorrection);
       const auto crh = Sub(BitCast(di16, PromoteUpperTo(du16, vlf)), uvCorrection);
@@ -144,7 +153,7 @@ void NV21ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
       const uint8_t uValue = reinterpret_cast<const uint8_t *>(uvSource)[LoadOrder == YUV_ORDER_UV ? 0 : 1];
       const uint8_t vValue = reinterpret_cast<const uint8_t *>(uvSource)[LoadOrder == YUV_ORDER_UV ? 1 : 0];
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       const int Cr = (static_cast<int>(vValue) - biasUV);
       const int Cb = (static_cast<int>(uValue) - biasUV);
 
@@ -158,7 +167,7 @@ void NV21ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
       ySrc += 1;
 
       if (x + 1 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -176,6 +185,7 @@ void NV21ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
     mYSrc += yStride;
     dst += dstStride;
   }
+#endif
 }
 
 #define NVXXToXXXXHWY_DECLARATION_R(pixelType, NVType, NVOrder) \
@@ -208,6 +218,202 @@ NVXXToXXXXHWY_DECLARATION_R(BGR, NV12, YUV_ORDER_UV)
 
 #undef NVXXToXXXXHWY_DECLARATION_R
 
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, SparkYuvNVLoadOrder LoadOrder = sparkyuv::YUV_ORDER_UV>
+void NV21RegionToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                        const uint32_t dstWidth, const uint32_t dstHeight,
+                        const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                        const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride,
+                        const uint32_t width, const uint32_t height,
+                        const uint32_t regionX, const uint32_t regionY,
+                        const uint32_t regionWidth, const uint32_t regionHeight,
+                        const float kr, const float kb, const SparkYuvColorRange colorRange,
+                        const SparkYuvSampler sampler) {
+  // Chroma pair is shared by two pixels so rows are converted from even column
+  const uint32_t alignedX = regionX & ~1u;
+  const uint32_t shift = regionX - alignedX;
+  const uint32_t rowLength = regionWidth + shift;
+  const int components = getPixelTypeComponents(PixelType);
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUVSrc = reinterpret_cast<const uint8_t *>(uvPlane);
+
+  ConvertRegionStrip<PixelType>([&](const uint32_t row, uint8_t *buffer) -> const uint8_t * {
+    const uint32_t sourceY = regionY + row;
+    NV21ToPixel8<PixelType, LoadOrder>(buffer, rowLength * components, rowLength, 1,
+                                       mYSrc + static_cast<size_t>(sourceY) * yStride + alignedX, yStride,
+                                       mUVSrc + static_cast<size_t>(sourceY >> 1) * uvStride + alignedX, uvStride,
+                                       kr, kb, colorRange);
+    return buffer + shift * components;
+  }, rowLength, regionWidth, regionHeight, dst, dstStride, dstWidth, dstHeight, sampler);
+}
+
+#define NVXXRegionToXXXXHWY_DECLARATION_R(pixelType, NVType, NVOrder) \
+        void NVType##RegionTo##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                           const uint32_t dstWidth, const uint32_t dstHeight,\
+                           const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                           const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride, \
+                           const uint32_t width, const uint32_t height,\
+                           const uint32_t regionX, const uint32_t regionY,\
+                           const uint32_t regionWidth, const uint32_t regionHeight,\
+                           const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                           const SparkYuvSampler sampler) { \
+        NV21RegionToPixel8<sparkyuv::PIXEL_##pixelType, NVOrder>(dst, dstStride, dstWidth, dstHeight, \
+                                  yPlane, yStride, uvPlane, uvStride, width, height, \
+                                  regionX, regionY, regionWidth, regionHeight, kr, kb, colorRange, sampler); \
+        }
+
+NVXXRegionToXXXXHWY_DECLARATION_R(RGBA, NV21, YUV_ORDER_VU)
+NVXXRegionToXXXXHWY_DECLARATION_R(RGB, NV21, YUV_ORDER_VU)
+#if SPARKYUV_FULL_CHANNELS
+NVXXRegionToXXXXHWY_DECLARATION_R(ARGB, NV21, YUV_ORDER_VU)
+NVXXRegionToXXXXHWY_DECLARATION_R(ABGR, NV21, YUV_ORDER_VU)
+NVXXRegionToXXXXHWY_DECLARATION_R(BGRA, NV21, YUV_ORDER_VU)
+NVXXRegionToXXXXHWY_DECLARATION_R(BGR, NV21, YUV_ORDER_VU)
+#endif
+
+NVXXRegionToXXXXHWY_DECLARATION_R(RGBA, NV12, YUV_ORDER_UV)
+NVXXRegionToXXXXHWY_DECLARATION_R(RGB, NV12, YUV_ORDER_UV)
+#if SPARKYUV_FULL_CHANNELS
+NVXXRegionToXXXXHWY_DECLARATION_R(ARGB, NV12, YUV_ORDER_UV)
+NVXXRegionToXXXXHWY_DECLARATION_R(ABGR, NV12, YUV_ORDER_UV)
+NVXXRegionToXXXXHWY_DECLARATION_R(BGRA, NV12, YUV_ORDER_UV)
+NVXXRegionToXXXXHWY_DECLARATION_R(BGR, NV12, YUV_ORDER_UV)
+#endif
+
+#undef NVXXRegionToXXXXHWY_DECLARATION_R
+
+/**
+ * Luma and chroma planes are decimated first and only destination sized planes are converted to RGB.
+ * Sampler is chosen once for both planes, rows [startRow, endRow) are converted, `startRow` must be even
+ */
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, SparkYuvNVLoadOrder LoadOrder = sparkyuv::YUV_ORDER_UV>
+void NV21ScaledToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                        const uint32_t dstWidth, const uint32_t dstHeight,
+                        const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                        const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride,
+                        const uint32_t width, const uint32_t height,
+                        const float kr, const float kb, const SparkYuvColorRange colorRange,
+                        const SparkYuvSampler sampler, const uint32_t startRow, const uint32_t endRow) {
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUVSrc = reinterpret_cast<const uint8_t *>(uvPlane);
+
+  const uint32_t rows = endRow - startRow;
+  std::vector<uint8_t> scaledY(static_cast<size_t>(dstWidth) * rows);
+  ScaleRowsStrip([&](const uint32_t row, uint8_t *) -> const uint8_t * {
+    return mYSrc + static_cast<size_t>(row) * yStride;
+  }, 0, 1, width, height, scaledY.data(), dstWidth, dstWidth, dstHeight, startRow, endRow, sampler);
+
+  const uint32_t chromaWidth = (width + 1) / 2;
+  const uint32_t chromaHeight = (height + 1) / 2;
+  const uint32_t dstChromaWidth = (dstWidth + 1) / 2;
+  const uint32_t dstChromaHeight = (dstHeight + 1) / 2;
+  const uint32_t scaledUVStride = dstChromaWidth * 2;
+  const uint32_t chromaStart = startRow / 2;
+  const uint32_t chromaEnd = (endRow + 1) / 2;
+
+  std::vector<uint8_t> scaledUV(static_cast<size_t>(scaledUVStride) * (chromaEnd - chromaStart));
+  ScaleRowsStrip([&](const uint32_t row, uint8_t *) -> const uint8_t * {
+    return mUVSrc + static_cast<size_t>(row) * uvStride;
+  }, 0, 2, chromaWidth, chromaHeight, scaledUV.data(), scaledUVStride, dstChromaWidth, dstChromaHeight,
+                 chromaStart, chromaEnd, sampler);
+
+  NV21ToPixel8<PixelType, LoadOrder>(dst + static_cast<size_t>(startRow) * dstStride, dstStride, dstWidth, rows,
+                                     scaledY.data(), dstWidth, scaledUV.data(), scaledUVStride,
+                                     kr, kb, colorRange);
+}
+
+#define NVXXScaledToXXXXHWY_DECLARATION_R(pixelType, NVType, NVOrder) \
+        void NVType##To##pixelType##ScaledHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                           const uint32_t dstWidth, const uint32_t dstHeight,\
+                           const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                           const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride, \
+                           const uint32_t width, const uint32_t height,\
+                           const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                           const SparkYuvSampler sampler, const uint32_t startRow, const uint32_t endRow) { \
+        NV21ScaledToPixel8<sparkyuv::PIXEL_##pixelType, NVOrder>(dst, dstStride, dstWidth, dstHeight, \
+                                  yPlane, yStride, uvPlane, uvStride, width, height, kr, kb, colorRange, \
+                                  sampler, startRow, endRow); \
+        }
+
+NVXXScaledToXXXXHWY_DECLARATION_R(RGBA, NV21, YUV_ORDER_VU)
+NVXXScaledToXXXXHWY_DECLARATION_R(RGB, NV21, YUV_ORDER_VU)
+#if SPARKYUV_FULL_CHANNELS
+NVXXScaledToXXXXHWY_DECLARATION_R(ARGB, NV21, YUV_ORDER_VU)
+NVXXScaledToXXXXHWY_DECLARATION_R(ABGR, NV21, YUV_ORDER_VU)
+NVXXScaledToXXXXHWY_DECLARATION_R(BGRA, NV21, YUV_ORDER_VU)
+NVXXScaledToXXXXHWY_DECLARATION_R(BGR, NV21, YUV_ORDER_VU)
+#endif
+
+NVXXScaledToXXXXHWY_DECLARATION_R(RGBA, NV12, YUV_ORDER_UV)
+NVXXScaledToXXXXHWY_DECLARATION_R(RGB, NV12, YUV_ORDER_UV)
+#if SPARKYUV_FULL_CHANNELS
+NVXXScaledToXXXXHWY_DECLARATION_R(ARGB, NV12, YUV_ORDER_UV)
+NVXXScaledToXXXXHWY_DECLARATION_R(ABGR, NV12, YUV_ORDER_UV)
+NVXXScaledToXXXXHWY_DECLARATION_R(BGRA, NV12, YUV_ORDER_UV)
+NVXXScaledToXXXXHWY_DECLARATION_R(BGR, NV12, YUV_ORDER_UV)
+#endif
+
+#undef NVXXScaledToXXXXHWY_DECLARATION_R
+
+/**
+ * Decodes pairs of rows in [startRow, endRow) into small RGB buffer and normalizes them into the tensor,
+ * startRow must be even
+ */
+template<SparkYuvNVLoadOrder LoadOrder, typename T>
+void NV21ToTensorHWY(const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                     const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride,
+                     const uint32_t width, const uint32_t height,
+                     T *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,
+                     const SparkYuvTensorNormalization normalization,
+                     const float quantizationScale, const int32_t zeroPoint,
+                     const float kr, const float kb, const SparkYuvColorRange colorRange,
+                     const uint32_t startRow, const uint32_t endRow) {
+  const TensorTransform transform = ComputeTensorTransform(normalization, quantizationScale, zeroPoint);
+  const uint32_t rowStride = width * 3;
+  std::vector<uint8_t> rows(rowStride * 2);
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUVSrc = reinterpret_cast<const uint8_t *>(uvPlane);
+
+  for (uint32_t y = startRow; y < endRow; y += 2) {
+    const uint32_t rowsCount = std::min(endRow - y, 2u);
+    NV21ToPixel8<sparkyuv::PIXEL_RGB, LoadOrder>(rows.data(), rowStride, width, rowsCount,
+                                                 mYSrc + static_cast<size_t>(y) * yStride, yStride,
+                                                 mUVSrc + static_cast<size_t>(y >> 1) * uvStride, uvStride,
+                                                 kr, kb, colorRange);
+    for (uint32_t i = 0; i < rowsCount; ++i) {
+      PixelRowToTensor<sparkyuv::PIXEL_RGB, T>(rows.data() + i * rowStride, width, height, y + i,
+                                               tensor, layout, transform);
+    }
+  }
+}
+
+#define NVXXToTensorHWY_DECLARATION_R(NVType, NVOrder, suffix, storageType, tensorType) \
+        void NVType##ToTensor##suffix##HWY(const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                           const uint8_t *SPARKYUV_RESTRICT uvPlane, const uint32_t uvStride,\
+                           const uint32_t width, const uint32_t height,\
+                           storageType *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                           const SparkYuvTensorNormalization normalization,\
+                           const float quantizationScale, const int32_t zeroPoint,\
+                           const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                           const uint32_t startRow, const uint32_t endRow) {\
+        NV21ToTensorHWY<NVOrder, tensorType>(yPlane, yStride, uvPlane, uvStride, width, height,\
+                                             reinterpret_cast<tensorType *>(tensor), layout, normalization,\
+                                             quantizationScale, zeroPoint, kr, kb, colorRange, startRow, endRow);\
+        }
+
+NVXXToTensorHWY_DECLARATION_R(NV21, YUV_ORDER_VU, F32, float, float)
+NVXXToTensorHWY_DECLARATION_R(NV21, YUV_ORDER_VU, F16, uint16_t, hwy::float16_t)
+NVXXToTensorHWY_DECLARATION_R(NV21, YUV_ORDER_VU, I8, int8_t, int8_t)
+NVXXToTensorHWY_DECLARATION_R(NV12, YUV_ORDER_UV, F32, float, float)
+NVXXToTensorHWY_DECLARATION_R(NV12, YUV_ORDER_UV, F16, uint16_t, hwy::float16_t)
+NVXXToTensorHWY_DECLARATION_R(NV12, YUV_ORDER_UV, I8, int8_t, int8_t)
+
+#undef NVXXToTensorHWY_DECLARATION_R
+
+/**
+ * RGB to NV12/NV21, two rows per iteration with WeightedSumRGB8 and AverageBlock2x2
+ */
 template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA,
     SparkYuvNVLoadOrder LoadOrder = sparkyuv::YUV_ORDER_UV>
 void Pixel8ToNV21HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
@@ -236,49 +442,85 @@ void Pixel8ToNV21HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStr
   const auto iBiasUV = static_cast<uint16_t>((static_cast<float>(biasUV) + 0.5f) * scale);
 
   auto yStore = reinterpret_cast<uint8_t *>(yPlane);
-  auto uvSource = reinterpret_cast<uint8_t *>(uvPlane);
+  auto uvStore = reinterpret_cast<uint8_t *>(uvPlane);
 
   auto mSource = reinterpret_cast<const uint8_t *>(src);
 
-  const ScalableTag<uint16_t> du16;
   const ScalableTag<int16_t> di16;
+  const RebindToUnsigned<decltype(di16)> du16;
   const Rebind<uint8_t, decltype(di16)> du8;
-  const Half<decltype(di16)> dhi16;
-  const Rebind<int32_t, decltype(dhi16)> d32;
-  const RebindToUnsigned<decltype(d32)> du32;
+  const RepartitionToWide<decltype(di16)> d32;
+  const Rebind<uint8_t, decltype(d32)> du8h;
   using VU8 = Vec<decltype(du8)>;
-  using V32 = Vec<decltype(d32)>;
-
-  const Half<decltype(du8)> du8h;
 
   const int lanes = Lanes(du8);
 
   const auto vBiasY = Set(d32, iBiasY);
   const auto vBiasUV = Set(d32, iBiasUV);
 
-  const auto coeffTag = di16;
-
-  const auto vYR = Set(coeffTag, YR);
-  const auto vYG = Set(coeffTag, YG);
-  const auto vYB = Set(coeffTag, YB);
+  const auto vYR = Set(di16, YR);
+  const auto vYG = Set(di16, YG);
+  const auto vYB = Set(di16, YB);
 
-  const auto vCbR = Set(coeffTag, -CbR);
-  const auto vCbG = Set(coeffTag, -CbG);
-  const auto vCbB = Set(coeffTag, CbB);
+  const auto vCbR = Set(d32, -static_cast<int>(CbR));
+  const auto vCbG = Set(d32, -static_cast<int>(CbG));
+  const auto vCbB = Set(d32, CbB);
 
-  const auto vCrR = Set(coeffTag, CrR);
-  const auto vCrG = Set(coeffTag, -CrG);
-  const auto vCrB = Set(coeffTag, -CrB);
+  const auto vCrR = Set(d32, CrR);
+  const auto vCrG = Set(d32, -static_cast<int>(CrG));
+  const auto vCrB = Set(d32, -static_cast<int>(CrB));
 
   const int components = getPixelTypeComponents(PixelType);
 
-  for (uint32_t y = 0; y < height; ++y) {
-    uint32_t x = 0;
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<uint8_t, decltype(di16)> du8x;
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+  const int pixelLanes = Lanes(du8x);
+#endif
+
+  for (uint32_t y = 0; y < height; y += 2) {
+    // Last odd row is paired with itself and its luma is simply written twice
+    const uint32_t nextRow = y + 1 < height ? 1 : 0;
 
     auto yDst = reinterpret_cast<uint8_t *>(yStore);
-    auto uvDestination = reinterpret_cast<uint8_t *>(uvSource);
+    auto yNextDst = reinterpret_cast<uint8_t *>(yStore + nextRow * yStride);
+    auto uvDst = reinterpret_cast<uint8_t *>(uvStore);
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
+    auto mNextSrc = reinterpret_cast<const uint8_t *>(mSource + nextRow * srcStride);
+
+    uint32_t x = 0;
+
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        StoreU(DemoteTo(du8, BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY))), du8, yDst);
+        StoreU(DemoteTo(du8, BitCast(du16, DotPixels8(di16, mNextSrc, vDotY, vDotYRest, vBiasY))), du8, yNextDst);
+
+        const auto block = AveragePixels2x2(du8x, LoadU(du8x, mSrc), LoadU(du8x, mSrc + pixelLanes),
+                                            LoadU(du8x, mNextSrc), LoadU(du8x, mNextSrc + pixelLanes));
+        const auto Cb = DotPixels8(d32, block, vDotCb, vDotCbRest, vBiasUV);
+        const auto Cr = DotPixels8(d32, block, vDotCr, vDotCrRest, vBiasUV);
+
+        if (LoadOrder == YUV_ORDER_UV) {
+          StoreInterleaved2(DemoteTo(du8h, Cb), DemoteTo(du8h, Cr), du8h, uvDst);
+        } else {
+          StoreInterleaved2(DemoteTo(du8h, Cr), DemoteTo(du8h, Cb), du8h, uvDst);
+        }
+
+        yDst += lanes;
+        yNextDst += lanes;
+        uvDst += lanes;
+
+        mSrc += components * lanes;
+        mNextSrc += components * lanes;
+      }
+    }
+#endif
 
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
@@ -286,140 +528,86 @@ void Pixel8ToNV21HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStr
       VU8 B8;
       VU8 A8;
       LoadRGBA<PixelType>(du8, mSrc, R8, G8, B8, A8);
+      const auto R = PromoteTo(du16, R8);
+      const auto G = PromoteTo(du16, G8);
+      const auto B = PromoteTo(du16, B8);
 
-      auto R = BitCast(di16, PromoteTo(du16, R8));
-      auto G = BitCast(di16, PromoteTo(du16, G8));
-      auto B = BitCast(di16, PromoteTo(du16, B8));
+      LoadRGBA<PixelType>(du8, mNextSrc, R8, G8, B8, A8);
+      const auto R1 = PromoteTo(du16, R8);
+      const auto G1 = PromoteTo(du16, G8);
+      const auto B1 = PromoteTo(du16, B8);
 
-      V32 YRh = vBiasY;
-      V32 YRl = WidenMulAccumulate(d32, R, vYR, vBiasY, YRh);
-      YRl = WidenMulAccumulate(d32, G, vYG, YRl, YRh);
-      YRl = WidenMulAccumulate(d32, B, vYB, YRl, YRh);
+      StoreU(WeightedSumRGB8(di16, BitCast(di16, R), BitCast(di16, G), BitCast(di16, B),
+                             vYR, vYG, vYB, vBiasY), du8, yDst);
+      StoreU(WeightedSumRGB8(di16, BitCast(di16, R1), BitCast(di16, G1), BitCast(di16, B1),
+                             vYR, vYG, vYB, vBiasY), du8, yNextDst);
 
-      const auto
-          Y = BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, YRh), ShiftRightNarrow<8>(d32, YRl)));
-      if (!(y & 1)) {
-        if (y + 1 < height) {
-          LoadRGBA<PixelType>(du8, mSrc, R8, G8, B8, A8);
-
-          const auto R1 = BitCast(di16, PromoteTo(du16, R8));
-          const auto G1 = BitCast(di16, PromoteTo(du16, G8));
-          const auto B1 = BitCast(di16, PromoteTo(du16, B8));
-          R = AddAndHalf(di16, R, R1);
-          G = AddAndHalf(di16, G, G1);
-          B = AddAndHalf(di16, B, B1);
-        }
-
-        V32 Cbh = vBiasUV;
-        V32 Cbl = WidenMulAccumulate(d32, R, vCbR, vBiasUV, Cbh);
-        Cbl = WidenMulAccumulate(d32, G, vCbG, Cbl, Cbh);
-        Cbl = WidenMulAccumulate(d32, B, vCbB, Cbl, Cbh);
-
-        const auto Cbf =
-            BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, Cbh), ShiftRightNarrow<8>(d32, Cbl)));
+      const auto Rc = AverageBlock2x2(du16, R, R1);
+      const auto Gc = AverageBlock2x2(du16, G, G1);
+      const auto Bc = AverageBlock2x2(du16, B, B1);
 
-        V32 Crh = vBiasUV;
-        V32 Crl = WidenMulAccumulate(d32, R, vCrR, vBiasUV, Crh);
-        Crl = WidenMulAccumulate(d32, G, vCrG, Crl, Crh);
-        Crl = WidenMulAccumulate(d32, B, vCrB, Crl, Crh);
+      const auto Cb = ShiftRight<8>(Add(Add(Mul(Rc, vCbR), Mul(Gc, vCbG)), Add(Mul(Bc, vCbB), vBiasUV)));
+      const auto Cr = ShiftRight<8>(Add(Add(Mul(Rc, vCrR), Mul(Gc, vCrG)), Add(Mul(Bc, vCrB), vBiasUV)));
 
-        const auto Crf =
-            BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, Crh), ShiftRightNarrow<8>(d32, Crl)));
-
-        const auto Cb = DemoteTo(du8h, ShiftRightNarrow<1>(du32, SumsOf2(Cbf)));
-        const auto Cr = DemoteTo(du8h, ShiftRightNarrow<1>(du32, SumsOf2(Crf)));
-
-        if (LoadOrder == YUV_ORDER_UV) {
-          StoreInterleaved2(Cb, Cr, du8h, uvDestination);
-        } else {
-          StoreInterleaved2(Cr, Cb, du8h, uvDestination);
-        }
+      if (LoadOrder == YUV_ORDER_UV) {
+        StoreInterleaved2(DemoteTo(du8h, Cb), DemoteTo(du8h, Cr), du8h, uvDst);
+      } else {
+        StoreInterleaved2(DemoteTo(du8h, Cr), DemoteTo(du8h, Cb), du8h, uvDst);
       }
 
-      StoreU(DemoteTo(du8, Y), du8, yDst);
-
       yDst += lanes;
-      uvDestination += lanes;
+      yNextDst += lanes;
+      uvDst += lanes;
 
       mSrc += components * lanes;
+      mNextSrc += components * lanes;
     }
 
     for (; x < width; x += 2) {
-      int r;
-      int g;
-      int b;
-
+      int r, g, b;
+      int r1, g1, b1;
       LoadRGB<uint8_t, int, PixelType>(mSrc, r, g, b);
-
-      int Y0 = ((r * YR + g * YG + b * YB + iBiasY) >> precision);
-
-      auto mNextSrc = mSrc;
-
-      if (y + 1 < height) {
-        mNextSrc = reinterpret_cast<const uint8_t *>(mSrc) + srcStride;
-      }
-
-      int r1 = r;
-      int g1 = g;
-      int b1 = b;
-
       LoadRGB<uint8_t, int, PixelType>(mNextSrc, r1, g1, b1);
 
-      yDst[0] = Y0;
-      yDst += 1;
-
-      int r2 = r;
-      int g2 = g;
-      int b2 = b;
+      int r2 = r, g2 = g, b2 = b;
+      int r3 = r1, g3 = g1, b3 = b1;
 
-      int r3 = r;
-      int g3 = g;
-      int b3 = b;
+      yDst[0] = std::min((r * YR + g * YG + b * YB + iBiasY) >> precision, 255);
+      yNextDst[0] = std::min((r1 * YR + g1 * YG + b1 * YB + iBiasY) >> precision, 255);
 
       if (x + 1 < width) {
-        mSrc += components;
-        mNextSrc += components;
-
-        LoadRGB<uint8_t, int, PixelType>(mSrc, r2, g2, b2);
+        LoadRGB<uint8_t, int, PixelType>(mSrc + components, r2, g2, b2);
+        LoadRGB<uint8_t, int, PixelType>(mNextSrc + components, r3, g3, b3);
 
-        int Y1 = ((r2 * YR + g2 * YG + b2 * YB + iBiasY) >> precision);
-
-        if (!(y & 1)) {
-          LoadRGB<uint8_t, int, PixelType>(mNextSrc, r3, g3, b3);
-        }
-
-        yDst[0] = Y1;
-        yDst += 1;
-
-        mSrc += components;
-      } else {
-        mSrc += components;
+        yDst[1] = std::min((r2 * YR + g2 * YG + b2 * YB + iBiasY) >> precision, 255);
+        yNextDst[1] = std::min((r3 * YR + g3 * YG + b3 * YB + iBiasY) >> precision, 255);
       }
 
-      if (!(y & 1)) {
-        r = (r + r1 + r2 + r3) >> 2;
-        g = (g + g1 + g2 + g3) >> 2;
-        b = (b + b1 + b2 + b3) >> 2;
-        int Cb = ((-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision);
-        int Cr = ((r * CrR - g * CrG - b * CrB + iBiasUV) >> precision);
-        if (LoadOrder == YUV_ORDER_UV) {
-          uvDestination[0] = Cb;
-          uvDestination[1] = Cr;
-        } else {
-          uvDestination[1] = Cb;
-          uvDestination[0] = Cr;
-        }
-        uvDestination += 2;
+      r = (r + r1 + r2 + r3 + 2) >> 2;
+      g = (g + g1 + g2 + g3 + 2) >> 2;
+      b = (b + b1 + b2 + b3 + 2) >> 2;
+      const int Cb = (-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision;
+      const int Cr = (r * CrR - g * CrG - b * CrB + iBiasUV) >> precision;
+      if (LoadOrder == YUV_ORDER_UV) {
+        uvDst[0] = std::clamp(Cb, 0, 255);
+        uvDst[1] = std::clamp(Cr, 0, 255);
+      } else {
+        uvDst[0] = std::clamp(Cr, 0, 255);
+        uvDst[1] = std::clamp(Cb, 0, 255);
       }
-    }
 
-    yStore += yStride;
+      yDst += 2;
+      yNextDst += 2;
+      uvDst += 2;
 
-    if (y & 1) {
-      uvSource += uvStride;
+      mSrc += components * 2;
+      mNextSrc += components * 2;
     }
 
-    mSource += srcStride;
+    yStore += yStride * 2;
+    uvStore += uvStride;
+
+    mSource += srcStride * 2;
   }
 }
 
@@ -22,6 +22,7 @@
 #include "hwy/cache_control.h"
 #include "yuv-inl.h"
 #include "NV12-inl.h"
+#include "concurrency.hpp"
 
 #if HWY_ONCE
 namespace sparkyuv {
@@ -115,7 +116,16 @@ XXXToNVXX_DECLARATION_HWY(BGR, NV12)
     HWY_DLLEXPORT void \
     Pixel##To##NV(const uint8_t *dst, uint32_t dstStride, uint32_t width, uint32_t height, uint8_t *ySrc, uint32_t yStride, \
                   uint8_t *uv, uint32_t uvStride, const float kr, const float kb, const SparkYuvColorRange colorRange) { \
-      HWY_DYNAMIC_DISPATCH(Pixel##To##NV##HWY)(dst, dstStride, width, height, ySrc, yStride, uv, uvStride, kr, kb, colorRange); \
+      ValidateYCbCrParameters(kr, kb, colorRange); \
+      const int threadCount = concurrency::getThreadCounts(width, height); \
+      concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) { \
+        const uint32_t y = start * 2; \
+        const uint32_t rows = std::min(static_cast<uint32_t>(end * 2), height) - y; \
+        HWY_DYNAMIC_DISPATCH(Pixel##To##NV##HWY)(dst + static_cast<size_t>(y) * dstStride, dstStride, width, rows, \
+                                                 ySrc + static_cast<size_t>(y) * yStride, yStride, \
+                                                 uv + static_cast<size_t>(start) * uvStride, uvStride, \
+                                                 kr, kb, colorRange); \
+      }); \
     }
 
 XXXXToNVXX_DECLARATION_E(RGBA, NV21)
@@ -138,5 +148,209 @@ XXXXToNVXX_DECLARATION_E(BGR, NV12)
 
 #undef XXXXToNVXX_DECLARATION_E
 
+// MARK: Region conversion
+
+#define NVXXRegionToXXXX_DECLARATION_HWY(pixel, NV) HWY_EXPORT(NV##RegionTo##pixel##HWY);
+
+NVXXRegionToXXXX_DECLARATION_HWY(RGBA, NV21)
+NVXXRegionToXXXX_DECLARATION_HWY(RGB, NV21)
+#if SPARKYUV_FULL_CHANNELS
+NVXXRegionToXXXX_DECLARATION_HWY(ARGB, NV21)
+NVXXRegionToXXXX_DECLARATION_HWY(ABGR, NV21)
+NVXXRegionToXXXX_DECLARATION_HWY(BGRA, NV21)
+NVXXRegionToXXXX_DECLARATION_HWY(BGR, NV21)
+#endif
+
+NVXXRegionToXXXX_DECLARATION_HWY(RGBA, NV12)
+NVXXRegionToXXXX_DECLARATION_HWY(RGB, NV12)
+#if SPARKYUV_FULL_CHANNELS
+NVXXRegionToXXXX_DECLARATION_HWY(ARGB, NV12)
+NVXXRegionToXXXX_DECLARATION_HWY(ABGR, NV12)
+NVXXRegionToXXXX_DECLARATION_HWY(BGRA, NV12)
+NVXXRegionToXXXX_DECLARATION_HWY(BGR, NV12)
+#endif
+
+#undef NVXXRegionToXXXX_DECLARATION_HWY
+
+#define NVXXRegionToXXXX_DECLARATION_E(pixelType, NV) \
+    HWY_DLLEXPORT void \
+    NV##RegionTo##pixelType(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight, \
+                            const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride, \
+                            uint32_t width, uint32_t height, const SparkYuvRegion region, \
+                            const float kr, const float kb, const SparkYuvColorRange colorRange, \
+                            const SparkYuvSampler sampler) { \
+      ValidateYCbCrParameters(kr, kb, colorRange); \
+      ValidateRegionConversion(width, height, region, dstWidth, dstHeight, sampler); \
+      HWY_DYNAMIC_DISPATCH(NV##RegionTo##pixelType##HWY)(dst, dstStride, dstWidth, dstHeight, ySrc, yStride, uv, uvStride, \
+                                                         width, height, region.x, region.y, region.width, region.height, \
+                                                         kr, kb, colorRange, sampler); \
+    } \
+    \
+    HWY_DLLEXPORT void \
+    NV##RegionsTo##pixelType(const SparkYuvRegionTarget *targets, uint32_t targetsCount, \
+                             const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride, \
+                             uint32_t width, uint32_t height, \
+                             const float kr, const float kb, const SparkYuvColorRange colorRange, \
+                             const SparkYuvSampler sampler) { \
+      if (targetsCount == 0) { \
+        return; \
+      } \
+      ValidateYCbCrParameters(kr, kb, colorRange); \
+      uint64_t pixels = 0; \
+      for (uint32_t i = 0; i < targetsCount; ++i) { \
+        const SparkYuvRegionTarget &target = targets[i]; \
+        ValidateRegionConversion(width, height, target.region, target.dstWidth, target.dstHeight, sampler); \
+        pixels += static_cast<uint64_t>(target.dstWidth) * target.dstHeight; \
+      } \
+      const auto workload = static_cast<uint32_t>(std::min(pixels, static_cast<uint64_t>(UINT32_MAX))); \
+      const int threadCount = std::min(concurrency::getThreadCounts(workload, 1), static_cast<int>(targetsCount)); \
+      concurrency::parallel_for(threadCount, targetsCount, [&](int i) { \
+        const SparkYuvRegionTarget &target = targets[i]; \
+        HWY_DYNAMIC_DISPATCH(NV##RegionTo##pixelType##HWY)(target.dst, target.dstStride, target.dstWidth, target.dstHeight, \
+                                                           ySrc, yStride, uv, uvStride, width, height, \
+                                                           target.region.x, target.region.y, \
+                                                           target.region.width, target.region.height, \
+                                                           kr, kb, colorRange, sampler); \
+      }); \
+    }
+
+NVXXRegionToXXXX_DECLARATION_E(RGBA, NV21)
+NVXXRegionToXXXX_DECLARATION_E(RGB, NV21)
+#if SPARKYUV_FULL_CHANNELS
+NVXXRegionToXXXX_DECLARATION_E(ARGB, NV21)
+NVXXRegionToXXXX_DECLARATION_E(ABGR, NV21)
+NVXXRegionToXXXX_DECLARATION_E(BGRA, NV21)
+NVXXRegionToXXXX_DECLARATION_E(BGR, NV21)
+#endif
+
+NVXXRegionToXXXX_DECLARATION_E(RGBA, NV12)
+NVXXRegionToXXXX_DECLARATION_E(RGB, NV12)
+#if SPARKYUV_FULL_CHANNELS
+NVXXRegionToXXXX_DECLARATION_E(ARGB, NV12)
+NVXXRegionToXXXX_DECLARATION_E(ABGR, NV12)
+NVXXRegionToXXXX_DECLARATION_E(BGRA, NV12)
+NVXXRegionToXXXX_DECLARATION_E(BGR, NV12)
+#endif
+
+#undef NVXXRegionToXXXX_DECLARATION_E
+
+// MARK: Scaled conversion
+
+#define NVXXToXXXXScaled_DECLARATION_HWY(pixel, NV) HWY_EXPORT(NV##To##pixel##ScaledHWY);
+
+NVXXToXXXXScaled_DECLARATION_HWY(RGBA, NV21)
+NVXXToXXXXScaled_DECLARATION_HWY(RGB, NV21)
+#if SPARKYUV_FULL_CHANNELS
+NVXXToXXXXScaled_DECLARATION_HWY(ARGB, NV21)
+NVXXToXXXXScaled_DECLARATION_HWY(ABGR, NV21)
+NVXXToXXXXScaled_DECLARATION_HWY(BGRA, NV21)
+NVXXToXXXXScaled_DECLARATION_HWY(BGR, NV21)
+#endif
+
+NVXXToXXXXScaled_DECLARATION_HWY(RGBA, NV12)
+NVXXToXXXXScaled_DECLARATION_HWY(RGB, NV12)
+#if SPARKYUV_FULL_CHANNELS
+NVXXToXXXXScaled_DECLARATION_HWY(ARGB, NV12)
+NVXXToXXXXScaled_DECLARATION_HWY(ABGR, NV12)
+NVXXToXXXXScaled_DECLARATION_HWY(BGRA, NV12)
+NVXXToXXXXScaled_DECLARATION_HWY(BGR, NV12)
+#endif
+
+#undef NVXXToXXXXScaled_DECLARATION_HWY
+
+#define NVXXToXXXXScaled_DECLARATION_E(pixelType, NV) \
+    HWY_DLLEXPORT void \
+    NV##To##pixelType##Scaled(uint8_t *dst, uint32_t dstStride, uint32_t dstWidth, uint32_t dstHeight, \
+                              const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride, \
+                              uint32_t width, uint32_t height, \
+                              const float kr, const float kb, const SparkYuvColorRange colorRange) { \
+      ValidateYCbCrParameters(kr, kb, colorRange); \
+      ValidateRegion(width, height, 0, 0, width, height, dstWidth, dstHeight); \
+      const SparkYuvSampler sampler = SelectDecimationSampler(width, height, dstWidth, dstHeight); \
+      const int threadCount = concurrency::getThreadCounts(dstWidth, dstHeight); \
+      concurrency::parallel_for_segment(threadCount, (dstHeight + 1) / 2, [&](int start, int end) { \
+        HWY_DYNAMIC_DISPATCH(NV##To##pixelType##ScaledHWY)(dst, dstStride, dstWidth, dstHeight, ySrc, yStride, uv, uvStride, \
+                                                           width, height, kr, kb, colorRange, sampler, start * 2, \
+                                                           std::min(static_cast<uint32_t>(end * 2), dstHeight)); \
+      }); \
+    }
+
+NVXXToXXXXScaled_DECLARATION_E(RGBA, NV21)
+NVXXToXXXXScaled_DECLARATION_E(RGB, NV21)
+#if SPARKYUV_FULL_CHANNELS
+NVXXToXXXXScaled_DECLARATION_E(ARGB, NV21)
+NVXXToXXXXScaled_DECLARATION_E(ABGR, NV21)
+NVXXToXXXXScaled_DECLARATION_E(BGRA, NV21)
+NVXXToXXXXScaled_DECLARATION_E(BGR, NV21)
+#endif
+
+NVXXToXXXXScaled_DECLARATION_E(RGBA, NV12)
+NVXXToXXXXScaled_DECLARATION_E(RGB, NV12)
+#if SPARKYUV_FULL_CHANNELS
+NVXXToXXXXScaled_DECLARATION_E(ARGB, NV12)
+NVXXToXXXXScaled_DECLARATION_E(ABGR, NV12)
+NVXXToXXXXScaled_DECLARATION_E(BGRA, NV12)
+NVXXToXXXXScaled_DECLARATION_E(BGR, NV12)
+#endif
+
+#undef NVXXToXXXXScaled_DECLARATION_E
+
+// MARK: Tensor conversion
+
+HWY_EXPORT(NV21ToTensorF32HWY);
+HWY_EXPORT(NV21ToTensorF16HWY);
+HWY_EXPORT(NV21ToTensorI8HWY);
+HWY_EXPORT(NV12ToTensorF32HWY);
+HWY_EXPORT(NV12ToTensorF16HWY);
+HWY_EXPORT(NV12ToTensorI8HWY);
+
+#define NVXXToTensor_DECLARATION_E(NV, suffix, storageType) \
+    HWY_DLLEXPORT void \
+    NV##ToTensor##suffix(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride, \
+                         uint32_t width, uint32_t height, \
+                         storageType *tensor, const SparkYuvTensorLayout layout, \
+                         const SparkYuvTensorNormalization normalization, \
+                         const float kr, const float kb, const SparkYuvColorRange colorRange) { \
+      ValidateYCbCrParameters(kr, kb, colorRange); \
+      ValidateTensorTransform(normalization, 1.f); \
+      const int threadCount = concurrency::getThreadCounts(width, height); \
+      concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) { \
+        HWY_DYNAMIC_DISPATCH(NV##ToTensor##suffix##HWY)(ySrc, yStride, uv, uvStride, width, height, \
+                                                        tensor, layout, normalization, 1.f, 0, kr, kb, colorRange, \
+                                                        start * 2, std::min(static_cast<uint32_t>(end * 2), height)); \
+      }); \
+    }
+
+NVXXToTensor_DECLARATION_E(NV21, F32, float)
+NVXXToTensor_DECLARATION_E(NV21, F16, uint16_t)
+NVXXToTensor_DECLARATION_E(NV12, F32, float)
+NVXXToTensor_DECLARATION_E(NV12, F16, uint16_t)
+
+#undef NVXXToTensor_DECLARATION_E
+
+#define NVXXToTensorI8_DECLARATION_E(NV) \
+    HWY_DLLEXPORT void \
+    NV##ToTensorI8(const uint8_t *ySrc, uint32_t yStride, const uint8_t *uv, uint32_t uvStride, \
+                   uint32_t width, uint32_t height, \
+                   int8_t *tensor, const SparkYuvTensorLayout layout, \
+                   const SparkYuvTensorNormalization normalization, \
+                   const float quantizationScale, const int32_t zeroPoint, \
+                   const float kr, const float kb, const SparkYuvColorRange colorRange) { \
+      ValidateYCbCrParameters(kr, kb, colorRange); \
+      ValidateTensorTransform(normalization, quantizationScale); \
+      const int threadCount = concurrency::getThreadCounts(width, height); \
+      concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) { \
+        HWY_DYNAMIC_DISPATCH(NV##ToTensorI8HWY)(ySrc, yStride, uv, uvStride, width, height, \
+                                                tensor, layout, normalization, quantizationScale, zeroPoint, \
+                                                kr, kb, colorRange, \
+                                                start * 2, std::min(static_cast<uint32_t>(end * 2), height)); \
+      }); \
+    }
+
+NVXXToTensorI8_DECLARATION_E(NV21)
+NVXXToTensorI8_DECLARATION_E(NV12)
+
+#undef NVXXToTensorI8_DECLARATION_E
+
 }
-#endif
\ No newline at end of file
+#endif
@@ -102,7 +102,7 @@ void NV16ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
         LoadInterleaved2(du8h, uvSource, vlfh, ulfh);
       }
 
-      const auto luma8 = Sub(LoadU(du8, ySrc), uvCorrIY);
+      const auto luma8 = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
 
       auto ulf = Combine(du8, InterleaveUpper(du8h, ulfh, ulfh), InterleaveLower(ulfh, ulfh));
       auto vlf = Combine(du8, InterleaveUpper(du8h, vlfh, vlfh), InterleaveLower(vlfh, vlfh));
@@ -144,7 +144,7 @@ void NV16ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
       const uint8_t uValue = reinterpret_cast<const uint8_t *>(uvSource)[LoadOrder == YUV_ORDER_UV ? 0 : 1];
       const uint8_t vValue = reinterpret_cast<const uint8_t *>(uvSource)[LoadOrder == YUV_ORDER_UV ? 1 : 0];
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       const int Cr = (static_cast<int>(vValue) - biasUV);
       const int Cb = (static_cast<int>(uValue) - biasUV);
 
@@ -157,7 +157,7 @@ void NV16ToPixel8(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
       ySrc += 1;
 
       if (x + 1 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -269,6 +269,14 @@ void Pixel8ToNV16HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStr
 
   const int components = getPixelTypeComponents(PixelType);
 
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+#endif
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -277,6 +285,32 @@ void Pixel8ToNV16HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStr
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
 
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        const auto Y = BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY));
+        const auto Cbf = BitCast(du16, DotPixels8(di16, mSrc, vDotCb, vDotCbRest, vBiasUV));
+        const auto Crf = BitCast(du16, DotPixels8(di16, mSrc, vDotCr, vDotCrRest, vBiasUV));
+
+        const auto Cb = DemoteTo(du8h, ShiftRightNarrow<1>(du32, SumsOf2(Cbf)));
+        const auto Cr = DemoteTo(du8h, ShiftRightNarrow<1>(du32, SumsOf2(Crf)));
+
+        if (LoadOrder == YUV_ORDER_UV) {
+          StoreInterleaved2(Cb, Cr, du8h, uvDestination);
+        } else {
+          StoreInterleaved2(Cr, Cb, du8h, uvDestination);
+        }
+
+        StoreU(DemoteTo(du8, Y), du8, yDst);
+
+        yDst += lanes;
+        uvDestination += lanes;
+
+        mSrc += components * lanes;
+      }
+    }
+#endif
+
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
       VU8 G8;
@@ -239,6 +239,14 @@ void Pixel8ToNV24HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStr
 
   const int components = getPixelTypeComponents(PixelType);
 
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+#endif
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -247,6 +255,28 @@ void Pixel8ToNV24HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStr
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
 
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        const auto Y = BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY));
+        const auto Cb = DemoteTo(du8, BitCast(du16, DotPixels8(di16, mSrc, vDotCb, vDotCbRest, vBiasUV)));
+        const auto Cr = DemoteTo(du8, BitCast(du16, DotPixels8(di16, mSrc, vDotCr, vDotCrRest, vBiasUV)));
+
+        if (LoadOrder == YUV_ORDER_UV) {
+          StoreInterleaved2(Cb, Cr, du8, uvDestination);
+        } else {
+          StoreInterleaved2(Cr, Cb, du8, uvDestination);
+        }
+
+        StoreU(DemoteTo(du8, Y), du8, yDst);
+
+        yDst += lanes;
+        uvDestination += uvLanes;
+        mSrc += components * lanes;
+      }
+    }
+#endif
+
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
       VU8 G8;
@@ -0,0 +1,290 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_PYRAMID_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_PYRAMID_INL_H
+#undef SPARKYUV_PYRAMID_INL_H
+#else
+#define SPARKYUV_PYRAMID_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "TypeSupport.h"
+#include <algorithm>
+#include <vector>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+/**
+ * 2x2 box reduction of two rows of integer surface. Odd trailing pixel is averaged with itself
+ */
+template<class T, SparkYuvSurfaceChannels Surface>
+SPARKYUV_INLINE static void
+PyramidReduceRow(const T *SPARKYUV_RESTRICT top, const T *SPARKYUV_RESTRICT bottom, T *SPARKYUV_RESTRICT dst,
+                 const uint32_t srcWidth, const uint32_t dstWidth) {
+  static_assert(Surface == SURFACE_CHANNEL || Surface == SURFACE_CHANNELS_3
+                    || Surface == SURFACE_CHANNELS_4, "Unknown surface type");
+  const ScalableTag<T> d;
+  const RepartitionToWide<decltype(d)> dw;
+  const Rebind<T, decltype(dw)> dn;
+  using V = Vec<decltype(d)>;
+  using VN = Vec<decltype(dn)>;
+  const int channels = Surface == SURFACE_CHANNEL ? 1 : (Surface == SURFACE_CHANNELS_3 ? 3 : 4);
+  const uint32_t lanes = Lanes(d);
+  const uint32_t halfLanes = lanes / 2;
+  const auto vRounding = Set(dw, 2);
+
+  const auto box = [&](const V t, const V b) -> VN {
+    return DemoteTo(dn, ShiftRight<2>(Add(Add(SumsOf2(t), SumsOf2(b)), vRounding)));
+  };
+
+  uint32_t x = 0;
+
+  for (; x + halfLanes <= dstWidth && 2 * x + lanes <= srcWidth; x += halfLanes) {
+    const T *t = top + 2 * x * channels;
+    const T *b = bottom + 2 * x * channels;
+    T *store = dst + x * channels;
+    if (Surface == SURFACE_CHANNEL) {
+      StoreU(box(LoadU(d, t), LoadU(d, b)), dn, store);
+    } else if (Surface == SURFACE_CHANNELS_3) {
+      V t1, t2, t3, b1, b2, b3;
+      LoadInterleaved3(d, t, t1, t2, t3);
+      LoadInterleaved3(d, b, b1, b2, b3);
+      StoreInterleaved3(box(t1, b1), box(t2, b2), box(t3, b3), dn, store);
+    } else {
+      V t1, t2, t3, t4, b1, b2, b3, b4;
+      LoadInterleaved4(d, t, t1, t2, t3, t4);
+      LoadInterleaved4(d, b, b1, b2, b3, b4);
+      StoreInterleaved4(box(t1, b1), box(t2, b2), box(t3, b3), box(t4, b4), dn, store);
+    }
+  }
+
+  for (; x < dstWidth; ++x) {
+    const uint32_t x0 = 2 * x * channels;
+    const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1) * channels;
+    for (int c = 0; c < channels; ++c) {
+      const uint32_t sum = static_cast<uint32_t>(top[x0 + c]) + static_cast<uint32_t>(top[x1 + c])
+          + static_cast<uint32_t>(bottom[x0 + c]) + static_cast<uint32_t>(bottom[x1 + c]);
+      dst[x * channels + c] = static_cast<T>((sum + 2) >> 2);
+    }
+  }
+}
+
+/**
+ * 2x2 box reduction of F16 surface rows, accumulation is done in F32
+ */
+template<SparkYuvSurfaceChannels Surface>
+SPARKYUV_INLINE static void
+PyramidReduceRowF16(const uint16_t *SPARKYUV_RESTRICT top, const uint16_t *SPARKYUV_RESTRICT bottom,
+                    uint16_t *SPARKYUV_RESTRICT dst, const uint32_t srcWidth, const uint32_t dstWidth) {
+  static_assert(Surface == SURFACE_CHANNEL || Surface == SURFACE_CHANNELS_3
+                    || Surface == SURFACE_CHANNELS_4, "Unknown surface type");
+  const ScalableTag<uint16_t> du16;
+  const Half<decltype(du16)> du16h;
+  const Rebind<float, decltype(du16h)> df32;
+  const Rebind<hwy::float16_t, decltype(du16h)> df16;
+  using V = Vec<decltype(du16)>;
+  using VH = Vec<decltype(du16h)>;
+  const int channels = Surface == SURFACE_CHANNEL ? 1 : (Surface == SURFACE_CHANNELS_3 ? 3 : 4);
+  const uint32_t lanes = Lanes(du16);
+  const uint32_t halfLanes = lanes / 2;
+  const auto vQuarter = Set(df32, 0.25f);
+
+  const auto pairs = [&](const V v) {
+    const auto even = PromoteTo(df32, BitCast(df16, LowerHalf(du16h, ConcatEven(du16, v, v))));
+    const auto odd = PromoteTo(df32, BitCast(df16, LowerHalf(du16h, ConcatOdd(du16, v, v))));
+    return Add(even, odd);
+  };
+
+  const auto box = [&](const V t, const V b) -> VH {
+    return BitCast(du16h, DemoteTo(df16, Mul(Add(pairs(t), pairs(b)), vQuarter)));
+  };
+
+  auto fTop = reinterpret_cast<const hwy::float16_t *>(top);
+  auto fBottom = reinterpret_cast<const hwy::float16_t *>(bottom);
+  auto fDst = reinterpret_cast<hwy::float16_t *>(dst);
+
+  uint32_t x = 0;
+
+  for (; x + halfLanes <= dstWidth && 2 * x + lanes <= srcWidth; x += halfLanes) {
+    const uint16_t *t = top + 2 * x * channels;
+    const uint16_t *b = bottom + 2 * x * channels;
+    uint16_t *store = dst + x * channels;
+    if (Surface == SURFACE_CHANNEL) {
+      StoreU(box(LoadU(du16, t), LoadU(du16, b)), du16h, store);
+    } else if (Surface == SURFACE_CHANNELS_3) {
+      V t1, t2, t3, b1, b2, b3;
+      LoadInterleaved3(du16, t, t1, t2, t3);
+      LoadInterleaved3(du16, b, b1, b2, b3);
+      StoreInterleaved3(box(t1, b1), box(t2, b2), box(t3, b3), du16h, store);
+    } else {
+      V t1, t2, t3, t4, b1, b2, b3, b4;
+      LoadInterleaved4(du16, t, t1, t2, t3, t4);
+      LoadInterleaved4(du16, b, b1, b2, b3, b4);
+      StoreInterleaved4(box(t1, b1), box(t2, b2), box(t3, b3), box(t4, b4), du16h, store);
+    }
+  }
+
+  for (; x < dstWidth; ++x) {
+    const uint32_t x0 = 2 * x * channels;
+    const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1) * channels;
+    for (int c = 0; c < channels; ++c) {
+      const float sum = LoadFloat(&fTop[x0 + c]) + LoadFloat(&fTop[x1 + c])
+          + LoadFloat(&fBottom[x0 + c]) + LoadFloat(&fBottom[x1 + c]);
+      StoreFloat(&fDst[x * channels + c], sum * 0.25f);
+    }
+  }
+}
+
+/**
+ * 2x2 box reduction of packed RGBA1010102 rows, every field is averaged separately
+ */
+SPARKYUV_INLINE static void
+PyramidReduceRow1010102(const uint8_t *SPARKYUV_RESTRICT top, const uint8_t *SPARKYUV_RESTRICT bottom,
+                        uint8_t *SPARKYUV_RESTRICT dst, const uint32_t srcWidth, const uint32_t dstWidth) {
+  const ScalableTag<uint32_t> du32;
+  using V = Vec<decltype(du32)>;
+  const uint32_t lanes = Lanes(du32);
+  const auto mask = Set(du32, 0x3ff);
+  const auto vRounding = Set(du32, 2);
+
+  auto t32 = reinterpret_cast<const uint32_t *>(top);
+  auto b32 = reinterpret_cast<const uint32_t *>(bottom);
+  auto d32 = reinterpret_cast<uint32_t *>(dst);
+
+  uint32_t x = 0;
+
+  for (; x + lanes <= dstWidth && 2 * x + 2 * lanes <= srcWidth; x += lanes) {
+    const V t0 = LoadU(du32, t32 + 2 * x);
+    const V t1 = LoadU(du32, t32 + 2 * x + lanes);
+    const V b0 = LoadU(du32, b32 + 2 * x);
+    const V b1 = LoadU(du32, b32 + 2 * x + lanes);
+    const V te = ConcatEven(du32, t1, t0);
+    const V to = ConcatOdd(du32, t1, t0);
+    const V be = ConcatEven(du32, b1, b0);
+    const V bo = ConcatOdd(du32, b1, b0);
+
+    const V r = Add(Add(And(te, mask), And(to, mask)), Add(And(be, mask), And(bo, mask)));
+    const V g = Add(Add(And(ShiftRight<10>(te), mask), And(ShiftRight<10>(to), mask)),
+                    Add(And(ShiftRight<10>(be), mask), And(ShiftRight<10>(bo), mask)));
+    const V b = Add(Add(And(ShiftRight<20>(te), mask), And(ShiftRight<20>(to), mask)),
+                    Add(And(ShiftRight<20>(be), mask), And(ShiftRight<20>(bo), mask)));
+    const V a = Add(Add(ShiftRight<30>(te), ShiftRight<30>(to)), Add(ShiftRight<30>(be), ShiftRight<30>(bo)));
+
+    const V packed = Or(Or(ShiftRight<2>(Add(r, vRounding)), ShiftLeft<10>(ShiftRight<2>(Add(g, vRounding)))),
+                        Or(ShiftLeft<20>(ShiftRight<2>(Add(b, vRounding))),
+                           ShiftLeft<30>(ShiftRight<2>(Add(a, vRounding)))));
+    StoreU(packed, du32, d32 + x);
+  }
+
+  for (; x < dstWidth; ++x) {
+    const uint32_t x0 = 2 * x;
+    const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1);
+    const uint32_t pixels[4] = {t32[x0], t32[x1], b32[x0], b32[x1]};
+    uint32_t packed = 0;
+    for (int shift = 0; shift < 30; shift += 10) {
+      uint32_t sum = 0;
+      for (uint32_t pixel : pixels) {
+        sum += (pixel >> shift) & 0x3ff;
+      }
+      packed |= ((sum + 2) >> 2) << shift;
+    }
+    uint32_t alpha = 0;
+    for (uint32_t pixel : pixels) {
+      alpha += pixel >> 30;
+    }
+    packed |= ((alpha + 2) >> 2) << 30;
+    d32[x] = packed;
+  }
+}
+
+/**
+ * Builds pyramid levels in one pass. As soon as two rows of a level are ready they are reduced into the next level
+ * while still hot in cache, so the source is read from memory only once and deeper levels never touch DRAM again.
+ * `startRow` and `endRow` are rows of the first level, when the range is not the whole level
+ * `startRow` must be aligned to 2^(levelsCount - 1)
+ */
+template<typename T, typename RowReducer>
+void BuildPyramidCascade(RowReducer &&reduce,
+                         const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                         const uint32_t width, const uint32_t height,
+                         T **levels, const uint32_t *levelStrides, const uint32_t levelsCount,
+                         const uint32_t startRow, const uint32_t endRow) {
+  std::vector<uint32_t> widths(levelsCount + 1), heights(levelsCount + 1);
+  widths[0] = width;
+  heights[0] = height;
+  for (uint32_t i = 1; i <= levelsCount; ++i) {
+    widths[i] = (widths[i - 1] + 1) / 2;
+    heights[i] = (heights[i - 1] + 1) / 2;
+  }
+
+  const auto row = [&](const uint32_t level, const uint32_t y) -> T * {
+    if (level == 0) {
+      return reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(const_cast<T *>(src)) + y * srcStride);
+    }
+    return reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(levels[level - 1]) + y * levelStrides[level - 1]);
+  };
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    uint32_t level = 1;
+    uint32_t r = y;
+    while (true) {
+      const uint32_t r0 = 2 * r;
+      const uint32_t r1 = std::min(2 * r + 1, heights[level - 1] - 1);
+      reduce(row(level - 1, r0), row(level - 1, r1), row(level, r), widths[level - 1], widths[level]);
+      if (level == levelsCount || ((r & 1) == 0 && r != heights[level] - 1)) {
+        break;
+      }
+      r /= 2;
+      level += 1;
+    }
+  }
+}
+
+#define PYRAMID_DECLARATION_R(srcPixel, storageType, reducer) \
+    void BuildPyramid##srcPixel##HWY(const storageType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                     const uint32_t width, const uint32_t height,\
+                                     storageType **levels, const uint32_t *levelStrides, const uint32_t levelsCount,\
+                                     const uint32_t startRow, const uint32_t endRow) {\
+        BuildPyramidCascade<storageType>(reducer, src, srcStride, width, height,\
+                                         levels, levelStrides, levelsCount, startRow, endRow); \
+    }
+
+PYRAMID_DECLARATION_R(RGBA, uint8_t, (PyramidReduceRow<uint8_t, sparkyuv::SURFACE_CHANNELS_4>))
+PYRAMID_DECLARATION_R(RGB, uint8_t, (PyramidReduceRow<uint8_t, sparkyuv::SURFACE_CHANNELS_3>))
+PYRAMID_DECLARATION_R(Channel, uint8_t, (PyramidReduceRow<uint8_t, sparkyuv::SURFACE_CHANNEL>))
+PYRAMID_DECLARATION_R(RGBA1010102, uint8_t, PyramidReduceRow1010102)
+
+PYRAMID_DECLARATION_R(RGBA16, uint16_t, (PyramidReduceRow<uint16_t, sparkyuv::SURFACE_CHANNELS_4>))
+PYRAMID_DECLARATION_R(RGB16, uint16_t, (PyramidReduceRow<uint16_t, sparkyuv::SURFACE_CHANNELS_3>))
+PYRAMID_DECLARATION_R(Channel16, uint16_t, (PyramidReduceRow<uint16_t, sparkyuv::SURFACE_CHANNEL>))
+
+PYRAMID_DECLARATION_R(RGBAF16, uint16_t, (PyramidReduceRowF16<sparkyuv::SURFACE_CHANNELS_4>))
+PYRAMID_DECLARATION_R(RGBF16, uint16_t, (PyramidReduceRowF16<sparkyuv::SURFACE_CHANNELS_3>))
+PYRAMID_DECLARATION_R(ChannelF16, uint16_t, (PyramidReduceRowF16<sparkyuv::SURFACE_CHANNEL>))
+
+#undef PYRAMID_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
@@ -0,0 +1,123 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/Pyramid.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "Pyramid-inl.h"
+#include "concurrency.hpp"
+#include <stdexcept>
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+#define PYRAMID_EXPORT_DECLARATION(srcPixel) HWY_EXPORT(BuildPyramid##srcPixel##HWY);
+
+PYRAMID_EXPORT_DECLARATION(RGBA)
+PYRAMID_EXPORT_DECLARATION(RGB)
+PYRAMID_EXPORT_DECLARATION(Channel)
+PYRAMID_EXPORT_DECLARATION(RGBA1010102)
+
+PYRAMID_EXPORT_DECLARATION(RGBA16)
+PYRAMID_EXPORT_DECLARATION(RGB16)
+PYRAMID_EXPORT_DECLARATION(Channel16)
+
+PYRAMID_EXPORT_DECLARATION(RGBAF16)
+PYRAMID_EXPORT_DECLARATION(RGBF16)
+PYRAMID_EXPORT_DECLARATION(ChannelF16)
+
+#undef PYRAMID_EXPORT_DECLARATION
+
+/**
+ * Splits first level into bands aligned to 2^(levelsCount - 1) rows, so every band
+ * produces its part of every level independently
+ */
+template<typename Function>
+static void BuildPyramidBands(const uint32_t width, const uint32_t height,
+                              const uint32_t levelsCount, const uint32_t bandScale, Function &&func) {
+  if (levelsCount == 0 || width == 0 || height == 0) {
+    return;
+  }
+  if (levelsCount > 16) {
+    throw std::runtime_error("Pyramid can't have more than 16 levels");
+  }
+  const uint32_t firstLevelHeight = (height + 1) / 2;
+  const uint32_t bandRows = 1u << (levelsCount - 1);
+  const uint32_t bands = (firstLevelHeight + bandRows - 1) / bandRows;
+  const int threadCount = std::min(concurrency::getThreadCounts(width * bandScale, height * bandScale),
+                                   static_cast<int>(bands));
+  concurrency::parallel_for_segment(threadCount, bands, [&](int start, int end) {
+    func(start * bandRows, std::min(end * bandRows, firstLevelHeight));
+  });
+}
+
+#define PYRAMID_DECLARATION_E(srcPixel, storageType) \
+    void BuildPyramid##srcPixel(const storageType *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                const uint32_t width, const uint32_t height,\
+                                storageType **levels, const uint32_t *levelStrides, const uint32_t levelsCount) {\
+        BuildPyramidBands(width, height, levelsCount, 1, [&](uint32_t startRow, uint32_t endRow) {\
+          HWY_DYNAMIC_DISPATCH(BuildPyramid##srcPixel##HWY)(src, srcStride, width, height,\
+                                                            levels, levelStrides, levelsCount, startRow, endRow);\
+        }); \
+    }
+
+PYRAMID_DECLARATION_E(RGBA, uint8_t)
+PYRAMID_DECLARATION_E(RGB, uint8_t)
+PYRAMID_DECLARATION_E(Channel, uint8_t)
+PYRAMID_DECLARATION_E(RGBA1010102, uint8_t)
+
+PYRAMID_DECLARATION_E(RGBA16, uint16_t)
+PYRAMID_DECLARATION_E(RGB16, uint16_t)
+PYRAMID_DECLARATION_E(Channel16, uint16_t)
+
+PYRAMID_DECLARATION_E(RGBAF16, uint16_t)
+PYRAMID_DECLARATION_E(RGBF16, uint16_t)
+PYRAMID_DECLARATION_E(ChannelF16, uint16_t)
+
+#undef PYRAMID_DECLARATION_E
+
+void BuildPyramidYCbCr420(const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yStride,
+                          const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uStride,
+                          const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vStride,
+                          const uint32_t width, const uint32_t height,
+                          uint8_t **yLevels, const uint32_t *yLevelStrides,
+                          uint8_t **uLevels, const uint32_t *uLevelStrides,
+                          uint8_t **vLevels, const uint32_t *vLevelStrides,
+                          const uint32_t levelsCount) {
+  const uint32_t chromaWidth = (width + 1) / 2;
+  const uint32_t chromaHeight = (height + 1) / 2;
+  const uint32_t lumaFirstLevelHeight = (height + 1) / 2;
+  // Bands are counted in chroma rows, every chroma band covers twice more luma rows,
+  // so luma and chroma of the same area are reduced together by one worker
+  BuildPyramidBands(chromaWidth, chromaHeight, levelsCount, 2,
+                    [&](uint32_t startRow, uint32_t endRow) {
+                      HWY_DYNAMIC_DISPATCH(BuildPyramidChannelHWY)(ySrc, yStride, width, height,
+                                                                   yLevels, yLevelStrides, levelsCount,
+                                                                   std::min(startRow * 2, lumaFirstLevelHeight),
+                                                                   std::min(endRow * 2, lumaFirstLevelHeight));
+                      HWY_DYNAMIC_DISPATCH(BuildPyramidChannelHWY)(uSrc, uStride, chromaWidth, chromaHeight,
+                                                                   uLevels, uLevelStrides, levelsCount,
+                                                                   startRow, endRow);
+                      HWY_DYNAMIC_DISPATCH(BuildPyramidChannelHWY)(vSrc, vStride, chromaWidth, chromaHeight,
+                                                                   vLevels, vLevelStrides, levelsCount,
+                                                                   startRow, endRow);
+                    });
+}
+
+}
+#endif
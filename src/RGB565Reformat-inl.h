@@ -25,6 +25,7 @@
 #include "src/yuv-inl.h"
 #include "src/sparkyuv-internal.h"
 #include "TypeSupport.h"
+#include "Dither-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
@@ -32,7 +33,8 @@ template<class T, SparkYuvReformatPixelType PixelType = sparkyuv::REFORMAT_RGBA>
 void
 ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                             uint16_t *SPARKYUV_RESTRICT destination, const uint32_t dstStride,
-                            const uint32_t width, const uint32_t height, const int bitDepth) {
+                            const uint32_t width, const uint32_t height, const int bitDepth,
+                            const SparkYuvDither dither) {
   const int rbShiftDiff = bitDepth - 5;
   const int gShiftDiff = bitDepth - 6;
 
@@ -42,6 +44,14 @@ ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcSt
   const int components = (PixelType == REFORMAT_BGR || PixelType == REFORMAT_RGB) ? 3 : 4;
 
   const ScalableTag<uint16_t> d16;
+  using V16 = Vec<decltype(d16)>;
+
+  // Thresholds are added before the shifts, sums are clamped so shifted values stay in 5 and 6 bits
+  const bool useDither = dither != DITHER_NONE;
+  const auto maxColors = static_cast<uint32_t>((1 << bitDepth) - 1);
+  const V16 vMaxColors = Set(d16, static_cast<uint16_t>(maxColors));
+  HWY_ALIGN uint16_t rbDitherRow[HWY_MAX_BYTES + kDitherRowPeriod];
+  HWY_ALIGN uint16_t gDitherRow[HWY_MAX_BYTES + kDitherRowPeriod];
 
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
@@ -49,7 +59,20 @@ ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcSt
     auto srcPixels = reinterpret_cast<const T *>(mSource);
     auto dstPixels = reinterpret_cast<uint16_t *>(mDestination);
 
-    if (std::is_same<T, uint8_t>::value) {
+    if (useDither) {
+      FillDitherRow(rbDitherRow, y, HWY_MAX_BYTES + kDitherRowPeriod, rbShiftDiff, dither);
+      FillDitherRow(gDitherRow, y, HWY_MAX_BYTES + kDitherRowPeriod, gShiftDiff, dither);
+    }
+
+    auto applyDither = [&](V16 &R, V16 &G, V16 &B, const uint32_t offset) {
+      const V16 rbThreshold = LoadU(d16, rbDitherRow + offset);
+      const V16 gThreshold = LoadU(d16, gDitherRow + offset);
+      R = Min(SaturatedAdd(R, rbThreshold), vMaxColors);
+      G = Min(SaturatedAdd(G, gThreshold), vMaxColors);
+      B = Min(SaturatedAdd(B, rbThreshold), vMaxColors);
+    };
+
+    if (std::is_same<T, uint8_t>::value && PixelType != REFORMAT_RGBA1010102) {
       const ScalableTag<uint8_t> d8;
       const int lanes = Lanes(d8);
       const int writeLanes = Lanes(d16);
@@ -65,6 +88,10 @@ ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcSt
         auto G16l = PromoteLowerTo(d16, G);
         auto B16l = PromoteLowerTo(d16, B);
 
+        if (useDither) {
+          applyDither(R16l, G16l, B16l, x & 7);
+        }
+
         R16l = ShiftLeft<11>(ShiftRightSame(R16l, rbShiftDiff));
         G16l = ShiftLeft<5>(ShiftRightSame(G16l, gShiftDiff));
         B16l = ShiftRightSame(B16l, rbShiftDiff);
@@ -76,6 +103,10 @@ ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcSt
         G16l = PromoteUpperTo(d16, G);
         B16l = PromoteUpperTo(d16, B);
 
+        if (useDither) {
+          applyDither(R16l, G16l, B16l, (x & 7) + writeLanes);
+        }
+
         R16l = ShiftLeft<11>(ShiftRightSame(R16l, rbShiftDiff));
         G16l = ShiftLeft<5>(ShiftRightSame(G16l, gShiftDiff));
         B16l = ShiftRightSame(B16l, rbShiftDiff);
@@ -86,43 +117,75 @@ ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcSt
         srcPixels += components * lanes;
         dstPixels += writeLanes * 2;
       }
+    } else if (std::is_same<T, uint8_t>::value && PixelType == REFORMAT_RGBA1010102) {
+      // Pixels are unpacked in 32-bit lanes and narrowed to 16-bit, so all 10 bits reach dithering and shifts
+      const RepartitionToWide<decltype(d16)> d32;
+      const Half<decltype(d16)> d16h;
+      const int lanes = Lanes(d16);
+      const int halfLanes = Lanes(d32);
+      const auto vMask = Set(d32, 0x3FF);
+      for (; x + lanes < width; x += lanes) {
+        const auto pixels = reinterpret_cast<const uint32_t *>(srcPixels);
+        const auto lo = LoadU(d32, pixels);
+        const auto hi = LoadU(d32, pixels + halfLanes);
+
+        V16 R = Combine(d16, DemoteTo(d16h, And(ShiftRight<20>(hi), vMask)),
+                        DemoteTo(d16h, And(ShiftRight<20>(lo), vMask)));
+        V16 G = Combine(d16, DemoteTo(d16h, And(ShiftRight<10>(hi), vMask)),
+                        DemoteTo(d16h, And(ShiftRight<10>(lo), vMask)));
+        V16 B = Combine(d16, DemoteTo(d16h, And(hi, vMask)), DemoteTo(d16h, And(lo, vMask)));
+
+        if (useDither) {
+          applyDither(R, G, B, x & 7);
+        }
+
+        const auto R32h = ShiftLeft<11>(ShiftRightSame(R, rbShiftDiff));
+        const auto G32h = ShiftLeft<5>(ShiftRightSame(G, gShiftDiff));
+        const auto B32h = ShiftRightSame(B, rbShiftDiff);
+        const auto px = Or(Or(R32h, G32h), B32h);
+
+        StoreU(px, d16, reinterpret_cast<uint16_t *>(dstPixels));
+
+        srcPixels += components * lanes;
+        dstPixels += lanes;
+      }
     } else if (std::is_same<T, uint16_t>::value) {
       const int lanes = Lanes(d16);
-      const int writeLanes = Lanes(d16);
-      using V = Vec<decltype(d16)>;
-      V R;
-      V G;
-      V B;
-      V A;
-      LoadReformatRGBA<PixelType>(d16, reinterpret_cast<const uint16_t *>(srcPixels), R, G, B, A);
+      for (; x + lanes < width; x += lanes) {
+        V16 R;
+        V16 G;
+        V16 B;
+        V16 A;
+        LoadReformatRGBA<PixelType>(d16, reinterpret_cast<const uint16_t *>(srcPixels), R, G, B, A);
+
+        if (useDither) {
+          applyDither(R, G, B, x & 7);
+        }
 
-      const auto R32h = ShiftLeft<11>(ShiftRightSame(R, rbShiftDiff));
-      const auto G32h = ShiftLeft<5>(ShiftRightSame(G, gShiftDiff));
-      const auto B32h = ShiftRightSame(B, rbShiftDiff);
-      const auto hi = Or(Or(R32h, G32h), B32h);
+        const auto R32h = ShiftLeft<11>(ShiftRightSame(R, rbShiftDiff));
+        const auto G32h = ShiftLeft<5>(ShiftRightSame(G, gShiftDiff));
+        const auto B32h = ShiftRightSame(B, rbShiftDiff);
+        const auto hi = Or(Or(R32h, G32h), B32h);
 
-      StoreU(hi, d16, reinterpret_cast<uint16_t *>(dstPixels));
+        StoreU(hi, d16, reinterpret_cast<uint16_t *>(dstPixels));
 
-      srcPixels += components * lanes;
-      dstPixels += writeLanes;
+        srcPixels += components * lanes;
+        dstPixels += lanes;
+      }
     }
 
     for (; x < width; ++x) {
-      T r;
-      T g;
-      T b;
+      uint32_t r;
+      uint32_t g;
+      uint32_t b;
 
       switch (PixelType) {
         case REFORMAT_RGBA1010102: {
           uint32_t rgba1010102 = reinterpret_cast<const uint32_t *>(srcPixels)[0];
           const uint32_t scalarMask = (1u << 10u) - 1u;
-          uint32_t b32, g32, r32;
-          b32 = static_cast<T>((rgba1010102 & scalarMask));
-          g32 = static_cast<T>(((rgba1010102 >> 10) & scalarMask));
-          r32 = static_cast<T>(((rgba1010102 >> 20) & scalarMask));
-          r = static_cast<T>(r32);
-          g = static_cast<T>(g32);
-          b = static_cast<T>(b32);
+          b = rgba1010102 & scalarMask;
+          g = (rgba1010102 >> 10) & scalarMask;
+          r = (rgba1010102 >> 20) & scalarMask;
         }
           break;
         case REFORMAT_RGBA:
@@ -153,6 +216,14 @@ ReformatSurfaceToRGB565Impl(const T *SPARKYUV_RESTRICT src, const uint32_t srcSt
           break;
       }
 
+      if (useDither) {
+        const uint32_t rbThreshold = BayerThreshold(x, y, rbShiftDiff);
+        const uint32_t gThreshold = BayerThreshold(x, y, gShiftDiff);
+        r = std::min(r + rbThreshold, maxColors);
+        g = std::min(g + gThreshold, maxColors);
+        b = std::min(b + rbThreshold, maxColors);
+      }
+
       uint16_t red565 = (r >> rbShiftDiff) << 11;
       uint16_t green565 = (g >> gShiftDiff) << 5;
       uint16_t blue565 = b >> rbShiftDiff;
@@ -288,7 +359,7 @@ template<SparkYuvReformatPixelType PixelType = sparkyuv::REFORMAT_RGBA>
 void
 ReformatF16ToRGB565Impl(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                         uint16_t *SPARKYUV_RESTRICT destination, const uint32_t dstStride,
-                        const uint32_t width, const uint32_t height) {
+                        const uint32_t width, const uint32_t height, const SparkYuvDither dither) {
   static_assert(PixelType != REFORMAT_RGBA1010102, "RGBA1010102 has no sense in F16");
   auto mSource = reinterpret_cast<const uint8_t *>(src);
   auto mDestination = reinterpret_cast<uint8_t *>(destination);
@@ -304,8 +375,14 @@ ReformatF16ToRGB565Impl(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t sr
   const int lanes = Lanes(df);
   using V = Vec<decltype(df)>;
   const Rebind<uint16_t, decltype(df)> d16;
+  const auto vRBMax = Set(d16, 0x1F);
+  const auto vGMax = Set(d16, 0x3F);
+  HWY_ALIGN hwy::float16_t ditherRow[HWY_MAX_BYTES / sizeof(uint16_t) + kDitherRowPeriod];
 #endif
 
+  // Dithered path truncates after adding a fractional threshold, plain path rounds
+  const bool useDither = dither != DITHER_NONE;
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -313,6 +390,10 @@ ReformatF16ToRGB565Impl(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t sr
     auto dstPixels = reinterpret_cast<uint16_t *>(mDestination);
 
 #if SPARKYUV_ALLOW_FLOAT16
+    if (useDither) {
+      FillDitherRow(ditherRow, y, lanes + kDitherRowPeriod, dither);
+    }
+
     for (; x + lanes < width; x += lanes) {
       V R;
       V G;
@@ -320,13 +401,21 @@ ReformatF16ToRGB565Impl(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t sr
       V A;
       LoadReformatRGBA<PixelType>(df, reinterpret_cast<const hwy::float16_t *>(srcPixels), R, G, B, A);
 
-      R = Mul(R, vRBScale);
-      G = Mul(G, vGScale);
-      B = Mul(B, vRBScale);
+      Vec<decltype(d16)> R16, G16, B16;
+      if (useDither) {
+        const V threshold = LoadU(df, ditherRow + (x & 7));
+        R16 = Min(ConvertTo(d16, MulAdd(R, vRBScale, threshold)), vRBMax);
+        G16 = Min(ConvertTo(d16, MulAdd(G, vGScale, threshold)), vGMax);
+        B16 = Min(ConvertTo(d16, MulAdd(B, vRBScale, threshold)), vRBMax);
+      } else {
+        R16 = ConvertTo(d16, Mul(R, vRBScale));
+        G16 = ConvertTo(d16, Mul(G, vGScale));
+        B16 = ConvertTo(d16, Mul(B, vRBScale));
+      }
 
-      const auto R32h = ShiftLeft<11>(ConvertTo(d16, R));
-      const auto G32h = ShiftLeft<5>(ConvertTo(d16, G));
-      const auto B32h = ConvertTo(d16, B);
+      const auto R32h = ShiftLeft<11>(R16);
+      const auto G32h = ShiftLeft<5>(G16);
+      const auto B32h = B16;
       const auto px = Or(Or(R32h, G32h), B32h);
 
       StoreU(px, d16, reinterpret_cast<uint16_t *>(dstPixels));
@@ -372,9 +461,17 @@ ReformatF16ToRGB565Impl(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t sr
           break;
       }
 
-      uint16_t r565 = static_cast<uint16_t>(::roundf(r * rbMaxColors)) & 0x1F;
-      uint16_t g565 = static_cast<uint16_t>(::roundf(g * gMaxColors)) & 0x3F;
-      uint16_t b565 = static_cast<uint16_t>(::roundf(b * rbMaxColors)) & 0x1F;
+      uint16_t r565, g565, b565;
+      if (useDither) {
+        const float threshold = BayerThreshold(x, y);
+        r565 = static_cast<uint16_t>(std::clamp(::floorf(r * rbMaxColors + threshold), 0.f, rbMaxColors));
+        g565 = static_cast<uint16_t>(std::clamp(::floorf(g * gMaxColors + threshold), 0.f, gMaxColors));
+        b565 = static_cast<uint16_t>(std::clamp(::floorf(b * rbMaxColors + threshold), 0.f, rbMaxColors));
+      } else {
+        r565 = static_cast<uint16_t>(::roundf(r * rbMaxColors)) & 0x1F;
+        g565 = static_cast<uint16_t>(::roundf(g * gMaxColors)) & 0x3F;
+        b565 = static_cast<uint16_t>(::roundf(b * rbMaxColors)) & 0x1F;
+      }
 
       uint16_t red565 = r565 << 11;
       uint16_t green565 = g565 << 5;
@@ -395,9 +492,9 @@ ReformatF16ToRGB565Impl(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t sr
 #define REFORMATF16_TO_RGB565(PixelName, Pixel) \
     void PixelName##ToRGB565HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                 uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
-                                const uint32_t width, const uint32_t height) {\
+                                const uint32_t width, const uint32_t height, const SparkYuvDither dither) {\
         ReformatF16ToRGB565Impl<sparkyuv::REFORMAT_##Pixel>(src, srcStride, dst, dstStride,\
-                                                           width, height);\
+                                                           width, height, dither);\
     }
 
 REFORMATF16_TO_RGB565(RGBF16, RGB)
@@ -412,9 +509,9 @@ REFORMATF16_TO_RGB565(ARGBF16, ARGB)
 #define REFORMAT_TO_RGB565_BIT_DEFINED(PixelName, Pixel, T, depth) \
     void PixelName##ToRGB565HWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                 uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
-                                const uint32_t width, const uint32_t height) {\
+                                const uint32_t width, const uint32_t height, const SparkYuvDither dither) {\
         ReformatSurfaceToRGB565Impl<T, sparkyuv::REFORMAT_##Pixel>(src, srcStride, dst, dstStride,\
-                                                                  width, height, depth);\
+                                                                  width, height, depth, dither);\
     }
 
 REFORMAT_TO_RGB565_BIT_DEFINED(RGB, RGB, uint8_t, 8)
@@ -430,9 +527,10 @@ REFORMAT_TO_RGB565_BIT_DEFINED(RGBA1010102, RGBA1010102, uint8_t, 10)
 #define REFORMAT_TO_RGB565(PixelName, Pixel, T) \
     void PixelName##ToRGB565HWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                 uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
-                                const uint32_t width, const uint32_t height, const int bitDepth) {\
+                                const uint32_t width, const uint32_t height, const int bitDepth,\
+                                const SparkYuvDither dither) {\
         ReformatSurfaceToRGB565Impl<T, sparkyuv::REFORMAT_##Pixel>(src, srcStride, dst, dstStride,\
-                                                                  width, height, bitDepth);\
+                                                                  width, height, bitDepth, dither);\
     }
 
 REFORMAT_TO_RGB565(RGB16, RGB, uint16_t)
@@ -48,11 +48,17 @@ REFORMAT_TO_RGB565_DECLARE_HWY(ARGBF16)
 #undef REFORMAT_TO_RGB565_DECLARE_HWY
 
 #define REFORMATF16_TO_RGB565_E(PixelName, Pixel) \
+    void PixelName##ToRGB565HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                const uint32_t width, const uint32_t height, const SparkYuvDither dither) {\
+        HWY_DYNAMIC_DISPATCH(PixelName##ToRGB565HWY)(src, srcStride, dst, dstStride,\
+                                                     width, height, dither);\
+    }\
     void PixelName##ToRGB565HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                 uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                 const uint32_t width, const uint32_t height) {\
         HWY_DYNAMIC_DISPATCH(PixelName##ToRGB565HWY)(src, srcStride, dst, dstStride,\
-                                                     width, height);\
+                                                     width, height, DITHER_NONE);\
     }
 
 REFORMATF16_TO_RGB565_E(RGBF16, RGB)
@@ -65,11 +71,17 @@ REFORMATF16_TO_RGB565_E(ARGBF16, ARGB)
 #undef REFORMATF16_TO_RGB565_E
 
 #define REFORMAT_TO_RGB565_NBIT(PixelName, Pixel, T) \
+    void PixelName##ToRGB565(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                const uint32_t width, const uint32_t height, const SparkYuvDither dither) {\
+        HWY_DYNAMIC_DISPATCH(PixelName##ToRGB565HWY)(src, srcStride, dst, dstStride,\
+                                                     width, height, dither);\
+    }\
     void PixelName##ToRGB565(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                 uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                 const uint32_t width, const uint32_t height) {\
         HWY_DYNAMIC_DISPATCH(PixelName##ToRGB565HWY)(src, srcStride, dst, dstStride,\
-                                                     width, height);\
+                                                     width, height, DITHER_NONE);\
     }
 
 REFORMAT_TO_RGB565_NBIT(RGB, RGB, uint8_t)
@@ -89,11 +101,18 @@ REFORMAT_TO_RGB565_NBIT(ARGBF16, ARGB, uint16_t)
 #undef REFORMAT_TO_RGB565_NBIT
 
 #define REFORMAT_TO_RGB565(PixelName, Pixel, T) \
+    void PixelName##ToRGB565(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                const uint32_t width, const uint32_t height, const int bitDepth,\
+                                const SparkYuvDither dither) {\
+        HWY_DYNAMIC_DISPATCH(PixelName##ToRGB565HWY)(src, srcStride, dst, dstStride,\
+                                                     width, height, bitDepth, dither);\
+    }\
     void PixelName##ToRGB565(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                 uint16_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
                                 const uint32_t width, const uint32_t height, const int bitDepth) {\
         HWY_DYNAMIC_DISPATCH(PixelName##ToRGB565HWY)(src, srcStride, dst, dstStride,\
-                                                     width, height, bitDepth);\
+                                                     width, height, bitDepth, DITHER_NONE);\
     }
 
 REFORMAT_TO_RGB565(RGB16, RGB, uint16_t)
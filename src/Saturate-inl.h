@@ -24,6 +24,7 @@
 #include "hwy/highway.h"
 #include "yuv-inl.h"
 #include "sparkyuv-internal.h"
+#include "Dither-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
@@ -35,7 +36,7 @@ namespace sparkyuv::HWY_NAMESPACE {
 template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, int sourceBitDepth>
 void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                                 uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
-                                const uint32_t width, const uint32_t height) {
+                                const uint32_t width, const uint32_t height, const SparkYuvDither dither) {
   const ScalableTag<uint16_t> du16;
   const Rebind<uint8_t, decltype(du16)> du8;
   using V8 = Vec<decltype(du8)>;
@@ -47,6 +48,12 @@ void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uin
 
   const int diff = sourceBitDepth - 8;
 
+  // Threshold is added before the shift, sum is clamped so the shifted value stays in 8 bits
+  const bool useDither = dither != DITHER_NONE;
+  const auto maxColors = static_cast<uint32_t>((1 << sourceBitDepth) - 1);
+  const V16 vMaxColors = Set(du16, static_cast<uint16_t>(maxColors));
+  HWY_ALIGN uint16_t ditherRow[HWY_MAX_BYTES / sizeof(uint16_t) + kDitherRowPeriod];
+
   auto mSource = reinterpret_cast<const uint8_t *>(src);
   auto mDestination = reinterpret_cast<uint8_t *>(dst);
 
@@ -56,6 +63,10 @@ void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uin
 
     uint32_t x = 0;
 
+    if (useDither) {
+      FillDitherRow(ditherRow, y, lanes + kDitherRowPeriod, diff, dither);
+    }
+
     for (; x + lanes < width; x += lanes) {
       V16 R;
       V16 G;
@@ -63,6 +74,13 @@ void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uin
       V16 A;
       LoadRGBA<PixelType>(du16, source, R, G, B, A);
 
+      if (useDither) {
+        const V16 threshold = LoadU(du16, ditherRow + (x & 7));
+        R = Min(SaturatedAdd(R, threshold), vMaxColors);
+        G = Min(SaturatedAdd(G, threshold), vMaxColors);
+        B = Min(SaturatedAdd(B, threshold), vMaxColors);
+      }
+
       V8 R8, G8, B8, A8;
 
       if (diff == 2) {
@@ -95,10 +113,6 @@ void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uin
         }
       }
 
-      if (PixelType != PIXEL_BGR && PixelType != PIXEL_RGB) {
-        A8 = DemoteTo(du8, A);
-      }
-
       StoreRGBA<PixelType>(du8, store, R8, G8, B8, A8);
 
       store += lanes * components;
@@ -113,6 +127,13 @@ void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uin
 
       LoadRGBA<uint16_t, uint16_t, PixelType>(source, r, g, b, a);
 
+      if (useDither) {
+        const uint32_t threshold = BayerThreshold(x, y, diff);
+        r = static_cast<uint16_t>(std::min(r + threshold, maxColors));
+        g = static_cast<uint16_t>(std::min(g + threshold, maxColors));
+        b = static_cast<uint16_t>(std::min(b + threshold, maxColors));
+      }
+
       r = r >> diff;
       g = g >> diff;
       b = b >> diff;
@@ -137,7 +158,8 @@ void SaturateSurfaceFromNBitTo8(const uint16_t *SPARKYUV_RESTRICT src, const uin
 template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
 void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                           uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
-                          const uint32_t width, const uint32_t height, const int sourceBitDepth) {
+                          const uint32_t width, const uint32_t height, const int sourceBitDepth,
+                          const SparkYuvDither dither) {
   const ScalableTag<uint16_t> du16;
   const Rebind<uint8_t, decltype(du16)> du8;
   using V8 = Vec<decltype(du8)>;
@@ -149,6 +171,12 @@ void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
 
   const int diff = sourceBitDepth - 8;
 
+  // Threshold is added before the shift, sum is clamped so the shifted value stays in 8 bits
+  const bool useDither = dither != DITHER_NONE;
+  const auto maxColors = static_cast<uint32_t>((1 << sourceBitDepth) - 1);
+  const V16 vMaxColors = Set(du16, static_cast<uint16_t>(maxColors));
+  HWY_ALIGN uint16_t ditherRow[HWY_MAX_BYTES / sizeof(uint16_t) + kDitherRowPeriod];
+
   auto mSource = reinterpret_cast<const uint8_t *>(src);
   auto mDestination = reinterpret_cast<uint8_t *>(dst);
 
@@ -158,6 +186,10 @@ void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
 
     uint32_t x = 0;
 
+    if (useDither) {
+      FillDitherRow(ditherRow, y, lanes + kDitherRowPeriod, diff, dither);
+    }
+
     for (; x + lanes < width; x += lanes) {
       V16 R;
       V16 G;
@@ -165,6 +197,13 @@ void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
       V16 A;
       LoadRGBA<PixelType>(du16, source, R, G, B, A);
 
+      if (useDither) {
+        const V16 threshold = LoadU(du16, ditherRow + (x & 7));
+        R = Min(SaturatedAdd(R, threshold), vMaxColors);
+        G = Min(SaturatedAdd(G, threshold), vMaxColors);
+        B = Min(SaturatedAdd(B, threshold), vMaxColors);
+      }
+
       R = ShiftRightSame(R, diff);
       G = ShiftRightSame(G, diff);
       B = ShiftRightSame(B, diff);
@@ -176,10 +215,6 @@ void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
       const V8 G8 = DemoteTo(du8, G);
       const V8 B8 = DemoteTo(du8, B);
       V8 A8;
-      if (PixelType != PIXEL_BGR && PixelType != PIXEL_RGB) {
-        A8 = DemoteTo(du8, A);
-      }
-
       StoreRGBA<PixelType>(du8, store, R8, G8, B8, A8);
 
       store += lanes * components;
@@ -194,6 +229,13 @@ void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
 
       LoadRGBA<uint16_t, uint16_t, PixelType>(source, r, g, b, a);
 
+      if (useDither) {
+        const uint32_t threshold = BayerThreshold(x, y, diff);
+        r = static_cast<uint16_t>(std::min(r + threshold, maxColors));
+        g = static_cast<uint16_t>(std::min(g + threshold, maxColors));
+        b = static_cast<uint16_t>(std::min(b + threshold, maxColors));
+      }
+
       r = r >> diff;
       g = g >> diff;
       b = b >> diff;
@@ -215,9 +257,10 @@ void SaturateSurface16To8(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
 #define SaturateXXXXFromNTo8_DECLARATION_R(pixelType, sourceBitDepth) \
     void Saturate##pixelType##sourceBitDepth##To8HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride, \
                                                      uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
-                                                     const uint32_t width, const uint32_t height) {\
+                                                     const uint32_t width, const uint32_t height,\
+                                                     const SparkYuvDither dither) {\
         SaturateSurfaceFromNBitTo8<sparkyuv::PIXEL_##pixelType, sourceBitDepth>(src, srcStride, dst, dstStride,\
-                                                                                width, height); \
+                                                                                width, height, dither); \
     }
 
 SaturateXXXXFromNTo8_DECLARATION_R(RGBA, 10)
@@ -234,9 +277,10 @@ SaturateXXXXFromNTo8_DECLARATION_R(RGB, 16)
 #define SaturateXXXX16_T08_DECLARATION_R(pixelType) \
     void Saturate##pixelType##16##HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride, \
                                                      uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
-                                                     const uint32_t width, const uint32_t height, const int sourceBitDepth) {\
+                                                     const uint32_t width, const uint32_t height, const int sourceBitDepth,\
+                                                     const SparkYuvDither dither) {\
         SaturateSurface16To8<sparkyuv::PIXEL_##pixelType>(src, srcStride, dst, dstStride,\
-                                                           width, height, sourceBitDepth); \
+                                                           width, height, sourceBitDepth, dither); \
     }
 
 SaturateXXXX16_T08_DECLARATION_R(RGBA)
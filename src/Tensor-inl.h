@@ -0,0 +1,176 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_TENSOR_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_TENSOR_INL_H
+#undef SPARKYUV_TENSOR_INL_H
+#else
+#define SPARKYUV_TENSOR_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-def.h"
+#include "sparkyuv-internal.h"
+#include "TypeSupport.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+/**
+ * (x / 255 - mean) / std and optional quantization q = v / scale + zeroPoint are folded into x * scale + bias,
+ * std and scale are checked by ValidateTensorTransform in the public wrapper
+ */
+struct TensorTransform {
+  float scale[3];
+  float bias[3];
+};
+
+static TensorTransform ComputeTensorTransform(const SparkYuvTensorNormalization normalization,
+                                              const float quantizationScale, const int32_t zeroPoint) {
+  TensorTransform transform{};
+  for (int c = 0; c < 3; ++c) {
+    transform.scale[c] = 1.f / (255.f * normalization.std[c] * quantizationScale);
+    transform.bias[c] = -normalization.mean[c] / (normalization.std[c] * quantizationScale)
+        + static_cast<float>(zeroPoint);
+  }
+  return transform;
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void StoreTensorPlane(D d, V v, float *SPARKYUV_RESTRICT store) {
+  StoreU(v, d, store);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void StoreTensorPlane(D d, V v, hwy::float16_t *SPARKYUV_RESTRICT store) {
+  const Rebind<hwy::float16_t, D> df16;
+  StoreU(DemoteTo(df16, v), df16, store);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void StoreTensorPlane(D d, V v, int8_t *SPARKYUV_RESTRICT store) {
+  const Rebind<int8_t, D> di8;
+  StoreU(DemoteTo(di8, NearestInt(v)), di8, store);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void StoreTensorInterleaved(D d, V r, V g, V b, float *SPARKYUV_RESTRICT store) {
+  StoreInterleaved3(r, g, b, d, store);
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void StoreTensorInterleaved(D d, V r, V g, V b, hwy::float16_t *SPARKYUV_RESTRICT store) {
+  const Rebind<hwy::float16_t, D> df16;
+  const Rebind<uint16_t, D> du16;
+  StoreInterleaved3(BitCast(du16, DemoteTo(df16, r)), BitCast(du16, DemoteTo(df16, g)),
+                    BitCast(du16, DemoteTo(df16, b)), du16, reinterpret_cast<uint16_t *>(store));
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API void StoreTensorInterleaved(D d, V r, V g, V b, int8_t *SPARKYUV_RESTRICT store) {
+  const Rebind<int8_t, D> di8;
+  StoreInterleaved3(DemoteTo(di8, NearestInt(r)), DemoteTo(di8, NearestInt(g)),
+                    DemoteTo(di8, NearestInt(b)), di8, store);
+}
+
+SPARKYUV_INLINE static void StoreTensorValue(float *store, const float v) {
+  store[0] = v;
+}
+
+SPARKYUV_INLINE static void StoreTensorValue(hwy::float16_t *store, const float v) {
+  store[0] = TransformCast<hwy::float16_t, float>(v);
+}
+
+SPARKYUV_INLINE static void StoreTensorValue(int8_t *store, const float v) {
+  store[0] = static_cast<int8_t>(std::clamp(static_cast<int>(::lrintf(v)), -128, 127));
+}
+
+/**
+ * Normalizes one row of 8-bit pixels into row `y` of RGB tensor with `width` x `height` spatial size
+ */
+template<SparkYuvDefaultPixelType PixelType, typename T>
+void PixelRowToTensor(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t width, const uint32_t height,
+                      const uint32_t y, T *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,
+                      const TensorTransform &transform) {
+  const ScalableTag<float> df;
+  const Rebind<int32_t, decltype(df)> di32;
+  using VI32 = Vec<decltype(di32)>;
+
+  const int components = getPixelTypeComponents(PixelType);
+  const uint32_t lanes = Lanes(df);
+  const size_t planeSize = static_cast<size_t>(width) * height;
+
+  const auto vScaleR = Set(df, transform.scale[0]);
+  const auto vScaleG = Set(df, transform.scale[1]);
+  const auto vScaleB = Set(df, transform.scale[2]);
+  const auto vBiasR = Set(df, transform.bias[0]);
+  const auto vBiasG = Set(df, transform.bias[1]);
+  const auto vBiasB = Set(df, transform.bias[2]);
+
+  T *rStore = tensor + static_cast<size_t>(y) * width;
+  T *gStore = rStore + planeSize;
+  T *bStore = gStore + planeSize;
+  T *hwcStore = tensor + static_cast<size_t>(y) * width * 3;
+
+  auto mSrc = reinterpret_cast<const uint8_t *>(src);
+
+  uint32_t x = 0;
+
+  for (; x + lanes <= width; x += lanes) {
+    VI32 R32, G32, B32;
+    LoadRGB<PixelType>(di32, mSrc, R32, G32, B32);
+    const auto r = MulAdd(ConvertTo(df, R32), vScaleR, vBiasR);
+    const auto g = MulAdd(ConvertTo(df, G32), vScaleG, vBiasG);
+    const auto b = MulAdd(ConvertTo(df, B32), vScaleB, vBiasB);
+    if (layout == TENSOR_CHW) {
+      StoreTensorPlane(df, r, rStore + x);
+      StoreTensorPlane(df, g, gStore + x);
+      StoreTensorPlane(df, b, bStore + x);
+    } else {
+      StoreTensorInterleaved(df, r, g, b, hwcStore + x * 3);
+    }
+    mSrc += lanes * components;
+  }
+
+  for (; x < width; ++x) {
+    int r, g, b;
+    LoadRGB<uint8_t, int, PixelType>(mSrc, r, g, b);
+    const float fr = static_cast<float>(r) * transform.scale[0] + transform.bias[0];
+    const float fg = static_cast<float>(g) * transform.scale[1] + transform.bias[1];
+    const float fb = static_cast<float>(b) * transform.scale[2] + transform.bias[2];
+    if (layout == TENSOR_CHW) {
+      StoreTensorValue(rStore + x, fr);
+      StoreTensorValue(gStore + x, fg);
+      StoreTensorValue(bStore + x, fb);
+    } else {
+      StoreTensorValue(hwcStore + x * 3, fr);
+      StoreTensorValue(hwcStore + x * 3 + 1, fg);
+      StoreTensorValue(hwcStore + x * 3 + 2, fb);
+    }
+    mSrc += components;
+  }
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/Tensor.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Tensor-inl.h"
+#include "concurrency.hpp"
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+template<SparkYuvDefaultPixelType PixelType, typename T>
+void Pixel8ToTensorHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                       const uint32_t width, const uint32_t height,
+                       T *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,
+                       const SparkYuvTensorNormalization normalization,
+                       const float quantizationScale, const int32_t zeroPoint,
+                       const uint32_t startRow, const uint32_t endRow) {
+  const TensorTransform transform = ComputeTensorTransform(normalization, quantizationScale, zeroPoint);
+  auto mSrc = reinterpret_cast<const uint8_t *>(src);
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    PixelRowToTensor<PixelType, T>(mSrc + static_cast<size_t>(y) * srcStride, width, height, y,
+                                   tensor, layout, transform);
+  }
+}
+
+#define PIXEL_TO_TENSOR_DECLARATION_R(pixelType, suffix, storageType, tensorType) \
+void pixelType##ToTensor##suffix##HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                      const uint32_t width, const uint32_t height,\
+                                      storageType *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                                      const SparkYuvTensorNormalization normalization,\
+                                      const float quantizationScale, const int32_t zeroPoint,\
+                                      const uint32_t startRow, const uint32_t endRow) {\
+  Pixel8ToTensorHWY<sparkyuv::PIXEL_##pixelType, tensorType>(src, srcStride, width, height,\
+                                                             reinterpret_cast<tensorType *>(tensor), layout,\
+                                                             normalization, quantizationScale, zeroPoint,\
+                                                             startRow, endRow);\
+}
+
+#define PIXEL_TO_TENSOR_TYPES_DECLARATION_R(pixelType) \
+        PIXEL_TO_TENSOR_DECLARATION_R(pixelType, F32, float, float) \
+        PIXEL_TO_TENSOR_DECLARATION_R(pixelType, F16, uint16_t, hwy::float16_t) \
+        PIXEL_TO_TENSOR_DECLARATION_R(pixelType, I8, int8_t, int8_t)
+
+PIXEL_TO_TENSOR_TYPES_DECLARATION_R(RGBA)
+PIXEL_TO_TENSOR_TYPES_DECLARATION_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+PIXEL_TO_TENSOR_TYPES_DECLARATION_R(ARGB)
+PIXEL_TO_TENSOR_TYPES_DECLARATION_R(ABGR)
+PIXEL_TO_TENSOR_TYPES_DECLARATION_R(BGRA)
+PIXEL_TO_TENSOR_TYPES_DECLARATION_R(BGR)
+#endif
+
+#undef PIXEL_TO_TENSOR_TYPES_DECLARATION_R
+#undef PIXEL_TO_TENSOR_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+#define PIXEL_TO_TENSOR_DECLARATION_HWY(pixelType) \
+        HWY_EXPORT(pixelType##ToTensorF32HWY); \
+        HWY_EXPORT(pixelType##ToTensorF16HWY); \
+        HWY_EXPORT(pixelType##ToTensorI8HWY);
+
+PIXEL_TO_TENSOR_DECLARATION_HWY(RGBA)
+PIXEL_TO_TENSOR_DECLARATION_HWY(RGB)
+#if SPARKYUV_FULL_CHANNELS
+PIXEL_TO_TENSOR_DECLARATION_HWY(ARGB)
+PIXEL_TO_TENSOR_DECLARATION_HWY(ABGR)
+PIXEL_TO_TENSOR_DECLARATION_HWY(BGRA)
+PIXEL_TO_TENSOR_DECLARATION_HWY(BGR)
+#endif
+
+#undef PIXEL_TO_TENSOR_DECLARATION_HWY
+
+#define PIXEL_TO_TENSOR_DECLARATION_E(pixelType) \
+    void pixelType##ToTensorF32(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                const uint32_t width, const uint32_t height,\
+                                float *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                                const SparkYuvTensorNormalization normalization) {\
+      ValidateTensorTransform(normalization, 1.f);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(pixelType##ToTensorF32HWY)(src, srcStride, width, height, tensor, layout,\
+                                                        normalization, 1.f, 0, start, end);\
+      });\
+    }\
+    \
+    void pixelType##ToTensorF16(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                const uint32_t width, const uint32_t height,\
+                                uint16_t *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                                const SparkYuvTensorNormalization normalization) {\
+      ValidateTensorTransform(normalization, 1.f);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(pixelType##ToTensorF16HWY)(src, srcStride, width, height, tensor, layout,\
+                                                        normalization, 1.f, 0, start, end);\
+      });\
+    }\
+    \
+    void pixelType##ToTensorI8(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                               const uint32_t width, const uint32_t height,\
+                               int8_t *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                               const SparkYuvTensorNormalization normalization,\
+                               const float quantizationScale, const int32_t zeroPoint) {\
+      ValidateTensorTransform(normalization, quantizationScale);\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, height, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(pixelType##ToTensorI8HWY)(src, srcStride, width, height, tensor, layout,\
+                                                       normalization, quantizationScale, zeroPoint, start, end);\
+      });\
+    }
+
+PIXEL_TO_TENSOR_DECLARATION_E(RGBA)
+PIXEL_TO_TENSOR_DECLARATION_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+PIXEL_TO_TENSOR_DECLARATION_E(ARGB)
+PIXEL_TO_TENSOR_DECLARATION_E(ABGR)
+PIXEL_TO_TENSOR_DECLARATION_E(BGRA)
+PIXEL_TO_TENSOR_DECLARATION_E(BGR)
+#endif
+
+#undef PIXEL_TO_TENSOR_DECLARATION_E
+
+}
+#endif
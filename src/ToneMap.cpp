@@ -0,0 +1,533 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/ToneMap.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "sparkyuv.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Eotf-inl.h"
+#include "TransferLut-inl.h"
+#include "Gamut-inl.h"
+#include "concurrency.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+/**
+ * Everything that is required to tone map one pixel, computed once per call.
+ * Linear light after scaling is relative to display peak, so 1 is the brightest SDR value
+ */
+struct ToneMapContext {
+  float biasY, biasUV, scaleY, scaleUV;
+  float crR, crG, cbG, cbB;
+  float sourceScale;
+  SparkYuvToneMapper toneMapper;
+  float invPeak2;
+  float hableWhiteScale;
+  bool eetfActive;
+  float srcMaxPq, invSrcMaxPq, ks, invOneMinusKs, maxLum, displayToReference, referenceToDisplay;
+  SparkYuvTransformMatrix gamut;
+  float srcKr, srcKg, srcKb;
+  float dstKr, dstKg, dstKb;
+  float outBiasY, outBiasUV, outRangeY, outRangeUV, outCbScale, outCrScale;
+  SparkYuvTransferFunction transferFunction;
+  SparkYuvTransferFunction sdrTransferFunction;
+  SparkYuvTransferAccuracy accuracy;
+  const TransferLut *sourceLut;
+  const TransferLut *sdrLut;
+};
+
+SPARKYUV_INLINE static float HableCurve(const float x) {
+  const float A = 0.15f, B = 0.5f, C = 0.1f, D = 0.2f, E = 0.02f, F = 0.3f;
+  return ((x * (A * x + C * B) + D * E) / (x * (A * x + B) + D * F)) - E / F;
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE VF HableCurve(DF df, VF x) {
+  const VF A = Set(df, 0.15f);
+  const VF B = Set(df, 0.5f);
+  const VF num = MulAdd(x, MulAdd(A, x, Set(df, 0.1f * 0.5f)), Set(df, 0.2f * 0.02f));
+  const VF den = MulAdd(x, MulAdd(A, x, B), Set(df, 0.2f * 0.3f));
+  return Sub(Div(num, den), Set(df, 0.02f / 0.3f));
+}
+
+static ToneMapContext MakeToneMapContext(const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                         const SparkYuvTransferFunction transferFunction,
+                                         const SparkYuvToneMapping mapping,
+                                         const SparkYuvTransferAccuracy accuracy) {
+  ToneMapContext c{};
+  uint16_t biasY, biasUV, rangeY, rangeUV;
+  GetYUVRange(colorRange, 10, biasY, biasUV, rangeY, rangeUV);
+  c.biasY = static_cast<float>(biasY);
+  c.biasUV = static_cast<float>(biasUV);
+  c.scaleY = 1.f / static_cast<float>(rangeY);
+  c.scaleUV = 1.f / static_cast<float>(rangeUV);
+
+  const float kg = 1.f - kr - kb;
+  c.crR = 2.f * (1.f - kr);
+  c.cbB = 2.f * (1.f - kb);
+  c.crG = 2.f * kr * (1.f - kr) / kg;
+  c.cbG = 2.f * kb * (1.f - kb) / kg;
+
+  const float peak = mapping.contentMaxNits / mapping.displayMaxNits;
+  c.sourceScale = transferFunction == TransferPQ ? 203.f / mapping.displayMaxNits : peak;
+  c.toneMapper = mapping.toneMapper;
+  c.invPeak2 = 1.f / (peak * peak);
+  c.hableWhiteScale = 1.f / HableCurve(peak);
+
+  // ITU-R BT.2390 EETF in PQ domain normalized to content peak, black level is 0
+  c.displayToReference = mapping.displayMaxNits / 203.f;
+  c.referenceToDisplay = 203.f / mapping.displayMaxNits;
+  c.srcMaxPq = PQOetf(mapping.contentMaxNits / 203.f);
+  c.invSrcMaxPq = 1.f / c.srcMaxPq;
+  c.maxLum = PQOetf(mapping.displayMaxNits / 203.f) * c.invSrcMaxPq;
+  c.ks = 1.5f * c.maxLum - 0.5f;
+  c.eetfActive = c.ks < 1.f;
+  c.invOneMinusKs = c.eetfActive ? 1.f / (1.f - c.ks) : 0.f;
+
+  c.gamut = ComputeGamutMatrix(kBT2020Primaries, kBT709Primaries);
+  ComputeGamutLuminance(kBT2020Primaries, c.srcKr, c.srcKg, c.srcKb);
+  ComputeGamutLuminance(kBT709Primaries, c.dstKr, c.dstKg, c.dstKb);
+
+  uint16_t outBiasY, outBiasUV, outRangeY, outRangeUV;
+  GetYUVRange(colorRange, 8, outBiasY, outBiasUV, outRangeY, outRangeUV);
+  c.outBiasY = static_cast<float>(outBiasY);
+  c.outBiasUV = static_cast<float>(outBiasUV);
+  c.outRangeY = static_cast<float>(outRangeY);
+  c.outRangeUV = static_cast<float>(outRangeUV);
+  c.outCbScale = 1.f / (2.f * (1.f - c.dstKb));
+  c.outCrScale = 1.f / (2.f * (1.f - c.dstKr));
+
+  c.transferFunction = transferFunction;
+  c.sdrTransferFunction = mapping.sdrTransferFunction;
+  c.accuracy = accuracy;
+  c.sourceLut = GetTransferLutFor(accuracy, transferFunction, 10);
+  c.sdrLut = GetTransferLutFor(accuracy, mapping.sdrTransferFunction, 8);
+  return c;
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE VF Bt2390Eetf(DF df, VF x, const ToneMapContext &c) {
+  if (!c.eetfActive) {
+    return x;
+  }
+  const VF ones = Set(df, 1.f);
+  const VF ks = Set(df, c.ks);
+  const VF e1 = Min(Mul(PQOetf(df, Mul(x, Set(df, c.displayToReference))), Set(df, c.invSrcMaxPq)), ones);
+  const VF t = Mul(Sub(e1, ks), Set(df, c.invOneMinusKs));
+  const VF t2 = Mul(t, t);
+  const VF t3 = Mul(t2, t);
+  const VF h00 = MulAdd(Set(df, 2.f), t3, NegMulAdd(Set(df, 3.f), t2, ones));
+  const VF h10 = Add(NegMulAdd(Set(df, 2.f), t2, t3), t);
+  const VF h01 = NegMulAdd(Set(df, 2.f), t3, Mul(Set(df, 3.f), t2));
+  const VF spline = MulAdd(h00, ks, MulAdd(h10, Set(df, 1.f - c.ks), Mul(h01, Set(df, c.maxLum))));
+  const VF e2 = IfThenElse(Lt(e1, ks), e1, spline);
+  return Mul(PQEotf(df, Mul(e2, Set(df, c.srcMaxPq)), 203.f), Set(df, c.referenceToDisplay));
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE VF ToneMapLuminance(DF df, VF x, const ToneMapContext &c) {
+  switch (c.toneMapper) {
+    case TONEMAP_REINHARD_EXTENDED: {
+      const VF ones = Set(df, 1.f);
+      return Div(Mul(x, MulAdd(x, Set(df, c.invPeak2), ones)), Add(x, ones));
+    }
+    case TONEMAP_HABLE:return Mul(HableCurve(df, x), Set(df, c.hableWhiteScale));
+    case TONEMAP_BT2390:return Bt2390Eetf(df, x, c);
+  }
+  return x;
+}
+
+/**
+ * Decodes one vector of 10-bit samples into SDR gamma-encoded BT.709 RGB in [0, 1]
+ */
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE void ToneMapP10(DF df, const uint16_t *SPARKYUV_RESTRICT ySrc,
+                           const uint16_t *SPARKYUV_RESTRICT cbSrc, const uint16_t *SPARKYUV_RESTRICT crSrc,
+                           const ToneMapContext &c, VF &r, VF &g, VF &b) {
+  const RebindToSigned<decltype(df)> di32;
+  const Rebind<uint16_t, decltype(df)> du16;
+  const VF zeros = Zero(df);
+  const VF ones = Set(df, 1.f);
+
+  const VF Y = Mul(Sub(ConvertTo(df, PromoteTo(di32, LoadU(du16, ySrc))), Set(df, c.biasY)), Set(df, c.scaleY));
+  const VF Cb = Mul(Sub(ConvertTo(df, PromoteTo(di32, LoadU(du16, cbSrc))), Set(df, c.biasUV)), Set(df, c.scaleUV));
+  const VF Cr = Mul(Sub(ConvertTo(df, PromoteTo(di32, LoadU(du16, crSrc))), Set(df, c.biasUV)), Set(df, c.scaleUV));
+
+  r = Clamp(MulAdd(Set(df, c.crR), Cr, Y), zeros, ones);
+  g = Clamp(NegMulAdd(Set(df, c.crG), Cr, NegMulAdd(Set(df, c.cbG), Cb, Y)), zeros, ones);
+  b = Clamp(MulAdd(Set(df, c.cbB), Cb, Y), zeros, ones);
+
+  const VF sourceScale = Set(df, c.sourceScale);
+  r = Mul(ApplyEotf(df, r, c.transferFunction, c.accuracy, c.sourceLut), sourceScale);
+  g = Mul(ApplyEotf(df, g, c.transferFunction, c.accuracy, c.sourceLut), sourceScale);
+  b = Mul(ApplyEotf(df, b, c.transferFunction, c.accuracy, c.sourceLut), sourceScale);
+
+  // Luminance is mapped and RGB is scaled by the same ratio, so chroma ratios are kept
+  const VF eps = Set(df, 1e-6f);
+  const VF luma = MulAdd(Set(df, c.srcKr), r, MulAdd(Set(df, c.srcKg), g, Mul(Set(df, c.srcKb), b)));
+  const VF ratio = IfThenElseZero(Gt(luma, eps), Div(ToneMapLuminance(df, luma, c), Max(luma, eps)));
+  r = Mul(r, ratio);
+  g = Mul(g, ratio);
+  b = Mul(b, ratio);
+
+  ApplyGamutMatrix(df, r, g, b, c.gamut);
+  DesaturateOutOfGamut(df, r, g, b, c.dstKr, c.dstKg, c.dstKb);
+
+  r = ApplyOetf(df, Clamp(r, zeros, ones), c.sdrTransferFunction, c.accuracy, c.sdrLut);
+  g = ApplyOetf(df, Clamp(g, zeros, ones), c.sdrTransferFunction, c.accuracy, c.sdrLut);
+  b = ApplyOetf(df, Clamp(b, zeros, ones), c.sdrTransferFunction, c.accuracy, c.sdrLut);
+}
+
+/**
+ * Row is padded with the last sample for `padding` entries so the tail may be read by a full vector,
+ * `width` must not be 0, public wrappers return before dispatch for empty images
+ */
+static void UpsampleToneMapChroma(const uint16_t *SPARKYUV_RESTRICT src, uint16_t *SPARKYUV_RESTRICT dst,
+                                  const uint32_t width, const uint32_t padding) {
+  UpsampleChromaRow2x(src, dst, width);
+  std::fill(dst + width, dst + width + padding, dst[width - 1]);
+}
+
+/**
+ * Tone maps one row, the tail is processed in full vector with replicated last pixel.
+ * `store` is called with pixel offset and vector of SDR components
+ */
+template<class DF, typename Store>
+HWY_INLINE void ToneMapP10Row(DF df, const uint16_t *SPARKYUV_RESTRICT ySrc,
+                              const uint16_t *SPARKYUV_RESTRICT cbRow, const uint16_t *SPARKYUV_RESTRICT crRow,
+                              const uint32_t width, const ToneMapContext &c, Store store) {
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  uint32_t x = 0;
+  for (; x + lanes <= width; x += lanes) {
+    VF r, g, b;
+    ToneMapP10(df, ySrc + x, cbRow + x, crRow + x, c, r, g, b);
+    store(x, r, g, b);
+  }
+  if (x < width) {
+    HWY_ALIGN uint16_t yTail[HWY_MAX_BYTES / sizeof(float)];
+    for (uint32_t i = 0; i < lanes; ++i) {
+      yTail[i] = ySrc[std::min(x + i, width - 1)];
+    }
+    VF r, g, b;
+    ToneMapP10(df, yTail, cbRow + x, crRow + x, c, r, g, b);
+    store(x, r, g, b);
+  }
+}
+
+template<SparkYuvDefaultPixelType PixelType>
+void YCbCr420P10ToXXXXToneMappedHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                                    const uint32_t width, const uint32_t height,
+                                    const uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                    const uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                    const uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                    const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                    const SparkYuvTransferFunction transferFunction,
+                                    const SparkYuvToneMapping mapping, const SparkYuvTransferAccuracy accuracy,
+                                    const uint32_t startRow, const uint32_t endRow) {
+  const ToneMapContext context = MakeToneMapContext(kr, kb, colorRange, transferFunction, mapping, accuracy);
+  const ScalableTag<float> df;
+  const Rebind<uint8_t, decltype(df)> du8;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const int components = getPixelTypeComponents(PixelType);
+  const VF vMaxColors = Set(df, 255.f);
+  const auto alpha = Set(du8, 255);
+
+  std::vector<uint16_t> cbRow(width + lanes);
+  std::vector<uint16_t> crRow(width + lanes);
+  HWY_ALIGN uint8_t storeTail[HWY_MAX_BYTES];
+
+  for (uint32_t y = startRow; y < endRow; ++y) {
+    if (y == startRow || (y & 1) == 0) {
+      const size_t chromaOffset = static_cast<size_t>(y / 2);
+      UpsampleToneMapChroma(reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(uPlane)
+                                + chromaOffset * uStride), cbRow.data(), width, lanes);
+      UpsampleToneMapChroma(reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(vPlane)
+                                + chromaOffset * vStride), crRow.data(), width, lanes);
+    }
+
+    auto ySrc = reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(yPlane)
+        + static_cast<size_t>(y) * yStride);
+    auto mDst = reinterpret_cast<uint8_t *>(dst) + static_cast<size_t>(y) * dstStride;
+
+    ToneMapP10Row(df, ySrc, cbRow.data(), crRow.data(), width, context,
+                  [&](const uint32_t x, VF r, VF g, VF b) {
+                    const auto R = DemoteTo(du8, NearestInt(Mul(r, vMaxColors)));
+                    const auto G = DemoteTo(du8, NearestInt(Mul(g, vMaxColors)));
+                    const auto B = DemoteTo(du8, NearestInt(Mul(b, vMaxColors)));
+                    if (x + lanes <= width) {
+                      StoreRGBA<PixelType>(du8, mDst + x * components, R, G, B, alpha);
+                    } else {
+                      StoreRGBA<PixelType>(du8, storeTail, R, G, B, alpha);
+                      std::copy(storeTail, storeTail + (width - x) * components, mDst + x * components);
+                    }
+                  });
+  }
+}
+
+template<class DF, typename VF = Vec<DF>>
+HWY_INLINE Vec<Rebind<uint8_t, DF>> EncodeToneMappedLuma(DF df, VF r, VF g, VF b, const ToneMapContext &c) {
+  const Rebind<uint8_t, decltype(df)> du8;
+  const VF Y = MulAdd(Set(df, c.dstKr), r, MulAdd(Set(df, c.dstKg), g, Mul(Set(df, c.dstKb), b)));
+  return DemoteTo(du8, NearestInt(MulAdd(Y, Set(df, c.outRangeY), Set(df, c.outBiasY))));
+}
+
+void YCbCr420P10ToNV12ToneMappedHWY(uint8_t *SPARKYUV_RESTRICT yDst, const uint32_t yDstStride,
+                                    uint8_t *SPARKYUV_RESTRICT uvDst, const uint32_t uvDstStride,
+                                    const uint32_t width, const uint32_t height,
+                                    const uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                    const uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                    const uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                    const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                    const SparkYuvTransferFunction transferFunction,
+                                    const SparkYuvToneMapping mapping, const SparkYuvTransferAccuracy accuracy,
+                                    const uint32_t startRow, const uint32_t endRow) {
+  const ToneMapContext context = MakeToneMapContext(kr, kb, colorRange, transferFunction, mapping, accuracy);
+  const ScalableTag<float> df;
+  const Rebind<uint8_t, decltype(df)> du8;
+  using VF = Vec<decltype(df)>;
+  const uint32_t lanes = Lanes(df);
+  const uint32_t chromaWidth = (width + 1) / 2;
+
+  std::vector<uint16_t> cbRow(width + lanes);
+  std::vector<uint16_t> crRow(width + lanes);
+  // SDR gamma-encoded RGB of the row pair, chroma is averaged from it
+  std::vector<float> sdr[2][3];
+  for (auto &row : sdr) {
+    for (auto &channel : row) {
+      channel.resize(width + lanes);
+    }
+  }
+  HWY_ALIGN uint8_t storeTail[HWY_MAX_BYTES / sizeof(float)];
+
+  const VF quarter = Set(df, 0.25f);
+  const VF vRangeUV = Set(df, context.outRangeUV);
+  const VF vBiasUV = Set(df, context.outBiasUV);
+  const VF vCbScale = Set(df, context.outCbScale);
+  const VF vCrScale = Set(df, context.outCrScale);
+
+  for (uint32_t y = startRow; y < endRow; y += 2) {
+    const size_t chromaOffset = static_cast<size_t>(y / 2);
+    UpsampleToneMapChroma(reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(uPlane)
+                              + chromaOffset * uStride), cbRow.data(), width, lanes);
+    UpsampleToneMapChroma(reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(vPlane)
+                              + chromaOffset * vStride), crRow.data(), width, lanes);
+
+    const uint32_t rows = y + 1 < endRow ? 2 : 1;
+    for (uint32_t j = 0; j < rows; ++j) {
+      auto ySrc = reinterpret_cast<const uint16_t *>(reinterpret_cast<const uint8_t *>(yPlane)
+          + static_cast<size_t>(y + j) * yStride);
+      auto yStore = reinterpret_cast<uint8_t *>(yDst) + static_cast<size_t>(y + j) * yDstStride;
+      float *rRow = sdr[j][0].data();
+      float *gRow = sdr[j][1].data();
+      float *bRow = sdr[j][2].data();
+      ToneMapP10Row(df, ySrc, cbRow.data(), crRow.data(), width, context,
+                    [&](const uint32_t x, VF r, VF g, VF b) {
+                      StoreU(r, df, rRow + x);
+                      StoreU(g, df, gRow + x);
+                      StoreU(b, df, bRow + x);
+                      const auto Y = EncodeToneMappedLuma(df, r, g, b, context);
+                      if (x + lanes <= width) {
+                        StoreU(Y, du8, yStore + x);
+                      } else {
+                        StoreU(Y, du8, storeTail);
+                        std::copy(storeTail, storeTail + (width - x), yStore + x);
+                      }
+                    });
+      // Odd width chroma reads one pixel past the row
+      rRow[width] = rRow[width - 1];
+      gRow[width] = gRow[width - 1];
+      bRow[width] = bRow[width - 1];
+    }
+
+    const uint32_t second = rows - 1;
+    const float *r0 = sdr[0][0].data(), *g0 = sdr[0][1].data(), *b0 = sdr[0][2].data();
+    const float *r1 = sdr[second][0].data(), *g1 = sdr[second][1].data(), *b1 = sdr[second][2].data();
+    auto uvStore = reinterpret_cast<uint8_t *>(uvDst) + chromaOffset * uvDstStride;
+
+    uint32_t x = 0;
+    for (; x + lanes <= chromaWidth; x += lanes) {
+      VF r0e, r0o, g0e, g0o, b0e, b0o, r1e, r1o, g1e, g1o, b1e, b1o;
+      LoadInterleaved2(df, r0 + x * 2, r0e, r0o);
+      LoadInterleaved2(df, g0 + x * 2, g0e, g0o);
+      LoadInterleaved2(df, b0 + x * 2, b0e, b0o);
+      LoadInterleaved2(df, r1 + x * 2, r1e, r1o);
+      LoadInterleaved2(df, g1 + x * 2, g1e, g1o);
+      LoadInterleaved2(df, b1 + x * 2, b1e, b1o);
+      const VF R = Mul(Add(Add(r0e, r0o), Add(r1e, r1o)), quarter);
+      const VF G = Mul(Add(Add(g0e, g0o), Add(g1e, g1o)), quarter);
+      const VF B = Mul(Add(Add(b0e, b0o), Add(b1e, b1o)), quarter);
+      const VF Y = MulAdd(Set(df, context.dstKr), R, MulAdd(Set(df, context.dstKg), G, Mul(Set(df, context.dstKb), B)));
+      const auto Cb = DemoteTo(du8, NearestInt(MulAdd(Mul(Sub(B, Y), vCbScale), vRangeUV, vBiasUV)));
+      const auto Cr = DemoteTo(du8, NearestInt(MulAdd(Mul(Sub(R, Y), vCrScale), vRangeUV, vBiasUV)));
+      StoreInterleaved2(Cb, Cr, du8, uvStore + x * 2);
+    }
+
+    for (; x < chromaWidth; ++x) {
+      const uint32_t p = x * 2;
+      const float R = (r0[p] + r0[p + 1] + r1[p] + r1[p + 1]) * 0.25f;
+      const float G = (g0[p] + g0[p + 1] + g1[p] + g1[p + 1]) * 0.25f;
+      const float B = (b0[p] + b0[p + 1] + b1[p] + b1[p + 1]) * 0.25f;
+      const float Y = context.dstKr * R + context.dstKg * G + context.dstKb * B;
+      const float Cb = (B - Y) * context.outCbScale * context.outRangeUV + context.outBiasUV;
+      const float Cr = (R - Y) * context.outCrScale * context.outRangeUV + context.outBiasUV;
+      uvStore[p] = static_cast<uint8_t>(std::clamp(::roundf(Cb), 0.f, 255.f));
+      uvStore[p + 1] = static_cast<uint8_t>(std::clamp(::roundf(Cr), 0.f, 255.f));
+    }
+  }
+}
+
+#define YCBCR420P10_TONE_MAP_DECLARATION_R(pixelType) \
+void YCbCr420P10To##pixelType##ToneMappedHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                             const uint32_t width, const uint32_t height,\
+                                             const uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                             const uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                             const uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                             const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                             const SparkYuvTransferFunction transferFunction,\
+                                             const SparkYuvToneMapping mapping,\
+                                             const SparkYuvTransferAccuracy accuracy,\
+                                             const uint32_t startRow, const uint32_t endRow) {\
+  YCbCr420P10ToXXXXToneMappedHWY<sparkyuv::PIXEL_##pixelType>(dst, dstStride, width, height,\
+                                                              yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                              kr, kb, colorRange, transferFunction, mapping,\
+                                                              accuracy, startRow, endRow);\
+}
+
+YCBCR420P10_TONE_MAP_DECLARATION_R(RGBA)
+YCBCR420P10_TONE_MAP_DECLARATION_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCBCR420P10_TONE_MAP_DECLARATION_R(ARGB)
+YCBCR420P10_TONE_MAP_DECLARATION_R(ABGR)
+YCBCR420P10_TONE_MAP_DECLARATION_R(BGRA)
+YCBCR420P10_TONE_MAP_DECLARATION_R(BGR)
+#endif
+
+#undef YCBCR420P10_TONE_MAP_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+static void ValidateToneMapping(const SparkYuvTransferFunction transferFunction,
+                                const SparkYuvToneMapping mapping,
+                                const SparkYuvTransferAccuracy accuracy) {
+  if (transferFunction != TransferPQ && transferFunction != TransferHLG) {
+    throw std::runtime_error("Tone mapping supports only PQ and HLG transfer functions");
+  }
+  if (mapping.toneMapper != TONEMAP_REINHARD_EXTENDED && mapping.toneMapper != TONEMAP_HABLE
+      && mapping.toneMapper != TONEMAP_BT2390) {
+    throw std::runtime_error("Unknown tone mapper was requested");
+  }
+  if (!(mapping.contentMaxNits > 0.f) || !(mapping.displayMaxNits > 0.f)) {
+    throw std::runtime_error("Content and display peak luminance must be positive");
+  }
+  if (accuracy != TRANSFER_ACCURACY_EXACT && accuracy != TRANSFER_ACCURACY_FAST
+      && accuracy != TRANSFER_ACCURACY_LUT) {
+    throw std::runtime_error("Unknown transfer accuracy was requested");
+  }
+}
+
+#define YCBCR420P10_TONE_MAP_DECLARATION_HWY(pixelType) \
+        HWY_EXPORT(YCbCr420P10To##pixelType##ToneMappedHWY);
+
+YCBCR420P10_TONE_MAP_DECLARATION_HWY(RGBA)
+YCBCR420P10_TONE_MAP_DECLARATION_HWY(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCBCR420P10_TONE_MAP_DECLARATION_HWY(ARGB)
+YCBCR420P10_TONE_MAP_DECLARATION_HWY(ABGR)
+YCBCR420P10_TONE_MAP_DECLARATION_HWY(BGRA)
+YCBCR420P10_TONE_MAP_DECLARATION_HWY(BGR)
+#endif
+HWY_EXPORT(YCbCr420P10ToNV12ToneMappedHWY);
+
+#undef YCBCR420P10_TONE_MAP_DECLARATION_HWY
+
+#define YCBCR420P10_TONE_MAP_DECLARATION_E(pixelType) \
+    void YCbCr420P10To##pixelType##ToneMapped(uint8_t *dst, const uint32_t dstStride,\
+                                              const uint32_t width, const uint32_t height,\
+                                              const uint16_t *yPlane, const uint32_t yStride,\
+                                              const uint16_t *uPlane, const uint32_t uStride,\
+                                              const uint16_t *vPlane, const uint32_t vStride,\
+                                              const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                              const SparkYuvTransferFunction transferFunction,\
+                                              const SparkYuvToneMapping mapping,\
+                                              const SparkYuvTransferAccuracy accuracy) {\
+      ValidateToneMapping(transferFunction, mapping, accuracy);\
+      ValidateYCbCrParameters(kr, kb, colorRange);\
+      if (width == 0 || height == 0) {\
+        return;\
+      }\
+      const int threadCount = concurrency::getThreadCounts(width, height);\
+      concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {\
+        HWY_DYNAMIC_DISPATCH(YCbCr420P10To##pixelType##ToneMappedHWY)(dst, dstStride, width, height,\
+                                                                      yPlane, yStride, uPlane, uStride,\
+                                                                      vPlane, vStride, kr, kb, colorRange,\
+                                                                      transferFunction, mapping, accuracy,\
+                                                                      start * 2,\
+                                                                      std::min(static_cast<uint32_t>(end * 2),\
+                                                                               height));\
+      });\
+    }
+
+YCBCR420P10_TONE_MAP_DECLARATION_E(RGBA)
+YCBCR420P10_TONE_MAP_DECLARATION_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCBCR420P10_TONE_MAP_DECLARATION_E(ARGB)
+YCBCR420P10_TONE_MAP_DECLARATION_E(ABGR)
+YCBCR420P10_TONE_MAP_DECLARATION_E(BGRA)
+YCBCR420P10_TONE_MAP_DECLARATION_E(BGR)
+#endif
+
+#undef YCBCR420P10_TONE_MAP_DECLARATION_E
+
+void YCbCr420P10ToNV12ToneMapped(uint8_t *yDst, const uint32_t yDstStride,
+                                 uint8_t *uvDst, const uint32_t uvDstStride,
+                                 const uint32_t width, const uint32_t height,
+                                 const uint16_t *yPlane, const uint32_t yStride,
+                                 const uint16_t *uPlane, const uint32_t uStride,
+                                 const uint16_t *vPlane, const uint32_t vStride,
+                                 const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                 const SparkYuvTransferFunction transferFunction,
+                                 const SparkYuvToneMapping mapping,
+                                 const SparkYuvTransferAccuracy accuracy) {
+  ValidateToneMapping(transferFunction, mapping, accuracy);
+  ValidateYCbCrParameters(kr, kb, colorRange);
+  if (width == 0 || height == 0) {
+    return;
+  }
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(YCbCr420P10ToNV12ToneMappedHWY)(yDst, yDstStride, uvDst, uvDstStride, width, height,
+                                                         yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                                         kr, kb, colorRange, transferFunction, mapping, accuracy,
+                                                         start * 2, std::min(static_cast<uint32_t>(end * 2), height));
+  });
+}
+
+}
+#endif
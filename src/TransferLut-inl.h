@@ -0,0 +1,202 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_TRANSFER_LUT_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_TRANSFER_LUT_INL_H
+#undef SPARKYUV_TRANSFER_LUT_INL_H
+#else
+#define SPARKYUV_TRANSFER_LUT_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "Eotf-inl.h"
+#include "TransferLut.h"
+#include <algorithm>
+#include <cmath>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API V TransferLutInterpolate(D d, const float *SPARKYUV_RESTRICT table, V position) {
+  const RebindToSigned<decltype(d)> di32;
+  const auto zeros = Zero(d);
+  // NaN and negatives goes to the first entry
+  position = Min(IfThenElseZero(Gt(position, zeros), position), Set(d, static_cast<float>(kTransferLutSegments)));
+  const auto index = ConvertTo(di32, position);
+  const auto fraction = Sub(position, ConvertTo(d, index));
+  const auto low = GatherIndex(d, table, index);
+  const auto high = GatherIndex(d, table + 1, index);
+  return MulAdd(Sub(high, low), fraction, low);
+}
+
+SPARKYUV_INLINE static float TransferLutInterpolate(const float *SPARKYUV_RESTRICT table, float position) {
+  if (!(position > 0.f)) {
+    position = 0.f;
+  }
+  position = std::min(position, static_cast<float>(kTransferLutSegments));
+  const int index = static_cast<int>(position);
+  const float fraction = position - static_cast<float>(index);
+  return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+/**
+ * Linearizes integer samples, index must be non-negative
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>, typename VI = Vec<RebindToSigned<D>>>
+HWY_API V TransferLutEotf(D d, const TransferLut &lut, VI index) {
+  const RebindToSigned<decltype(d)> di32;
+  return GatherIndex(d, lut.eotf.data(), Min(index, Set(di32, lut.maxSample)));
+}
+
+SPARKYUV_INLINE static float TransferLutEotf(const TransferLut &lut, const int index) {
+  return lut.eotf[std::clamp(index, 0, lut.maxSample)];
+}
+
+/**
+ * Linearizes fractional gamma-encoded values in [0, 1]
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API V TransferLutEotfCurve(D d, const TransferLut &lut, V x) {
+  return TransferLutInterpolate(d, lut.eotfCurve.data(), Mul(x, Set(d, static_cast<float>(kTransferLutSegments))));
+}
+
+SPARKYUV_INLINE static float TransferLutEotfCurve(const TransferLut &lut, const float x) {
+  return TransferLutInterpolate(lut.eotfCurve.data(), x * static_cast<float>(kTransferLutSegments));
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API V TransferLutOetf(D d, const TransferLut &lut, V x) {
+  const auto t = Sqrt(Sqrt(ZeroIfNegative(Mul(x, Set(d, lut.invLinearMax)))));
+  return TransferLutInterpolate(d, lut.oetfCurve.data(), Mul(t, Set(d, static_cast<float>(kTransferLutSegments))));
+}
+
+SPARKYUV_INLINE static float TransferLutOetf(const TransferLut &lut, const float x) {
+  const float t = ::sqrtf(::sqrtf(std::max(x * lut.invLinearMax, 0.f)));
+  return TransferLutInterpolate(lut.oetfCurve.data(), t * static_cast<float>(kTransferLutSegments));
+}
+
+/**
+ * Encodes linear values straight into 8-bit codes, `lut` must be an 8-bit context
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API Vec<RebindToSigned<D>> TransferLutOetf8(D d, const TransferLut &lut, V x) {
+  const RebindToSigned<decltype(d)> di32;
+  const auto zeros = Zero(d);
+  auto position = Mul(Sqrt(Sqrt(ZeroIfNegative(Mul(x, Set(d, lut.invLinearMax))))),
+                      Set(d, static_cast<float>(kTransferLutSegments)));
+  // NaN goes to the first entry
+  position = Min(IfThenElseZero(Gt(position, zeros), position), Set(d, static_cast<float>(kTransferLutSegments)));
+  return GatherIndex(di32, lut.oetf8.data(), NearestInt(position));
+}
+
+SPARKYUV_INLINE static int32_t TransferLutOetf8(const TransferLut &lut, const float x) {
+  float position = ::sqrtf(::sqrtf(std::max(x * lut.invLinearMax, 0.f))) * static_cast<float>(kTransferLutSegments);
+  if (!(position > 0.f)) {
+    position = 0.f;
+  }
+  position = std::min(position, static_cast<float>(kTransferLutSegments));
+  return lut.oetf8[static_cast<int>(::lrintf(position))];
+}
+
+/**
+ * Transfer of fractional values with selected accuracy, `lut` is required only for TRANSFER_ACCURACY_LUT
+ */
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API V ApplyEotf(D d, V v, const SparkYuvTransferFunction transferFunction,
+                    const SparkYuvTransferAccuracy accuracy, const TransferLut *lut) {
+  switch (accuracy) {
+    case TRANSFER_ACCURACY_EXACT: {
+      HWY_ALIGN float lanes[HWY_MAX_BYTES / sizeof(float)];
+      Store(v, d, lanes);
+      for (size_t i = 0; i < Lanes(d); ++i) {
+        lanes[i] = Eotf(lanes[i], transferFunction);
+      }
+      return Load(d, lanes);
+    }
+    case TRANSFER_ACCURACY_FAST:return Eotf(d, v, transferFunction);
+    case TRANSFER_ACCURACY_LUT:return TransferLutEotfCurve(d, *lut, v);
+  }
+  return v;
+}
+
+template<class D, HWY_IF_F32_D(D), typename V = Vec<D>>
+HWY_API V ApplyOetf(D d, V v, const SparkYuvTransferFunction transferFunction,
+                    const SparkYuvTransferAccuracy accuracy, const TransferLut *lut) {
+  switch (accuracy) {
+    case TRANSFER_ACCURACY_EXACT: {
+      HWY_ALIGN float lanes[HWY_MAX_BYTES / sizeof(float)];
+      Store(v, d, lanes);
+      for (size_t i = 0; i < Lanes(d); ++i) {
+        lanes[i] = Oetf(lanes[i], transferFunction);
+      }
+      return Load(d, lanes);
+    }
+    case TRANSFER_ACCURACY_FAST:return Oetf(d, v, transferFunction);
+    case TRANSFER_ACCURACY_LUT:return TransferLutOetf(d, *lut, v);
+  }
+  return v;
+}
+
+SPARKYUV_INLINE static float ApplyEotf(const float v, const SparkYuvTransferFunction transferFunction,
+                                       const SparkYuvTransferAccuracy accuracy, const TransferLut *lut) {
+  if (accuracy == TRANSFER_ACCURACY_LUT) {
+    return TransferLutEotfCurve(*lut, v);
+  }
+  return Eotf(v, transferFunction);
+}
+
+SPARKYUV_INLINE static float ApplyOetf(const float v, const SparkYuvTransferFunction transferFunction,
+                                       const SparkYuvTransferAccuracy accuracy, const TransferLut *lut) {
+  if (accuracy == TRANSFER_ACCURACY_LUT) {
+    return TransferLutOetf(*lut, v);
+  }
+  return Oetf(v, transferFunction);
+}
+
+static const TransferLut *GetTransferLutFor(const SparkYuvTransferAccuracy accuracy,
+                                            const SparkYuvTransferFunction transferFunction, const int bitDepth) {
+  return accuracy == TRANSFER_ACCURACY_LUT ? &GetTransferLut(transferFunction, bitDepth) : nullptr;
+}
+
+#if SPARKYUV_ALLOW_FLOAT16
+template<class D, HWY_IF_F16_D(D), typename V = Vec<D>>
+HWY_API V TransferLutEotfCurve(D d, const TransferLut &lut, V x) {
+  const Repartition<float, decltype(d)> df32;
+  const Half<decltype(d)> dh;
+  const auto low = TransferLutEotfCurve(df32, lut, PromoteLowerTo(df32, x));
+  const auto high = TransferLutEotfCurve(df32, lut, PromoteUpperTo(df32, x));
+  return Combine(d, DemoteTo(dh, high), DemoteTo(dh, low));
+}
+
+template<class D, HWY_IF_F16_D(D), typename V = Vec<D>>
+HWY_API V TransferLutOetf(D d, const TransferLut &lut, V x) {
+  const Repartition<float, decltype(d)> df32;
+  const Half<decltype(d)> dh;
+  const auto low = TransferLutOetf(df32, lut, PromoteLowerTo(df32, x));
+  const auto high = TransferLutOetf(df32, lut, PromoteUpperTo(df32, x));
+  return Combine(d, DemoteTo(dh, high), DemoteTo(dh, low));
+}
+#endif
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
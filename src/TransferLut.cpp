@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TransferLut.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include "hwy/highway.h"
+#include "Eotf-inl.h"
+
+namespace sparkyuv {
+
+// Tables are built once for the static target, scalar transfer functions are the same on every target
+using HWY_NAMESPACE::Eotf;
+using HWY_NAMESPACE::Oetf;
+
+static constexpr int kTransferLutFunctions = TransferHLG;
+static constexpr int kTransferLutMaxBitDepth = 16;
+
+static std::unique_ptr<TransferLut> MakeTransferLut(const SparkYuvTransferFunction transferFunction,
+                                                    const int bitDepth) {
+  auto lut = std::make_unique<TransferLut>();
+  lut->maxSample = (1 << bitDepth) - 1;
+
+  const float sampleScale = 1.f / static_cast<float>(lut->maxSample);
+  lut->eotf.resize(lut->maxSample + 1);
+  for (int i = 0; i <= lut->maxSample; ++i) {
+    lut->eotf[i] = Eotf(static_cast<float>(i) * sampleScale, transferFunction);
+  }
+
+  const float segmentScale = 1.f / static_cast<float>(kTransferLutSegments);
+  lut->eotfCurve.resize(kTransferLutSegments + 2);
+  for (int i = 0; i <= kTransferLutSegments; ++i) {
+    lut->eotfCurve[i] = Eotf(static_cast<float>(i) * segmentScale, transferFunction);
+  }
+  lut->eotfCurve[kTransferLutSegments + 1] = lut->eotfCurve[kTransferLutSegments];
+
+  lut->linearMax = std::max(Eotf(1.f, transferFunction), 1.f);
+  lut->invLinearMax = 1.f / lut->linearMax;
+  lut->oetfCurve.resize(kTransferLutSegments + 2);
+  for (int i = 0; i <= kTransferLutSegments; ++i) {
+    const float t = static_cast<float>(i) * segmentScale;
+    const float t2 = t * t;
+    lut->oetfCurve[i] = Oetf(t2 * t2 * lut->linearMax, transferFunction);
+  }
+  lut->oetfCurve[kTransferLutSegments + 1] = lut->oetfCurve[kTransferLutSegments];
+
+  if (bitDepth == 8) {
+    lut->oetf8.resize(kTransferLutSegments + 1);
+    for (int i = 0; i <= kTransferLutSegments; ++i) {
+      lut->oetf8[i] = static_cast<int32_t>(std::clamp(::roundf(lut->oetfCurve[i] * 255.f), 0.f, 255.f));
+    }
+  }
+  return lut;
+}
+
+struct TransferLutSlot {
+  std::once_flag once;
+  std::unique_ptr<TransferLut> lut;
+};
+
+const TransferLut &GetTransferLut(const SparkYuvTransferFunction transferFunction, const int bitDepth) {
+  if (bitDepth < 1 || bitDepth > kTransferLutMaxBitDepth) {
+    throw std::runtime_error("Transfer LUT supports bit-depth in range [1, 16]");
+  }
+  // Unknown transfer functions are evaluated as identity by `Eotf` and `Oetf`, so they share the linear tables
+  const SparkYuvTransferFunction function = transferFunction >= TransferBT709 && transferFunction <= TransferHLG
+                                            ? transferFunction : TransferLinear;
+  static TransferLutSlot slots[kTransferLutFunctions][kTransferLutMaxBitDepth];
+  TransferLutSlot &slot = slots[function - TransferBT709][bitDepth - 1];
+  std::call_once(slot.once, [&slot, function, bitDepth]() {
+    slot.lut = MakeTransferLut(function, bitDepth);
+  });
+  return *slot.lut;
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YUV_SRC_TRANSFERLUT_H_
+#define YUV_SRC_TRANSFERLUT_H_
+
+#include <cstdint>
+#include <vector>
+#include "sparkyuv-eotf.h"
+
+namespace sparkyuv {
+
+static constexpr int kTransferLutSegments = 4096;
+
+/**
+ * Precomputed transfer function context for one transfer function and bit-depth.
+ * `eotf` is exact linearization of every integer sample of the bit-depth.
+ * `eotfCurve` samples EOTF uniformly over [0, 1] for fractional gamma-encoded values.
+ * `oetfCurve` samples OETF uniformly over fourth root of x / linearMax, in this domain piecewise linear
+ * interpolation stays below one code value at 12-bit for every supported curve, see `SparkyuvDelinearize*LUT` bench.
+ * Curves have one extra entry so the last segment may be read without a branch.
+ * `oetf8` exists only for 8-bit contexts: ready 8-bit codes on the `oetfCurve` lattice read by nearest entry,
+ * in this domain neighbouring entries are far below one code apart, so encoding costs a single gather.
+ */
+struct TransferLut {
+  std::vector<float> eotf;
+  std::vector<float> eotfCurve;
+  std::vector<float> oetfCurve;
+  std::vector<int32_t> oetf8;
+  float linearMax;
+  float invLinearMax;
+  int maxSample;
+};
+
+/**
+ * Returns process wide context, it is built once on the first request and never released.
+ * Once built, lookups do not take any lock, so it is safe to call from the worker threads.
+ * Throws when bit-depth is outside [1, 16].
+ */
+const TransferLut &GetTransferLut(SparkYuvTransferFunction transferFunction, int bitDepth);
+
+}
+
+#endif //YUV_SRC_TRANSFERLUT_H_
@@ -0,0 +1,219 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_TRANSFER_SURFACE_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_TRANSFER_SURFACE_INL_H
+#undef SPARKYUV_TRANSFER_SURFACE_INL_H
+#else
+#define SPARKYUV_TRANSFER_SURFACE_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include "TransferLut-inl.h"
+#include "TypeSupport.h"
+#include <algorithm>
+#include <cmath>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+using namespace hwy;
+using namespace hwy::HWY_NAMESPACE;
+
+/**
+ * Packed RGBA layouts of gamma-encoded images that transfer function kernels read and write
+ */
+enum TransferSurface {
+  TRANSFER_SURFACE_RGBA8,
+  TRANSFER_SURFACE_RGBA16,
+  TRANSFER_SURFACE_RGBA1010102,
+  TRANSFER_SURFACE_RGBAF16
+};
+
+constexpr int TransferSurfacePixelSize(const TransferSurface surface) {
+  return (surface == TRANSFER_SURFACE_RGBA8 || surface == TRANSFER_SURFACE_RGBA1010102) ? 4 : 8;
+}
+
+/**
+ * Loads gamma-encoded pixels normalized to [0, 1]
+ */
+template<TransferSurface Surface, class DF, typename VF = Vec<DF>>
+HWY_INLINE void LoadTransferSurface(DF df, const uint8_t *SPARKYUV_RESTRICT src,
+                                    VF &r, VF &g, VF &b, VF &a, const float scale) {
+  const RebindToSigned<decltype(df)> di32;
+  const auto vScale = Set(df, scale);
+  if (Surface == TRANSFER_SURFACE_RGBA8) {
+    const Rebind<uint8_t, decltype(df)> du8;
+    Vec<decltype(du8)> r8, g8, b8, a8;
+    LoadInterleaved4(du8, src, r8, g8, b8, a8);
+    r = Mul(ConvertTo(df, PromoteTo(di32, r8)), vScale);
+    g = Mul(ConvertTo(df, PromoteTo(di32, g8)), vScale);
+    b = Mul(ConvertTo(df, PromoteTo(di32, b8)), vScale);
+    a = Mul(ConvertTo(df, PromoteTo(di32, a8)), vScale);
+  } else if (Surface == TRANSFER_SURFACE_RGBA16) {
+    const Rebind<uint16_t, decltype(df)> du16;
+    Vec<decltype(du16)> r16, g16, b16, a16;
+    LoadInterleaved4(du16, reinterpret_cast<const uint16_t *>(src), r16, g16, b16, a16);
+    r = Mul(ConvertTo(df, PromoteTo(di32, r16)), vScale);
+    g = Mul(ConvertTo(df, PromoteTo(di32, g16)), vScale);
+    b = Mul(ConvertTo(df, PromoteTo(di32, b16)), vScale);
+    a = Mul(ConvertTo(df, PromoteTo(di32, a16)), vScale);
+  } else if (Surface == TRANSFER_SURFACE_RGBA1010102) {
+    const RebindToUnsigned<decltype(df)> du32;
+    const auto mask = Set(du32, 0x3ff);
+    const auto pixels = LoadU(du32, reinterpret_cast<const uint32_t *>(src));
+    r = Mul(ConvertTo(df, BitCast(di32, And(pixels, mask))), vScale);
+    g = Mul(ConvertTo(df, BitCast(di32, And(ShiftRight<10>(pixels), mask))), vScale);
+    b = Mul(ConvertTo(df, BitCast(di32, And(ShiftRight<20>(pixels), mask))), vScale);
+    a = Mul(ConvertTo(df, BitCast(di32, ShiftRight<30>(pixels))), Set(df, 1.f / 3.f));
+  } else {
+    const Rebind<uint16_t, decltype(df)> du16;
+    const Rebind<hwy::float16_t, decltype(df)> df16;
+    Vec<decltype(du16)> r16, g16, b16, a16;
+    LoadInterleaved4(du16, reinterpret_cast<const uint16_t *>(src), r16, g16, b16, a16);
+    r = PromoteTo(df, BitCast(df16, r16));
+    g = PromoteTo(df, BitCast(df16, g16));
+    b = PromoteTo(df, BitCast(df16, b16));
+    a = PromoteTo(df, BitCast(df16, a16));
+  }
+}
+
+template<TransferSurface Surface, class DF, typename VF = Vec<DF>>
+HWY_INLINE void StoreTransferSurface(DF df, uint8_t *SPARKYUV_RESTRICT dst,
+                                     VF r, VF g, VF b, VF a, const int maxColors) {
+  const RebindToSigned<decltype(df)> di32;
+  const auto vScale = Set(df, static_cast<float>(maxColors));
+  if (Surface == TRANSFER_SURFACE_RGBA8) {
+    const Rebind<uint8_t, decltype(df)> du8;
+    StoreInterleaved4(DemoteTo(du8, NearestInt(Mul(r, vScale))), DemoteTo(du8, NearestInt(Mul(g, vScale))),
+                      DemoteTo(du8, NearestInt(Mul(b, vScale))), DemoteTo(du8, NearestInt(Mul(a, vScale))),
+                      du8, dst);
+  } else if (Surface == TRANSFER_SURFACE_RGBA16) {
+    const Rebind<uint16_t, decltype(df)> du16;
+    const auto vMax = Set(di32, maxColors);
+    StoreInterleaved4(DemoteTo(du16, Min(NearestInt(Mul(r, vScale)), vMax)),
+                      DemoteTo(du16, Min(NearestInt(Mul(g, vScale)), vMax)),
+                      DemoteTo(du16, Min(NearestInt(Mul(b, vScale)), vMax)),
+                      DemoteTo(du16, Min(NearestInt(Mul(a, vScale)), vMax)),
+                      du16, reinterpret_cast<uint16_t *>(dst));
+  } else if (Surface == TRANSFER_SURFACE_RGBA1010102) {
+    const RebindToUnsigned<decltype(df)> du32;
+    const auto zeros = Zero(di32);
+    const auto vMax = Set(di32, 1023);
+    const auto R = BitCast(du32, Clamp(NearestInt(Mul(r, vScale)), zeros, vMax));
+    const auto G = BitCast(du32, Clamp(NearestInt(Mul(g, vScale)), zeros, vMax));
+    const auto B = BitCast(du32, Clamp(NearestInt(Mul(b, vScale)), zeros, vMax));
+    const auto A = BitCast(du32, Clamp(NearestInt(Mul(a, Set(df, 3.f))), zeros, Set(di32, 3)));
+    const auto pixels = Or(Or(ShiftLeft<30>(A), ShiftLeft<20>(B)), Or(ShiftLeft<10>(G), R));
+    StoreU(pixels, du32, reinterpret_cast<uint32_t *>(dst));
+  } else {
+    const Rebind<uint16_t, decltype(df)> du16;
+    const Rebind<hwy::float16_t, decltype(df)> df16;
+    StoreInterleaved4(BitCast(du16, DemoteTo(df16, r)), BitCast(du16, DemoteTo(df16, g)),
+                      BitCast(du16, DemoteTo(df16, b)), BitCast(du16, DemoteTo(df16, a)),
+                      du16, reinterpret_cast<uint16_t *>(dst));
+  }
+}
+
+template<TransferSurface Surface>
+SPARKYUV_INLINE static void LoadTransferPixel(const uint8_t *SPARKYUV_RESTRICT src,
+                                              float &r, float &g, float &b, float &a, const float scale) {
+  if (Surface == TRANSFER_SURFACE_RGBA8) {
+    r = static_cast<float>(src[0]) * scale;
+    g = static_cast<float>(src[1]) * scale;
+    b = static_cast<float>(src[2]) * scale;
+    a = static_cast<float>(src[3]) * scale;
+  } else if (Surface == TRANSFER_SURFACE_RGBA16) {
+    auto source = reinterpret_cast<const uint16_t *>(src);
+    r = static_cast<float>(source[0]) * scale;
+    g = static_cast<float>(source[1]) * scale;
+    b = static_cast<float>(source[2]) * scale;
+    a = static_cast<float>(source[3]) * scale;
+  } else if (Surface == TRANSFER_SURFACE_RGBA1010102) {
+    const uint32_t pixel = reinterpret_cast<const uint32_t *>(src)[0];
+    r = static_cast<float>(pixel & 0x3ff) * scale;
+    g = static_cast<float>((pixel >> 10) & 0x3ff) * scale;
+    b = static_cast<float>((pixel >> 20) & 0x3ff) * scale;
+    a = static_cast<float>(pixel >> 30) * (1.f / 3.f);
+  } else {
+    auto source = reinterpret_cast<const hwy::float16_t *>(src);
+    r = LoadFloat(source);
+    g = LoadFloat(source + 1);
+    b = LoadFloat(source + 2);
+    a = LoadFloat(source + 3);
+  }
+}
+
+template<TransferSurface Surface>
+SPARKYUV_INLINE static void StoreTransferPixel(uint8_t *SPARKYUV_RESTRICT dst,
+                                               const float r, const float g, const float b, const float a,
+                                               const int maxColors) {
+  const auto fMaxColors = static_cast<float>(maxColors);
+  auto quantize = [](const float v, const float scale, const float maxValue) -> uint32_t {
+    return static_cast<uint32_t>(std::clamp(::roundf(v * scale), 0.f, maxValue));
+  };
+  if (Surface == TRANSFER_SURFACE_RGBA8) {
+    dst[0] = static_cast<uint8_t>(quantize(r, fMaxColors, fMaxColors));
+    dst[1] = static_cast<uint8_t>(quantize(g, fMaxColors, fMaxColors));
+    dst[2] = static_cast<uint8_t>(quantize(b, fMaxColors, fMaxColors));
+    dst[3] = static_cast<uint8_t>(quantize(a, fMaxColors, fMaxColors));
+  } else if (Surface == TRANSFER_SURFACE_RGBA16) {
+    auto store = reinterpret_cast<uint16_t *>(dst);
+    store[0] = static_cast<uint16_t>(quantize(r, fMaxColors, fMaxColors));
+    store[1] = static_cast<uint16_t>(quantize(g, fMaxColors, fMaxColors));
+    store[2] = static_cast<uint16_t>(quantize(b, fMaxColors, fMaxColors));
+    store[3] = static_cast<uint16_t>(quantize(a, fMaxColors, fMaxColors));
+  } else if (Surface == TRANSFER_SURFACE_RGBA1010102) {
+    const uint32_t R = quantize(r, fMaxColors, fMaxColors);
+    const uint32_t G = quantize(g, fMaxColors, fMaxColors);
+    const uint32_t B = quantize(b, fMaxColors, fMaxColors);
+    const uint32_t A = quantize(a, 3.f, 3.f);
+    reinterpret_cast<uint32_t *>(dst)[0] = (A << 30) | (B << 20) | (G << 10) | R;
+  } else {
+    auto store = reinterpret_cast<hwy::float16_t *>(dst);
+    StoreFloat(store, r);
+    StoreFloat(store + 1, g);
+    StoreFloat(store + 2, b);
+    StoreFloat(store + 3, a);
+  }
+}
+
+/**
+ * Integer sources are looked up exactly by sample, F16 sources are interpolated
+ */
+template<TransferSurface Surface, class DF, typename VF = Vec<DF>>
+HWY_INLINE VF LinearizeVector(DF df, VF v, const SparkYuvTransferFunction transferFunction,
+                              const SparkYuvTransferAccuracy accuracy, const TransferLut *lut) {
+  if (accuracy == TRANSFER_ACCURACY_LUT && Surface != TRANSFER_SURFACE_RGBAF16) {
+    return TransferLutEotf(df, *lut, NearestInt(Mul(v, Set(df, static_cast<float>(lut->maxSample)))));
+  }
+  return ApplyEotf(df, v, transferFunction, accuracy, lut);
+}
+
+template<TransferSurface Surface>
+SPARKYUV_INLINE static float LinearizeValue(const float v, const SparkYuvTransferFunction transferFunction,
+                                            const SparkYuvTransferAccuracy accuracy, const TransferLut *lut) {
+  if (accuracy == TRANSFER_ACCURACY_LUT && Surface != TRANSFER_SURFACE_RGBAF16) {
+    return TransferLutEotf(*lut, static_cast<int>(::lrintf(v * static_cast<float>(lut->maxSample))));
+  }
+  return ApplyEotf(v, transferFunction, accuracy, lut);
+}
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
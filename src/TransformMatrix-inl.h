@@ -427,7 +427,7 @@ void TransformYUVToRGBMatrix(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstSt
 
   const int components = getPixelTypeComponents(PixelType);
 
-  for (int y = 0; y < height; ++y) {
+  for (uint32_t y = 0; y < height; ++y) {
     auto CbSource = reinterpret_cast<const T *>(mUSrc);
     auto CrSource = reinterpret_cast<const T *>(mVSrc);
     auto ySrc = reinterpret_cast<const T *>(mYSrc);
@@ -457,10 +457,8 @@ void TransformYUVToRGBMatrix(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstSt
         } else if (chromaSubsample == YUV_SAMPLE_420 || chromaSubsample == YUV_SAMPLE_422) {
           auto cbh = PromoteTo(dh16, LoadU(dh8, reinterpret_cast<const uint8_t *>(CbSource)));
           auto crh = PromoteTo(dh16, LoadU(dh8, reinterpret_cast<const uint8_t *>(CrSource)));
-          const auto ulc = Sub(BitCast(di16, Combine(d16, cbh, cbh)), uvCorrection);
-          U = InterleaveLower(ulc, ulc);
-          const auto vlc = Sub(BitCast(di16, Combine(d16, crh, crh)), uvCorrection);
-          V = InterleaveLower(vlc, vlc);
+          U = Sub(BitCast(di16, DuplicateChroma(d16, cbh)), uvCorrection);
+          V = Sub(BitCast(di16, DuplicateChroma(d16, crh)), uvCorrection);
         } else {
           static_assert("Must not be reached");
         }
@@ -471,10 +469,8 @@ void TransformYUVToRGBMatrix(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstSt
         } else if (chromaSubsample == YUV_SAMPLE_420 || chromaSubsample == YUV_SAMPLE_422) {
           auto cbh = LoadU(dh16, reinterpret_cast<const uint16_t *>(CbSource));
           auto crh = LoadU(dh16, reinterpret_cast<const uint16_t *>(CrSource));
-          const auto ulc = Sub(BitCast(di16, Combine(d16, cbh, cbh)), uvCorrection);
-          U = InterleaveLower(ulc, ulc);
-          const auto vlc = Sub(BitCast(di16, Combine(d16, crh, crh)), uvCorrection);
-          V = InterleaveLower(vlc, vlc);
+          U = Sub(BitCast(di16, DuplicateChroma(d16, cbh)), uvCorrection);
+          V = Sub(BitCast(di16, DuplicateChroma(d16, crh)), uvCorrection);
         } else {
           static_assert("Must not be reached");
         }
@@ -577,6 +573,196 @@ void TransformYUVToRGBMatrix(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstSt
   }
 }
 
+template<class DI16, class VF32>
+HWY_INLINE Vec<DI16> TransformMatrixRowF32(const DI16 di16, const VF32 Y, const VF32 U, const VF32 V,
+                                           const VF32 c1, const VF32 c2, const VF32 c3) {
+  return DemoteTo(di16, NearestInt(MulAdd(Y, c1, MulAdd(U, c2, Mul(V, c3)))));
+}
+
+/**
+ * Same as TransformYUVToRGBMatrix but evaluates the matrix with f32 FMA and rounds to nearest,
+ * matrices with tiny or non-representable in Q10 coefficients, as YDbDr, keep full precision
+ */
+template<typename T, SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA,
+    SparkYuvChromaSubsample chromaSubsample, int bitDepth>
+void TransformYUVToRGBMatrixF32(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
+                                const uint32_t width, const uint32_t height,
+                                const T *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                const T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                const T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                const SparkYuvColorRange colorRange,
+                                const SparkYuvTransformMatrix matrix) {
+  static_assert(bitDepth >= 8, "Invalid bit depth");
+  static_assert(
+      chromaSubsample == YUV_SAMPLE_444 || chromaSubsample == YUV_SAMPLE_420 || chromaSubsample == YUV_SAMPLE_422,
+      "Unsupported chroma type");
+  const ScalableTag<uint16_t> d16;
+  const RebindToSigned<decltype(d16)> di16;
+  const Half<decltype(d16)> dh16;
+  const Half<decltype(di16)> dhi16;
+  const Rebind<int32_t, decltype(dh16)> d32;
+  const Rebind<float, decltype(d32)> df32;
+  using V16 = Vec<decltype(d16)>;
+  using VI16 = Vec<decltype(di16)>;
+  using VF32 = Vec<decltype(df32)>;
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
+  auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
+  auto dst = reinterpret_cast<uint8_t *>(rgbaData);
+
+  uint16_t biasY;
+  uint16_t biasUV;
+  uint16_t rangeY;
+  uint16_t rangeUV;
+  GetYUVRange(colorRange, bitDepth, biasY, biasUV, rangeY, rangeUV);
+
+  const int maxColors = static_cast<int>(::powf(2.f, static_cast<float>(bitDepth)) - 1.f);
+
+  const auto uvCorrection = Set(di16, biasUV);
+  const V16 vAlpha = Set(d16, maxColors);
+  const auto uvCorrIY = Set(di16, biasY);
+  const auto vMaxColors = Set(di16, maxColors);
+  const auto zeros = Zero(di16);
+
+  const float rangeReformatY = static_cast<float>(maxColors) / static_cast<float>(rangeY);
+  const float rangeReformatUV = static_cast<float>(maxColors) / static_cast<float>(rangeUV);
+
+  const float YR = matrix.Y1 * rangeReformatY, YG = matrix.Y2 * rangeReformatUV, YB = matrix.Y3 * rangeReformatUV;
+  const float CbR = matrix.U1 * rangeReformatY, CbG = matrix.U2 * rangeReformatUV, CbB = matrix.U3 * rangeReformatUV;
+  const float CrR = matrix.V1 * rangeReformatY, CrG = matrix.V2 * rangeReformatUV, CrB = matrix.V3 * rangeReformatUV;
+
+  const auto vYR = Set(df32, YR);
+  const auto vYG = Set(df32, YG);
+  const auto vYB = Set(df32, YB);
+  const auto vCbR = Set(df32, CbR);
+  const auto vCbG = Set(df32, CbG);
+  const auto vCbB = Set(df32, CbB);
+  const auto vCrR = Set(df32, CrR);
+  const auto vCrG = Set(df32, CrG);
+  const auto vCrB = Set(df32, CrB);
+
+  const int lanes = Lanes(d16);
+  const int lanesForward = getYuvChromaPixels(chromaSubsample);
+  const int uvLanes = (chromaSubsample == YUV_SAMPLE_444) ? lanes : Lanes(dh16);
+
+  const int components = getPixelTypeComponents(PixelType);
+
+  for (uint32_t y = 0; y < height; ++y) {
+    auto CbSource = reinterpret_cast<const T *>(mUSrc);
+    auto CrSource = reinterpret_cast<const T *>(mVSrc);
+    auto ySrc = reinterpret_cast<const T *>(mYSrc);
+    auto store = reinterpret_cast<T *>(dst);
+
+    uint32_t x = 0;
+
+    for (; x + lanes < width; x += lanes) {
+      VI16 Y;
+      if (std::is_same<T, uint16_t>::value) {
+        Y = Sub(BitCast(di16, LoadU(d16, reinterpret_cast<const uint16_t *>(ySrc))), uvCorrIY);
+      } else if (std::is_same<T, uint8_t>::value) {
+        const Rebind<uint8_t, decltype(d16)> d8;
+        Y = Sub(BitCast(di16, PromoteTo(d16, LoadU(d8, reinterpret_cast<const uint8_t *>(ySrc)))), uvCorrIY);
+      } else {
+        static_assert("Must not be reached");
+      }
+
+      VI16 U;
+      VI16 V;
+      if (std::is_same<T, uint8_t>::value) {
+        const Rebind<uint8_t, decltype(d16)> d8;
+        const Rebind<uint8_t, decltype(dh16)> dh8;
+        if (chromaSubsample == YUV_SAMPLE_444) {
+          U = Sub(BitCast(di16, PromoteTo(d16, LoadU(d8, reinterpret_cast<const uint8_t *>(CbSource)))), uvCorrection);
+          V = Sub(BitCast(di16, PromoteTo(d16, LoadU(d8, reinterpret_cast<const uint8_t *>(CrSource)))), uvCorrection);
+        } else if (chromaSubsample == YUV_SAMPLE_420 || chromaSubsample == YUV_SAMPLE_422) {
+          auto cbh = PromoteTo(dh16, LoadU(dh8, reinterpret_cast<const uint8_t *>(CbSource)));
+          auto crh = PromoteTo(dh16, LoadU(dh8, reinterpret_cast<const uint8_t *>(CrSource)));
+          U = Sub(BitCast(di16, DuplicateChroma(d16, cbh)), uvCorrection);
+          V = Sub(BitCast(di16, DuplicateChroma(d16, crh)), uvCorrection);
+        } else {
+          static_assert("Must not be reached");
+        }
+      } else if (std::is_same<T, uint16_t>::value) {
+        if (chromaSubsample == YUV_SAMPLE_444) {
+          U = Sub(BitCast(di16, LoadU(d16, reinterpret_cast<const uint16_t *>(CbSource))), uvCorrection);
+          V = Sub(BitCast(di16, LoadU(d16, reinterpret_cast<const uint16_t *>(CrSource))), uvCorrection);
+        } else if (chromaSubsample == YUV_SAMPLE_420 || chromaSubsample == YUV_SAMPLE_422) {
+          auto cbh = LoadU(dh16, reinterpret_cast<const uint16_t *>(CbSource));
+          auto crh = LoadU(dh16, reinterpret_cast<const uint16_t *>(CrSource));
+          U = Sub(BitCast(di16, DuplicateChroma(d16, cbh)), uvCorrection);
+          V = Sub(BitCast(di16, DuplicateChroma(d16, crh)), uvCorrection);
+        } else {
+          static_assert("Must not be reached");
+        }
+      }
+
+      const VF32 Yl = ConvertTo(df32, PromoteLowerTo(d32, Y));
+      const VF32 Yh = ConvertTo(df32, PromoteUpperTo(d32, Y));
+      const VF32 Ul = ConvertTo(df32, PromoteLowerTo(d32, U));
+      const VF32 Uh = ConvertTo(df32, PromoteUpperTo(d32, U));
+      const VF32 Vl = ConvertTo(df32, PromoteLowerTo(d32, V));
+      const VF32 Vh = ConvertTo(df32, PromoteUpperTo(d32, V));
+
+      V16 r, g, b;
+      r = BitCast(d16, Clamp(Combine(di16, TransformMatrixRowF32(dhi16, Yh, Uh, Vh, vYR, vYG, vYB),
+                                     TransformMatrixRowF32(dhi16, Yl, Ul, Vl, vYR, vYG, vYB)), zeros, vMaxColors));
+      g = BitCast(d16, Clamp(Combine(di16, TransformMatrixRowF32(dhi16, Yh, Uh, Vh, vCbR, vCbG, vCbB),
+                                     TransformMatrixRowF32(dhi16, Yl, Ul, Vl, vCbR, vCbG, vCbB)), zeros, vMaxColors));
+      b = BitCast(d16, Clamp(Combine(di16, TransformMatrixRowF32(dhi16, Yh, Uh, Vh, vCrR, vCrG, vCrB),
+                                     TransformMatrixRowF32(dhi16, Yl, Ul, Vl, vCrR, vCrG, vCrB)), zeros, vMaxColors));
+
+      if (std::is_same<T, uint16_t>::value) {
+        StoreRGBA<PixelType>(d16, reinterpret_cast<uint16_t *>(store), r, g, b, vAlpha);
+      } else if (std::is_same<T, uint8_t>::value) {
+        StoreRGBA<PixelType>(d16, reinterpret_cast<uint8_t *>(store), r, g, b, vAlpha);
+      } else {
+        static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value, "Unexpected storage type");
+      }
+
+      store += lanes * components;
+      ySrc += lanes;
+
+      CbSource += uvLanes;
+      CrSource += uvLanes;
+    }
+
+    for (; x < width; x += lanesForward) {
+      const float U = static_cast<float>(static_cast<int>(CbSource[0]) - biasUV);
+      const float V = static_cast<float>(static_cast<int>(CrSource[0]) - biasUV);
+
+      const int pixels = (chromaSubsample == YUV_SAMPLE_444) ? 1 : std::min(2, static_cast<int>(width - x));
+
+      for (int i = 0; i < pixels; ++i) {
+        const float Y = static_cast<float>(static_cast<int>(ySrc[0]) - biasY);
+        const int R = static_cast<int>(::roundf(Y * YR + U * YG + V * YB));
+        const int G = static_cast<int>(::roundf(Y * CbR + U * CbG + V * CbB));
+        const int B = static_cast<int>(::roundf(Y * CrR + U * CrG + V * CrB));
+
+        SaturatedStoreRGBA<T, int, PixelType>(store, R, G, B, maxColors, maxColors);
+
+        store += components;
+        ySrc += 1;
+      }
+
+      CbSource += 1;
+      CrSource += 1;
+    }
+
+    if (chromaSubsample == YUV_SAMPLE_444 || chromaSubsample == YUV_SAMPLE_422) {
+      mUSrc += uStride;
+      mVSrc += vStride;
+    } else if (chromaSubsample == YUV_SAMPLE_420) {
+      if (y & 1) {
+        mUSrc += uStride;
+        mVSrc += vStride;
+      }
+    }
+    mYSrc += yStride;
+    dst += dstStride;
+  }
+}
+
 }
 HWY_AFTER_NAMESPACE();
 
@@ -83,6 +83,12 @@ void Pixel8ToYCbCr400HWY(const uint8_t *SPARKYUV_RESTRICT src,
 
   const int components = getPixelTypeComponents(PixelType);
 
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+#endif
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -90,6 +96,19 @@ void Pixel8ToYCbCr400HWY(const uint8_t *SPARKYUV_RESTRICT src,
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
 
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        const auto Y = BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY));
+        StoreU(DemoteTo(du8, Y), du8, yDst);
+
+        yDst += lanes;
+
+        mSrc += components * lanes;
+      }
+    }
+#endif
+
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
       VU8 G8;
@@ -203,7 +222,7 @@ void YCbCr400ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
     uint32_t x = 0;
 
     for (; x + lanes < width; x += lanes) {
-      const auto Y = Sub(LoadU(du8, ySrc), uvCorrIY);
+      const auto Y = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
 
       const auto Yh = BitCast(di16, WidenMulHigh(du8, Y, ivLumaCoeff));
       const auto Yl = BitCast(di16, WidenMul(du8h, LowerHalf(Y), ivLumaCoeffh));
@@ -218,7 +237,7 @@ void YCbCr400ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
 
     for (; x < width; ++x) {
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       int tone = Y >> 6;
 
       SaturatedStoreRGBA<uint8_t, int, PixelType>(store, tone, tone, tone, 255, 255);
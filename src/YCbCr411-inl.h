@@ -29,6 +29,53 @@
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
 
+/**
+ * Chroma of one pixel, clamped as the vector path demotes it
+ */
+template<SparkYuvDefaultPixelType PixelType>
+SPARKYUV_INLINE static void EncodeChroma411(const uint8_t *SPARKYUV_RESTRICT source,
+                                            const int CbR, const int CbG, const int CbB,
+                                            const int CrR, const int CrG, const int CrB,
+                                            const int iBiasUV, const int precision, uint8_t &cb, uint8_t &cr) {
+  int r, g, b;
+  LoadRGB<uint8_t, int, PixelType>(source, r, g, b);
+  cb = static_cast<uint8_t>(std::clamp((-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision, 0, 255));
+  cr = static_cast<uint8_t>(std::clamp((r * CrR - g * CrG - b * CrB + iBiasUV) >> precision, 0, 255));
+}
+
+/**
+ * Scalar counterpart of ChromaTapFilter121
+ */
+SPARKYUV_INLINE static int ChromaTap121(const int left, const int center, const int right) {
+  return (center + ((left + right) >> 1) + 1) >> 1;
+}
+
+/**
+ * Filters one vector of full resolution chroma by ChromaTapFilter121 and sums each 4 samples into 4:1:1 sample.
+ * `cbNext` and `crNext` belong to the pixel after the vector, previous carries are updated from the last lane
+ */
+template<class D, HWY_IF_U8_D(D)>
+SPARKYUV_INLINE static void StoreChroma411(D du8, const Vec<D> CbFull, const Vec<D> CrFull, const bool firstVector,
+                                           uint8_t &cbPrevious, uint8_t &crPrevious,
+                                           const uint8_t cbNext, const uint8_t crNext,
+                                           uint8_t *SPARKYUV_RESTRICT uDst, uint8_t *SPARKYUV_RESTRICT vDst) {
+  const RepartitionToWide<RepartitionToWide<D>> du32;
+  const Rebind<uint8_t, decltype(du32)> du8CbCr;
+  if (firstVector) {
+    cbPrevious = ExtractLane(CbFull, 0);
+    crPrevious = ExtractLane(CrFull, 0);
+  }
+
+  const auto Cb = ShiftRightNarrow<2>(du32, SumsOf2(SumsOf2(ChromaTapFilter121(du8, CbFull, cbPrevious, cbNext))));
+  const auto Cr = ShiftRightNarrow<2>(du32, SumsOf2(SumsOf2(ChromaTapFilter121(du8, CrFull, crPrevious, crNext))));
+
+  cbPrevious = ExtractLane(CbFull, Lanes(du8) - 1);
+  crPrevious = ExtractLane(CrFull, Lanes(du8) - 1);
+
+  StoreU(DemoteTo(du8CbCr, Cb), du8CbCr, uDst);
+  StoreU(DemoteTo(du8CbCr, Cr), du8CbCr, vDst);
+}
+
 template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, SparkYuvChromaSubsample chromaSubsample>
 void Pixel8ToYCbCr411(const uint8_t *SPARKYUV_RESTRICT src,
                       const uint32_t srcStride,
@@ -70,11 +117,9 @@ void Pixel8ToYCbCr411(const uint8_t *SPARKYUV_RESTRICT src,
   const ScalableTag<uint8_t> du8;
   const Half<decltype(di16)> dhi16;
   const Rebind<int32_t, decltype(dhi16)> d32;
-  const RebindToUnsigned<decltype(d32)> du32;
   using VU8 = Vec<decltype(du8)>;
   using VU16 = Vec<decltype(di16)>;
   using V32 = Vec<decltype(d32)>;
-  const Rebind<uint8_t, decltype(du32)> du8CbCr;
 
   const Half<decltype(du8)> du8h;
 
@@ -101,6 +146,14 @@ void Pixel8ToYCbCr411(const uint8_t *SPARKYUV_RESTRICT src,
   const int components = getPixelTypeComponents(PixelType);
   const uint32_t lastY = height - 1 - 4;
 
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+#endif
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -110,6 +163,43 @@ void Pixel8ToYCbCr411(const uint8_t *SPARKYUV_RESTRICT src,
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
 
+    uint8_t cbPrevious = 0;
+    uint8_t crPrevious = 0;
+
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        // Lower and upper halves of the row are dotted separately, each gives one i16 vector
+        const uint8_t *mSrcHigh = mSrc + (lanes / 2) * components;
+        const auto Yl = BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY));
+        const auto Yh = BitCast(du16, DotPixels8(di16, mSrcHigh, vDotY, vDotYRest, vBiasY));
+
+        StoreU(Combine(du8, DemoteTo(du8h, Yh), DemoteTo(du8h, Yl)), du8, yDst);
+
+        if (chromaSubsample == YUV_SAMPLE_411 || ((y % 4 == 0 || y > lastY) && chromaSubsample == YUV_SAMPLE_410)) {
+          const auto Clbf = BitCast(du16, DotPixels8(di16, mSrc, vDotCb, vDotCbRest, vBiasUV));
+          const auto Chbf = BitCast(du16, DotPixels8(di16, mSrcHigh, vDotCb, vDotCbRest, vBiasUV));
+          const auto Clrf = BitCast(du16, DotPixels8(di16, mSrc, vDotCr, vDotCrRest, vBiasUV));
+          const auto Chrf = BitCast(du16, DotPixels8(di16, mSrcHigh, vDotCr, vDotCrRest, vBiasUV));
+
+          const auto CbFull = Combine(du8, DemoteTo(du8h, Chbf), DemoteTo(du8h, Clbf));
+          const auto CrFull = Combine(du8, DemoteTo(du8h, Chrf), DemoteTo(du8h, Clrf));
+
+          uint8_t cbNext, crNext;
+          EncodeChroma411<PixelType>(mSrc + components * lanes, CbR, CbG, CbB, CrR, CrG, CrB, iBiasUV, precision,
+                                     cbNext, crNext);
+          StoreChroma411(du8, CbFull, CrFull, x == 0, cbPrevious, crPrevious, cbNext, crNext, uDst, vDst);
+        }
+
+        yDst += lanes;
+        uDst += uvLanes;
+        vDst += uvLanes;
+
+        mSrc += components * lanes;
+      }
+    }
+#endif
+
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
       VU8 G8;
@@ -177,15 +267,14 @@ void Pixel8ToYCbCr411(const uint8_t *SPARKYUV_RESTRICT src,
         const auto
             Clrf = BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, Clrh), ShiftRightNarrow<8>(d32, Clrl)));
 
-        const auto
-            Cb = ShiftRightNarrow<2>(du32,
-                                     SumsOf2(SumsOf2(Combine(du8, DemoteTo(du8h, Chbf), DemoteTo(du8h, Clbf)))));
-        const auto
-            Cr = ShiftRightNarrow<2>(du32,
-                                     SumsOf2(SumsOf2(Combine(du8, DemoteTo(du8h, Chrf), DemoteTo(du8h, Clrf)))));
+        const auto CbFull = Combine(du8, DemoteTo(du8h, Chbf), DemoteTo(du8h, Clbf));
+        const auto CrFull = Combine(du8, DemoteTo(du8h, Chrf), DemoteTo(du8h, Clrf));
 
-        StoreU(DemoteTo(du8CbCr, Cb), du8CbCr, uDst);
-        StoreU(DemoteTo(du8CbCr, Cr), du8CbCr, vDst);
+        // Loop condition guarantees that next pixel exists
+        uint8_t cbNext, crNext;
+        EncodeChroma411<PixelType>(mSrc + components * lanes, CbR, CbG, CbB, CrR, CrG, CrB, iBiasUV, precision,
+                                   cbNext, crNext);
+        StoreChroma411(du8, CbFull, CrFull, x == 0, cbPrevious, crPrevious, cbNext, crNext, uDst, vDst);
       }
 
       yDst += lanes;
@@ -196,70 +285,47 @@ void Pixel8ToYCbCr411(const uint8_t *SPARKYUV_RESTRICT src,
     }
 
     for (; x < width; x += 4) {
-      int r;
-      int g;
-      int b;
-
-      LoadRGB<uint8_t, int, PixelType>(mSrc, r, g, b);
-
-      int r1 = r, g1 = g, b1 = b;
-      int r2 = r, g2 = g, b2 = b;
-      int r3 = r, g3 = g, b3 = b;
-
-      int Y = ((r * YR + g * YG + b * YB + iBiasY) >> precision);
-
-      yDst[0] = Y;
-      yDst += 1;
-
-      mSrc += components;
-
-      if (x + 1 < width) {
-        LoadRGB<uint8_t, int, PixelType>(mSrc, r1, g1, b1);
-
-        int Y1 = ((r1 * YR + g1 * YG + b1 * YB + iBiasY) >> precision);
-
-        yDst[0] = Y1;
-        yDst += 1;
-
-        mSrc += components;
-      }
-
-      if (x + 2 < width) {
-        LoadRGB<uint8_t, int, PixelType>(mSrc, r2, g2, b2);
-
-        int Y1 = ((r2 * YR + g2 * YG + b2 * YB + iBiasY) >> precision);
-
-        yDst[0] = Y1;
-        yDst += 1;
-
-        mSrc += components;
-      }
-
-      if (x + 3 < width) {
-        LoadRGB<uint8_t, int, PixelType>(mSrc, r3, g3, b3);
-
-        int Y1 = ((r3 * YR + g3 * YG + b3 * YB + iBiasY) >> precision);
-
-        yDst[0] = Y1;
-        yDst += 1;
-
-        mSrc += components;
+      const uint32_t blockWidth = std::min(width - x, static_cast<uint32_t>(4));
+      for (uint32_t i = 0; i < blockWidth; ++i) {
+        int r, g, b;
+        LoadRGB<uint8_t, int, PixelType>(mSrc + i * components, r, g, b);
+        yDst[i] = static_cast<uint8_t>((r * YR + g * YG + b * YB + iBiasY) >> precision);
       }
 
       if (chromaSubsample == YUV_SAMPLE_411 || ((y % 4 == 0 || y > lastY) && chromaSubsample == YUV_SAMPLE_410)) {
-        r = (r + r1 + r2 + r3) >> 2;
-        g = (g + g1 + g2 + g3) >> 2;
-        b = (b + b1 + b2 + b3) >> 2;
+        // Same signal as in vector path: encoded chroma is [1, 2, 1] filtered and then summed by 4,
+        // pixels past the row end repeat the last one
+        uint8_t cb[6], cr[6];
+        for (uint32_t i = 0; i < 4; ++i) {
+          EncodeChroma411<PixelType>(mSrc + std::min(i, blockWidth - 1) * components,
+                                     CbR, CbG, CbB, CrR, CrG, CrB, iBiasUV, precision, cb[i + 1], cr[i + 1]);
+        }
+        cb[0] = x == 0 ? cb[1] : cbPrevious;
+        cr[0] = x == 0 ? cr[1] : crPrevious;
+        cb[5] = cb[4];
+        cr[5] = cr[4];
+        if (x + 4 < width) {
+          EncodeChroma411<PixelType>(mSrc + 4 * components, CbR, CbG, CbB, CrR, CrG, CrB, iBiasUV, precision,
+                                     cb[5], cr[5]);
+        }
+        cbPrevious = cb[4];
+        crPrevious = cr[4];
 
-        int Cb = ((-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision);
-        int Cr = ((r * CrR - g * CrG - b * CrB + iBiasUV) >> precision);
+        int Cb = 0, Cr = 0;
+        for (int i = 1; i <= 4; ++i) {
+          Cb += ChromaTap121(cb[i - 1], cb[i], cb[i + 1]);
+          Cr += ChromaTap121(cr[i - 1], cr[i], cr[i + 1]);
+        }
 
-        uDst[0] = Cb;
-        vDst[0] = Cr;
+        uDst[0] = static_cast<uint8_t>(Cb >> 2);
+        vDst[0] = static_cast<uint8_t>(Cr >> 2);
       }
 
+      yDst += blockWidth;
       uDst += 1;
       vDst += 1;
+
+      mSrc += components * blockWidth;
     }
 
     yStore += yStride;
@@ -402,7 +468,7 @@ void YCbCr411ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
     for (; x + lanes < width; x += lanes) {
       const RepartitionToWide<decltype(di16hh)> di32hh;
       const Twice<decltype(di32hh)> di32h;
-      const auto luma8 = Sub(LoadU(du8, ySrc), uvCorrIY);
+      const auto luma8 = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
       const auto ulFull = Sub(BitCast(di16hh, PromoteTo(du16hh, LoadU(du8hh, uSource))), uvCorrection);
       const auto vlFull = Sub(BitCast(di16hh, PromoteTo(du16hh, LoadU(du8hh, vSource))), uvCorrection);
 
@@ -464,7 +530,7 @@ void YCbCr411ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
       const uint8_t uValue = reinterpret_cast<const uint8_t *>(uSource)[0];
       const uint8_t vValue = reinterpret_cast<const uint8_t *>(vSource)[0];
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       const int Cr = (static_cast<int>(vValue) - biasUV);
       const int Cb = (static_cast<int>(uValue) - biasUV);
 
@@ -478,7 +544,7 @@ void YCbCr411ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
       ySrc += 1;
 
       if (x + 1 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -489,7 +555,7 @@ void YCbCr411ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
       }
 
       if (x + 2 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -500,7 +566,7 @@ void YCbCr411ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
       }
 
       if (x + 3 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -120,6 +120,9 @@ void Pixel16ToYCbCr411HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
 
     auto mSrc = reinterpret_cast<const uint16_t *>(mSource);
 
+    uint16_t cbPrevious = 0;
+    uint16_t crPrevious = 0;
+
     for (; x + lanes < width; x += lanes) {
       V16 R;
       V16 G;
@@ -154,11 +157,26 @@ void Pixel16ToYCbCr411HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
         const auto
             Cr = BitCast(du16, Combine(d16, ShiftRightNarrow<8>(d32, Crh), ShiftRightNarrow<8>(d32, Crl)));
 
+        // Loop condition guarantees that next pixel exists
+        int nr, ng, nb;
+        LoadRGB<uint16_t, int, PixelType>(mSrc + components * lanes, nr, ng, nb);
+        const auto cbNext = static_cast<uint16_t>(std::clamp((-nr * CbR - ng * CbG + nb * CbB + iBiasUV) >> precision,
+                                                             0, maxColors));
+        const auto crNext = static_cast<uint16_t>(std::clamp((nr * CrR - ng * CrG - nb * CrB + iBiasUV) >> precision,
+                                                             0, maxColors));
+        if (x == 0) {
+          cbPrevious = ExtractLane(Cb, 0);
+          crPrevious = ExtractLane(Cr, 0);
+        }
+
         const RepartitionToWide<decltype(du32)> du64;
         const Rebind<uint16_t, decltype(du64)> du16cb;
 
-        const auto cbh = ShiftRightNarrow<2>(du64, SumsOf2(SumsOf2(Cb)));
-        const auto crh = ShiftRightNarrow<2>(du64, SumsOf2(SumsOf2(Cr)));
+        const auto cbh = ShiftRightNarrow<2>(du64, SumsOf2(SumsOf2(ChromaTapFilter121(du16, Cb, cbPrevious, cbNext))));
+        const auto crh = ShiftRightNarrow<2>(du64, SumsOf2(SumsOf2(ChromaTapFilter121(du16, Cr, crPrevious, crNext))));
+
+        cbPrevious = ExtractLane(Cb, lanes - 1);
+        crPrevious = ExtractLane(Cr, lanes - 1);
         StoreU(DemoteTo(du16cb, cbh), du16cb, uDst);
         StoreU(DemoteTo(du16cb, crh), du16cb, vDst);
       }
@@ -176,6 +194,11 @@ void Pixel16ToYCbCr411HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
 
       LoadRGB<uint16_t, int, PixelType>(mSrc, r, g, b);
 
+      int rl = r, gl = g, bl = b;
+      if (x > 0) {
+        LoadRGB<uint16_t, int, PixelType>(mSrc - components, rl, gl, bl);
+      }
+
       int r1 = r, g1 = g, b1 = b;
       int r2 = r, g2 = g, b2 = b;
       int r3 = r, g3 = g, b3 = b;
@@ -219,9 +242,14 @@ void Pixel16ToYCbCr411HWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t
       }
 
       if (chromaSubsample == YUV_SAMPLE_411 || ((y % 4 == 0 || y > lastY) && chromaSubsample == YUV_SAMPLE_410)) {
-        r = (r + r1 + r2 + r3) >> 2;
-        g = (g + g1 + g2 + g3) >> 2;
-        b = (b + b1 + b2 + b3) >> 2;
+        int rr = r3, gr = g3, br = b3;
+        if (x + lanesForward < width) {
+          LoadRGB<uint16_t, int, PixelType>(mSrc, rr, gr, br);
+        }
+
+        r = (rl + 3 * r + 4 * r1 + 4 * r2 + 3 * r3 + rr + 8) >> 4;
+        g = (gl + 3 * g + 4 * g1 + 4 * g2 + 3 * g3 + gr + 8) >> 4;
+        b = (bl + 3 * b + 4 * b1 + 4 * b2 + 3 * b3 + br + 8) >> 4;
 
         int Cb = ((-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision);
         int Cr = ((r * CrR - g * CrG - b * CrB + iBiasUV) >> precision);
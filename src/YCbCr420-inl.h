@@ -24,6 +24,10 @@
 #include "hwy/highway.h"
 #include "yuv-inl.h"
 #include "sparkyuv-internal.h"
+#include "ConvertRegion-inl.h"
+#include "Letterbox-inl.h"
+#include "Tensor-inl.h"
+#include "YCbCr420Wide-inl.h"
 #include <algorithm>
 #include <cmath>
 
@@ -32,6 +36,9 @@ namespace sparkyuv::HWY_NAMESPACE {
 using namespace hwy;
 using namespace hwy::HWY_NAMESPACE;
 
+/**
+ * RGB to planar 4:2:0, two rows per iteration with WeightedSumRGB8 and AverageBlock2x2
+ */
 template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
 void Pixel8ToYCbCr420HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                          const uint32_t width, const uint32_t height,
@@ -65,16 +72,12 @@ void Pixel8ToYCbCr420HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t sr
 
   auto mSource = reinterpret_cast<const uint8_t *>(src);
 
-  const ScalableTag<uint16_t> du16;
   const ScalableTag<int16_t> di16;
+  const RebindToUnsigned<decltype(di16)> du16;
   const Rebind<uint8_t, decltype(di16)> du8;
-  const Half<decltype(di16)> dhi16;
-  const Rebind<int32_t, decltype(dhi16)> d32;
-  const RebindToUnsigned<decltype(d32)> du32;
+  const RepartitionToWide<decltype(di16)> d32;
+  const Rebind<uint8_t, decltype(d32)> du8h;
   using VU8 = Vec<decltype(du8)>;
-  using V32 = Vec<decltype(d32)>;
-
-  const Half<decltype(du8)> du8h;
 
   const int lanes = Lanes(du8);
   const int halfLanes = lanes / 2;
@@ -82,30 +85,68 @@ void Pixel8ToYCbCr420HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t sr
   const auto vBiasY = Set(d32, iBiasY);
   const auto vBiasUV = Set(d32, iBiasUV);
 
-  const auto coeffTag = di16;
+  const auto vYR = Set(di16, YR);
+  const auto vYG = Set(di16, YG);
+  const auto vYB = Set(di16, YB);
 
-  const auto vYR = Set(coeffTag, YR);
-  const auto vYG = Set(coeffTag, YG);
-  const auto vYB = Set(coeffTag, YB);
+  const auto vCbR = Set(d32, -static_cast<int>(CbR));
+  const auto vCbG = Set(d32, -static_cast<int>(CbG));
+  const auto vCbB = Set(d32, CbB);
 
-  const auto vCbR = Set(coeffTag, -CbR);
-  const auto vCbG = Set(coeffTag, -CbG);
-  const auto vCbB = Set(coeffTag, CbB);
-
-  const auto vCrR = Set(coeffTag, CrR);
-  const auto vCrG = Set(coeffTag, -CrG);
-  const auto vCrB = Set(coeffTag, -CrB);
+  const auto vCrR = Set(d32, CrR);
+  const auto vCrG = Set(d32, -static_cast<int>(CrG));
+  const auto vCrB = Set(d32, -static_cast<int>(CrB));
 
   const int components = getPixelTypeComponents(PixelType);
 
-  for (uint32_t y = 0; y < height; ++y) {
-    uint32_t x = 0;
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<uint8_t, decltype(di16)> du8x;
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+  const int pixelLanes = Lanes(du8x);
+#endif
+
+  for (uint32_t y = 0; y < height; y += 2) {
+    // Last odd row is paired with itself and its luma is simply written twice
+    const uint32_t nextRow = y + 1 < height ? 1 : 0;
 
     auto yDst = reinterpret_cast<uint8_t *>(yStore);
+    auto yNextDst = reinterpret_cast<uint8_t *>(yStore + nextRow * yStride);
     auto uDst = reinterpret_cast<uint8_t *>(uStore);
     auto vDst = reinterpret_cast<uint8_t *>(vStore);
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
+    auto mNextSrc = reinterpret_cast<const uint8_t *>(mSource + nextRow * srcStride);
+
+    uint32_t x = 0;
+
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        StoreU(DemoteTo(du8, BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY))), du8, yDst);
+        StoreU(DemoteTo(du8, BitCast(du16, DotPixels8(di16, mNextSrc, vDotY, vDotYRest, vBiasY))), du8, yNextDst);
+
+        const auto block = AveragePixels2x2(du8x, LoadU(du8x, mSrc), LoadU(du8x, mSrc + pixelLanes),
+                                            LoadU(du8x, mNextSrc), LoadU(du8x, mNextSrc + pixelLanes));
+        const auto Cb = DotPixels8(d32, block, vDotCb, vDotCbRest, vBiasUV);
+        const auto Cr = DotPixels8(d32, block, vDotCr, vDotCrRest, vBiasUV);
+
+        StoreU(DemoteTo(du8h, Cb), du8h, uDst);
+        StoreU(DemoteTo(du8h, Cr), du8h, vDst);
+
+        yDst += lanes;
+        yNextDst += lanes;
+        uDst += halfLanes;
+        vDst += halfLanes;
+
+        mSrc += components * lanes;
+        mNextSrc += components * lanes;
+      }
+    }
+#endif
 
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
@@ -113,132 +154,81 @@ void Pixel8ToYCbCr420HWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t sr
       VU8 B8;
       VU8 A8;
       LoadRGBA<PixelType>(du8, mSrc, R8, G8, B8, A8);
+      const auto R = PromoteTo(du16, R8);
+      const auto G = PromoteTo(du16, G8);
+      const auto B = PromoteTo(du16, B8);
 
-      auto R = BitCast(di16, PromoteTo(du16, R8));
-      auto G = BitCast(di16, PromoteTo(du16, G8));
-      auto B = BitCast(di16, PromoteTo(du16, B8));
-
-      V32 YRh = vBiasY;
-      V32 YRl = WidenMulAccumulate(d32, R, vYR, vBiasY, YRh);
-      YRl = WidenMulAccumulate(d32, G, vYG, YRl, YRh);
-      YRl = WidenMulAccumulate(d32, B, vYB, YRl, YRh);
-
-      const auto Y = BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, YRh), ShiftRightNarrow<8>(d32, YRl)));
-      if (!(y & 1)) {
-        if (y + 1 < height) {
-          LoadRGBA<PixelType>(du8, mSrc, R8, G8, B8, A8);
-
-          const auto R1 = BitCast(di16, PromoteTo(du16, R8));
-          const auto G1 = BitCast(di16, PromoteTo(du16, G8));
-          const auto B1 = BitCast(di16, PromoteTo(du16, B8));
-          R = AddAndHalf(di16, R, R1);
-          G = AddAndHalf(di16, G, G1);
-          B = AddAndHalf(di16, B, B1);
-        }
-
-        V32 Cbh = vBiasUV;
-        V32 Cbl = WidenMulAccumulate(d32, R, vCbR, vBiasUV, Cbh);
-        Cbl = WidenMulAccumulate(d32, G, vCbG, Cbl, Cbh);
-        Cbl = WidenMulAccumulate(d32, B, vCbB, Cbl, Cbh);
-
-        const auto Cbf = BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, Cbh), ShiftRightNarrow<8>(d32, Cbl)));
+      LoadRGBA<PixelType>(du8, mNextSrc, R8, G8, B8, A8);
+      const auto R1 = PromoteTo(du16, R8);
+      const auto G1 = PromoteTo(du16, G8);
+      const auto B1 = PromoteTo(du16, B8);
 
-        V32 Crh = vBiasUV;
-        V32 Crl = WidenMulAccumulate(d32, R, vCrR, vBiasUV, Crh);
-        Crl = WidenMulAccumulate(d32, G, vCrG, Crl, Crh);
-        Crl = WidenMulAccumulate(d32, B, vCrB, Crl, Crh);
+      StoreU(WeightedSumRGB8(di16, BitCast(di16, R), BitCast(di16, G), BitCast(di16, B),
+                             vYR, vYG, vYB, vBiasY), du8, yDst);
+      StoreU(WeightedSumRGB8(di16, BitCast(di16, R1), BitCast(di16, G1), BitCast(di16, B1),
+                             vYR, vYG, vYB, vBiasY), du8, yNextDst);
 
-        const auto Crf = BitCast(du16, Combine(di16, ShiftRightNarrow<8>(d32, Crh), ShiftRightNarrow<8>(d32, Crl)));
+      const auto Rc = AverageBlock2x2(du16, R, R1);
+      const auto Gc = AverageBlock2x2(du16, G, G1);
+      const auto Bc = AverageBlock2x2(du16, B, B1);
 
-        const auto Cb = DemoteTo(du8h, ShiftRightNarrow<1>(du32, SumsOf2(Cbf)));
-        const auto Cr = DemoteTo(du8h, ShiftRightNarrow<1>(du32, SumsOf2(Crf)));
+      const auto Cb = ShiftRight<8>(Add(Add(Mul(Rc, vCbR), Mul(Gc, vCbG)), Add(Mul(Bc, vCbB), vBiasUV)));
+      const auto Cr = ShiftRight<8>(Add(Add(Mul(Rc, vCrR), Mul(Gc, vCrG)), Add(Mul(Bc, vCrB), vBiasUV)));
 
-        StoreU(Cb, du8h, uDst);
-        StoreU(Cr, du8h, vDst);
-      }
-
-      StoreU(DemoteTo(du8, Y), du8, yDst);
+      StoreU(DemoteTo(du8h, Cb), du8h, uDst);
+      StoreU(DemoteTo(du8h, Cr), du8h, vDst);
 
       yDst += lanes;
+      yNextDst += lanes;
       uDst += halfLanes;
       vDst += halfLanes;
 
       mSrc += components * lanes;
+      mNextSrc += components * lanes;
     }
 
     for (; x < width; x += 2) {
-      int r;
-      int g;
-      int b;
-
+      int r, g, b;
+      int r1, g1, b1;
       LoadRGB<uint8_t, int, PixelType>(mSrc, r, g, b);
-
-      int Y0 = ((r * YR + g * YG + b * YB + iBiasY) >> precision);
-
-      auto mNextSrc = mSrc;
-
-      if (y + 1 < height) {
-        mNextSrc = reinterpret_cast<const uint8_t *>(mSrc) + srcStride;
-      }
-
-      int r1 = r;
-      int g1 = g;
-      int b1 = b;
-
       LoadRGB<uint8_t, int, PixelType>(mNextSrc, r1, g1, b1);
 
-      yDst[0] = Y0;
-      yDst += 1;
-
-      int r2 = r;
-      int g2 = g;
-      int b2 = b;
+      int r2 = r, g2 = g, b2 = b;
+      int r3 = r1, g3 = g1, b3 = b1;
 
-      int r3 = r;
-      int g3 = g;
-      int b3 = b;
+      yDst[0] = std::min((r * YR + g * YG + b * YB + iBiasY) >> precision, 255);
+      yNextDst[0] = std::min((r1 * YR + g1 * YG + b1 * YB + iBiasY) >> precision, 255);
 
       if (x + 1 < width) {
-        mSrc += components;
-        mNextSrc += components;
+        LoadRGB<uint8_t, int, PixelType>(mSrc + components, r2, g2, b2);
+        LoadRGB<uint8_t, int, PixelType>(mNextSrc + components, r3, g3, b3);
 
-        LoadRGB<uint8_t, int, PixelType>(mSrc, r2, g2, b2);
-
-        int Y1 = ((r2 * YR + g2 * YG + b2 * YB + iBiasY) >> precision);
-
-        if (!(y & 1)) {
-          LoadRGB<uint8_t, int, PixelType>(mNextSrc, r3, g3, b3);
-        }
-
-        yDst[0] = Y1;
-        yDst += 1;
-
-        mSrc += components;
-      } else {
-        mSrc += components;
+        yDst[1] = std::min((r2 * YR + g2 * YG + b2 * YB + iBiasY) >> precision, 255);
+        yNextDst[1] = std::min((r3 * YR + g3 * YG + b3 * YB + iBiasY) >> precision, 255);
       }
 
-      if (!(y & 1)) {
-        r = (r + r1 + r2 + r3) >> 2;
-        g = (g + g1 + g2 + g3) >> 2;
-        b = (b + b1 + b2 + b3) >> 2;
-        int Cb = ((-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision);
-        int Cr = ((r * CrR - g * CrG - b * CrB + iBiasUV) >> precision);
-        uDst[0] = Cb;
-        vDst[0] = Cr;
-        uDst += 1;
-        vDst += 1;
-      }
+      r = (r + r1 + r2 + r3 + 2) >> 2;
+      g = (g + g1 + g2 + g3 + 2) >> 2;
+      b = (b + b1 + b2 + b3 + 2) >> 2;
+      const int Cb = (-r * CbR - g * CbG + b * CbB + iBiasUV) >> precision;
+      const int Cr = (r * CrR - g * CrG - b * CrB + iBiasUV) >> precision;
+      uDst[0] = std::clamp(Cb, 0, 255);
+      vDst[0] = std::clamp(Cr, 0, 255);
+
+      yDst += 2;
+      yNextDst += 2;
+      uDst += 1;
+      vDst += 1;
+
+      mSrc += components * 2;
+      mNextSrc += components * 2;
     }
 
-    yStore += yStride;
+    yStore += yStride * 2;
+    uStore += uStride;
+    vStore += vStride;
 
-    if (y & 1) {
-      uStore += uStride;
-      vStore += vStride;
-    }
-
-    mSource += srcStride;
+    mSource += srcStride * 2;
   }
 }
 
@@ -264,25 +254,25 @@ XXXXToYCbCr420HWY_DECLARATION_R(BGR)
 
 #undef XXXXToYCbCr420HWY_DECLARATION_R
 
-template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+/**
+ * Generic 4:2:0 8-bit decoding, on wide targets it is used only to check and benchmark the wide kernel against
+ */
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, typename Coefficients = YCbCr8InverseCoefficients>
 void
-YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
-                  const uint32_t width, const uint32_t height,
-                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
-                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
-                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
-                  const float kr, const float kb, const SparkYuvColorRange colorRange) {
+YCbCr420ToXXXXGeneric(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
+                      const uint32_t width, const uint32_t height,
+                      const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                      const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                      const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                      const Coefficients coefficients) {
   const ScalableTag<uint8_t> du8;
   const Half<decltype(du8)> du8h;
   const Rebind<int16_t, decltype(du8h)> di16;
   const RebindToUnsigned<decltype(di16)> du16;
   using VU16 = Vec<decltype(di16)>;
 
-  uint16_t biasY;
-  uint16_t biasUV;
-  uint16_t rangeY;
-  uint16_t rangeUV;
-  GetYUVRange(colorRange, 8, biasY, biasUV, rangeY, rangeUV);
+  const int biasY = coefficients.biasY;
+  const int biasUV = coefficients.biasUV;
 
   const VU16 uvCorrection = Set(di16, biasUV);
   const auto uvCorrIY = Set(du8, biasY);
@@ -293,21 +283,14 @@ YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
 
   const auto A = Set(du8, 255);
 
-  float fCrCoeff = 0.f;
-  float fCbCoeff = 0.f;
-  float fGCoeff1 = 0.f;
-  float fGCoeff2 = 0.f;
-  const float flumaCoeff = 255.f / static_cast<float>(rangeY);
-  ComputeInverseTransform(kr, kb, 255.f, static_cast<float>(rangeUV), fCrCoeff, fCbCoeff, fGCoeff1, fGCoeff2);
-
-  int precision = 6;
+  const int precision = 6;
 
-  const int CrCoeff = static_cast<int>(::roundf(fCrCoeff * static_cast<float>( 1 << precision )));
-  const int CbCoeff = static_cast<int>(::roundf(fCbCoeff * static_cast<float>( 1 << precision )));
-  const int GCoeff1 = static_cast<int>(::roundf(fGCoeff1 * static_cast<float>( 1 << precision )));
-  const int GCoeff2 = static_cast<int>(::roundf(fGCoeff2 * static_cast<float>( 1 << precision )));
+  const int CrCoeff = coefficients.CrCoeff;
+  const int CbCoeff = coefficients.CbCoeff;
+  const int GCoeff1 = coefficients.GCoeff1;
+  const int GCoeff2 = coefficients.GCoeff2;
 
-  const int iLumaCoeff = static_cast<int>(::roundf(flumaCoeff * static_cast<float>( 1 << precision )));
+  const int iLumaCoeff = coefficients.lumaCoeff;
 
   const auto ivLumaCoeff = Set(du8, iLumaCoeff);
   const auto ivLumaCoeffh = Set(du8h, iLumaCoeff);
@@ -332,14 +315,14 @@ YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
     uint32_t x = 0;
 
     for (; x + lanes < width; x += lanes) {
-      const auto luma8 = Sub(LoadU(du8, ySrc), uvCorrIY);
-      const VU16 ulFull = Sub(BitCast(di16, PromoteTo(du16, LoadU(du8h, uSource))), uvCorrection);
-      const VU16 vlFull = Sub(BitCast(di16, PromoteTo(du16, LoadU(du8h, vSource))), uvCorrection);
+      const auto luma8 = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
+      const auto ulf = DuplicateChroma(du8, LoadU(du8h, uSource));
+      const auto vlf = DuplicateChroma(du8, LoadU(du8h, vSource));
 
-      const auto cbl = InterleaveLower(ulFull, ulFull);
-      const auto cbh = InterleaveUpper(di16, ulFull, ulFull);
-      const auto crl = InterleaveLower(vlFull, vlFull);
-      const auto crh = InterleaveUpper(di16, vlFull, vlFull);
+      const VU16 cbl = Sub(BitCast(di16, PromoteLowerTo(du16, ulf)), uvCorrection);
+      const VU16 cbh = Sub(BitCast(di16, PromoteUpperTo(du16, ulf)), uvCorrection);
+      const VU16 crl = Sub(BitCast(di16, PromoteLowerTo(du16, vlf)), uvCorrection);
+      const VU16 crh = Sub(BitCast(di16, PromoteUpperTo(du16, vlf)), uvCorrection);
 
       const auto Yh = BitCast(di16, WidenMulHigh(du8, luma8, ivLumaCoeff));
       const auto rh = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedAdd(Mul(ivCrCoeff, crh), Yh), vZero)));
@@ -373,7 +356,7 @@ YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
       const uint8_t uValue = reinterpret_cast<const uint8_t *>(uSource)[0];
       const uint8_t vValue = reinterpret_cast<const uint8_t *>(vSource)[0];
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       const int Cr = (static_cast<int>(vValue) - biasUV);
       const int Cb = (static_cast<int>(uValue) - biasUV);
 
@@ -387,7 +370,7 @@ YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
       ySrc += 1;
 
       if (x + 1 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -410,6 +393,35 @@ YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
   }
 }
 
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, typename Coefficients = YCbCr8InverseCoefficients>
+void
+YCbCr420ToXXXXImpl(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
+                   const uint32_t width, const uint32_t height,
+                   const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                   const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                   const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                   const Coefficients coefficients) {
+#if SPARKYUV_WIDE_420
+  YCbCr420ToXXXXWide<PixelType, false>(dst, rgbaStride, width, height, yPlane, yStride, uPlane, uStride,
+                                       vPlane, vStride, coefficients);
+#else
+  YCbCr420ToXXXXGeneric<PixelType>(dst, rgbaStride, width, height, yPlane, yStride, uPlane, uStride,
+                                   vPlane, vStride, coefficients);
+#endif
+}
+
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+void
+YCbCr420ToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t rgbaStride,
+                  const uint32_t width, const uint32_t height,
+                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                  const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  YCbCr420ToXXXXImpl<PixelType>(dst, rgbaStride, width, height, yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                ComputeYCbCr8InverseCoefficients(kr, kb, colorRange));
+}
+
 #define YCbCr420ToXXXX_DECLARATION_R(pixelType) \
     void YCbCr420To##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                                   const uint32_t width, const uint32_t height,\
@@ -432,6 +444,331 @@ YCbCr420ToXXXX_DECLARATION_R(BGR)
 
 #undef YCbCr420ToXXXX_DECLARATION_R
 
+void YCbCr420ToRGBAGenericHWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                              const uint32_t width, const uint32_t height,
+                              const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                              const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                              const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                              const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  YCbCr420ToXXXXGeneric<sparkyuv::PIXEL_RGBA>(src, srcStride, width, height,
+                                              yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                              ComputeYCbCr8InverseCoefficients(kr, kb, colorRange));
+}
+
+#define YCbCr420ToXXXX_STANDARD_DECLARATION_R(pixelType, name, matrix) \
+    void YCbCr420##name##To##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                  const uint32_t width, const uint32_t height,\
+                                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride) {\
+         YCbCr420ToXXXXImpl<sparkyuv::PIXEL_##pixelType>(src, srcStride, width, height,\
+                                  yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                  YCbCr8InverseStandard<matrix, sparkyuv::YUV_RANGE_TV>());\
+    }
+
+#define YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(pixelType) \
+    YCbCr420ToXXXX_STANDARD_DECLARATION_R(pixelType, BT601, sparkyuv::YUV_MATRIX_BT601) \
+    YCbCr420ToXXXX_STANDARD_DECLARATION_R(pixelType, BT709, sparkyuv::YUV_MATRIX_BT709) \
+    YCbCr420ToXXXX_STANDARD_DECLARATION_R(pixelType, BT2020, sparkyuv::YUV_MATRIX_BT2020)
+
+YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(RGBA)
+YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(ARGB)
+YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(ABGR)
+YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(BGRA)
+YCbCr420ToXXXX_STANDARD_DECLARATIONS_R(BGR)
+#endif
+
+#undef YCbCr420ToXXXX_STANDARD_DECLARATIONS_R
+#undef YCbCr420ToXXXX_STANDARD_DECLARATION_R
+
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+void YCbCr420RegionToXXXXHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                             const uint32_t dstWidth, const uint32_t dstHeight,
+                             const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                             const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                             const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                             const uint32_t width, const uint32_t height,
+                             const uint32_t regionX, const uint32_t regionY,
+                             const uint32_t regionWidth, const uint32_t regionHeight,
+                             const float kr, const float kb, const SparkYuvColorRange colorRange,
+                             const SparkYuvSampler sampler) {
+  // Chroma sample is shared by two pixels so rows are converted from even column
+  const uint32_t alignedX = regionX & ~1u;
+  const uint32_t shift = regionX - alignedX;
+  const uint32_t rowLength = regionWidth + shift;
+  const int components = getPixelTypeComponents(PixelType);
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
+  auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
+
+  ConvertRegionStrip<PixelType>([&](const uint32_t row, uint8_t *buffer) -> const uint8_t * {
+    const uint32_t sourceY = regionY + row;
+    const auto chromaRow = static_cast<size_t>(sourceY >> 1);
+    YCbCr420ToXXXXHWY<PixelType>(buffer, rowLength * components, rowLength, 1,
+                                 mYSrc + static_cast<size_t>(sourceY) * yStride + alignedX, yStride,
+                                 mUSrc + chromaRow * uStride + (alignedX >> 1), uStride,
+                                 mVSrc + chromaRow * vStride + (alignedX >> 1), vStride,
+                                 kr, kb, colorRange);
+    return buffer + shift * components;
+  }, rowLength, regionWidth, regionHeight, dst, dstStride, dstWidth, dstHeight, sampler);
+}
+
+#define YCbCr420RegionToXXXX_DECLARATION_R(pixelType) \
+    void YCbCr420RegionTo##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                  const uint32_t dstWidth, const uint32_t dstHeight,\
+                                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                  const uint32_t width, const uint32_t height,\
+                                  const uint32_t regionX, const uint32_t regionY,\
+                                  const uint32_t regionWidth, const uint32_t regionHeight,\
+                                  const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                  const SparkYuvSampler sampler) {\
+         YCbCr420RegionToXXXXHWY<sparkyuv::PIXEL_##pixelType>(dst, dstStride, dstWidth, dstHeight,\
+                                                      yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                      width, height, regionX, regionY, regionWidth, regionHeight,\
+                                                      kr, kb, colorRange, sampler);\
+    }
+
+YCbCr420RegionToXXXX_DECLARATION_R(RGBA)
+YCbCr420RegionToXXXX_DECLARATION_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420RegionToXXXX_DECLARATION_R(ARGB)
+YCbCr420RegionToXXXX_DECLARATION_R(ABGR)
+YCbCr420RegionToXXXX_DECLARATION_R(BGRA)
+YCbCr420RegionToXXXX_DECLARATION_R(BGR)
+#endif
+
+#undef YCbCr420RegionToXXXX_DECLARATION_R
+
+
+/**
+ * Decodes into content rectangle of a fixed size destination and writes the border in the same pass,
+ * when content size differs from the source image it is resampled with `sampler`
+ */
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+void YCbCr420ToXXXXLetterboxHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                                const uint32_t dstWidth, const uint32_t dstHeight,
+                                const uint32_t contentX, const uint32_t contentY,
+                                const uint32_t contentWidth, const uint32_t contentHeight,
+                                const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                const uint32_t width, const uint32_t height, const SparkYuvColor border,
+                                const float kr, const float kb, const SparkYuvColorRange colorRange,
+                                const SparkYuvSampler sampler) {
+  ValidateLetterbox(dstWidth, dstHeight, contentX, contentY, contentWidth, contentHeight);
+
+  const int components = getPixelTypeComponents(PixelType);
+  uint8_t color[4];
+  LetterboxPixelColor<PixelType>(border, color);
+
+  auto mDst = reinterpret_cast<uint8_t *>(dst);
+  FillLetterboxRows8(mDst, dstStride, dstWidth, dstHeight, contentY, contentHeight, color, components);
+
+  uint8_t *contentDst = mDst + static_cast<size_t>(contentY) * dstStride + contentX * components;
+
+  if (contentWidth != width || contentHeight != height) {
+    FillLetterboxMargins8(mDst, dstStride, dstWidth, contentX, contentWidth,
+                          contentY, contentY + contentHeight, color, components);
+    YCbCr420RegionToXXXXHWY<PixelType>(contentDst, dstStride, contentWidth, contentHeight,
+                                       yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                       width, height, 0, 0, width, height, kr, kb, colorRange, sampler);
+    return;
+  }
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
+  auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
+
+  // Rows pairs share chroma row, margins are written right before the content of the same rows
+  for (uint32_t y = 0; y < height; y += 2) {
+    const uint32_t rows = std::min(height - y, 2u);
+    FillLetterboxMargins8(mDst, dstStride, dstWidth, contentX, contentWidth,
+                          contentY + y, contentY + y + rows, color, components);
+    YCbCr420ToXXXXHWY<PixelType>(contentDst + static_cast<size_t>(y) * dstStride, dstStride, width, rows,
+                                 mYSrc + static_cast<size_t>(y) * yStride, yStride,
+                                 mUSrc + static_cast<size_t>(y >> 1) * uStride, uStride,
+                                 mVSrc + static_cast<size_t>(y >> 1) * vStride, vStride,
+                                 kr, kb, colorRange);
+  }
+}
+
+#define YCbCr420ToXXXXLetterbox_DECLARATION_R(pixelType) \
+    void YCbCr420To##pixelType##LetterboxHWY(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                  const uint32_t dstWidth, const uint32_t dstHeight,\
+                                  const uint32_t contentX, const uint32_t contentY,\
+                                  const uint32_t contentWidth, const uint32_t contentHeight,\
+                                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                  const uint32_t width, const uint32_t height, const SparkYuvColor border,\
+                                  const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                  const SparkYuvSampler sampler) {\
+         YCbCr420ToXXXXLetterboxHWY<sparkyuv::PIXEL_##pixelType>(dst, dstStride, dstWidth, dstHeight,\
+                                                      contentX, contentY, contentWidth, contentHeight,\
+                                                      yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                      width, height, border, kr, kb, colorRange, sampler);\
+    }
+
+YCbCr420ToXXXXLetterbox_DECLARATION_R(RGBA)
+YCbCr420ToXXXXLetterbox_DECLARATION_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420ToXXXXLetterbox_DECLARATION_R(ARGB)
+YCbCr420ToXXXXLetterbox_DECLARATION_R(ABGR)
+YCbCr420ToXXXXLetterbox_DECLARATION_R(BGRA)
+YCbCr420ToXXXXLetterbox_DECLARATION_R(BGR)
+#endif
+
+#undef YCbCr420ToXXXXLetterbox_DECLARATION_R
+
+/**
+ * Encodes image into content rectangle of fixed size planes, border is given in YCbCr.
+ * Content has the image size, its origin must be even so chroma samples of the content and the border never mix
+ */
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+void Pixel8ToYCbCr420LetterboxHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                                  const uint32_t width, const uint32_t height,
+                                  uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                                  uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                                  uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                                  const uint32_t dstWidth, const uint32_t dstHeight,
+                                  const uint32_t contentX, const uint32_t contentY,
+                                  const uint32_t contentWidth, const uint32_t contentHeight,
+                                  const uint8_t borderY, const uint8_t borderCb, const uint8_t borderCr,
+                                  const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  ValidateLetterbox(dstWidth, dstHeight, contentX, contentY, contentWidth, contentHeight);
+  if (contentWidth != width || contentHeight != height) {
+    throw std::runtime_error("Letterbox encoder doesn't resample, content size must match the image size");
+  }
+  if ((contentX & 1) || (contentY & 1)) {
+    throw std::runtime_error("Letterbox content origin must be even for YCbCr420");
+  }
+
+  const uint32_t chromaWidth = (dstWidth + 1) / 2;
+  const uint32_t chromaHeight = (dstHeight + 1) / 2;
+  const uint32_t chromaX = contentX / 2;
+  const uint32_t chromaY = contentY / 2;
+  const uint32_t contentChromaWidth = (width + 1) / 2;
+  const uint32_t contentChromaHeight = (height + 1) / 2;
+
+  auto mYDst = reinterpret_cast<uint8_t *>(yPlane);
+  auto mUDst = reinterpret_cast<uint8_t *>(uPlane);
+  auto mVDst = reinterpret_cast<uint8_t *>(vPlane);
+
+  FillLetterboxRows8(mYDst, yStride, dstWidth, dstHeight, contentY, height, &borderY, 1);
+  FillLetterboxRows8(mUDst, uStride, chromaWidth, chromaHeight, chromaY, contentChromaHeight, &borderCb, 1);
+  FillLetterboxRows8(mVDst, vStride, chromaWidth, chromaHeight, chromaY, contentChromaHeight, &borderCr, 1);
+
+  auto mSrc = reinterpret_cast<const uint8_t *>(src);
+
+  for (uint32_t y = 0; y < height; y += 2) {
+    const uint32_t rows = std::min(height - y, 2u);
+    const uint32_t chromaRow = chromaY + (y >> 1);
+    FillLetterboxMargins8(mYDst, yStride, dstWidth, contentX, width,
+                          contentY + y, contentY + y + rows, &borderY, 1);
+    FillLetterboxMargins8(mUDst, uStride, chromaWidth, chromaX, contentChromaWidth,
+                          chromaRow, chromaRow + 1, &borderCb, 1);
+    FillLetterboxMargins8(mVDst, vStride, chromaWidth, chromaX, contentChromaWidth,
+                          chromaRow, chromaRow + 1, &borderCr, 1);
+    Pixel8ToYCbCr420HWY<PixelType>(mSrc + static_cast<size_t>(y) * srcStride, srcStride, width, rows,
+                                   mYDst + static_cast<size_t>(contentY + y) * yStride + contentX, yStride,
+                                   mUDst + static_cast<size_t>(chromaRow) * uStride + chromaX, uStride,
+                                   mVDst + static_cast<size_t>(chromaRow) * vStride + chromaX, vStride,
+                                   kr, kb, colorRange);
+  }
+}
+
+#define XXXXToYCbCr420Letterbox_DECLARATION_R(pixelType) \
+        void pixelType##ToYCbCr420LetterboxHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                    const uint32_t width, const uint32_t height,\
+                                    uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                    uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                    uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                    const uint32_t dstWidth, const uint32_t dstHeight,\
+                                    const uint32_t contentX, const uint32_t contentY,\
+                                    const uint32_t contentWidth, const uint32_t contentHeight,\
+                                    const uint8_t borderY, const uint8_t borderCb, const uint8_t borderCr,\
+                                    const float kr, const float kb, const SparkYuvColorRange colorRange) {\
+          Pixel8ToYCbCr420LetterboxHWY<sparkyuv::PIXEL_##pixelType>(src, srcStride, width, height,\
+                                                         yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                         dstWidth, dstHeight, contentX, contentY,\
+                                                         contentWidth, contentHeight,\
+                                                         borderY, borderCb, borderCr, kr, kb, colorRange);\
+        }
+
+XXXXToYCbCr420Letterbox_DECLARATION_R(RGBA)
+XXXXToYCbCr420Letterbox_DECLARATION_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+XXXXToYCbCr420Letterbox_DECLARATION_R(ARGB)
+XXXXToYCbCr420Letterbox_DECLARATION_R(ABGR)
+XXXXToYCbCr420Letterbox_DECLARATION_R(BGRA)
+XXXXToYCbCr420Letterbox_DECLARATION_R(BGR)
+#endif
+
+#undef XXXXToYCbCr420Letterbox_DECLARATION_R
+
+
+/**
+ * Decodes pairs of rows in [startRow, endRow) into small RGB buffer and normalizes them into the tensor,
+ * startRow must be even
+ */
+template<typename T>
+void YCbCr420ToTensorHWY(const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                         const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                         const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                         const uint32_t width, const uint32_t height,
+                         T *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,
+                         const SparkYuvTensorNormalization normalization,
+                         const float quantizationScale, const int32_t zeroPoint,
+                         const float kr, const float kb, const SparkYuvColorRange colorRange,
+                         const uint32_t startRow, const uint32_t endRow) {
+  const TensorTransform transform = ComputeTensorTransform(normalization, quantizationScale, zeroPoint);
+  const uint32_t rowStride = width * 3;
+  std::vector<uint8_t> rows(rowStride * 2);
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
+  auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
+
+  for (uint32_t y = startRow; y < endRow; y += 2) {
+    const uint32_t rowsCount = std::min(endRow - y, 2u);
+    YCbCr420ToXXXXHWY<sparkyuv::PIXEL_RGB>(rows.data(), rowStride, width, rowsCount,
+                                           mYSrc + static_cast<size_t>(y) * yStride, yStride,
+                                           mUSrc + static_cast<size_t>(y >> 1) * uStride, uStride,
+                                           mVSrc + static_cast<size_t>(y >> 1) * vStride, vStride,
+                                           kr, kb, colorRange);
+    for (uint32_t i = 0; i < rowsCount; ++i) {
+      PixelRowToTensor<sparkyuv::PIXEL_RGB, T>(rows.data() + i * rowStride, width, height, y + i,
+                                               tensor, layout, transform);
+    }
+  }
+}
+
+#define YCbCr420ToTensor_DECLARATION_R(suffix, storageType, tensorType) \
+    void YCbCr420ToTensor##suffix##HWY(const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                  const uint32_t width, const uint32_t height,\
+                                  storageType *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                                  const SparkYuvTensorNormalization normalization,\
+                                  const float quantizationScale, const int32_t zeroPoint,\
+                                  const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                  const uint32_t startRow, const uint32_t endRow) {\
+         YCbCr420ToTensorHWY<tensorType>(yPlane, yStride, uPlane, uStride, vPlane, vStride, width, height,\
+                                         reinterpret_cast<tensorType *>(tensor), layout, normalization,\
+                                         quantizationScale, zeroPoint, kr, kb, colorRange, startRow, endRow);\
+    }
+
+YCbCr420ToTensor_DECLARATION_R(F32, float, float)
+YCbCr420ToTensor_DECLARATION_R(F16, uint16_t, hwy::float16_t)
+YCbCr420ToTensor_DECLARATION_R(I8, int8_t, int8_t)
+
+#undef YCbCr420ToTensor_DECLARATION_R
+
 }
 HWY_AFTER_NAMESPACE();
 
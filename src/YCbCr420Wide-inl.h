@@ -0,0 +1,175 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_YCBCR420_WIDE_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_YCBCR420_WIDE_INL_H
+#undef SPARKYUV_YCBCR420_WIDE_INL_H
+#else
+#define SPARKYUV_YCBCR420_WIDE_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+#include <algorithm>
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+#if SPARKYUV_WIDE_420
+
+/**
+ * 4:2:0 8-bit decoding for AVX-512 and SVE, planar or NV12/NV21 chroma.
+ * Chroma is duplicated in u8 with a single whole-vector permute and promoted once per half.
+ * Last partial vector of a row goes through the same body using vector-sized stack rows,
+ * so there is no scalar tail, results match generic kernel bit-exact.
+ */
+template<SparkYuvDefaultPixelType PixelType, bool InterleavedChroma,
+    SparkYuvNVLoadOrder LoadOrder = sparkyuv::YUV_ORDER_UV, typename Coefficients>
+void YCbCr420ToXXXXWide(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                        const uint32_t width, const uint32_t height,
+                        const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                        const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                        const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                        const Coefficients coefficients) {
+  const ScalableTag<uint8_t> du8;
+  const Half<decltype(du8)> du8h;
+  const Rebind<int16_t, decltype(du8h)> di16;
+  const RebindToUnsigned<decltype(di16)> du16;
+  using VI16 = Vec<decltype(di16)>;
+  using VU8h = Vec<decltype(du8h)>;
+
+  const VI16 uvCorrection = Set(di16, coefficients.biasUV);
+  const auto uvCorrIY = Set(du8, coefficients.biasY);
+  const auto A = Set(du8, 255);
+
+  const auto ivLumaCoeff = Set(du8, coefficients.lumaCoeff);
+  const auto ivLumaCoeffh = Set(du8h, coefficients.lumaCoeff);
+  const VI16 ivCrCoeff = Set(di16, coefficients.CrCoeff);
+  const VI16 ivCbCoeff = Set(di16, coefficients.CbCoeff);
+  const VI16 ivGCoeff1 = Set(di16, coefficients.GCoeff1);
+  const VI16 ivGCoeff2 = Set(di16, coefficients.GCoeff2);
+  const VI16 vZero = Zero(di16);
+
+  const uint32_t lanes = Lanes(du8);
+  const uint32_t uvLanes = Lanes(du8h);
+  const int components = getPixelTypeComponents(PixelType);
+
+  HWY_ALIGN uint8_t yTail[HWY_MAX_BYTES] = {0};
+  HWY_ALIGN uint8_t uTail[HWY_MAX_BYTES] = {0};
+  HWY_ALIGN uint8_t vTail[HWY_MAX_BYTES / 2] = {0};
+  HWY_ALIGN uint8_t storeTail[HWY_MAX_BYTES * 4];
+
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
+  auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
+
+  for (uint32_t y = 0; y < height; ++y) {
+    auto uSource = mUSrc;
+    auto vSource = mVSrc;
+    auto ySrc = mYSrc;
+    auto store = dst;
+
+    for (uint32_t x = 0; x < width; x += lanes) {
+      const uint32_t pixels = std::min(width - x, lanes);
+      const uint8_t *yRow = ySrc;
+      const uint8_t *uRow = uSource;
+      const uint8_t *vRow = vSource;
+      uint8_t *out = store;
+
+      if (pixels != lanes) {
+        const uint32_t chroma = (pixels + 1) / 2;
+        CopyBytes(ySrc, yTail, pixels);
+        if (InterleavedChroma) {
+          CopyBytes(uSource, uTail, chroma * 2);
+        } else {
+          CopyBytes(uSource, uTail, chroma);
+          CopyBytes(vSource, vTail, chroma);
+        }
+        yRow = yTail;
+        uRow = uTail;
+        vRow = vTail;
+        out = storeTail;
+      }
+
+      VU8h uh, vh;
+      if (InterleavedChroma) {
+        if (LoadOrder == YUV_ORDER_UV) {
+          LoadInterleaved2(du8h, uRow, uh, vh);
+        } else {
+          LoadInterleaved2(du8h, uRow, vh, uh);
+        }
+      } else {
+        uh = LoadU(du8h, uRow);
+        vh = LoadU(du8h, vRow);
+      }
+
+      const auto luma8 = SaturatedSub(LoadU(du8, yRow), uvCorrIY);
+      const auto ulf = DuplicateChroma(du8, uh);
+      const auto vlf = DuplicateChroma(du8, vh);
+
+      const auto cbh = Sub(BitCast(di16, PromoteUpperTo(du16, ulf)), uvCorrection);
+      const auto crh = Sub(BitCast(di16, PromoteUpperTo(du16, vlf)), uvCorrection);
+      const auto cbl = Sub(BitCast(di16, PromoteLowerTo(du16, ulf)), uvCorrection);
+      const auto crl = Sub(BitCast(di16, PromoteLowerTo(du16, vlf)), uvCorrection);
+
+      const auto Yh = BitCast(di16, WidenMulHigh(du8, luma8, ivLumaCoeff));
+      const auto rh = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedAdd(Mul(ivCrCoeff, crh), Yh), vZero)));
+      const auto bh = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedAdd(Mul(ivCbCoeff, cbh), Yh), vZero)));
+      const auto gh = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedSub(Yh,
+                                                                               SaturatedAdd(Mul(ivGCoeff1, crh),
+                                                                                            Mul(ivGCoeff2, cbh))),
+                                                                  vZero)));
+
+      const auto Yl = BitCast(di16, WidenMul(du8h, LowerHalf(luma8), ivLumaCoeffh));
+      const auto rl = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedAdd(Mul(ivCrCoeff, crl), Yl), vZero)));
+      const auto bl = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedAdd(Mul(ivCbCoeff, cbl), Yl), vZero)));
+      const auto gl = ShiftRightNarrow<6>(du16, BitCast(du16, Max(SaturatedSub(Yl,
+                                                                               SaturatedAdd(Mul(ivGCoeff1, crl),
+                                                                                            Mul(ivGCoeff2, cbl))),
+                                                                  vZero)));
+
+      StoreRGBA<PixelType>(du8, out, Combine(du8, rh, rl), Combine(du8, gh, gl), Combine(du8, bh, bl), A);
+
+      if (pixels != lanes) {
+        CopyBytes(storeTail, store, pixels * components);
+      }
+
+      store += lanes * components;
+      ySrc += lanes;
+      if (InterleavedChroma) {
+        uSource += uvLanes * 2;
+      } else {
+        uSource += uvLanes;
+        vSource += uvLanes;
+      }
+    }
+
+    if (y & 1) {
+      mUSrc += uStride;
+      mVSrc += vStride;
+    }
+    mYSrc += yStride;
+    dst += dstStride;
+  }
+}
+
+#endif
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
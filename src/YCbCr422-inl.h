@@ -96,6 +96,14 @@ void Pixel8ToYCbCr422(const uint8_t *SPARKYUV_RESTRICT src,
 
   const int components = getPixelTypeComponents(PixelType);
 
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+#endif
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -105,6 +113,34 @@ void Pixel8ToYCbCr422(const uint8_t *SPARKYUV_RESTRICT src,
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
 
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        // Lower and upper halves of the row are dotted separately, each gives one i16 vector
+        const uint8_t *mSrcHigh = mSrc + uvLanes * components;
+        const auto Yl = BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY));
+        const auto Yh = BitCast(du16, DotPixels8(di16, mSrcHigh, vDotY, vDotYRest, vBiasY));
+        const auto Clbf = BitCast(du16, DotPixels8(di16, mSrc, vDotCb, vDotCbRest, vBiasUV));
+        const auto Chbf = BitCast(du16, DotPixels8(di16, mSrcHigh, vDotCb, vDotCbRest, vBiasUV));
+        const auto Clrf = BitCast(du16, DotPixels8(di16, mSrc, vDotCr, vDotCrRest, vBiasUV));
+        const auto Chrf = BitCast(du16, DotPixels8(di16, mSrcHigh, vDotCr, vDotCrRest, vBiasUV));
+
+        const auto Cb = ShiftRightNarrow<1>(du16, SumsOf2(Combine(du8, DemoteTo(du8h, Chbf), DemoteTo(du8h, Clbf))));
+        const auto Cr = ShiftRightNarrow<1>(du16, SumsOf2(Combine(du8, DemoteTo(du8h, Chrf), DemoteTo(du8h, Clrf))));
+
+        StoreU(Combine(du8, DemoteTo(du8h, Yh), DemoteTo(du8h, Yl)), du8, yDst);
+        StoreU(Cb, du8h, uDst);
+        StoreU(Cr, du8h, vDst);
+
+        yDst += lanes;
+        uDst += uvLanes;
+        vDst += uvLanes;
+
+        mSrc += components * lanes;
+      }
+    }
+#endif
+
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
       VU8 G8;
@@ -255,31 +291,26 @@ XXXXToYCbCr422HWY_DECLARATION_R(BGR)
 
 #undef YCbCr444ToXXXX_DECLARATION_R
 
-template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
-void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
-                      const uint32_t dstStride,
-                      const uint32_t width,
-                      const uint32_t height,
-                      const uint8_t *SPARKYUV_RESTRICT yPlane,
-                      const uint32_t yStride,
-                      const uint8_t *SPARKYUV_RESTRICT uPlane,
-                      const uint32_t uStride,
-                      const uint8_t *SPARKYUV_RESTRICT vPlane,
-                      const uint32_t vStride,
-                      const float kr,
-                      const float kb,
-                      const SparkYuvColorRange colorRange) {
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, typename Coefficients = YCbCr8InverseCoefficients>
+void YCbCr422ToPixel8Impl(uint8_t *SPARKYUV_RESTRICT dst,
+                          const uint32_t dstStride,
+                          const uint32_t width,
+                          const uint32_t height,
+                          const uint8_t *SPARKYUV_RESTRICT yPlane,
+                          const uint32_t yStride,
+                          const uint8_t *SPARKYUV_RESTRICT uPlane,
+                          const uint32_t uStride,
+                          const uint8_t *SPARKYUV_RESTRICT vPlane,
+                          const uint32_t vStride,
+                          const Coefficients coefficients) {
   const ScalableTag<uint8_t> du8;
   const Half<decltype(du8)> du8h;
   const Rebind<int16_t, decltype(du8h)> di16;
   const RebindToUnsigned<decltype(di16)> du16;
   using VU16 = Vec<decltype(di16)>;
 
-  uint16_t biasY;
-  uint16_t biasUV;
-  uint16_t rangeY;
-  uint16_t rangeUV;
-  GetYUVRange(colorRange, 8, biasY, biasUV, rangeY, rangeUV);
+  const int biasY = coefficients.biasY;
+  const int biasUV = coefficients.biasUV;
 
   const VU16 uvCorrection = Set(di16, biasUV);
   const auto uvCorrIY = Set(du8, biasY);
@@ -290,21 +321,14 @@ void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
 
   const auto A = Set(du8, 255);
 
-  float fCrCoeff = 0.f;
-  float fCbCoeff = 0.f;
-  float fGCoeff1 = 0.f;
-  float fGCoeff2 = 0.f;
-  const float flumaCoeff = 255.f / static_cast<float>(rangeY);
-  ComputeInverseTransform(kr, kb, 255.f, static_cast<float>(rangeUV), fCrCoeff, fCbCoeff, fGCoeff1, fGCoeff2);
-
   const int precision = 6;
 
-  const int CrCoeff = static_cast<int>(::roundf(fCrCoeff * static_cast<float>( 1 << precision )));
-  const int CbCoeff = static_cast<int>(::roundf(fCbCoeff * static_cast<float>( 1 << precision )));
-  const int GCoeff1 = static_cast<int>(::roundf(fGCoeff1 * static_cast<float>( 1 << precision )));
-  const int GCoeff2 = static_cast<int>(::roundf(fGCoeff2 * static_cast<float>( 1 << precision )));
+  const int CrCoeff = coefficients.CrCoeff;
+  const int CbCoeff = coefficients.CbCoeff;
+  const int GCoeff1 = coefficients.GCoeff1;
+  const int GCoeff2 = coefficients.GCoeff2;
 
-  const int iLumaCoeff = static_cast<int>(::roundf(flumaCoeff * static_cast<float>( 1 << precision )));
+  const int iLumaCoeff = coefficients.lumaCoeff;
 
   const auto ivLumaCoeff = Set(du8, iLumaCoeff);
   const auto ivLumaCoeffh = Set(du8h, iLumaCoeff);
@@ -329,7 +353,7 @@ void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
     uint32_t x = 0;
 
     for (; x + lanes < width; x += lanes) {
-      const auto luma8 = Sub(LoadU(du8, ySrc), uvCorrIY);
+      const auto luma8 = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
       const VU16 ulFull = Sub(BitCast(di16, PromoteTo(du16, LoadU(du8h, uSource))), uvCorrection);
       const VU16 vlFull = Sub(BitCast(di16, PromoteTo(du16, LoadU(du8h, vSource))), uvCorrection);
 
@@ -370,7 +394,7 @@ void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
       const uint8_t uValue = reinterpret_cast<const uint8_t *>(uSource)[0];
       const uint8_t vValue = reinterpret_cast<const uint8_t *>(vSource)[0];
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       const int Cr = (static_cast<int>(vValue) - biasUV);
       const int Cb = (static_cast<int>(uValue) - biasUV);
 
@@ -384,7 +408,7 @@ void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
       ySrc += 1;
 
       if (x + 1 < width) {
-        Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+        Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
         R = (Y + CrCoeff * Cr) >> precision;
         B = (Y + CbCoeff * Cb) >> precision;
         G = (Y - GCoeff1 * Cr - GCoeff2 * Cb) >> precision;
@@ -405,6 +429,24 @@ void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
   }
 }
 
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+void YCbCr422ToPixel8(uint8_t *SPARKYUV_RESTRICT dst,
+                      const uint32_t dstStride,
+                      const uint32_t width,
+                      const uint32_t height,
+                      const uint8_t *SPARKYUV_RESTRICT yPlane,
+                      const uint32_t yStride,
+                      const uint8_t *SPARKYUV_RESTRICT uPlane,
+                      const uint32_t uStride,
+                      const uint8_t *SPARKYUV_RESTRICT vPlane,
+                      const uint32_t vStride,
+                      const float kr,
+                      const float kb,
+                      const SparkYuvColorRange colorRange) {
+  YCbCr422ToPixel8Impl<PixelType>(dst, dstStride, width, height, yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                  ComputeYCbCr8InverseCoefficients(kr, kb, colorRange));
+}
+
 #define YCbCr422ToXXXXHWY_DECLARATION_R(pixelType) \
         void YCbCr422To##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT dst,const uint32_t dstStride,\
                                       const uint32_t width,const uint32_t height,\
@@ -428,6 +470,34 @@ YCbCr422ToXXXXHWY_DECLARATION_R(BGR)
 
 #undef YCbCr422ToXXXXHWY_DECLARATION_R
 
+#define YCbCr422ToXXXX_STANDARD_DECLARATION_R(pixelType, name, matrix) \
+    void YCbCr422##name##To##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                  const uint32_t width, const uint32_t height,\
+                                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride) {\
+         YCbCr422ToPixel8Impl<sparkyuv::PIXEL_##pixelType>(src, srcStride, width, height,\
+                                  yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                  YCbCr8InverseStandard<matrix, sparkyuv::YUV_RANGE_TV>());\
+    }
+
+#define YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(pixelType) \
+    YCbCr422ToXXXX_STANDARD_DECLARATION_R(pixelType, BT601, sparkyuv::YUV_MATRIX_BT601) \
+    YCbCr422ToXXXX_STANDARD_DECLARATION_R(pixelType, BT709, sparkyuv::YUV_MATRIX_BT709) \
+    YCbCr422ToXXXX_STANDARD_DECLARATION_R(pixelType, BT2020, sparkyuv::YUV_MATRIX_BT2020)
+
+YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(RGBA)
+YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(ARGB)
+YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(ABGR)
+YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(BGRA)
+YCbCr422ToXXXX_STANDARD_DECLARATIONS_R(BGR)
+#endif
+
+#undef YCbCr422ToXXXX_STANDARD_DECLARATIONS_R
+#undef YCbCr422ToXXXX_STANDARD_DECLARATION_R
+
 }
 HWY_AFTER_NAMESPACE();
 
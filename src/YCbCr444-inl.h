@@ -99,6 +99,14 @@ void Pixel8ToYCbCr444HWY(const uint8_t *SPARKYUV_RESTRICT src,
 
   const int components = getPixelTypeComponents(PixelType);
 
+#if SPARKYUV_DOT_ENCODE
+  const Repartition<int8_t, decltype(di16)> di8;
+  Vec<decltype(di8)> vDotY, vDotYRest, vDotCb, vDotCbRest, vDotCr, vDotCrRest;
+  SetDotCoefficients<PixelType>(di8, YR, YG, YB, vDotY, vDotYRest);
+  SetDotCoefficients<PixelType>(di8, -CbR, -CbG, CbB, vDotCb, vDotCbRest);
+  SetDotCoefficients<PixelType>(di8, CrR, -CrG, -CrB, vDotCr, vDotCrRest);
+#endif
+
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
 
@@ -108,6 +116,26 @@ void Pixel8ToYCbCr444HWY(const uint8_t *SPARKYUV_RESTRICT src,
 
     auto mSrc = reinterpret_cast<const uint8_t *>(mSource);
 
+#if SPARKYUV_DOT_ENCODE
+    if constexpr (IsDotEncodable<PixelType>()) {
+      for (; x + lanes < width; x += lanes) {
+        const auto Y = BitCast(du16, DotPixels8(di16, mSrc, vDotY, vDotYRest, vBiasY));
+        const auto Cb = BitCast(du16, DotPixels8(di16, mSrc, vDotCb, vDotCbRest, vBiasUV));
+        const auto Cr = BitCast(du16, DotPixels8(di16, mSrc, vDotCr, vDotCrRest, vBiasUV));
+
+        StoreU(DemoteTo(du8, Y), du8, yDst);
+        StoreU(DemoteTo(du8, Cb), du8, uDst);
+        StoreU(DemoteTo(du8, Cr), du8, vDst);
+
+        yDst += lanes;
+        uDst += lanes;
+        vDst += lanes;
+
+        mSrc += components * lanes;
+      }
+    }
+#endif
+
     for (; x + lanes < width; x += lanes) {
       VU8 R8;
       VU8 G8;
@@ -205,13 +233,13 @@ XXXXToYCbCr444HWY_DECLARATION_R(BGR)
 
 #undef XXXXToYCbCr444HWY_DECLARATION_R
 
-template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
-void YCbCr444ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
-                    const uint32_t width, const uint32_t height,
-                    const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
-                    const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
-                    const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
-                    const float kr, const float kb, const SparkYuvColorRange colorRange) {
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA, typename Coefficients = YCbCr8InverseCoefficients>
+void YCbCr444ToXRGBImpl(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                        const uint32_t width, const uint32_t height,
+                        const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                        const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                        const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                        const Coefficients coefficients) {
   const ScalableTag<uint8_t> du8;
   const Half<decltype(du8)> du8h;
   const Rebind<int16_t, decltype(du8h)> di16;
@@ -222,32 +250,22 @@ void YCbCr444ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
   auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
   auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
 
-  uint16_t biasY;
-  uint16_t biasUV;
-  uint16_t rangeY;
-  uint16_t rangeUV;
-  GetYUVRange(colorRange, 8, biasY, biasUV, rangeY, rangeUV);
+  const int biasY = coefficients.biasY;
+  const int biasUV = coefficients.biasUV;
 
   const auto uvCorrection = Set(di16, biasUV);
 
   const auto uvCorrIY = Set(du8, biasY);
   const auto A = Set(du8, 255);
 
-  float fCrCoeff = 0.f;
-  float fCbCoeff = 0.f;
-  float fGCoeff1 = 0.f;
-  float fGCoeff2 = 0.f;
-  const float flumaCoeff = 255.f / static_cast<float>(rangeY);
-  ComputeInverseTransform(kr, kb, 255.f, static_cast<float>(rangeUV), fCrCoeff, fCbCoeff, fGCoeff1, fGCoeff2);
-
   const int precision = 6;
 
-  const int CrCoeff = static_cast<int>(::roundf(fCrCoeff * static_cast<float>( 1 << precision )));
-  const int CbCoeff = static_cast<int>(::roundf(fCbCoeff * static_cast<float>( 1 << precision )));
-  const int GCoeff1 = static_cast<int>(::roundf(fGCoeff1 * static_cast<float>( 1 << precision )));
-  const int GCoeff2 = static_cast<int>(::roundf(fGCoeff2 * static_cast<float>( 1 << precision )));
+  const int CrCoeff = coefficients.CrCoeff;
+  const int CbCoeff = coefficients.CbCoeff;
+  const int GCoeff1 = coefficients.GCoeff1;
+  const int GCoeff2 = coefficients.GCoeff2;
 
-  const int iLumaCoeff = static_cast<int>(::roundf(flumaCoeff * static_cast<float>( 1 << precision )));
+  const int iLumaCoeff = coefficients.lumaCoeff;
 
   const auto ivLumaCoeff = Set(du8, iLumaCoeff);
   const auto ivLumaCoeffh = Set(du8h, iLumaCoeff);
@@ -271,7 +289,7 @@ void YCbCr444ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
     uint32_t x = 0;
 
     for (; x + lanes < width; x += lanes) {
-      const auto Y = Sub(LoadU(du8, ySrc), uvCorrIY);
+      const auto Y = SaturatedSub(LoadU(du8, ySrc), uvCorrIY);
       const auto U = LoadU(du8, uSource);
       const auto V = LoadU(du8, vSource);
 
@@ -312,7 +330,7 @@ void YCbCr444ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
       const uint8_t uValue = reinterpret_cast<const uint8_t *>(uSource)[0];
       const uint8_t vValue = reinterpret_cast<const uint8_t *>(vSource)[0];
 
-      int Y = (static_cast<int>(ySrc[0]) - biasY) * iLumaCoeff;
+      int Y = std::max(static_cast<int>(ySrc[0]) - biasY, 0) * iLumaCoeff;
       const int Cr = (static_cast<int>(vValue) - biasUV);
       const int Cb = (static_cast<int>(uValue) - biasUV);
 
@@ -334,6 +352,17 @@ void YCbCr444ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
   }
 }
 
+template<SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA>
+void YCbCr444ToXRGB(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,
+                    const uint32_t width, const uint32_t height,
+                    const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                    const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                    const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                    const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  YCbCr444ToXRGBImpl<PixelType>(dst, dstStride, width, height, yPlane, yStride, uPlane, uStride, vPlane, vStride,
+                                ComputeYCbCr8InverseCoefficients(kr, kb, colorRange));
+}
+
 #define YCbCr444ToXXXX_DECLARATION_R(pixelType) \
     void YCbCr444To##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
                          const uint32_t width, const uint32_t height,\
@@ -356,6 +385,34 @@ YCbCr444ToXXXX_DECLARATION_R(BGR)
 
 #undef YCbCr444ToXXXX_DECLARATION_R
 
+#define YCbCr444ToXXXX_STANDARD_DECLARATION_R(pixelType, name, matrix) \
+    void YCbCr444##name##To##pixelType##HWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                  const uint32_t width, const uint32_t height,\
+                                  const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                  const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride) {\
+         YCbCr444ToXRGBImpl<sparkyuv::PIXEL_##pixelType>(src, srcStride, width, height,\
+                                  yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                  YCbCr8InverseStandard<matrix, sparkyuv::YUV_RANGE_TV>());\
+    }
+
+#define YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(pixelType) \
+    YCbCr444ToXXXX_STANDARD_DECLARATION_R(pixelType, BT601, sparkyuv::YUV_MATRIX_BT601) \
+    YCbCr444ToXXXX_STANDARD_DECLARATION_R(pixelType, BT709, sparkyuv::YUV_MATRIX_BT709) \
+    YCbCr444ToXXXX_STANDARD_DECLARATION_R(pixelType, BT2020, sparkyuv::YUV_MATRIX_BT2020)
+
+YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(RGBA)
+YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(ARGB)
+YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(ABGR)
+YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(BGRA)
+YCbCr444ToXXXX_STANDARD_DECLARATIONS_R(BGR)
+#endif
+
+#undef YCbCr444ToXXXX_STANDARD_DECLARATIONS_R
+#undef YCbCr444ToXXXX_STANDARD_DECLARATION_R
+
 }
 HWY_AFTER_NAMESPACE();
 
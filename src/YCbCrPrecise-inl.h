@@ -0,0 +1,581 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(SPARKYUV_YCBCR_PRECISE_INL_H) == defined(HWY_TARGET_TOGGLE)
+#ifdef SPARKYUV_YCBCR_PRECISE_INL_H
+#undef SPARKYUV_YCBCR_PRECISE_INL_H
+#else
+#define SPARKYUV_YCBCR_PRECISE_INL_H
+#endif
+
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "sparkyuv-internal.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace sparkyuv::HWY_NAMESPACE {
+
+/**
+ * Inverse coefficient split into integer part and Q15 fraction,
+ * so coefficients above one are applied with MulFixedPoint15 without leaving 16-bit lanes
+ */
+struct YCbCrSplitCoefficient {
+  int16_t whole;
+  int16_t fraction;
+};
+
+static inline YCbCrSplitCoefficient SplitYCbCrCoefficient(const float coefficient) {
+  int whole = static_cast<int>(::floorf(coefficient));
+  int fraction = static_cast<int>(::roundf((coefficient - static_cast<float>(whole)) * 32768.f));
+  if (fraction == 32768) {
+    whole += 1;
+    fraction = 0;
+  }
+  return {static_cast<int16_t>(whole), static_cast<int16_t>(fraction)};
+}
+
+static inline int MulSplitCoefficient(const int v, const YCbCrSplitCoefficient c) {
+  return v * c.whole + ((v * c.fraction + (1 << 14)) >> 15);
+}
+
+template<class V>
+HWY_INLINE V MulSplitCoefficient(const V v, const V whole, const V fraction) {
+  return Add(Mul(v, whole), MulFixedPoint15(v, fraction));
+}
+
+template<typename T, SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA,
+    SparkYuvChromaSubsample chromaSubsample, int bitDepth>
+void YCbCrToXRGBPrecise(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
+                        const uint32_t width, const uint32_t height,
+                        const T *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                        const T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                        const T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                        const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  static_assert(bitDepth >= 8 && bitDepth <= 12, "Invalid bit depth");
+  static_assert(chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420
+                    || chromaSubsample == YUV_SAMPLE_444, "Unexpected chroma sample type");
+  auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
+  auto mUSrc = reinterpret_cast<const uint8_t *>(uPlane);
+  auto mVSrc = reinterpret_cast<const uint8_t *>(vPlane);
+  auto dst = reinterpret_cast<uint8_t *>(rgbaData);
+
+  uint16_t biasY;
+  uint16_t biasUV;
+  uint16_t rangeY;
+  uint16_t rangeUV;
+  GetYUVRange(colorRange, bitDepth, biasY, biasUV, rangeY, rangeUV);
+
+  const int maxColors = (1 << bitDepth) - 1;
+
+  float fCrCoeff = 0.f;
+  float fCbCoeff = 0.f;
+  float fGCoeff1 = 0.f;
+  float fGCoeff2 = 0.f;
+  const float flumaCoeff = static_cast<float>(maxColors) / static_cast<float>(rangeY);
+  ComputeInverseTransform(kr, kb, static_cast<float>(maxColors), static_cast<float>(rangeUV),
+                          fCrCoeff, fCbCoeff, fGCoeff1, fGCoeff2);
+
+  // Samples are moved to the top of int16_t, R and B may saturate only when they are far above maxColors
+  constexpr int precision = 14 - bitDepth;
+  const int rounding = 1 << (precision - 1);
+
+  const YCbCrSplitCoefficient lumaCoeff = SplitYCbCrCoefficient(flumaCoeff);
+  const YCbCrSplitCoefficient CrCoeff = SplitYCbCrCoefficient(fCrCoeff);
+  const YCbCrSplitCoefficient CbCoeff = SplitYCbCrCoefficient(fCbCoeff);
+  const YCbCrSplitCoefficient GCoeff1 = SplitYCbCrCoefficient(fGCoeff1);
+  const YCbCrSplitCoefficient GCoeff2 = SplitYCbCrCoefficient(fGCoeff2);
+
+  const int lanesForward = getYuvChromaPixels(chromaSubsample);
+
+  const int components = getPixelTypeComponents(PixelType);
+
+  const ScalableTag<uint16_t> du16;
+  const RebindToSigned<decltype(du16)> di16;
+  using VU16 = Vec<decltype(du16)>;
+  const Rebind<T, decltype(du16)> d;
+  const Half<decltype(d)> dh;
+  const Half<decltype(du16)> dhu16;
+  const auto vBiasY = Set(di16, static_cast<int16_t>(biasY));
+  const auto vBiasUV = Set(di16, static_cast<int16_t>(biasUV));
+  const auto vMaxColors = Set(di16, static_cast<int16_t>(maxColors));
+  const auto viZeros = Zero(di16);
+  const auto vRounding = Set(di16, static_cast<int16_t>(rounding));
+  const auto A16 = Set(du16, maxColors);
+  const auto vLumaWhole = Set(di16, lumaCoeff.whole);
+  const auto vLumaFraction = Set(di16, lumaCoeff.fraction);
+  const auto vCrWhole = Set(di16, CrCoeff.whole);
+  const auto vCrFraction = Set(di16, CrCoeff.fraction);
+  const auto vCbWhole = Set(di16, CbCoeff.whole);
+  const auto vCbFraction = Set(di16, CbCoeff.fraction);
+  const auto vG1Whole = Set(di16, GCoeff1.whole);
+  const auto vG1Fraction = Set(di16, GCoeff1.fraction);
+  const auto vG2Whole = Set(di16, GCoeff2.whole);
+  const auto vG2Fraction = Set(di16, GCoeff2.fraction);
+
+  const int lanes = Lanes(d);
+  const int uvLanes = (chromaSubsample == YUV_SAMPLE_444) ? lanes : Lanes(dh);
+
+  for (uint32_t y = 0; y < height; ++y) {
+    auto CbSource = reinterpret_cast<const T *>(mUSrc);
+    auto CrSource = reinterpret_cast<const T *>(mVSrc);
+    auto ySrc = reinterpret_cast<const T *>(mYSrc);
+    auto store = reinterpret_cast<T *>(dst);
+
+    uint32_t x = 0;
+
+    for (; x + lanes < width; x += lanes) {
+      VU16 Y, Cb, Cr;
+
+      if (std::is_same<T, uint16_t>::value) {
+        Y = LoadU(du16, reinterpret_cast<const uint16_t *>(ySrc));
+        if (chromaSubsample == YUV_SAMPLE_444) {
+          Cb = LoadU(du16, reinterpret_cast<const uint16_t *>(CbSource));
+          Cr = LoadU(du16, reinterpret_cast<const uint16_t *>(CrSource));
+        } else {
+          Cb = DuplicateChroma(du16, LoadU(dhu16, reinterpret_cast<const uint16_t *>(CbSource)));
+          Cr = DuplicateChroma(du16, LoadU(dhu16, reinterpret_cast<const uint16_t *>(CrSource)));
+        }
+      } else if (std::is_same<T, uint8_t>::value) {
+        const Rebind<uint8_t, decltype(du16)> du8;
+        Y = PromoteTo(du16, LoadU(du8, reinterpret_cast<const uint8_t *>(ySrc)));
+        if (chromaSubsample == YUV_SAMPLE_444) {
+          Cb = PromoteTo(du16, LoadU(du8, reinterpret_cast<const uint8_t *>(CbSource)));
+          Cr = PromoteTo(du16, LoadU(du8, reinterpret_cast<const uint8_t *>(CrSource)));
+        } else {
+          const Rebind<uint8_t, decltype(dhu16)> dhu8;
+          Cb = DuplicateChroma(du16, PromoteTo(dhu16, LoadU(dhu8, reinterpret_cast<const uint8_t *>(CbSource))));
+          Cr = DuplicateChroma(du16, PromoteTo(dhu16, LoadU(dhu8, reinterpret_cast<const uint8_t *>(CrSource))));
+        }
+      } else {
+        static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value, "Unexpected storage type");
+      }
+
+      const auto sY = ShiftLeft<precision>(Sub(BitCast(di16, Y), vBiasY));
+      const auto sCb = ShiftLeft<precision>(Sub(BitCast(di16, Cb), vBiasUV));
+      const auto sCr = ShiftLeft<precision>(Sub(BitCast(di16, Cr), vBiasUV));
+
+      const auto lY = Add(MulSplitCoefficient(sY, vLumaWhole, vLumaFraction), vRounding);
+      const auto r = SaturatedAdd(lY, MulSplitCoefficient(sCr, vCrWhole, vCrFraction));
+      const auto b = SaturatedAdd(lY, MulSplitCoefficient(sCb, vCbWhole, vCbFraction));
+      const auto g = Sub(lY, Add(MulSplitCoefficient(sCr, vG1Whole, vG1Fraction),
+                                 MulSplitCoefficient(sCb, vG2Whole, vG2Fraction)));
+
+      const VU16 R16 = BitCast(du16, Clamp(ShiftRight<precision>(r), viZeros, vMaxColors));
+      const VU16 G16 = BitCast(du16, Clamp(ShiftRight<precision>(g), viZeros, vMaxColors));
+      const VU16 B16 = BitCast(du16, Clamp(ShiftRight<precision>(b), viZeros, vMaxColors));
+
+      if (std::is_same<T, uint16_t>::value) {
+        StoreRGBA<PixelType>(du16, reinterpret_cast<uint16_t *>(store), R16, G16, B16, A16);
+      } else if (std::is_same<T, uint8_t>::value) {
+        StoreRGBA<PixelType>(du16, reinterpret_cast<uint8_t *>(store), R16, G16, B16, A16);
+      } else {
+        static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value, "Unexpected storage type");
+      }
+
+      CbSource += uvLanes;
+      CrSource += uvLanes;
+      ySrc += lanes;
+      store += lanes * components;
+    }
+
+    for (; x < width; x += lanesForward) {
+      const int Cb = (static_cast<int>(CbSource[0]) - biasUV) * (1 << precision);
+      const int Cr = (static_cast<int>(CrSource[0]) - biasUV) * (1 << precision);
+
+      const int rCr = MulSplitCoefficient(Cr, CrCoeff);
+      const int bCb = MulSplitCoefficient(Cb, CbCoeff);
+      const int gCrCb = MulSplitCoefficient(Cr, GCoeff1) + MulSplitCoefficient(Cb, GCoeff2);
+
+      const int pixels = (chromaSubsample == YUV_SAMPLE_444) ? 1 : std::min(2, static_cast<int>(width - x));
+
+      for (int i = 0; i < pixels; ++i) {
+        const int Y = MulSplitCoefficient((static_cast<int>(ySrc[0]) - biasY) * (1 << precision), lumaCoeff)
+            + rounding;
+
+        const int R = std::clamp((Y + rCr) >> precision, 0, maxColors);
+        const int G = std::clamp((Y - gCrCb) >> precision, 0, maxColors);
+        const int B = std::clamp((Y + bCb) >> precision, 0, maxColors);
+
+        StoreRGBA<T, int, PixelType>(store, R, G, B, maxColors);
+
+        store += components;
+        ySrc += 1;
+      }
+
+      CbSource += 1;
+      CrSource += 1;
+    }
+
+    if (chromaSubsample == YUV_SAMPLE_444 || chromaSubsample == YUV_SAMPLE_422) {
+      mUSrc += uStride;
+      mVSrc += vStride;
+    } else if (chromaSubsample == YUV_SAMPLE_420) {
+      if (y & 1) {
+        mUSrc += uStride;
+        mVSrc += vStride;
+      }
+    }
+    mYSrc += yStride;
+    dst += dstStride;
+  }
+}
+
+/**
+ * Forward coefficients as Q15 fractions, every forward coefficient is below one
+ */
+struct YCbCrForwardQ15 {
+  int16_t YR, YG, YB;
+  int16_t CbR, CbG, CbB;
+  int16_t CrR, CrG, CrB;
+};
+
+static inline int16_t ToQ15(const float coefficient) {
+  return static_cast<int16_t>(std::min(::roundf(coefficient * 32768.f), 32767.f));
+}
+
+/**
+ * Scalar counterpart of MulFixedPoint15, rounds the same way so tails match the vector body
+ */
+static inline int MulQ15(const int v, const int16_t c) {
+  return (v * static_cast<int>(c) + (1 << 14)) >> 15;
+}
+
+SPARKYUV_INLINE static void PreciseForwardPixel(const int r, const int g, const int b, const YCbCrForwardQ15 &q,
+                                                int &Y, int &Cb, int &Cr) {
+  Y = MulQ15(r, q.YR) + MulQ15(g, q.YG) + MulQ15(b, q.YB);
+  Cb = MulQ15(b, q.CbB) - (MulQ15(r, q.CbR) + MulQ15(g, q.CbG));
+  Cr = MulQ15(r, q.CrR) - (MulQ15(g, q.CrG) + MulQ15(b, q.CrB));
+}
+
+template<typename T, SparkYuvDefaultPixelType PixelType, class D, HWY_IF_I16_D(D), typename V = Vec<D>>
+HWY_INLINE void LoadPreciseRGB(D d, const T *SPARKYUV_RESTRICT source, V &R, V &G, V &B) {
+  const RebindToUnsigned<decltype(d)> du16;
+  Vec<decltype(du16)> R16, G16, B16, A16;
+  if (std::is_same<T, uint16_t>::value) {
+    LoadRGBA<PixelType>(du16, reinterpret_cast<const uint16_t *>(source), R16, G16, B16, A16);
+  } else {
+    LoadRGB<PixelType>(du16, reinterpret_cast<const uint8_t *>(source), R16, G16, B16);
+  }
+  R = BitCast(d, R16);
+  G = BitCast(d, G16);
+  B = BitCast(d, B16);
+}
+
+template<typename T, class D, HWY_IF_I16_D(D), typename V = Vec<D>>
+HWY_INLINE void StorePreciseSamples(D d, V v, T *SPARKYUV_RESTRICT store) {
+  if (std::is_same<T, uint16_t>::value) {
+    const RebindToUnsigned<decltype(d)> du16;
+    StoreU(BitCast(du16, v), du16, reinterpret_cast<uint16_t *>(store));
+  } else {
+    const Rebind<uint8_t, decltype(d)> du8;
+    StoreU(DemoteTo(du8, v), du8, reinterpret_cast<uint8_t *>(store));
+  }
+}
+
+template<typename T, class D, HWY_IF_I32_D(D), typename V = Vec<D>>
+HWY_INLINE void StorePreciseSamples(D d, V v, T *SPARKYUV_RESTRICT store) {
+  if (std::is_same<T, uint16_t>::value) {
+    const Rebind<uint16_t, decltype(d)> du16;
+    StoreU(DemoteTo(du16, v), du16, reinterpret_cast<uint16_t *>(store));
+  } else {
+    const Rebind<uint8_t, decltype(d)> du8;
+    StoreU(DemoteTo(du8, v), du8, reinterpret_cast<uint8_t *>(store));
+  }
+}
+
+/**
+ * Encoding counterpart of YCbCrToXRGBPrecise: samples are moved to 14 bits and multiplied by Q15 coefficients.
+ * Chroma of 4:2:2 and 4:2:0 is a sum of full resolution chroma of the block,
+ * so it is rounded once after averaging, odd edges are paired with themselves.
+ */
+template<typename T, SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA,
+    SparkYuvChromaSubsample chromaSubsample, int bitDepth>
+void XRGBToYCbCrPrecise(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
+                        const uint32_t width, const uint32_t height,
+                        T *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,
+                        T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
+                        T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
+                        const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  static_assert(bitDepth >= 8 && bitDepth <= 12, "Invalid bit depth");
+  static_assert(chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420
+                    || chromaSubsample == YUV_SAMPLE_444, "Unexpected chroma sample type");
+  uint16_t biasY;
+  uint16_t biasUV;
+  uint16_t rangeY;
+  uint16_t rangeUV;
+  GetYUVRange(colorRange, bitDepth, biasY, biasUV, rangeY, rangeUV);
+
+  const int maxColors = (1 << bitDepth) - 1;
+
+  float YR, YG, YB;
+  float CbR, CbG, CbB;
+  float CrR, CrG, CrB;
+  ComputeTransform(kr, kb, static_cast<float>(biasY), static_cast<float>(biasUV),
+                   static_cast<float>(rangeY), static_cast<float>(rangeUV),
+                   static_cast<float>(maxColors), YR, YG, YB, CbR, CbG, CbB, CrR, CrG, CrB);
+  const YCbCrForwardQ15 q = {ToQ15(YR), ToQ15(YG), ToQ15(YB),
+                             ToQ15(CbR), ToQ15(CbG), ToQ15(CbB),
+                             ToQ15(CrR), ToQ15(CrG), ToQ15(CrB)};
+
+  constexpr int precision = 14 - bitDepth;
+  constexpr int chromaShift = precision + (chromaSubsample == YUV_SAMPLE_444 ? 0
+                                                                            : (chromaSubsample == YUV_SAMPLE_422 ? 1
+                                                                                                                 : 2));
+  const int yOffset = (static_cast<int>(biasY) << precision) + (1 << (precision - 1));
+  const int uvOffset = (static_cast<int>(biasUV) << chromaShift) + (1 << (chromaShift - 1));
+
+  const ScalableTag<int16_t> di16;
+  const RepartitionToWide<decltype(di16)> di32;
+  using VI16 = Vec<decltype(di16)>;
+  using VI32 = Vec<decltype(di32)>;
+
+  const VI16 vYR = Set(di16, q.YR);
+  const VI16 vYG = Set(di16, q.YG);
+  const VI16 vYB = Set(di16, q.YB);
+  const VI16 vCbR = Set(di16, q.CbR);
+  const VI16 vCbG = Set(di16, q.CbG);
+  const VI16 vCbB = Set(di16, q.CbB);
+  const VI16 vCrR = Set(di16, q.CrR);
+  const VI16 vCrG = Set(di16, q.CrG);
+  const VI16 vCrB = Set(di16, q.CrB);
+  const VI16 vYOffset = Set(di16, static_cast<int16_t>(yOffset));
+  const VI16 vUVOffset = Set(di16, static_cast<int16_t>(uvOffset));
+  const VI32 vUVOffset32 = Set(di32, uvOffset);
+  const VI16 viZeros = Zero(di16);
+  const VI32 viZeros32 = Zero(di32);
+  const VI16 vMaxColors = Set(di16, static_cast<int16_t>(maxColors));
+  const VI32 vMaxColors32 = Set(di32, maxColors);
+
+  const int lanes = Lanes(di16);
+  const int uvLanes = (chromaSubsample == YUV_SAMPLE_444) ? lanes : lanes / 2;
+  const int components = getPixelTypeComponents(PixelType);
+  const int lanesForward = getYuvChromaPixels(chromaSubsample);
+
+  auto mSource = reinterpret_cast<const uint8_t *>(src);
+  auto yStore = reinterpret_cast<uint8_t *>(yPlane);
+  auto uStore = reinterpret_cast<uint8_t *>(uPlane);
+  auto vStore = reinterpret_cast<uint8_t *>(vPlane);
+
+  for (uint32_t y = 0; y < height; ++y) {
+    const bool chromaRow = chromaSubsample != YUV_SAMPLE_420 || !(y & 1);
+    auto mSrc = reinterpret_cast<const T *>(mSource);
+    auto mNext = mSrc;
+    if (chromaSubsample == YUV_SAMPLE_420 && y + 1 < height) {
+      mNext = reinterpret_cast<const T *>(mSource + srcStride);
+    }
+    auto yDst = reinterpret_cast<T *>(yStore);
+    auto uDst = reinterpret_cast<T *>(uStore);
+    auto vDst = reinterpret_cast<T *>(vStore);
+
+    uint32_t x = 0;
+
+    for (; x + lanes < width; x += lanes) {
+      VI16 R, G, B;
+      LoadPreciseRGB<T, PixelType>(di16, mSrc, R, G, B);
+      R = ShiftLeft<precision>(R);
+      G = ShiftLeft<precision>(G);
+      B = ShiftLeft<precision>(B);
+
+      const VI16 Y = Add(Add(MulFixedPoint15(R, vYR), MulFixedPoint15(G, vYG)), MulFixedPoint15(B, vYB));
+      StorePreciseSamples(di16, Clamp(ShiftRight<precision>(Add(Y, vYOffset)), viZeros, vMaxColors), yDst);
+
+      if (chromaRow) {
+        const VI16 Cb = Sub(MulFixedPoint15(B, vCbB), Add(MulFixedPoint15(R, vCbR), MulFixedPoint15(G, vCbG)));
+        const VI16 Cr = Sub(MulFixedPoint15(R, vCrR), Add(MulFixedPoint15(G, vCrG), MulFixedPoint15(B, vCrB)));
+
+        if (chromaSubsample == YUV_SAMPLE_444) {
+          StorePreciseSamples(di16, Clamp(ShiftRight<chromaShift>(Add(Cb, vUVOffset)), viZeros, vMaxColors), uDst);
+          StorePreciseSamples(di16, Clamp(ShiftRight<chromaShift>(Add(Cr, vUVOffset)), viZeros, vMaxColors), vDst);
+        } else {
+          VI32 CbSum = SumsOf2(Cb);
+          VI32 CrSum = SumsOf2(Cr);
+          if (chromaSubsample == YUV_SAMPLE_420) {
+            VI16 R1, G1, B1;
+            LoadPreciseRGB<T, PixelType>(di16, mNext, R1, G1, B1);
+            R1 = ShiftLeft<precision>(R1);
+            G1 = ShiftLeft<precision>(G1);
+            B1 = ShiftLeft<precision>(B1);
+            const VI16 Cb1 = Sub(MulFixedPoint15(B1, vCbB), Add(MulFixedPoint15(R1, vCbR), MulFixedPoint15(G1, vCbG)));
+            const VI16 Cr1 = Sub(MulFixedPoint15(R1, vCrR), Add(MulFixedPoint15(G1, vCrG), MulFixedPoint15(B1, vCrB)));
+            CbSum = Add(CbSum, SumsOf2(Cb1));
+            CrSum = Add(CrSum, SumsOf2(Cr1));
+          }
+          StorePreciseSamples(di32, Clamp(ShiftRight<chromaShift>(Add(CbSum, vUVOffset32)), viZeros32, vMaxColors32),
+                              uDst);
+          StorePreciseSamples(di32, Clamp(ShiftRight<chromaShift>(Add(CrSum, vUVOffset32)), viZeros32, vMaxColors32),
+                              vDst);
+        }
+        uDst += uvLanes;
+        vDst += uvLanes;
+      }
+
+      yDst += lanes;
+      mSrc += lanes * components;
+      mNext += lanes * components;
+    }
+
+    for (; x < width; x += lanesForward) {
+      int CbSum = 0;
+      int CrSum = 0;
+      const int pixels = (chromaSubsample == YUV_SAMPLE_444) ? 1 : std::min(2, static_cast<int>(width - x));
+      for (int i = 0; i < pixels; ++i) {
+        int r, g, b;
+        LoadRGB<T, int, PixelType>(mSrc, r, g, b);
+        int Y, Cb, Cr;
+        PreciseForwardPixel(r << precision, g << precision, b << precision, q, Y, Cb, Cr);
+        yDst[0] = static_cast<T>(std::clamp((Y + yOffset) >> precision, 0, maxColors));
+        CbSum += Cb;
+        CrSum += Cr;
+        if (chromaSubsample == YUV_SAMPLE_420) {
+          LoadRGB<T, int, PixelType>(mNext, r, g, b);
+          PreciseForwardPixel(r << precision, g << precision, b << precision, q, Y, Cb, Cr);
+          CbSum += Cb;
+          CrSum += Cr;
+        }
+        yDst += 1;
+        mSrc += components;
+        mNext += components;
+      }
+
+      if (chromaRow) {
+        if (chromaSubsample != YUV_SAMPLE_444 && pixels == 1) {
+          CbSum *= 2;
+          CrSum *= 2;
+        }
+        uDst[0] = static_cast<T>(std::clamp((CbSum + uvOffset) >> chromaShift, 0, maxColors));
+        vDst[0] = static_cast<T>(std::clamp((CrSum + uvOffset) >> chromaShift, 0, maxColors));
+        uDst += 1;
+        vDst += 1;
+      }
+    }
+
+    yStore += yStride;
+    if (chromaRow) {
+      uStore += uStride;
+      vStore += vStride;
+    }
+    mSource += srcStride;
+  }
+}
+
+#define YCbCr8ToXXXX_PRECISE_DECLARATION_R(pixelType, yuvname, chroma) \
+void yuvname##To##pixelType##PreciseHWY(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                    const uint32_t width, const uint32_t height,                                 \
+                    const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,                         \
+                    const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,                         \
+                    const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,                         \
+                    const float kr, const float kb, const SparkYuvColorRange colorRange) {                           \
+      YCbCrToXRGBPrecise<uint8_t, sparkyuv::PIXEL_##pixelType, chroma, 8>(src, srcStride, width, height,    \
+                                                               yPlane, yStride,                  \
+                                                               uPlane, uStride,                  \
+                                                               vPlane, vStride,                  \
+                                                               kr, kb, colorRange);  \
+}
+
+#define YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, bit, yuvname, chroma) \
+void yuvname##P##bit##To##pixelType##bit##PreciseHWY(uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                    const uint32_t width, const uint32_t height,                                 \
+                    const uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,                         \
+                    const uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,                         \
+                    const uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,                         \
+                    const float kr, const float kb, const SparkYuvColorRange colorRange) {                           \
+      YCbCrToXRGBPrecise<uint16_t, sparkyuv::PIXEL_##pixelType, chroma, bit>(src, srcStride, width, height,    \
+                                                               yPlane, yStride,                  \
+                                                               uPlane, uStride,                  \
+                                                               vPlane, vStride,                  \
+                                                               kr, kb, colorRange);  \
+}
+
+#define YCbCrToXXXX_PRECISE_DECLARATIONS_R(pixelType) \
+    YCbCr8ToXXXX_PRECISE_DECLARATION_R(pixelType, YCbCr444, sparkyuv::YUV_SAMPLE_444) \
+    YCbCr8ToXXXX_PRECISE_DECLARATION_R(pixelType, YCbCr422, sparkyuv::YUV_SAMPLE_422) \
+    YCbCr8ToXXXX_PRECISE_DECLARATION_R(pixelType, YCbCr420, sparkyuv::YUV_SAMPLE_420) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, 10, YCbCr444, sparkyuv::YUV_SAMPLE_444) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, 10, YCbCr422, sparkyuv::YUV_SAMPLE_422) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, 10, YCbCr420, sparkyuv::YUV_SAMPLE_420) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, 12, YCbCr444, sparkyuv::YUV_SAMPLE_444) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, 12, YCbCr422, sparkyuv::YUV_SAMPLE_422) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_R(pixelType, 12, YCbCr420, sparkyuv::YUV_SAMPLE_420)
+
+YCbCrToXXXX_PRECISE_DECLARATIONS_R(RGBA)
+YCbCrToXXXX_PRECISE_DECLARATIONS_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCrToXXXX_PRECISE_DECLARATIONS_R(ARGB)
+YCbCrToXXXX_PRECISE_DECLARATIONS_R(ABGR)
+YCbCrToXXXX_PRECISE_DECLARATIONS_R(BGRA)
+YCbCrToXXXX_PRECISE_DECLARATIONS_R(BGR)
+#endif
+
+#undef YCbCrToXXXX_PRECISE_DECLARATIONS_R
+#undef YCbCr16ToXXXX_PRECISE_DECLARATION_R
+#undef YCbCr8ToXXXX_PRECISE_DECLARATION_R
+
+#define XXXXToYCbCr8_PRECISE_DECLARATION_R(pixelType, yuvname, chroma) \
+void pixelType##To##yuvname##PreciseHWY(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                    const uint32_t width, const uint32_t height,                                 \
+                    uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,                   \
+                    uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,                   \
+                    uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,                   \
+                    const float kr, const float kb, const SparkYuvColorRange colorRange) {       \
+      XRGBToYCbCrPrecise<uint8_t, sparkyuv::PIXEL_##pixelType, chroma, 8>(src, srcStride, width, height, \
+                                                               yPlane, yStride,                  \
+                                                               uPlane, uStride,                  \
+                                                               vPlane, vStride,                  \
+                                                               kr, kb, colorRange);  \
+}
+
+#define XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, bit, yuvname, chroma) \
+void pixelType##bit##To##yuvname##P##bit##PreciseHWY(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                    const uint32_t width, const uint32_t height,                                 \
+                    uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,                  \
+                    uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,                  \
+                    uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,                  \
+                    const float kr, const float kb, const SparkYuvColorRange colorRange) {       \
+      XRGBToYCbCrPrecise<uint16_t, sparkyuv::PIXEL_##pixelType, chroma, bit>(src, srcStride, width, height, \
+                                                               yPlane, yStride,                  \
+                                                               uPlane, uStride,                  \
+                                                               vPlane, vStride,                  \
+                                                               kr, kb, colorRange);  \
+}
+
+#define XXXXToYCbCr_PRECISE_DECLARATIONS_R(pixelType) \
+    XXXXToYCbCr8_PRECISE_DECLARATION_R(pixelType, YCbCr444, sparkyuv::YUV_SAMPLE_444) \
+    XXXXToYCbCr8_PRECISE_DECLARATION_R(pixelType, YCbCr422, sparkyuv::YUV_SAMPLE_422) \
+    XXXXToYCbCr8_PRECISE_DECLARATION_R(pixelType, YCbCr420, sparkyuv::YUV_SAMPLE_420) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, 10, YCbCr444, sparkyuv::YUV_SAMPLE_444) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, 10, YCbCr422, sparkyuv::YUV_SAMPLE_422) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, 10, YCbCr420, sparkyuv::YUV_SAMPLE_420) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, 12, YCbCr444, sparkyuv::YUV_SAMPLE_444) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, 12, YCbCr422, sparkyuv::YUV_SAMPLE_422) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_R(pixelType, 12, YCbCr420, sparkyuv::YUV_SAMPLE_420)
+
+XXXXToYCbCr_PRECISE_DECLARATIONS_R(RGBA)
+XXXXToYCbCr_PRECISE_DECLARATIONS_R(RGB)
+#if SPARKYUV_FULL_CHANNELS
+XXXXToYCbCr_PRECISE_DECLARATIONS_R(ARGB)
+XXXXToYCbCr_PRECISE_DECLARATIONS_R(ABGR)
+XXXXToYCbCr_PRECISE_DECLARATIONS_R(BGRA)
+XXXXToYCbCr_PRECISE_DECLARATIONS_R(BGR)
+#endif
+
+#undef XXXXToYCbCr_PRECISE_DECLARATIONS_R
+#undef XXXXToYCbCr16_PRECISE_DECLARATION_R
+#undef XXXXToYCbCr8_PRECISE_DECLARATION_R
+
+}
+HWY_AFTER_NAMESPACE();
+
+#endif
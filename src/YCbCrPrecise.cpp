@@ -0,0 +1,164 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparkyuv.h"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "src/YCbCrPrecise.cpp"
+
+#include "hwy/foreach_target.h"
+#include "hwy/highway.h"
+#include "yuv-inl.h"
+#include "YCbCrPrecise-inl.h"
+#include <stdexcept>
+
+#if HWY_ONCE
+namespace sparkyuv {
+
+#define YCbCr8ToXXXX_PRECISE_DECLARATION_E(yuvname, pixelType) \
+    HWY_EXPORT(yuvname##To##pixelType##PreciseHWY);\
+    void yuvname##To##pixelType(uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                const uint32_t width, const uint32_t height,\
+                                const uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                const uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                const uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                const SparkYuvPrecision precision) {\
+      if (precision == sparkyuv::YUV_PRECISION_FAST) {\
+        yuvname##To##pixelType(src, srcStride, width, height, yPlane, yStride, uPlane, uStride,\
+                               vPlane, vStride, kr, kb, colorRange);\
+      } else if (precision == sparkyuv::YUV_PRECISION_HIGH) {\
+        HWY_DYNAMIC_DISPATCH(yuvname##To##pixelType##PreciseHWY)(src, srcStride, width, height,\
+                                                                 yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                                 kr, kb, colorRange);\
+      } else {\
+        throw std::runtime_error("Precision is not supported");\
+      }\
+    }
+
+#define YCbCr16ToXXXX_PRECISE_DECLARATION_E(yuvname, pixelType, bit) \
+    HWY_EXPORT(yuvname##P##bit##To##pixelType##bit##PreciseHWY);\
+    void yuvname##P##bit##To##pixelType##bit(uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                             const uint32_t width, const uint32_t height,\
+                                             const uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                             const uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                             const uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                             const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                             const SparkYuvPrecision precision) {\
+      if (precision == sparkyuv::YUV_PRECISION_FAST) {\
+        yuvname##P##bit##To##pixelType##bit(src, srcStride, width, height, yPlane, yStride, uPlane, uStride,\
+                                            vPlane, vStride, kr, kb, colorRange);\
+      } else if (precision == sparkyuv::YUV_PRECISION_HIGH) {\
+        HWY_DYNAMIC_DISPATCH(yuvname##P##bit##To##pixelType##bit##PreciseHWY)(src, srcStride, width, height,\
+                                                                              yPlane, yStride, uPlane, uStride,\
+                                                                              vPlane, vStride, kr, kb, colorRange);\
+      } else {\
+        throw std::runtime_error("Precision is not supported");\
+      }\
+    }
+
+#define YCbCrToXXXX_PRECISE_DECLARATIONS_E(pixelType) \
+    YCbCr8ToXXXX_PRECISE_DECLARATION_E(YCbCr444, pixelType) \
+    YCbCr8ToXXXX_PRECISE_DECLARATION_E(YCbCr422, pixelType) \
+    YCbCr8ToXXXX_PRECISE_DECLARATION_E(YCbCr420, pixelType) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_E(YCbCr444, pixelType, 10) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_E(YCbCr422, pixelType, 10) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_E(YCbCr420, pixelType, 10) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_E(YCbCr444, pixelType, 12) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_E(YCbCr422, pixelType, 12) \
+    YCbCr16ToXXXX_PRECISE_DECLARATION_E(YCbCr420, pixelType, 12)
+
+YCbCrToXXXX_PRECISE_DECLARATIONS_E(RGBA)
+YCbCrToXXXX_PRECISE_DECLARATIONS_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCrToXXXX_PRECISE_DECLARATIONS_E(ARGB)
+YCbCrToXXXX_PRECISE_DECLARATIONS_E(ABGR)
+YCbCrToXXXX_PRECISE_DECLARATIONS_E(BGRA)
+YCbCrToXXXX_PRECISE_DECLARATIONS_E(BGR)
+#endif
+
+#undef YCbCrToXXXX_PRECISE_DECLARATIONS_E
+#undef YCbCr16ToXXXX_PRECISE_DECLARATION_E
+#undef YCbCr8ToXXXX_PRECISE_DECLARATION_E
+
+#define XXXXToYCbCr8_PRECISE_DECLARATION_E(yuvname, pixelType) \
+    HWY_EXPORT(pixelType##To##yuvname##PreciseHWY);\
+    void pixelType##To##yuvname(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                const uint32_t width, const uint32_t height,\
+                                uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                const SparkYuvPrecision precision) {\
+      if (precision == sparkyuv::YUV_PRECISION_FAST) {\
+        pixelType##To##yuvname(src, srcStride, width, height, yPlane, yStride, uPlane, uStride,\
+                               vPlane, vStride, kr, kb, colorRange);\
+      } else if (precision == sparkyuv::YUV_PRECISION_HIGH) {\
+        HWY_DYNAMIC_DISPATCH(pixelType##To##yuvname##PreciseHWY)(src, srcStride, width, height,\
+                                                                 yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                                 kr, kb, colorRange);\
+      } else {\
+        throw std::runtime_error("Precision is not supported");\
+      }\
+    }
+
+#define XXXXToYCbCr16_PRECISE_DECLARATION_E(yuvname, pixelType, bit) \
+    HWY_EXPORT(pixelType##bit##To##yuvname##P##bit##PreciseHWY);\
+    void pixelType##bit##To##yuvname##P##bit(const uint16_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                             const uint32_t width, const uint32_t height,\
+                                             uint16_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                             uint16_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                             uint16_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                             const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                             const SparkYuvPrecision precision) {\
+      if (precision == sparkyuv::YUV_PRECISION_FAST) {\
+        pixelType##bit##To##yuvname##P##bit(src, srcStride, width, height, yPlane, yStride, uPlane, uStride,\
+                                            vPlane, vStride, kr, kb, colorRange);\
+      } else if (precision == sparkyuv::YUV_PRECISION_HIGH) {\
+        HWY_DYNAMIC_DISPATCH(pixelType##bit##To##yuvname##P##bit##PreciseHWY)(src, srcStride, width, height,\
+                                                                              yPlane, yStride, uPlane, uStride,\
+                                                                              vPlane, vStride, kr, kb, colorRange);\
+      } else {\
+        throw std::runtime_error("Precision is not supported");\
+      }\
+    }
+
+#define XXXXToYCbCr_PRECISE_DECLARATIONS_E(pixelType) \
+    XXXXToYCbCr8_PRECISE_DECLARATION_E(YCbCr444, pixelType) \
+    XXXXToYCbCr8_PRECISE_DECLARATION_E(YCbCr422, pixelType) \
+    XXXXToYCbCr8_PRECISE_DECLARATION_E(YCbCr420, pixelType) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_E(YCbCr444, pixelType, 10) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_E(YCbCr422, pixelType, 10) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_E(YCbCr420, pixelType, 10) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_E(YCbCr444, pixelType, 12) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_E(YCbCr422, pixelType, 12) \
+    XXXXToYCbCr16_PRECISE_DECLARATION_E(YCbCr420, pixelType, 12)
+
+XXXXToYCbCr_PRECISE_DECLARATIONS_E(RGBA)
+XXXXToYCbCr_PRECISE_DECLARATIONS_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+XXXXToYCbCr_PRECISE_DECLARATIONS_E(ARGB)
+XXXXToYCbCr_PRECISE_DECLARATIONS_E(ABGR)
+XXXXToYCbCr_PRECISE_DECLARATIONS_E(BGRA)
+XXXXToYCbCr_PRECISE_DECLARATIONS_E(BGR)
+#endif
+
+#undef XXXXToYCbCr_PRECISE_DECLARATIONS_E
+#undef XXXXToYCbCr16_PRECISE_DECLARATION_E
+#undef XXXXToYCbCr8_PRECISE_DECLARATION_E
+
+}
+#endif
@@ -29,6 +29,16 @@
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
 
+/**
+ * YCgCo with the range scaling folded into Q15 coefficients,
+ * Y = (2G + R + B) * kY, Cg = (2G - R - B) * kY, Co = (R - B) * kCo, where kY = range / 4 and kCo = range / 2.
+ * Numerators of 12-bit content still fit into int16_t so every bit depth stays in 16-bit lanes,
+ * and TV range costs the same as full range.
+ */
+static inline int YCgCoMulFixedPoint15(const int a, const int b) {
+  return (a * b + (1 << 14)) >> 15;
+}
+
 template<typename T, SparkYuvDefaultPixelType PixelType = sparkyuv::PIXEL_RGBA,
     SparkYuvChromaSubsample chromaSubsample, int bitDepth>
 std::enable_if_t<std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value, void>
@@ -38,21 +48,21 @@ PixelToYcCbcCrcImpl(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
                     T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
                     T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
                     const SparkYuvColorRange colorRange) {
-  static_assert(bitDepth >= 8, "Invalid bit depth");
+  static_assert(bitDepth >= 8 && bitDepth <= 12, "Invalid bit depth");
   static_assert(chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420
                     || chromaSubsample == YUV_SAMPLE_444, "Unexpected chroma sample type");
-  uint16_t bY;
-  uint16_t bUV;
+  uint16_t biasY;
+  uint16_t biasUV;
   uint16_t rangeY;
   uint16_t rangeUV;
-  GetYUVRange(colorRange, bitDepth, bY, bUV, rangeY, rangeUV);
+  GetYUVRange(colorRange, bitDepth, biasY, biasUV, rangeY, rangeUV);
 
-  const int precision = 6;
-  const float maxColors = ::powf(2.f, bitDepth) - 1.f;
-  const int rangeReduction = static_cast<int>(::roundf((static_cast<float>(rangeY) / static_cast<float>(maxColors)
-      * static_cast<float>(1 << precision))));
-  const int biasY = static_cast<int>(bY) * (1 << precision);
-  const int biasUV = static_cast<int>(bUV) * (1 << precision);
+  const int maxColors = (1 << bitDepth) - 1;
+  const float rangeScale = static_cast<float>(rangeY) / static_cast<float>(maxColors);
+  // Chroma of subsampled planes is computed from sums of two pixels, so it takes a halved scale
+  const int scaleY = static_cast<int>(::roundf(rangeScale * static_cast<float>(1 << 13)));
+  const int scaleCo = static_cast<int>(::roundf(rangeScale * static_cast<float>(1 << 14)));
+  const int scaleHalfY = static_cast<int>(::roundf(rangeScale * static_cast<float>(1 << 12)));
 
   auto yStore = reinterpret_cast<uint8_t *>(yPlane);
   auto uStore = reinterpret_cast<uint8_t *>(uPlane);
@@ -68,15 +78,15 @@ PixelToYcCbcCrcImpl(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
   const Half<decltype(di16)> dhi16;
   const Half<decltype(d)> dh;
   const Half<decltype(du16)> dhu16;
-  const auto vBiasY = Set(du16, biasY);
-  const auto vBiasUV = Set(di16, biasUV);
-  const auto vhBiasUV = Set(dhi16, biasUV);
-  const auto vRangeReduction = Set(du16, rangeReduction);
-  const Rebind<int32_t, decltype(dhu16)> di32;
-  const RebindToUnsigned<decltype(di32)> d32;
-  const auto viRangeReduction = Set(di32, rangeReduction);
-  const auto viBiasY = Set(di32, biasY);
-  const auto viBiasUV = Set(di32, biasUV);
+  const auto vBiasY = Set(di16, static_cast<int16_t>(biasY));
+  const auto vBiasUV = Set(di16, static_cast<int16_t>(biasUV));
+  const auto vhBiasUV = Set(dhi16, static_cast<int16_t>(biasUV));
+  const auto vMaxColors = Set(di16, static_cast<int16_t>(maxColors));
+  const auto vhMaxColors = Set(dhi16, static_cast<int16_t>(maxColors));
+  const auto vScaleY = Set(di16, static_cast<int16_t>(scaleY));
+  const auto vScaleCo = Set(di16, static_cast<int16_t>(scaleCo));
+  const auto vhScaleY = Set(dhi16, static_cast<int16_t>(scaleY));
+  const auto vhScaleHalfY = Set(dhi16, static_cast<int16_t>(scaleHalfY));
 
   const int lanes = Lanes(d);
   const int uvLanes = (chromaSubsample == YUV_SAMPLE_444) ? lanes : Lanes(dh);
@@ -102,50 +112,17 @@ PixelToYcCbcCrcImpl(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
         static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value, "Unexpected storage type");
       }
 
+      const auto sR = BitCast(di16, R);
+      const auto sG = BitCast(di16, G);
+      const auto sB = BitCast(di16, B);
+      const auto sRB = Add(sR, sB);
+      const auto sG2 = Add(sG, sG);
+
+      const VU16 Y = BitCast(du16, Add(MulFixedPoint15(Add(sG2, sRB), vScaleY), vBiasY));
+
       if (chromaSubsample == YUV_SAMPLE_444) {
-        VU16 Y, Cg, Co;
-
-        if (bitDepth <= 8) {
-          R = Mul(R, vRangeReduction);
-          G = Mul(G, vRangeReduction);
-          B = Mul(B, vRangeReduction);
-          const auto hG = ShiftRight<1>(G);
-          const auto qRB = ShiftRight<2>(Add(R, B));
-          Y = ShiftRight<6>(Add(Add(hG, qRB), vBiasY));
-          const auto shG = BitCast(di16, hG);
-          const auto sR = BitCast(di16, R);
-          const auto sB = BitCast(di16, B);
-          Cg = BitCast(du16, ShiftRight<6>(Add(vBiasUV, Sub(shG, BitCast(di16, qRB)))));
-          Co = BitCast(du16, ShiftRight<6>(Add(ShiftRight<1>(Sub(sR, sB)), vBiasUV)));
-        } else {
-          auto Rl = PromoteLowerTo(di32, BitCast(di16, R));
-          auto Rh = PromoteUpperTo(di32, BitCast(di16, R));
-          auto Gl = PromoteLowerTo(di32, BitCast(di16, G));
-          auto Gh = PromoteUpperTo(di32, BitCast(di16, G));
-          auto Bl = PromoteLowerTo(di32, BitCast(di16, B));
-          auto Bh = PromoteUpperTo(di32, BitCast(di16, B));
-
-          Rl = Mul(Rl, viRangeReduction);
-          Gl = Mul(Gl, viRangeReduction);
-          Bl = Mul(Bl, viRangeReduction);
-          Rh = Mul(Rh, viRangeReduction);
-          Gh = Mul(Gh, viRangeReduction);
-          Bh = Mul(Bh, viRangeReduction);
-
-          const auto Yl = ShiftRightNarrow<6>(di32, Add(AddAndHalf(di32, Gl, AddAndHalf(di32, Rl, Bl)), viBiasY));
-          const auto Yh = ShiftRightNarrow<6>(di32, Add(AddAndHalf(di32, Gh, AddAndHalf(di32, Rh, Bh)), viBiasY));
-          Y = BitCast(du16, Combine(di16, Yh, Yl));
-          const auto Cgl = ShiftRightNarrow<6>(di32, Add(viBiasUV,
-                                                         Sub(ShiftRight<1>(Gl),
-                                                             ShiftRight<2>(Add(Rl, Bl)))));
-          const auto Cgh = ShiftRightNarrow<6>(di32, Add(viBiasUV,
-                                                         Sub(ShiftRight<1>(Gh),
-                                                             ShiftRight<2>(Add(Rh, Bh)))));
-          Cg = BitCast(du16, Combine(di16, Cgh, Cgl));
-          const auto Col = ShiftRightNarrow<6>(di32, Add(ShiftRight<1>(Sub(Rl, Bl)), viBiasUV));
-          const auto Coh = ShiftRightNarrow<6>(di32, Add(ShiftRight<1>(Sub(Rh, Bh)), viBiasUV));
-          Co = BitCast(du16, Combine(di16, Coh, Col));
-        }
+        const VU16 Cg = BitCast(du16, Min(Add(MulFixedPoint15(Sub(sG2, sRB), vScaleY), vBiasUV), vMaxColors));
+        const VU16 Co = BitCast(du16, Min(Add(MulFixedPoint15(Sub(sR, sB), vScaleCo), vBiasUV), vMaxColors));
 
         if (std::is_same<T, uint16_t>::value) {
           StoreU(Y, du16, reinterpret_cast<uint16_t *>(yDst));
@@ -161,53 +138,18 @@ PixelToYcCbcCrcImpl(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
         }
       } else if (chromaSubsample == YUV_SAMPLE_420 || chromaSubsample == YUV_SAMPLE_422) {
         using VHU16 = Vec<decltype(dhu16)>;
-        VU16 Y;
-        VHU16 Cg, Co;
-
-        // uint16_t 12 bit max colors 4096 then 4096*2 < 2^16 so overflowing is not possible in uint16_t domain
-        // Bi-linear sample
-        if (bitDepth <= 8) {
-          R = Mul(R, vRangeReduction);
-          G = Mul(G, vRangeReduction);
-          B = Mul(B, vRangeReduction);
-
-          Y = ShiftRight<6>(Add(AddAndHalf(du16, G, AddAndHalf(du16, R, B)), vBiasY));
-          const auto sR = BitCast(dhi16, ShiftRightNarrow<1>(d32, SumsOf2(R)));
-          const auto sG = BitCast(dhi16, ShiftRightNarrow<1>(d32, SumsOf2(G)));
-          const auto sB = BitCast(dhi16, ShiftRightNarrow<1>(d32, SumsOf2(B)));
-
-          Cg = BitCast(dhu16, ShiftRight<6>(Add(vhBiasUV,
-                                                Sub(ShiftRight<1>(sG), BitCast(dhi16, ShiftRight<2>(Add(sR, sB)))))));
-          Co = BitCast(dhu16, ShiftRight<6>(Add(ShiftRight<1>(Sub(sR, sB)), vhBiasUV)));
-        } else {
-          auto Rl = PromoteLowerTo(di32, BitCast(di16, R));
-          auto Rh = PromoteUpperTo(di32, BitCast(di16, R));
-          auto Gl = PromoteLowerTo(di32, BitCast(di16, G));
-          auto Gh = PromoteUpperTo(di32, BitCast(di16, G));
-          auto Bl = PromoteLowerTo(di32, BitCast(di16, B));
-          auto Bh = PromoteUpperTo(di32, BitCast(di16, B));
-
-          Rl = Mul(Rl, viRangeReduction);
-          Gl = Mul(Gl, viRangeReduction);
-          Bl = Mul(Bl, viRangeReduction);
-          Rh = Mul(Rh, viRangeReduction);
-          Gh = Mul(Gh, viRangeReduction);
-          Bh = Mul(Bh, viRangeReduction);
-
-          const auto Yl = ShiftRightNarrow<6>(di32, Add(Add(ShiftRight<1>(Gl), ShiftRight<2>(Add(Rl, Bl))), viBiasY));
-          const auto Yh = ShiftRightNarrow<6>(di32, Add(Add(ShiftRight<1>(Gh), ShiftRight<2>(Add(Rh, Bh))), viBiasY));
-          Y = BitCast(du16, Combine(di16, Yh, Yl));
-          const auto Cgl = ShiftRightNarrow<6>(di32, Add(viBiasUV,
-                                                         Sub(ShiftRight<1>(Gl),
-                                                             ShiftRight<2>(Add(Rl, Bl)))));
-          const auto Cgh = ShiftRightNarrow<6>(di32, Add(viBiasUV,
-                                                         Sub(ShiftRight<1>(Gh),
-                                                             ShiftRight<2>(Add(Rh, Bh)))));
-          Cg = BitCast(dhu16, ShiftRight<1>(Add(Cgh, Cgl)));
-          const auto Col = ShiftRightNarrow<6>(di32, Add(ShiftRight<1>(Sub(Rl, Bl)), viBiasUV));
-          const auto Coh = ShiftRightNarrow<6>(di32, Add(ShiftRight<1>(Sub(Rh, Bh)), viBiasUV));
-          Co = BitCast(dhu16, ShiftRight<1>(Add(Coh, Col)));
-        }
+
+        // uint16_t 12 bit max colors 4096 then 4096*2 < 2^15 so sums of pairs are safe in int16_t domain
+        const auto hR = BitCast(dhi16, DemoteTo(dhu16, SumsOf2(R)));
+        const auto hG = BitCast(dhi16, DemoteTo(dhu16, SumsOf2(G)));
+        const auto hB = BitCast(dhi16, DemoteTo(dhu16, SumsOf2(B)));
+        const auto hRB = Add(hR, hB);
+        const auto hG2 = Add(hG, hG);
+
+        const VHU16 Cg = BitCast(dhu16, Min(Add(MulFixedPoint15(Sub(hG2, hRB), vhScaleHalfY), vhBiasUV),
+                                            vhMaxColors));
+        const VHU16 Co = BitCast(dhu16, Min(Add(MulFixedPoint15(Sub(hR, hB), vhScaleY), vhBiasUV),
+                                            vhMaxColors));
 
         if (std::is_same<T, uint16_t>::value) {
           StoreU(Y, du16, reinterpret_cast<uint16_t *>(yDst));
@@ -251,104 +193,33 @@ PixelToYcCbcCrcImpl(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
 
       LoadRGB<T, int, PixelType>(mSrc, r, g, b);
 
-      r *= rangeReduction;
-      g *= rangeReduction;
-      b *= rangeReduction;
-
-      int hg = g >> 1;
-
-      int Y = static_cast<int>(hg + ((r + b) >> 2) + biasY) >> precision;
-      yDst[0] = Y;
+      yDst[0] = static_cast<T>(YCgCoMulFixedPoint15(2 * g + r + b, scaleY) + biasY);
       yDst += 1;
+      mSrc += components;
 
-      if (chromaSubsample == YUV_SAMPLE_444) {
-        mSrc += components;
-      } else if (chromaSubsample == YUV_SAMPLE_422) {
-        mSrc += components;
-        if (x + 1 < width) {
-          int r1 = r, g1 = g, b1 = b;
-          LoadRGB<T, int, PixelType>(mSrc, r1, g1, b1);
-
-          r1 *= rangeReduction;
-          g1 *= rangeReduction;
-          b1 *= rangeReduction;
-
-          r = (r + r1) >> 1;
-          g = (g + g1) >> 1;
-          b = (b + b1) >> 1;
-
-          T Y1 = static_cast<T>(static_cast<int>((g1 >> 1) + ((r1 + b1) >> 2) + biasY) >> precision);
-          yDst[0] = Y1;
-          yDst += 1;
-          mSrc += components;
-        }
-      } else if (chromaSubsample == YUV_SAMPLE_420) {
-        auto oldSrc = mSrc;
-
-        mSrc += components;
+      int cgScale = scaleY;
+      int coScale = scaleCo;
 
+      if (chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420) {
         int r1 = r, g1 = g, b1 = b;
-        int r2 = r, g2 = g, b2 = b;
-        int r3 = r, g3 = g, b3 = b;
-
         if (x + 1 < width) {
           LoadRGB<T, int, PixelType>(mSrc, r1, g1, b1);
 
-          r1 *= rangeReduction;
-          g1 *= rangeReduction;
-          b1 *= rangeReduction;
-
-          T Y1 = static_cast<T>(static_cast<int>((g1 >> 1) + ((r1 + b1) >> 2) + biasY) >> precision);
-          yDst[0] = Y1;
+          yDst[0] = static_cast<T>(YCgCoMulFixedPoint15(2 * g1 + r1 + b1, scaleY) + biasY);
           yDst += 1;
           mSrc += components;
         }
 
-        if (!(y & 1)) {
-          auto nextRow = reinterpret_cast<const T *>(oldSrc);
-          if (y + 1 < height - 1) {
-            nextRow = reinterpret_cast<const T *>(reinterpret_cast<const uint8_t *>(oldSrc) + srcStride);
-          }
-
-          LoadRGB<T, int, PixelType>(nextRow, r2, g2, b2);
-
-          r2 *= rangeReduction;
-          g2 *= rangeReduction;
-          b2 *= rangeReduction;
-
-          nextRow += components;
-
-          if (x + 1 < width) {
-            LoadRGB<T, int, PixelType>(nextRow, r3, g3, b3);
-
-            r3 *= rangeReduction;
-            g3 *= rangeReduction;
-            b3 *= rangeReduction;
-          }
-
-          r = (r + r1 + r2 + r3) >> 2;
-          g = (g + g1 + g2 + g3) >> 2;
-          b = (b + b1 + b2 + b3) >> 2;
-        }
-      }
-
-      if (chromaSubsample == YUV_SAMPLE_444 || chromaSubsample == YUV_SAMPLE_422) {
-        T Cb = static_cast<T>((((g >> 1) - ((r + b) >> 2)) + biasUV) >> precision);
-        T Cr = static_cast<T>((((r - b) >> 1) + biasUV) >> precision);
-
-        uDst[0] = Cb;
-        vDst[0] = Cr;
-      } else if (chromaSubsample == YUV_SAMPLE_420) {
-        if (!(y & 1)) {
-          T Cb = static_cast<T>((((g >> 1) - ((r + b) >> 2)) + biasUV) >> precision);
-          T Cr = static_cast<T>((((r - b) >> 1) + biasUV) >> precision);
-
-          uDst[0] = Cb;
-          vDst[0] = Cr;
-        }
+        r += r1;
+        g += g1;
+        b += b1;
+        cgScale = scaleHalfY;
+        coScale = scaleY;
       }
 
-      if (chromaSubsample == YUV_SAMPLE_444 || chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420) {
+      if (chromaSubsample == YUV_SAMPLE_444 || chromaSubsample == YUV_SAMPLE_422 || !(y & 1)) {
+        uDst[0] = static_cast<T>(std::min(YCgCoMulFixedPoint15(2 * g - r - b, cgScale) + biasUV, maxColors));
+        vDst[0] = static_cast<T>(std::min(YCgCoMulFixedPoint15(r - b, coScale) + biasUV, maxColors));
         uDst += 1;
         vDst += 1;
       }
@@ -466,7 +337,7 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
                     const T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,
                     const T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,
                     const SparkYuvColorRange colorRange) {
-  static_assert(bitDepth >= 8, "Invalid bit depth");
+  static_assert(bitDepth >= 8 && bitDepth <= 12, "Invalid bit depth");
   static_assert(chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420
                     || chromaSubsample == YUV_SAMPLE_444, "Unexpected chroma sample type");
   auto mYSrc = reinterpret_cast<const uint8_t *>(yPlane);
@@ -480,10 +351,12 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
   uint16_t rangeUV;
   GetYUVRange(colorRange, bitDepth, biasY, biasUV, rangeY, rangeUV);
 
-  const int maxColors = static_cast<int>(::powf(2.f, static_cast<float>(bitDepth)) - 1.f);
-  const int precision = 6;
-  const int rangeReduction = static_cast<int>(::roundf((static_cast<float>(maxColors) / static_cast<float>(rangeY)
-      * static_cast<float>(1 << precision))));
+  const int maxColors = (1 << bitDepth) - 1;
+  // Inputs are pre-shifted to the top of int16_t and multiplied by a half of range expansion in Q15,
+  // this leaves `precision` fractional bits and headroom for Y - Cg + Co in 16-bit lanes
+  constexpr int precision = 13 - bitDepth;
+  const int scale = static_cast<int>(::roundf((static_cast<float>(maxColors) / static_cast<float>(rangeY)
+      * static_cast<float>(1 << 14))));
 
   const int lanesForward = getYuvChromaPixels(chromaSubsample);
 
@@ -491,19 +364,17 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
 
   const ScalableTag<uint16_t> du16;
   const RebindToSigned<decltype(du16)> di16;
-  const Half<decltype(di16)> dhi16;
   using VU16 = Vec<decltype(du16)>;
   const Rebind<T, decltype(du16)> d;
   const Half<decltype(d)> dh;
   const Half<decltype(du16)> dhu16;
-  const auto vBiasY = Set(di16, biasY);
-  const auto vBiasUV = Set(di16, biasUV);
-  const auto vMaxColors = Set(di16, maxColors);
+  const auto vBiasY = Set(di16, static_cast<int16_t>(biasY));
+  const auto vBiasUV = Set(di16, static_cast<int16_t>(biasUV));
+  const auto vMaxColors = Set(di16, static_cast<int16_t>(maxColors));
   const auto viZeros = Zero(di16);
   const auto A16 = Set(du16, maxColors);
-  const auto vRangeReduction = Set(di16, rangeReduction);
-  const Rebind<int32_t, decltype(dhu16)> di32;
-  const auto viRangeReduction = Set(di32, rangeReduction);
+  const auto vScale = Set(di16, static_cast<int16_t>(scale));
+  const auto vRounding = Set(di16, static_cast<int16_t>(1 << (precision - 1)));
 
   const int lanes = Lanes(d);
   const int uvLanes = (chromaSubsample == YUV_SAMPLE_444) ? lanes : Lanes(dh);
@@ -557,41 +428,14 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
         static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, uint16_t>::value, "Unexpected storage type");
       }
 
-      VU16 R16, G16, B16;
+      const auto sY = MulFixedPoint15(ShiftLeft<precision + 1>(Sub(BitCast(di16, Y), vBiasY)), vScale);
+      const auto sCg = MulFixedPoint15(ShiftLeft<precision + 1>(Sub(BitCast(di16, Cg), vBiasUV)), vScale);
+      const auto sCo = MulFixedPoint15(ShiftLeft<precision + 1>(Sub(BitCast(di16, Co), vBiasUV)), vScale);
+      const auto t = Add(Sub(sY, sCg), vRounding);
 
-      if (bitDepth <= 8) {
-        const auto sY = Mul(Sub(BitCast(di16, Y), vBiasY), vRangeReduction);
-        const auto sCg = Mul(Sub(BitCast(di16, Cg), vBiasUV), vRangeReduction);
-        const auto sCo = Mul(Sub(BitCast(di16, Co), vBiasUV), vRangeReduction);
-        const auto t = Sub(sY, sCg);
-        G16 = BitCast(du16, Clamp(ShiftRight<6>(Add(sY, sCg)), viZeros, vMaxColors));
-        B16 = BitCast(du16, Clamp(ShiftRight<6>(Sub(t, sCo)), viZeros, vMaxColors));
-        R16 = BitCast(du16, Clamp(ShiftRight<6>(Add(t, sCo)), viZeros, vMaxColors));
-      } else {
-        const auto sY = Sub(BitCast(di16, Y), vBiasY);
-        const auto sCg = Sub(BitCast(di16, Cg), vBiasUV);
-        const auto sCo = Sub(BitCast(di16, Co), vBiasUV);
-        const auto sYl = Mul(PromoteLowerTo(di32, sY), viRangeReduction);
-        const auto sYh = Mul(PromoteUpperTo(di32, sY), viRangeReduction);
-        const auto sCgl = Mul(PromoteLowerTo(di32, sCg), viRangeReduction);
-        const auto sCgh = Mul(PromoteUpperTo(di32, sCg), viRangeReduction);
-        const auto sCol = Mul(PromoteLowerTo(di32, sCo), viRangeReduction);
-        const auto sCoh = Mul(PromoteUpperTo(di32, sCo), viRangeReduction);
-
-        const auto tl = Sub(sYl, sCgl);
-        const auto th = Sub(sYh, sCgh);
-
-        const auto Gl = ShiftRightNarrow<6>(di32, Add(sYl, sCgl));
-        const auto Gh = ShiftRightNarrow<6>(di32, Add(sYh, sCgh));
-        const auto Bl = ShiftRightNarrow<6>(di32, Sub(tl, sCol));
-        const auto Bh = ShiftRightNarrow<6>(di32, Sub(th, sCoh));
-        const auto Rl = ShiftRightNarrow<6>(di32, Add(tl, sCol));
-        const auto Rh = ShiftRightNarrow<6>(di32, Add(th, sCoh));
-
-        G16 = BitCast(du16, Clamp(Combine(di16, Gh, Gl), viZeros, vMaxColors));
-        B16 = BitCast(du16, Clamp(Combine(di16, Bh, Bl), viZeros, vMaxColors));
-        R16 = BitCast(du16, Clamp(Combine(di16, Rh, Rl), viZeros, vMaxColors));
-      }
+      const VU16 G16 = BitCast(du16, Clamp(ShiftRight<precision>(Add(Add(sY, sCg), vRounding)), viZeros, vMaxColors));
+      const VU16 B16 = BitCast(du16, Clamp(ShiftRight<precision>(Sub(t, sCo)), viZeros, vMaxColors));
+      const VU16 R16 = BitCast(du16, Clamp(ShiftRight<precision>(Add(t, sCo)), viZeros, vMaxColors));
 
       if (std::is_same<T, uint16_t>::value) {
         StoreRGBA<PixelType>(du16, reinterpret_cast<uint16_t *>(store), R16, G16, B16, A16);
@@ -607,17 +451,19 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
       store += lanes * components;
     }
 
+    const int rounding = 1 << (precision - 1);
+
     for (; x < width; x += lanesForward) {
       const T uValue = reinterpret_cast<const T *>(CgSource)[0];
       const T vValue = reinterpret_cast<const T *>(CoSource)[0];
 
-      const int Y = (static_cast<int>(ySrc[0]) - biasY) * rangeReduction;
-      const int Cr = (static_cast<int>(vValue) - biasUV) * rangeReduction;
-      const int Cb = (static_cast<int>(uValue) - biasUV) * rangeReduction;
+      const int Y = YCgCoMulFixedPoint15((static_cast<int>(ySrc[0]) - biasY) * (1 << (precision + 1)), scale);
+      const int Cr = YCgCoMulFixedPoint15((static_cast<int>(vValue) - biasUV) * (1 << (precision + 1)), scale);
+      const int Cb = YCgCoMulFixedPoint15((static_cast<int>(uValue) - biasUV) * (1 << (precision + 1)), scale);
 
-      int t = Y - Cb;
+      int t = Y - Cb + rounding;
 
-      int G = std::clamp((Y + Cb) >> precision, 0, maxColors);
+      int G = std::clamp((Y + Cb + rounding) >> precision, 0, maxColors);
       int B = std::clamp((t - Cr) >> precision, 0, maxColors);
       int R = std::clamp((t + Cr) >> precision, 0, maxColors);
 
@@ -628,11 +474,11 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
 
       if (chromaSubsample == YUV_SAMPLE_422 || chromaSubsample == YUV_SAMPLE_420) {
         if (x + 1 < width) {
-          int Y1 = (static_cast<int>(ySrc[0]) - biasY) * rangeReduction;
-          int t1 = Y1 - Cb;
-          int G1 = std::clamp((Y1 + Cb) >> precision, 0, maxColors);
+          int Y1 = YCgCoMulFixedPoint15((static_cast<int>(ySrc[0]) - biasY) * (1 << (precision + 1)), scale);
+          int t1 = Y1 - Cb + rounding;
+          int G1 = std::clamp((Y1 + Cb + rounding) >> precision, 0, maxColors);
           int B1 = std::clamp((t1 - Cr) >> precision, 0, maxColors);
-          int R1 = std::clamp((t + Cr) >> precision, 0, maxColors);
+          int R1 = std::clamp((t1 + Cr) >> precision, 0, maxColors);
 
           StoreRGBA<T, int, PixelType>(store, R1, G1, B1, maxColors);
           store += components;
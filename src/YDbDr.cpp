@@ -23,6 +23,7 @@
 #include "yuv-inl.h"
 #include "sparkyuv-internal.h"
 #include "TransformMatrix-inl.h"
+#include <stdexcept>
 
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
@@ -196,6 +197,49 @@ YIQ_ToXXXX_DECLARATION_R(uint16_t, BGR, 12, YDbDr420, sparkyuv::YUV_SAMPLE_420)
 
 #undef YIQ_ToXXXX_DECLARATION_R
 
+#define YDbDr_ToXXXX_PRECISE_DECLARATION_R(T, PixelType, bit, yuvname, chroma) \
+void yuvname##P##bit##To##PixelType##bit##PreciseHWY(T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                    const uint32_t width, const uint32_t height,                                 \
+                    const T *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,                         \
+                    const T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,                         \
+                    const T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,                         \
+                    const sparkyuv::SparkYuvColorRange colorRange) {                           \
+      TransformYUVToRGBMatrixF32<T, sparkyuv::PIXEL_##PixelType, chroma, bit>(src, srcStride, width, height,    \
+                                                               yPlane, yStride,                  \
+                                                               uPlane, uStride,                  \
+                                                               vPlane, vStride,                  \
+                                                               colorRange, kYDbDrToRGBMatrix);  \
+}
+
+#define YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(T, PixelType, bit) \
+    YDbDr_ToXXXX_PRECISE_DECLARATION_R(T, PixelType, bit, YDbDr444, sparkyuv::YUV_SAMPLE_444) \
+    YDbDr_ToXXXX_PRECISE_DECLARATION_R(T, PixelType, bit, YDbDr422, sparkyuv::YUV_SAMPLE_422) \
+    YDbDr_ToXXXX_PRECISE_DECLARATION_R(T, PixelType, bit, YDbDr420, sparkyuv::YUV_SAMPLE_420)
+
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint8_t, RGBA, 8)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint8_t, RGB, 8)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, RGBA, 10)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, RGB, 10)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, RGBA, 12)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, RGB, 12)
+#if SPARKYUV_FULL_CHANNELS
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint8_t, BGRA, 8)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint8_t, ABGR, 8)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint8_t, ARGB, 8)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint8_t, BGR, 8)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, BGRA, 10)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, ABGR, 10)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, ARGB, 10)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, BGR, 10)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, BGRA, 12)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, ABGR, 12)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, ARGB, 12)
+YDbDr_ToXXXX_PRECISE_DECLARATIONS_R(uint16_t, BGR, 12)
+#endif
+
+#undef YDbDr_ToXXXX_PRECISE_DECLARATIONS_R
+#undef YDbDr_ToXXXX_PRECISE_DECLARATION_R
+
 }
 HWY_AFTER_NAMESPACE();
 
@@ -518,5 +562,55 @@ YCgCo_TO_PX_DECLARATION_E(uint16_t, BGR, 12, YDbDr420)
 
 #undef YCgCo_TO_PX_DECLARATION_E
 
+#define YDbDr_TO_PX_PRECISE_DECLARATION_E(T, pixel, bit, yuv) \
+    HWY_EXPORT(yuv##P##bit##To##pixel##bit##PreciseHWY);\
+    void yuv##P##bit##To##pixel##bit(T *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                     const uint32_t width, const uint32_t height,\
+                                     const T *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                     const T *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                     const T *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                     const SparkYuvColorRange colorRange, const SparkYuvPrecision precision) {\
+      if (precision == sparkyuv::YUV_PRECISION_FAST) {\
+        HWY_DYNAMIC_DISPATCH(yuv##P##bit##To##pixel##bit##HWY)(src, srcStride, width, height,\
+                                                               yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                               colorRange);\
+      } else if (precision == sparkyuv::YUV_PRECISION_HIGH) {\
+        HWY_DYNAMIC_DISPATCH(yuv##P##bit##To##pixel##bit##PreciseHWY)(src, srcStride, width, height,\
+                                                                      yPlane, yStride, uPlane, uStride,\
+                                                                      vPlane, vStride, colorRange);\
+      } else {\
+        throw std::runtime_error("Precision is not supported");\
+      }\
+    }
+
+#define YDbDr_TO_PX_PRECISE_DECLARATIONS_E(T, pixel, bit) \
+    YDbDr_TO_PX_PRECISE_DECLARATION_E(T, pixel, bit, YDbDr444) \
+    YDbDr_TO_PX_PRECISE_DECLARATION_E(T, pixel, bit, YDbDr422) \
+    YDbDr_TO_PX_PRECISE_DECLARATION_E(T, pixel, bit, YDbDr420)
+
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint8_t, RGBA, 8)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint8_t, RGB, 8)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, RGBA, 10)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, RGB, 10)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, RGBA, 12)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, RGB, 12)
+#if SPARKYUV_FULL_CHANNELS
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint8_t, BGRA, 8)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint8_t, ABGR, 8)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint8_t, ARGB, 8)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint8_t, BGR, 8)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, BGRA, 10)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, ABGR, 10)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, ARGB, 10)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, BGR, 10)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, BGRA, 12)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, ABGR, 12)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, ARGB, 12)
+YDbDr_TO_PX_PRECISE_DECLARATIONS_E(uint16_t, BGR, 12)
+#endif
+
+#undef YDbDr_TO_PX_PRECISE_DECLARATIONS_E
+#undef YDbDr_TO_PX_PRECISE_DECLARATION_E
+
 }
 #endif
\ No newline at end of file
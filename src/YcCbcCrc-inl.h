@@ -25,12 +25,7 @@
 #include "yuv-inl.h"
 #include "sparkyuv-internal.h"
 #include "Eotf-inl.h"
-
-#if HWY_TARGET != HWY_SVE && HWY_TARGET != HWY_SVE2 && HWY_TARGET != HWY_SVE_256 && HWY_TARGET != HWY_SVE2_128
-#define YCCBCCRC_HWY_ENABLED 1
-#else
-#define YCCBCCRC_HWY_ENABLED 0
-#endif
+#include "TransferLut-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace sparkyuv::HWY_NAMESPACE {
@@ -48,15 +43,13 @@ void computeYcCbcCrcCutoffs(const SparkYuvTransferFunction transferFunction,
   Pr = 1.f - Oetf(kr, transferFunction);
 }
 
-#if YCCBCCRC_HWY_ENABLED
 template<typename D, typename V = Vec<D>, HWY_IF_FLOAT_D(D)>
 EOTF_INLINE V computeYcCbcCrcEquation(D d, V dx, V low, V high, V scaleLow, V scaleHigh) {
   const auto zeros = Zero(d);
-  auto v = IfThenElse(And(dx >= low, dx <= zeros), Mul(dx, scaleLow), zeros);
-  v = IfThenElse(And(dx > zeros, dx < high), Mul(dx, scaleHigh), v);
+  auto v = IfThenElse(And(Ge(dx, low), Le(dx, zeros)), Mul(dx, scaleLow), zeros);
+  v = IfThenElse(And(Gt(dx, zeros), Lt(dx, high)), Mul(dx, scaleHigh), v);
   return v;
 }
-#endif
 
 EOTF_INLINE float computeYcCbcCrcEquation(float dx, float low, float high, float scaleLow, float scaleHigh) {
   float Eb;
@@ -102,6 +95,8 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
   float Nb, Pb, Nr, Pr;
   computeYcCbcCrcCutoffs(TransferFunction, kr, kb, Nb, Pb, Nr, Pr);
 
+  const TransferLut &lut = GetTransferLut(TransferFunction, bitDepth);
+
   auto yStore = reinterpret_cast<uint8_t *>(yPlane);
   auto uStore = reinterpret_cast<uint8_t *>(uPlane);
   auto vStore = reinterpret_cast<uint8_t *>(vPlane);
@@ -121,14 +116,15 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
   const float divisor2 = 1.f / 2.f;
   const float divisor4 = 1.f / 4.f;
 
-#if YCCBCCRC_HWY_ENABLED
   const ScalableTag<uint16_t> du16;
   const Half<decltype(du16)> dhu16;
   const Rebind<T, decltype(du16)> d;
   const Half<decltype(d)> dh;
   const Rebind<uint32_t, decltype(dhu16)> du32;
   const Rebind<float, decltype(du32)> df;
+  const RebindToSigned<decltype(du32)> di32;
   using VF = Vec<decltype(df)>;
+  using VI = Vec<decltype(di32)>;
   using VU = Vec<decltype(du16)>;
   const int lanes = Lanes(d);
   const int uvLanes = (chromaSubsample == YUV_SAMPLE_444) ? lanes : Lanes(dh);
@@ -150,7 +146,6 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
   const auto vKg = Set(df, kg);
   const auto alpha = Set(d, maxColors);
   const auto v420Scale = Set(df, 0.5f);
-#endif
 
   for (uint32_t y = 0; y < height; ++y) {
     uint32_t x = 0;
@@ -160,44 +155,42 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
     auto vDst = reinterpret_cast<T *>(vStore);
     auto mSrc = reinterpret_cast<const T *>(mSource);
 
-#if YCCBCCRC_HWY_ENABLED
     for (; x + lanes < width; x += lanes) {
-      VF Rh, Rl, Gh, Gl, Bh, Bl;
+      VI Rih, Ril, Gih, Gil, Bih, Bil;
       if (std::is_same<T, uint16_t>::value) {
         VU R16, G16, B16, A16;
         LoadRGBA<PixelType>(du16, reinterpret_cast<const uint16_t *>(mSrc), R16, G16, B16, A16);
 
-        Rh = ConvertTo(df, PromoteUpperTo(du32, R16));
-        Rl = ConvertTo(df, PromoteLowerTo(du32, R16));
-        Gh = ConvertTo(df, PromoteUpperTo(du32, G16));
-        Gl = ConvertTo(df, PromoteLowerTo(du32, G16));
-        Bh = ConvertTo(df, PromoteUpperTo(du32, B16));
-        Bl = ConvertTo(df, PromoteLowerTo(du32, B16));
+        Rih = BitCast(di32, PromoteUpperTo(du32, R16));
+        Ril = BitCast(di32, PromoteLowerTo(du32, R16));
+        Gih = BitCast(di32, PromoteUpperTo(du32, G16));
+        Gil = BitCast(di32, PromoteLowerTo(du32, G16));
+        Bih = BitCast(di32, PromoteUpperTo(du32, B16));
+        Bil = BitCast(di32, PromoteLowerTo(du32, B16));
       } else if (std::is_same<T, uint8_t>::value) {
         VU R16, G16, B16;
         LoadRGB<PixelType>(du16, reinterpret_cast<const uint8_t *>(mSrc), R16, G16, B16);
 
-        Rh = ConvertTo(df, PromoteTo(du32, UpperHalf(dhu16, R16)));
-        Rl = ConvertTo(df, PromoteLowerTo(du32, R16));
-        Gh = ConvertTo(df, PromoteTo(du32, UpperHalf(dhu16, G16)));
-        Gl = ConvertTo(df, PromoteLowerTo(du32, G16));
-        Bh = ConvertTo(df, PromoteTo(du32, UpperHalf(dhu16, B16)));
-        Bl = ConvertTo(df, PromoteLowerTo(du32, B16));
+        Rih = BitCast(di32, PromoteTo(du32, UpperHalf(dhu16, R16)));
+        Ril = BitCast(di32, PromoteLowerTo(du32, R16));
+        Gih = BitCast(di32, PromoteTo(du32, UpperHalf(dhu16, G16)));
+        Gil = BitCast(di32, PromoteLowerTo(du32, G16));
+        Bih = BitCast(di32, PromoteTo(du32, UpperHalf(dhu16, B16)));
+        Bil = BitCast(di32, PromoteLowerTo(du32, B16));
       }
 
-      Rh = Mul(Rh, vLinearScale);
-      Rl = Mul(Rl, vLinearScale);
-      Gh = Mul(Gh, vLinearScale);
-      Gl = Mul(Gl, vLinearScale);
-      Bh = Mul(Bh, vLinearScale);
-      Bl = Mul(Bl, vLinearScale);
+      // Integer samples are linearized by table, luma is encoded back with interpolated OETF
+      auto Eh = TransferLutOetf(df, lut, MulAdd(TransferLutEotf(df, lut, Rih), vKr,
+                                                MulAdd(TransferLutEotf(df, lut, Gih), vKg,
+                                                       Mul(TransferLutEotf(df, lut, Bih), vKb))));
+      auto El = TransferLutOetf(df, lut, MulAdd(TransferLutEotf(df, lut, Ril), vKr,
+                                                MulAdd(TransferLutEotf(df, lut, Gil), vKg,
+                                                       Mul(TransferLutEotf(df, lut, Bil), vKb))));
 
-      auto Eh = Oetf(df, MulAdd(Eotf(df, Rh, TransferFunction), vKr,
-                                MulAdd(Eotf(df, Gh, TransferFunction), vKg,
-                                       Mul(Eotf(df, Bh, TransferFunction), vKb))), TransferFunction);
-      auto El = Oetf(df, MulAdd(Eotf(df, Rl, TransferFunction), vKr,
-                                MulAdd(Eotf(df, Gl, TransferFunction), vKg,
-                                       Mul(Eotf(df, Bl, TransferFunction), vKb))), TransferFunction);
+      VF Rh = Mul(ConvertTo(df, Rih), vLinearScale);
+      VF Rl = Mul(ConvertTo(df, Ril), vLinearScale);
+      VF Bh = Mul(ConvertTo(df, Bih), vLinearScale);
+      VF Bl = Mul(ConvertTo(df, Bil), vLinearScale);
 
       auto Yh = Add(Round(Mul(Eh, vScaleRangeY)), vBiasY);
       auto Yl = Add(Round(Mul(El, vScaleRangeY)), vBiasY);
@@ -327,7 +320,6 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
       vDst += uvLanes;
       mSrc += lanes*components;
     }
-#endif
 
     for (; x < width; x += lanesForward) {
       float r;
@@ -336,13 +328,14 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
 
       LoadRGB<T, float, PixelType>(mSrc, r, g, b);
 
+      const float dE = TransferLutEotf(lut, static_cast<int>(r)) * kr + TransferLutEotf(lut, static_cast<int>(g)) * kg
+          + TransferLutEotf(lut, static_cast<int>(b)) * kb;
+      const float E = TransferLutOetf(lut, dE);
+
       r *= linearScale;
       g *= linearScale;
       b *= linearScale;
 
-      const float dE = Eotf(r, TransferFunction) * kr + Eotf(g, TransferFunction) * kg + Eotf(b, TransferFunction) * kb;
-      const float E = Oetf(dE, TransferFunction);
-
       T Yc = static_cast<T>(static_cast<SignedT>(::roundf(E * static_cast<float>(rangeY))) + biasY);
       yDst[0] = Yc;
       yDst += 1;
@@ -354,6 +347,10 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
 
           LoadRGB<T, float, PixelType>(mSrc, r1, g1, b1);
 
+          const float dE1 = TransferLutEotf(lut, static_cast<int>(r1)) * kr
+              + TransferLutEotf(lut, static_cast<int>(g1)) * kg + TransferLutEotf(lut, static_cast<int>(b1)) * kb;
+          const float E1 = TransferLutOetf(lut, dE1);
+
           r1 *= linearScale;
           g1 *= linearScale;
           b1 *= linearScale;
@@ -362,10 +359,6 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
           g = (g + g1) * divisor2;
           b = (b + b1) * divisor2;
 
-          const float
-              dE1 = Eotf(r1, TransferFunction) * kr + Eotf(g1, TransferFunction) * kg + Eotf(b1, TransferFunction) * kb;
-          const float E1 = Oetf(dE1, TransferFunction);
-
           T Yc1 = static_cast<T>(::roundf(E1 * static_cast<float>(rangeY))) + biasY;
           yDst[0] = Yc1;
           yDst += 1;
@@ -382,14 +375,15 @@ PixelToYcCbcCrcHWY(const T *SPARKYUV_RESTRICT src, const uint32_t srcStride,
 
         if (x + 1 < width) {
           LoadRGB<T, float, PixelType>(mSrc, r1, g1, b1);
+
+          const float dE1 = TransferLutEotf(lut, static_cast<int>(r1)) * kr
+              + TransferLutEotf(lut, static_cast<int>(g1)) * kg + TransferLutEotf(lut, static_cast<int>(b1)) * kb;
+          const float E1 = TransferLutOetf(lut, dE1);
+
           r1 *= linearScale;
           g1 *= linearScale;
           b1 *= linearScale;
 
-          const float dE1 =
-              Eotf(r1, TransferFunction) * kr + Eotf(g1, TransferFunction) * kg + Eotf(b1, TransferFunction) * kb;
-          const float E1 = Oetf(dE1, TransferFunction);
-
           T Yc1 = static_cast<T>(::roundf(E1 * static_cast<float>(rangeY))) + biasY;
           yDst[0] = Yc1;
           yDst += 1;
@@ -581,7 +575,6 @@ EOTF_INLINE T YcCbcCrcInverse(T Y, T v, T scaleLow, T scaleHigh, T low, T high)
   return x;
 }
 
-#if YCCBCCRC_HWY_ENABLED
 template<class D, class V = Vec<D>>
 EOTF_INLINE V YcCbcCrcInverse(D d, V Y, V v, V scaleLow, V scaleHigh, V low, V high) {
   const V l = Mul(v, scaleLow);
@@ -589,11 +582,10 @@ EOTF_INLINE V YcCbcCrcInverse(D d, V Y, V v, V scaleLow, V scaleHigh, V low, V h
   const V diffl = l;
   const V diffh = h;
   const V zeros = Zero(d);
-  auto cv = IfThenElse(And(diffl >= low, diffl <= zeros), Add(l, Y), zeros);
-  cv = IfThenElse(And(diffh > zeros, diffh <= high), Add(h, Y), cv);
+  auto cv = IfThenElse(And(Ge(diffl, low), Le(diffl, zeros)), Add(l, Y), zeros);
+  cv = IfThenElse(And(Gt(diffh, zeros), Le(diffh, high)), Add(h, Y), cv);
   return cv;
 }
-#endif
 
 /**
 * @brief It will be good to declare a type of transfer function
@@ -628,6 +620,8 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
   float Nb, Pb, Nr, Pr;
   computeYcCbcCrcCutoffs(transferFunction, kr, kb, Nb, Pb, Nr, Pr);
 
+  const TransferLut &lut = GetTransferLut(transferFunction, bitDepth);
+
   const float EpbLow = (2.f * Nb);
   const float EpbHigh = (2.f * Pb);
   const float EprLow = (2.f * Nr);
@@ -645,7 +639,6 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
 
   const float ekg = 1.f / kg;
 
-#if YCCBCCRC_HWY_ENABLED
   const ScalableTag<uint16_t> du16;
   const Half<decltype(du16)> dhu16;
   const Rebind<T, decltype(du16)> d;
@@ -704,7 +697,6 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
 #endif
 
   const auto A = Set(du16, maxColors);
-#endif
 
   for (int y = 0; y < height; ++y) {
     auto CbSource = reinterpret_cast<const T *>(mUSrc);
@@ -714,7 +706,6 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
 
     uint32_t x = 0;
 
-#if YCCBCCRC_HWY_ENABLED
     for (; x + lanes < width; x += lanes) {
 #if SPARKYUV_ALLOW_FLOAT16
       VF Y, Cb, Cr;
@@ -773,9 +764,9 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
       auto Bf = YcCbcCrcInverse(df, Y, Cb, vEpbLow, vEpbHigh, vNb, vPb);
       auto Rf = YcCbcCrcInverse(df, Y, Cr, vEprLow, vEprHigh, vNr, vPr);
 
-      auto Gf = Oetf(df, Mul(Sub(Eotf(df, Y, transferFunction),
-                                 MulAdd(Eotf(df, Rf, transferFunction), vKr,
-                                        Mul(Eotf(df, Bf, transferFunction), vKb))), vEkg), transferFunction);
+      auto Gf = TransferLutOetf(df, lut, Mul(Sub(TransferLutEotfCurve(df, lut, Y),
+                                                 MulAdd(TransferLutEotfCurve(df, lut, Rf), vKr,
+                                                        Mul(TransferLutEotfCurve(df, lut, Bf), vKb))), vEkg));
 
       auto Ru = ConvertTo(du16, Clamp(Mul(Rf, vMaxColors), vZeros, vMaxColors));
       auto Bu = ConvertTo(du16, Clamp(Mul(Bf, vMaxColors), vZeros, vMaxColors));
@@ -825,12 +816,12 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
       auto Bh = YcCbcCrcInverse(df, Yh, Cbh, vEpbLow, vEpbHigh, vNb, vPb);
       auto Rh = YcCbcCrcInverse(df, Yh, Crh, vEprLow, vEprHigh, vNr, vPr);
 
-      auto Gl = Oetf(df, Mul(Sub(Eotf(df, Yl, transferFunction),
-                                 MulAdd(Eotf(df, Rl, transferFunction), vKr,
-                                        Mul(Eotf(df, Bl, transferFunction), vKb))), vEkg), transferFunction);
-      auto Gh = Oetf(df, Mul(Sub(Eotf(df, Yh, transferFunction),
-                                 MulAdd(Eotf(df, Rh, transferFunction), vKr,
-                                        Mul(Eotf(df, Bh, transferFunction), vKb))), vEkg), transferFunction);
+      auto Gl = TransferLutOetf(df, lut, Mul(Sub(TransferLutEotfCurve(df, lut, Yl),
+                                                 MulAdd(TransferLutEotfCurve(df, lut, Rl), vKr,
+                                                        Mul(TransferLutEotfCurve(df, lut, Bl), vKb))), vEkg));
+      auto Gh = TransferLutOetf(df, lut, Mul(Sub(TransferLutEotfCurve(df, lut, Yh),
+                                                 MulAdd(TransferLutEotfCurve(df, lut, Rh), vKr,
+                                                        Mul(TransferLutEotfCurve(df, lut, Bh), vKb))), vEkg));
 
       Bl = Clamp(Mul(Bl, vMaxColors), vZeros, vMaxColors);
       Rl = Clamp(Mul(Rl, vMaxColors), vZeros, vMaxColors);
@@ -851,7 +842,6 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
       CrSource += uvLanes;
       store += lanes * components;
     }
-#endif
 
     for (; x < width; x += lanesForward) {
       const T uValue = reinterpret_cast<const T *>(CbSource)[0];
@@ -863,8 +853,8 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
 
       auto B = YcCbcCrcInverse<float>(Y, Cb, EpbLow, EpbHigh, Nb, Pb);
       auto R = YcCbcCrcInverse<float>(Y, Cr, EprLow, EprHigh, Nr, Pr);
-      auto G = Oetf((Eotf(Y, transferFunction) - kr * Eotf(R, transferFunction) - kb * Eotf(B, transferFunction)) * ekg,
-                    transferFunction);
+      auto G = TransferLutOetf(lut, (TransferLutEotfCurve(lut, Y) - kr * TransferLutEotfCurve(lut, R)
+          - kb * TransferLutEotfCurve(lut, B)) * ekg);
 
       R = std::clamp(::roundf(R * fMaxColors), 0.f, fMaxColors);
       B = std::clamp(::roundf(B * fMaxColors), 0.f, fMaxColors);
@@ -879,10 +869,8 @@ void YcCbcCrcToXRGB(T *SPARKYUV_RESTRICT rgbaData, const uint32_t dstStride,
           auto Y1 = static_cast<float>(static_cast<int>(ySrc[0]) - biasY) * scaleRangeY;
           auto B1 = YcCbcCrcInverse<float>(Y1, Cb, EpbLow, EpbHigh, Nb, Pb);
           auto R1 = YcCbcCrcInverse<float>(Y1, Cr, EprLow, EprHigh, Nr, Pr);
-          auto G1 =
-              Oetf((Eotf(Y1, transferFunction) - kr * Eotf(R1, transferFunction) - kb * Eotf(B1, transferFunction))
-                       * ekg,
-                   transferFunction);
+          auto G1 = TransferLutOetf(lut, (TransferLutEotfCurve(lut, Y1) - kr * TransferLutEotfCurve(lut, R1)
+              - kb * TransferLutEotfCurve(lut, B1)) * ekg);
 
           R1 = std::clamp(::roundf(R1 * fMaxColors), 0.f, fMaxColors);
           B1 = std::clamp(::roundf(B1 * fMaxColors), 0.f, fMaxColors);
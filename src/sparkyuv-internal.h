@@ -22,6 +22,7 @@
 #include <cmath>
 #include <stdexcept>
 #include <cstdint>
+#include "sparkyuv-def.h"
 
 #if defined(__GNUC__) || defined(__clang__)
 #define SPARKYUV_RESTRICT __restrict__
@@ -36,18 +37,6 @@ enum SparkYuvNVLoadOrder {
   YUV_ORDER_VU
 };
 
-struct SparkYuvTransformMatrix {
-  float Y1;
-  float Y2;
-  float Y3;
-  float U1;
-  float U2;
-  float U3;
-  float V1;
-  float V2;
-  float V3;
-};
-
 static SparkYuvTransformMatrix kRGBToYIQMatrix = {.Y1 = 0.299f, .Y2 = 0.587f, .Y3 = 0.114f,
     .U1 = 0.5959f, .U2 = -0.2746f, .U3 = -0.3213f,
     .V1 = 0.2115f, .V2 = -0.5227, .V3 = 0.3112f};
@@ -148,4 +137,187 @@ static void GetYUVRange(const SparkYuvColorRange yuvColorRange, const int bitDep
   }
 }
 
+/**
+ * Threaded wrappers check parameters before the image is split,
+ * an exception escaping a worker thread can't be caught and terminates the process
+ */
+static void ValidateYCbCrParameters(const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  if (colorRange != YUV_RANGE_TV && colorRange != YUV_RANGE_PC) {
+    throw std::runtime_error("Yuv Color Range must be valid parameter");
+  }
+  const float kg = 1.0f - kr - kb;
+  if (kg == 0.f) {
+    throw std::runtime_error("1.0f - kr - kg must not be 0");
+  }
+}
+
+static void ValidateRegion(const uint32_t width, const uint32_t height,
+                           const uint32_t regionX, const uint32_t regionY,
+                           const uint32_t regionWidth, const uint32_t regionHeight,
+                           const uint32_t dstWidth, const uint32_t dstHeight) {
+  if (regionWidth == 0 || regionHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+    throw std::runtime_error("Region and destination sizes must not be zero");
+  }
+  if (regionX >= width || regionY >= height || regionWidth > width - regionX || regionHeight > height - regionY) {
+    throw std::runtime_error("Region must lie inside of the source image");
+  }
+}
+
+static void ValidateRegionConversion(const uint32_t width, const uint32_t height, const SparkYuvRegion region,
+                                     const uint32_t dstWidth, const uint32_t dstHeight,
+                                     const SparkYuvSampler sampler) {
+  ValidateRegion(width, height, region.x, region.y, region.width, region.height, dstWidth, dstHeight);
+  if (sampler != bilinear && sampler != nearest) {
+    throw std::runtime_error("Region conversion supports only bilinear and nearest samplers");
+  }
+}
+
+/**
+ * Box when luma and its subsampled chroma both have exact integer factors, otherwise bilinear,
+ * so both planes of scaled conversion are always decimated by the same filter
+ */
+static SparkYuvSampler SelectDecimationSampler(const uint32_t width, const uint32_t height,
+                                               const uint32_t dstWidth, const uint32_t dstHeight) {
+  const uint32_t chromaWidth = (width + 1) / 2;
+  const uint32_t chromaHeight = (height + 1) / 2;
+  const uint32_t dstChromaWidth = (dstWidth + 1) / 2;
+  const uint32_t dstChromaHeight = (dstHeight + 1) / 2;
+  if (width % dstWidth == 0 && height % dstHeight == 0 && height / dstHeight <= 256
+      && chromaWidth % dstChromaWidth == 0 && chromaHeight % dstChromaHeight == 0) {
+    return box;
+  }
+  return bilinear;
+}
+
+static void ValidateTensorTransform(const SparkYuvTensorNormalization &normalization, const float quantizationScale) {
+  if (quantizationScale == 0.f) {
+    throw std::runtime_error("Quantization scale must not be zero");
+  }
+  for (int c = 0; c < 3; ++c) {
+    if (normalization.std[c] == 0.f) {
+      throw std::runtime_error("Normalization std must not be zero");
+    }
+  }
+}
+
+enum SparkYuvStandardMatrix {
+  YUV_MATRIX_BT601,
+  YUV_MATRIX_BT709,
+  YUV_MATRIX_BT2020
+};
+
+/**
+ * Q6 coefficients of 8-bit YCbCr to RGB transform.
+ * Runtime kr/kb and compile time standard matrices are computed by the same float expression,
+ * so specialized kernels are bit-exact with generic ones called with the same matrix
+ */
+struct YCbCr8InverseCoefficients {
+  int biasY;
+  int biasUV;
+  int lumaCoeff;
+  int CrCoeff;
+  int CbCoeff;
+  int GCoeff1;
+  int GCoeff2;
+};
+
+/**
+ * Float chroma coefficients of YCbCr to RGB transform, `range` rescales chroma from its coded range.
+ * The only place where inverse matrix is derived from kr/kb
+ */
+struct YCbCrInverseMatrix {
+  float CrCoeff;
+  float CbCoeff;
+  float GCoeff1;
+  float GCoeff2;
+};
+
+static constexpr YCbCrInverseMatrix ComputeYCbCrInverseMatrix(const float kr, const float kb, const float range) {
+  const float kg = 1.0f - kr - kb;
+  if (kg == 0.f) {
+    throw std::runtime_error("1.0f - kr - kg must not be 0");
+  }
+  return {
+      .CrCoeff = (2.f * (1.f - kr)) * range,
+      .CbCoeff = (2.f * (1.f - kb)) * range,
+      .GCoeff1 = (2 * ((1 - kr) * kr / kg)) * range,
+      .GCoeff2 = (2 * ((1 - kb) * kb / kg)) * range,
+  };
+}
+
+static constexpr int RoundCoefficient(const float v) {
+  return static_cast<int>(static_cast<double>(v) + (v < 0.f ? -0.5 : 0.5));
+}
+
+static constexpr YCbCr8InverseCoefficients ComputeYCbCr8InverseCoefficients(const float kr, const float kb,
+                                                                             const SparkYuvColorRange colorRange) {
+  if (colorRange != YUV_RANGE_TV && colorRange != YUV_RANGE_PC) {
+    throw std::runtime_error("Yuv Color Range must be valid parameter");
+  }
+  const bool isTv = colorRange == YUV_RANGE_TV;
+  const float rangeY = isTv ? 219.f : 255.f;
+  const float rangeUV = isTv ? 224.f : 255.f;
+  const float scale = static_cast<float>(1 << 6);
+  const float lumaCoeff = 255.f / rangeY;
+  const YCbCrInverseMatrix matrix = ComputeYCbCrInverseMatrix(kr, kb, 255.f / rangeUV);
+  return {
+      .biasY = isTv ? 16 : 0,
+      .biasUV = 128,
+      .lumaCoeff = RoundCoefficient(lumaCoeff * scale),
+      .CrCoeff = RoundCoefficient(matrix.CrCoeff * scale),
+      .CbCoeff = RoundCoefficient(matrix.CbCoeff * scale),
+      .GCoeff1 = RoundCoefficient(matrix.GCoeff1 * scale),
+      .GCoeff2 = RoundCoefficient(matrix.GCoeff2 * scale),
+  };
+}
+
+template<SparkYuvStandardMatrix Matrix>
+struct YCbCrStandardMatrix;
+
+template<>
+struct YCbCrStandardMatrix<YUV_MATRIX_BT601> {
+  static constexpr float kr = 0.299f;
+  static constexpr float kb = 0.114f;
+};
+
+template<>
+struct YCbCrStandardMatrix<YUV_MATRIX_BT709> {
+  static constexpr float kr = 0.2126f;
+  static constexpr float kb = 0.0722f;
+};
+
+template<>
+struct YCbCrStandardMatrix<YUV_MATRIX_BT2020> {
+  static constexpr float kr = 0.2627f;
+  static constexpr float kb = 0.0593f;
+};
+
+/**
+ * Same members as YCbCr8InverseCoefficients, but every one is a compile time constant,
+ * kernels taking it fold biases and coefficients into immediates
+ */
+template<SparkYuvStandardMatrix Matrix, SparkYuvColorRange colorRange>
+struct YCbCr8InverseStandard {
+  static constexpr YCbCr8InverseCoefficients kCoefficients =
+      ComputeYCbCr8InverseCoefficients(YCbCrStandardMatrix<Matrix>::kr, YCbCrStandardMatrix<Matrix>::kb, colorRange);
+  static constexpr int biasY = kCoefficients.biasY;
+  static constexpr int biasUV = kCoefficients.biasUV;
+  static constexpr int lumaCoeff = kCoefficients.lumaCoeff;
+  static constexpr int CrCoeff = kCoefficients.CrCoeff;
+  static constexpr int CbCoeff = kCoefficients.CbCoeff;
+  static constexpr int GCoeff1 = kCoefficients.GCoeff1;
+  static constexpr int GCoeff2 = kCoefficients.GCoeff2;
+};
+
+/**
+ * 4:2:0 to RGBA with the generic kernel even on targets having the wide one,
+ * not a part of public API, exists to check and benchmark both kernels on the same target
+ */
+void YCbCr420ToRGBAGeneric(uint8_t *SPARKYUV_RESTRICT rgba, uint32_t rgbaStride,
+                           uint32_t width, uint32_t height,
+                           const uint8_t *SPARKYUV_RESTRICT ySrc, uint32_t yPlaneStride,
+                           const uint8_t *SPARKYUV_RESTRICT uSrc, uint32_t uPlaneStride,
+                           const uint8_t *SPARKYUV_RESTRICT vSrc, uint32_t vPlaneStride,
+                           float kr, float kb, SparkYuvColorRange colorRange);
+
 }
\ No newline at end of file
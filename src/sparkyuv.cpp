@@ -25,6 +25,7 @@
 #include "YCbCr420-inl.h"
 #include "YCbCr422-inl.h"
 #include "YCbCr444-inl.h"
+#include "concurrency.hpp"
 
 #if HWY_ONCE
 namespace sparkyuv {
@@ -68,6 +69,19 @@ YCbCr420ToXXXX_DECLARATION_E(BGR)
 
 #undef YCbCr420ToXXXX_DECLARATION_E
 
+HWY_EXPORT(YCbCr420ToRGBAGenericHWY);
+
+HWY_DLLEXPORT void YCbCr420ToRGBAGeneric(uint8_t *SPARKYUV_RESTRICT rgba, const uint32_t rgbaStride,
+                           const uint32_t width, const uint32_t height,
+                           const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,
+                           const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,
+                           const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride,
+                           const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  HWY_DYNAMIC_DISPATCH(YCbCr420ToRGBAGenericHWY)(rgba, rgbaStride, width, height,
+                                                 ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,
+                                                 kr, kb, colorRange);
+}
+
 // MARK: YCbCr444 To RGBX
 
 HWY_EXPORT(YCbCr444ToRGBAHWY);
@@ -136,6 +150,46 @@ YCbCr422ToXXXX_DECLARATION_E(BGR)
 
 #undef YCbCr422ToXXXX_DECLARATION_E
 
+// MARK: YCbCr BT.601/BT.709/BT.2020 To RGBX
+
+#define YCbCrToXXXX_STANDARD_DECLARATION_E(sample, name, pixelType) \
+  HWY_EXPORT(YCbCr##sample##name##To##pixelType##HWY); \
+  HWY_DLLEXPORT void \
+  YCbCr##sample##name##To##pixelType(uint8_t *SPARKYUV_RESTRICT rgba, const uint32_t rgbaStride,\
+                                     const uint32_t width, const uint32_t height,\
+                                     const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,\
+                                     const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,\
+                                     const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride) {\
+    HWY_DYNAMIC_DISPATCH(YCbCr##sample##name##To##pixelType##HWY)(rgba, rgbaStride,\
+                                                                 width, height,\
+                                                                 ySrc, yPlaneStride,\
+                                                                 uSrc, uPlaneStride,\
+                                                                 vSrc, vPlaneStride);\
+  }
+
+#define YCbCrToXXXX_STANDARD_DECLARATIONS_E(pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(420, BT601, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(420, BT709, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(420, BT2020, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(422, BT601, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(422, BT709, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(422, BT2020, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(444, BT601, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(444, BT709, pixelType) \
+  YCbCrToXXXX_STANDARD_DECLARATION_E(444, BT2020, pixelType)
+
+YCbCrToXXXX_STANDARD_DECLARATIONS_E(RGBA)
+YCbCrToXXXX_STANDARD_DECLARATIONS_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCrToXXXX_STANDARD_DECLARATIONS_E(ARGB)
+YCbCrToXXXX_STANDARD_DECLARATIONS_E(ABGR)
+YCbCrToXXXX_STANDARD_DECLARATIONS_E(BGRA)
+YCbCrToXXXX_STANDARD_DECLARATIONS_E(BGR)
+#endif
+
+#undef YCbCrToXXXX_STANDARD_DECLARATIONS_E
+#undef YCbCrToXXXX_STANDARD_DECLARATION_E
+
 // MARK: RGBX To YCbCr444
 
 HWY_EXPORT(RGBAToYCbCr444HWY);
@@ -220,10 +274,18 @@ HWY_DLLEXPORT void pixelType##ToYCbCr420(const uint8_t *SPARKYUV_RESTRICT src, c
                                        uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
                                        uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
                                        const float kr, const float kb, const SparkYuvColorRange colorRange) {\
-    HWY_DYNAMIC_DISPATCH(pixelType##ToYCbCr420HWY)(src, srcStride,\
-                                         width, height,\
-                                         yPlane, yStride, uPlane, uStride, vPlane, vStride,\
-                                         kr, kb, colorRange);\
+    ValidateYCbCrParameters(kr, kb, colorRange);\
+    const int threadCount = concurrency::getThreadCounts(width, height);\
+    concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {\
+      const uint32_t y = start * 2;\
+      const uint32_t rows = std::min(static_cast<uint32_t>(end * 2), height) - y;\
+      HWY_DYNAMIC_DISPATCH(pixelType##ToYCbCr420HWY)(src + static_cast<size_t>(y) * srcStride, srcStride,\
+                                                     width, rows,\
+                                                     yPlane + static_cast<size_t>(y) * yStride, yStride,\
+                                                     uPlane + static_cast<size_t>(start) * uStride, uStride,\
+                                                     vPlane + static_cast<size_t>(start) * vStride, vStride,\
+                                                     kr, kb, colorRange);\
+    });\
   }
 
 XXXXToYCbCr420_DECLARATION_E(RGBA)
@@ -237,5 +299,215 @@ XXXXToYCbCr420_DECLARATION_E(BGR)
 
 #undef XXXXToYCbCr420_DECLARATION_E
 
+// MARK: Region conversion
+
+#define YCbCr420RegionToXXXX_DECLARATION_HWY(pixelType) HWY_EXPORT(YCbCr420RegionTo##pixelType##HWY);
+
+YCbCr420RegionToXXXX_DECLARATION_HWY(RGBA)
+YCbCr420RegionToXXXX_DECLARATION_HWY(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420RegionToXXXX_DECLARATION_HWY(ARGB)
+YCbCr420RegionToXXXX_DECLARATION_HWY(ABGR)
+YCbCr420RegionToXXXX_DECLARATION_HWY(BGRA)
+YCbCr420RegionToXXXX_DECLARATION_HWY(BGR)
+#endif
+
+#undef YCbCr420RegionToXXXX_DECLARATION_HWY
+
+#define YCbCr420RegionToXXXX_DECLARATION_E(pixelType) \
+  HWY_DLLEXPORT void \
+  YCbCr420RegionTo##pixelType(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                              const uint32_t dstWidth, const uint32_t dstHeight,\
+                              const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,\
+                              const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,\
+                              const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride,\
+                              const uint32_t width, const uint32_t height, const SparkYuvRegion region,\
+                              const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                              const SparkYuvSampler sampler) {\
+    ValidateYCbCrParameters(kr, kb, colorRange);\
+    ValidateRegionConversion(width, height, region, dstWidth, dstHeight, sampler);\
+    HWY_DYNAMIC_DISPATCH(YCbCr420RegionTo##pixelType##HWY)(dst, dstStride, dstWidth, dstHeight,\
+                                                          ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,\
+                                                          width, height, region.x, region.y,\
+                                                          region.width, region.height,\
+                                                          kr, kb, colorRange, sampler);\
+  }\
+  \
+  HWY_DLLEXPORT void \
+  YCbCr420RegionsTo##pixelType(const SparkYuvRegionTarget *targets, const uint32_t targetsCount,\
+                               const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,\
+                               const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,\
+                               const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride,\
+                               const uint32_t width, const uint32_t height,\
+                               const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                               const SparkYuvSampler sampler) {\
+    if (targetsCount == 0) {\
+      return;\
+    }\
+    ValidateYCbCrParameters(kr, kb, colorRange);\
+    uint64_t pixels = 0;\
+    for (uint32_t i = 0; i < targetsCount; ++i) {\
+      const SparkYuvRegionTarget &target = targets[i];\
+      ValidateRegionConversion(width, height, target.region, target.dstWidth, target.dstHeight, sampler);\
+      pixels += static_cast<uint64_t>(target.dstWidth) * target.dstHeight;\
+    }\
+    const auto workload = static_cast<uint32_t>(std::min(pixels, static_cast<uint64_t>(UINT32_MAX)));\
+    const int threadCount = std::min(concurrency::getThreadCounts(workload, 1), static_cast<int>(targetsCount));\
+    concurrency::parallel_for(threadCount, targetsCount, [&](int i) {\
+      const SparkYuvRegionTarget &target = targets[i];\
+      HWY_DYNAMIC_DISPATCH(YCbCr420RegionTo##pixelType##HWY)(target.dst, target.dstStride,\
+                                                            target.dstWidth, target.dstHeight,\
+                                                            ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,\
+                                                            width, height, target.region.x, target.region.y,\
+                                                            target.region.width, target.region.height,\
+                                                            kr, kb, colorRange, sampler);\
+    });\
+  }
+
+YCbCr420RegionToXXXX_DECLARATION_E(RGBA)
+YCbCr420RegionToXXXX_DECLARATION_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420RegionToXXXX_DECLARATION_E(ARGB)
+YCbCr420RegionToXXXX_DECLARATION_E(ABGR)
+YCbCr420RegionToXXXX_DECLARATION_E(BGRA)
+YCbCr420RegionToXXXX_DECLARATION_E(BGR)
+#endif
+
+#undef YCbCr420RegionToXXXX_DECLARATION_E
+
+// MARK: Letterbox
+
+#define YCbCr420ToXXXXLetterbox_DECLARATION_HWY(pixelType) HWY_EXPORT(YCbCr420To##pixelType##LetterboxHWY);
+
+YCbCr420ToXXXXLetterbox_DECLARATION_HWY(RGBA)
+YCbCr420ToXXXXLetterbox_DECLARATION_HWY(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420ToXXXXLetterbox_DECLARATION_HWY(ARGB)
+YCbCr420ToXXXXLetterbox_DECLARATION_HWY(ABGR)
+YCbCr420ToXXXXLetterbox_DECLARATION_HWY(BGRA)
+YCbCr420ToXXXXLetterbox_DECLARATION_HWY(BGR)
+#endif
+
+#undef YCbCr420ToXXXXLetterbox_DECLARATION_HWY
+
+#define YCbCr420ToXXXXLetterbox_DECLARATION_E(pixelType) \
+  HWY_DLLEXPORT void \
+  YCbCr420To##pixelType##Letterbox(uint8_t *SPARKYUV_RESTRICT dst, const uint32_t dstStride,\
+                                   const uint32_t dstWidth, const uint32_t dstHeight, const SparkYuvRegion content,\
+                                   const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,\
+                                   const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,\
+                                   const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride,\
+                                   const uint32_t width, const uint32_t height, const SparkYuvColor border,\
+                                   const float kr, const float kb, const SparkYuvColorRange colorRange,\
+                                   const SparkYuvSampler sampler) {\
+    HWY_DYNAMIC_DISPATCH(YCbCr420To##pixelType##LetterboxHWY)(dst, dstStride, dstWidth, dstHeight,\
+                                                             content.x, content.y, content.width, content.height,\
+                                                             ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,\
+                                                             width, height, border, kr, kb, colorRange, sampler);\
+  }
+
+YCbCr420ToXXXXLetterbox_DECLARATION_E(RGBA)
+YCbCr420ToXXXXLetterbox_DECLARATION_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+YCbCr420ToXXXXLetterbox_DECLARATION_E(ARGB)
+YCbCr420ToXXXXLetterbox_DECLARATION_E(ABGR)
+YCbCr420ToXXXXLetterbox_DECLARATION_E(BGRA)
+YCbCr420ToXXXXLetterbox_DECLARATION_E(BGR)
+#endif
+
+#undef YCbCr420ToXXXXLetterbox_DECLARATION_E
+
+#define XXXXToYCbCr420Letterbox_DECLARATION_HWY(pixelType) HWY_EXPORT(pixelType##ToYCbCr420LetterboxHWY);
+
+XXXXToYCbCr420Letterbox_DECLARATION_HWY(RGBA)
+XXXXToYCbCr420Letterbox_DECLARATION_HWY(RGB)
+#if SPARKYUV_FULL_CHANNELS
+XXXXToYCbCr420Letterbox_DECLARATION_HWY(ARGB)
+XXXXToYCbCr420Letterbox_DECLARATION_HWY(ABGR)
+XXXXToYCbCr420Letterbox_DECLARATION_HWY(BGRA)
+XXXXToYCbCr420Letterbox_DECLARATION_HWY(BGR)
+#endif
+
+#undef XXXXToYCbCr420Letterbox_DECLARATION_HWY
+
+#define XXXXToYCbCr420Letterbox_DECLARATION_E(pixelType) \
+  HWY_DLLEXPORT void \
+  pixelType##ToYCbCr420Letterbox(const uint8_t *SPARKYUV_RESTRICT src, const uint32_t srcStride,\
+                                 const uint32_t width, const uint32_t height,\
+                                 uint8_t *SPARKYUV_RESTRICT yPlane, const uint32_t yStride,\
+                                 uint8_t *SPARKYUV_RESTRICT uPlane, const uint32_t uStride,\
+                                 uint8_t *SPARKYUV_RESTRICT vPlane, const uint32_t vStride,\
+                                 const uint32_t dstWidth, const uint32_t dstHeight, const SparkYuvRegion content,\
+                                 const uint8_t borderY, const uint8_t borderCb, const uint8_t borderCr,\
+                                 const float kr, const float kb, const SparkYuvColorRange colorRange) {\
+    HWY_DYNAMIC_DISPATCH(pixelType##ToYCbCr420LetterboxHWY)(src, srcStride, width, height,\
+                                                           yPlane, yStride, uPlane, uStride, vPlane, vStride,\
+                                                           dstWidth, dstHeight,\
+                                                           content.x, content.y, content.width, content.height,\
+                                                           borderY, borderCb, borderCr, kr, kb, colorRange);\
+  }
+
+XXXXToYCbCr420Letterbox_DECLARATION_E(RGBA)
+XXXXToYCbCr420Letterbox_DECLARATION_E(RGB)
+#if SPARKYUV_FULL_CHANNELS
+XXXXToYCbCr420Letterbox_DECLARATION_E(ARGB)
+XXXXToYCbCr420Letterbox_DECLARATION_E(ABGR)
+XXXXToYCbCr420Letterbox_DECLARATION_E(BGRA)
+XXXXToYCbCr420Letterbox_DECLARATION_E(BGR)
+#endif
+
+#undef XXXXToYCbCr420Letterbox_DECLARATION_E
+
+// MARK: Tensor conversion
+
+HWY_EXPORT(YCbCr420ToTensorF32HWY);
+HWY_EXPORT(YCbCr420ToTensorF16HWY);
+HWY_EXPORT(YCbCr420ToTensorI8HWY);
+
+#define YCbCr420ToTensor_DECLARATION_E(suffix, storageType) \
+  HWY_DLLEXPORT void \
+  YCbCr420ToTensor##suffix(const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,\
+                           const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,\
+                           const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride,\
+                           const uint32_t width, const uint32_t height,\
+                           storageType *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,\
+                           const SparkYuvTensorNormalization normalization,\
+                           const float kr, const float kb, const SparkYuvColorRange colorRange) {\
+    ValidateYCbCrParameters(kr, kb, colorRange);\
+    ValidateTensorTransform(normalization, 1.f);\
+    const int threadCount = concurrency::getThreadCounts(width, height);\
+    concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {\
+      HWY_DYNAMIC_DISPATCH(YCbCr420ToTensor##suffix##HWY)(ySrc, yPlaneStride, uSrc, uPlaneStride,\
+                                                          vSrc, vPlaneStride, width, height,\
+                                                          tensor, layout, normalization, 1.f, 0, kr, kb, colorRange,\
+                                                          start * 2, std::min(static_cast<uint32_t>(end * 2), height));\
+    });\
+  }
+
+YCbCr420ToTensor_DECLARATION_E(F32, float)
+YCbCr420ToTensor_DECLARATION_E(F16, uint16_t)
+
+#undef YCbCr420ToTensor_DECLARATION_E
+
+HWY_DLLEXPORT void
+YCbCr420ToTensorI8(const uint8_t *SPARKYUV_RESTRICT ySrc, const uint32_t yPlaneStride,
+                   const uint8_t *SPARKYUV_RESTRICT uSrc, const uint32_t uPlaneStride,
+                   const uint8_t *SPARKYUV_RESTRICT vSrc, const uint32_t vPlaneStride,
+                   const uint32_t width, const uint32_t height,
+                   int8_t *SPARKYUV_RESTRICT tensor, const SparkYuvTensorLayout layout,
+                   const SparkYuvTensorNormalization normalization,
+                   const float quantizationScale, const int32_t zeroPoint,
+                   const float kr, const float kb, const SparkYuvColorRange colorRange) {
+  ValidateYCbCrParameters(kr, kb, colorRange);
+  ValidateTensorTransform(normalization, quantizationScale);
+  const int threadCount = concurrency::getThreadCounts(width, height);
+  concurrency::parallel_for_segment(threadCount, (height + 1) / 2, [&](int start, int end) {
+    HWY_DYNAMIC_DISPATCH(YCbCr420ToTensorI8HWY)(ySrc, yPlaneStride, uSrc, uPlaneStride, vSrc, vPlaneStride,
+                                                width, height, tensor, layout, normalization,
+                                                quantizationScale, zeroPoint, kr, kb, colorRange,
+                                                start * 2, std::min(static_cast<uint32_t>(end * 2), height));
+  });
+}
+
 }
 #endif
@@ -37,10 +37,21 @@
 #define SPARKYUV_INLINE inline
 #endif
 
-#if HWY_TARGET != HWY_SVE && HWY_TARGET != HWY_SVE2 && HWY_TARGET != HWY_SVE_256 && HWY_TARGET != HWY_SVE2_128
-#undef NOACCELERATED_SAMPLER
+// Targets with native u8 x i8 quad dot product: AVX-512 VNNI and Armv8.6 USDOT
+#if (HWY_ARCH_X86 && HWY_TARGET <= HWY_AVX3_DL) || \
+    (HWY_ARCH_ARM_A64 && defined(HWY_NEON_BF16) && HWY_TARGET == HWY_NEON_BF16)
+#define SPARKYUV_DOT_ENCODE 1
 #else
-#define NOACCELERATED_SAMPLER 1
+#undef SPARKYUV_DOT_ENCODE
+#endif
+
+// Wide vector targets where 4:2:0 decoding runs a dedicated kernel: chroma is duplicated across the whole
+// vector in one permute (vpermt2b on AVX-512 VBMI, zip1 on SVE) and row tails reuse the vector body
+#if (HWY_ARCH_X86 && HWY_TARGET <= HWY_AVX3) || HWY_TARGET == HWY_SVE || HWY_TARGET == HWY_SVE2 \
+    || HWY_TARGET == HWY_SVE_256 || HWY_TARGET == HWY_SVE2_128
+#define SPARKYUV_WIDE_420 1
+#else
+#undef SPARKYUV_WIDE_420
 #endif
 
 HWY_BEFORE_NAMESPACE();
@@ -545,6 +556,21 @@ namespace sparkyuv::HWY_NAMESPACE {
 using namespace hwy;
 using namespace hwy::HWY_NAMESPACE;
 
+/**
+ * Repeats every lane of half vector twice keeping lane order across the whole vector,
+ * plain InterleaveLower/InterleaveUpper work per 128-bit block and are in order only when half fits one block
+ */
+template<class D>
+HWY_INLINE Vec<D> DuplicateChroma(D d, Vec<Half<D>> v) {
+#if SPARKYUV_WIDE_420
+  const auto full = ZeroExtendVector(d, v);
+  return InterleaveWholeLower(d, full, full);
+#else
+  const Half<D> dh;
+  return Combine(d, InterleaveUpper(dh, v, v), InterleaveLower(v, v));
+#endif
+}
+
 static void ComputeTransform(const float kr,
                              const float kb,
                              const float biasY,
@@ -667,15 +693,11 @@ static void ComputeInverseTransform(const float kr,
                                     float &CbCoeff,
                                     float &GCoeff1,
                                     float &GCoeff2) {
-  const float range = rangeHigh / rangeLow;
-  CrCoeff = (2.f * (1.f - kr)) * range;
-  CbCoeff = (2.f * (1.f - kb)) * range;
-  const float kg = 1.0f - kr - kb;
-  if (kg == 0.f) {
-    throw std::runtime_error("1.0f - kr - kg must not be 0");
-  }
-  GCoeff1 = (2 * ((1 - kr) * kr / kg)) * range;
-  GCoeff2 = (2 * ((1 - kb) * kb / kg)) * range;
+  const YCbCrInverseMatrix matrix = ComputeYCbCrInverseMatrix(kr, kb, rangeHigh / rangeLow);
+  CrCoeff = matrix.CrCoeff;
+  CbCoeff = matrix.CbCoeff;
+  GCoeff1 = matrix.GCoeff1;
+  GCoeff2 = matrix.GCoeff2;
 }
 
 template<typename T, typename C, SparkYuvDefaultPixelType PixelType>
@@ -792,6 +814,161 @@ SPARKYUV_INLINE static void SaturatedStoreRGBA(T *store, C r, C g, C b, C a, C m
   }
 }
 
+/**
+ * Horizontal [1, 2, 1] / 4 chroma pre-filter, neighbours of edge lanes are taken from previous and next pixels.
+ * Followed by 4 pixels box sum this gives [1, 3, 4, 4, 3, 1] / 16 decimation filter for 4:1:1 and 4:1:0
+ */
+template<class D, HWY_IF_UNSIGNED_D(D), typename V = Vec<D>, typename T = TFromD<D>>
+HWY_INLINE V ChromaTapFilter121(D d, V v, const T previous, const T next) {
+  const V left = InsertLane(Slide1Up(d, v), 0, previous);
+  const V right = InsertLane(Slide1Down(d, v), Lanes(d) - 1, next);
+  // Floor average of neighbours, then rounding average with center keeps total bias at about zero
+  const V neighbours = Add(And(left, right), ShiftRight<1>(Xor(left, right)));
+  return AverageRound(v, neighbours);
+}
+
+/**
+ * Nearest neighbour horizontal 2x chroma upsampling of one row into `width` samples
+ */
+template<typename T>
+HWY_INLINE void UpsampleChromaRow2x(const T *SPARKYUV_RESTRICT src, T *SPARKYUV_RESTRICT dst, const uint32_t width) {
+  const ScalableTag<T> d;
+  const uint32_t lanes = Lanes(d);
+  const uint32_t chromaWidth = width / 2;
+  uint32_t x = 0;
+  for (; x + lanes <= chromaWidth; x += lanes) {
+    const auto v = LoadU(d, src + x);
+    StoreInterleaved2(v, v, d, dst + x * 2);
+  }
+  for (; x < chromaWidth; ++x) {
+    dst[x * 2] = src[x];
+    dst[x * 2 + 1] = src[x];
+  }
+  if (width & 1) {
+    dst[width - 1] = src[chromaWidth];
+  }
+}
+
+#if SPARKYUV_DOT_ENCODE
+
+/**
+ * Whole interleaved pixel can be dotted with packed coefficients only when it has 4 channels
+ */
+template<SparkYuvDefaultPixelType PixelType>
+constexpr bool IsDotEncodable() {
+  return PixelType == sparkyuv::PIXEL_RGBA || PixelType == sparkyuv::PIXEL_BGRA
+      || PixelType == sparkyuv::PIXEL_ARGB || PixelType == sparkyuv::PIXEL_ABGR;
+}
+
+template<SparkYuvDefaultPixelType PixelType>
+static inline uint32_t PackDotCoefficients(const int cR, const int cG, const int cB) {
+  const auto r = static_cast<uint32_t>(static_cast<uint8_t>(static_cast<int8_t>(cR)));
+  const auto g = static_cast<uint32_t>(static_cast<uint8_t>(static_cast<int8_t>(cG)));
+  const auto b = static_cast<uint32_t>(static_cast<uint8_t>(static_cast<int8_t>(cB)));
+  switch (PixelType) {
+    case sparkyuv::PIXEL_BGRA:return b | (g << 8) | (r << 16);
+    case sparkyuv::PIXEL_ARGB:return (r << 8) | (g << 16) | (b << 24);
+    case sparkyuv::PIXEL_ABGR:return (b << 8) | (g << 16) | (r << 24);
+    default:return r | (g << 8) | (b << 16);
+  }
+}
+
+/**
+ * Q8 coefficients may exceed int8, they are split into clamped part and remainder so two dot products
+ * still give exact sum. Alpha gets zero weight
+ */
+template<SparkYuvDefaultPixelType PixelType, class DI8, HWY_IF_I8_D(DI8), typename V8 = Vec<DI8>>
+HWY_INLINE void SetDotCoefficients(DI8 di8, const int cR, const int cG, const int cB, V8 &main, V8 &rest) {
+  const Repartition<uint32_t, DI8> du32;
+  const int mR = std::clamp(cR, -128, 127);
+  const int mG = std::clamp(cG, -128, 127);
+  const int mB = std::clamp(cB, -128, 127);
+  main = BitCast(di8, Set(du32, PackDotCoefficients<PixelType>(mR, mG, mB)));
+  rest = BitCast(di8, Set(du32, PackDotCoefficients<PixelType>(cR - mR, cG - mG, cB - mB)));
+}
+
+/**
+ * Q8 transform of `Lanes(d)` interleaved 4 channel pixels with quad dot products,
+ * values match widening multiply-accumulate of separate channels
+ */
+template<class D, HWY_IF_I16_D(D), typename DI8 = Repartition<int8_t, D>, typename V8 = Vec<DI8>,
+    typename D32 = Repartition<int32_t, D>>
+HWY_INLINE Vec<D> DotPixels8(D d, const uint8_t *SPARKYUV_RESTRICT src, V8 main, V8 rest, Vec<D32> bias) {
+  const D32 d32;
+  const Repartition<uint8_t, D> du8;
+  const auto lo = LoadU(du8, src);
+  const auto hi = LoadU(du8, src + Lanes(du8));
+  auto sumLo = SumOfMulQuadAccumulate(d32, lo, main, bias);
+  auto sumHi = SumOfMulQuadAccumulate(d32, hi, main, bias);
+  sumLo = SumOfMulQuadAccumulate(d32, lo, rest, sumLo);
+  sumHi = SumOfMulQuadAccumulate(d32, hi, rest, sumHi);
+  return OrderedDemote2To(d, ShiftRight<8>(sumLo), ShiftRight<8>(sumHi));
+}
+
+/**
+ * Q8 transform of one vector of interleaved 4 channel pixels, one int32 lane per pixel before the shift
+ */
+template<class D32, HWY_IF_I32_D(D32), typename V8 = Vec<Repartition<int8_t, D32>>>
+HWY_INLINE Vec<D32> DotPixels8(D32 d32, Vec<Repartition<uint8_t, D32>> pixels, V8 main, V8 rest, Vec<D32> bias) {
+  return ShiftRight<8>(SumOfMulQuadAccumulate(d32, pixels, rest, SumOfMulQuadAccumulate(d32, pixels, main, bias)));
+}
+
+/**
+ * Rounded average of 2x2 blocks of interleaved 4 channel pixels, each row is given by two vectors,
+ * result keeps pixel layout and holds half of the pixels
+ */
+template<class D, HWY_IF_U8_D(D), typename V = Vec<D>>
+HWY_INLINE V AveragePixels2x2(D d, V top0, V top1, V bottom0, V bottom1) {
+  const RepartitionToWide<D> du16;
+  const Repartition<uint64_t, D> du64;
+  const auto round = Set(du16, 2);
+  // Pixel is one u64 lane after widening, adjacent lanes are neighbours in a row
+  const auto pairs = [&](Vec<decltype(du16)> lo, Vec<decltype(du16)> hi) {
+    const auto even = BitCast(du16, ConcatEven(du64, BitCast(du64, hi), BitCast(du64, lo)));
+    const auto odd = BitCast(du16, ConcatOdd(du64, BitCast(du64, hi), BitCast(du64, lo)));
+    return ShiftRight<2>(Add(Add(even, odd), round));
+  };
+  const auto s0 = pairs(Add(PromoteLowerTo(du16, top0), PromoteLowerTo(du16, bottom0)),
+                        Add(PromoteUpperTo(du16, top0), PromoteUpperTo(du16, bottom0)));
+  const auto s1 = pairs(Add(PromoteLowerTo(du16, top1), PromoteLowerTo(du16, bottom1)),
+                        Add(PromoteUpperTo(du16, top1), PromoteUpperTo(du16, bottom1)));
+  return OrderedDemote2To(d, s0, s1);
+}
+
+#endif
+
+/**
+ * Q8 weighted sum of 8-bit RGB promoted into int16 lanes, `bias` already carries the rounding,
+ * result is saturated into 8 bits
+ */
+template<class D, HWY_IF_I16_D(D), typename V = Vec<D>, typename DW = RepartitionToWide<D>,
+    typename D8 = Rebind<uint8_t, D>>
+HWY_INLINE Vec<D8> WeightedSumRGB8(D d, V R, V G, V B, V cR, V cG, V cB, Vec<DW> bias) {
+  const DW dw;
+  const RebindToUnsigned<D> du;
+  const D8 d8;
+  Vec<DW> high = bias;
+  Vec<DW> low = WidenMulAccumulate(dw, R, cR, bias, high);
+  low = WidenMulAccumulate(dw, G, cG, low, high);
+  low = WidenMulAccumulate(dw, B, cB, low, high);
+  return DemoteTo(d8, BitCast(du, Combine(d, ShiftRightNarrow<8>(dw, high), ShiftRightNarrow<8>(dw, low))));
+}
+
+/**
+ * Rounded average of 2x2 blocks from two rows of 8-bit samples promoted into u16 lanes,
+ * each pair of adjacent lanes gives one int32 lane.
+ * Together with WeightedSumRGB8 it makes 4:2:0 and NV encoders, which encode pairs of rows: both source rows
+ * are loaded together so each iteration writes two luma rows and one chroma row. 2x2 blocks are averaged in u16
+ * before chroma transform, odd last row or column is replicated
+ */
+template<class D, HWY_IF_U16_D(D), typename V = Vec<D>, typename DW = Repartition<int32_t, D>>
+HWY_INLINE Vec<DW> AverageBlock2x2(D d, V top, V bottom) {
+  const DW dw;
+  const RepartitionToWide<D> du32;
+  // Sum of four 8-bit samples fits u16 lanes, so vertical add goes before widening pairwise add
+  return BitCast(dw, ShiftRight<2>(Add(SumsOf2(Add(top, bottom)), Set(du32, 2))));
+}
+
 }
 HWY_AFTER_NAMESPACE();
 
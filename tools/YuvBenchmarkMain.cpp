@@ -32,6 +32,8 @@
 #include "bench/YuvBenchmarkYDbDr.h"
 #include "bench/YuvBenchmarkBase.h"
 #include "bench/YuvBenchmarkNV.h"
+#include "bench/YuvBenchmarkPrecision.h"
+#include "bench/YuvBenchmarkTransfer.h"
 
 static std::string filename = "filirovska.jpeg";
 
@@ -656,11 +658,19 @@ BENCHMARK(LibYuvYCbCr420P10ToRGBA8);
 BENCHMARK(SparkyuvRGBAP10ToYCbCr420P10);
 BENCHMARK(SparkyuvRGBA10ToYCbCr422P10);
 BENCHMARK(SparkyuvRGBA10ToYCbCr444P10);
+BENCHMARK(SparkyuvYCbCr420P10ToRGBA10Fast);
+BENCHMARK(SparkyuvYCbCr420P10ToRGBA10High);
 BENCHMARK(SparkyuvYCbCr444ToRGBA8);
 BENCHMARK(LibYuvYCbCr444ToRGBA8);
 BENCHMARK(SparkyuvYCbCr422ToRGBA8);
 BENCHMARK(LibYuvYCbCr422ToRGBA8);
 BENCHMARK(SparkyuvYCbCr420ToRGBA8);
+BENCHMARK(SparkyuvYCbCr420ToRGBA8Fast);
+BENCHMARK(SparkyuvYCbCr420ToRGBA8High);
+BENCHMARK(SparkyuvRGBA8ToYCbCr420Fast);
+BENCHMARK(SparkyuvRGBA8ToYCbCr420High);
+BENCHMARK(SparkyuvRGBA10ToYCbCr420P10Fast);
+BENCHMARK(SparkyuvRGBA10ToYCbCr420P10High);
 BENCHMARK(LibYuvYCbCr420ToRGBA8);
 BENCHMARK(SparkyuvRGBA8ToYCbCr420);
 BENCHMARK(LibyuvRGBA8ToYCbCr420);
@@ -708,6 +718,17 @@ BENCHMARK(SparkyuvRGBA8ToYcCbcCrc420);
 BENCHMARK(SparkyuvRGBA8ToYcCbcCrc422);
 BENCHMARK(SparkyuvRGBA8ToYcCbcCrc444);
 
+BENCHMARK(SparkyuvLinearizeRGBA12PQExact);
+BENCHMARK(SparkyuvLinearizeRGBA12PQFast);
+BENCHMARK(SparkyuvLinearizeRGBA12PQLUT);
+BENCHMARK(SparkyuvDelinearizeRGBA12PQExact);
+BENCHMARK(SparkyuvDelinearizeRGBA12PQFast);
+BENCHMARK(SparkyuvDelinearizeRGBA12PQLUT);
+BENCHMARK(SparkyuvRGBA8ToYcCbcCrc420PairBT2020);
+BENCHMARK(SparkyuvRGBA8ToYCbCr420PairBT2020);
+BENCHMARK(SparkyuvYcCbcCrc420ToRGBA8PairBT2020);
+BENCHMARK(SparkyuvYCbCr420ToRGBA8PairBT2020);
+
 BENCHMARK(SparkyuvYIQ444ToRGBA8);
 BENCHMARK(SparkyuvYIQ422ToRGBA8);
 BENCHMARK(SparkyuvYIQ420ToRGBA8);
@@ -725,6 +746,8 @@ BENCHMARK(SparkyuvRGBA8ToYDzDx444);
 BENCHMARK(SparkyuvYDbDr444ToRGBA8);
 BENCHMARK(SparkyuvYDbDr422ToRGBA8);
 BENCHMARK(SparkyuvYDbDr420ToRGBA8);
+BENCHMARK(SparkyuvYDbDr420ToRGBA8Fast);
+BENCHMARK(SparkyuvYDbDr420ToRGBA8High);
 BENCHMARK(SparkyuvRGBA8ToYDbDr420);
 BENCHMARK(SparkyuvRGBA8ToYDbDr422);
 BENCHMARK(SparkyuvRGBA8ToYDbDr444);
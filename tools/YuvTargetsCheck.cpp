@@ -0,0 +1,198 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "sparkyuv.h"
+#include "src/sparkyuv-internal.h"
+#include "hwy/targets.h"
+
+/**
+ * Runs the same conversions once per compiled and supported target and compares them with the baseline target.
+ * Used by CI to execute the vector paths under qemu, pass `sve` to also require one of the SVE targets to run.
+ */
+
+static constexpr uint32_t kCheckWidth = 131;
+static constexpr uint32_t kCheckHeight = 37;
+static constexpr int kCheckTolerance = 1;
+
+struct TargetOutput {
+  int64_t target;
+  std::vector<std::vector<uint8_t>> planes;
+};
+
+/**
+ * Premultiplied RGBA with every alpha present, odd size so every kernel goes through its tail
+ */
+static std::vector<uint8_t> MakeCheckImage() {
+  std::vector<uint8_t> rgba(kCheckWidth * 4 * kCheckHeight);
+  uint32_t seed = 0x9E3779B9u;
+  for (uint32_t i = 0; i < kCheckWidth * kCheckHeight; ++i) {
+    const uint32_t alpha = i % 256;
+    for (uint32_t c = 0; c < 3; ++c) {
+      seed = seed * 1664525u + 1013904223u;
+      rgba[i * 4 + c] = static_cast<uint8_t>((seed >> 24) * alpha / 255);
+    }
+    rgba[i * 4 + 3] = static_cast<uint8_t>(alpha);
+  }
+  return rgba;
+}
+
+static std::vector<std::vector<uint8_t>> RunConversions(const std::vector<uint8_t> &rgba) {
+  const uint32_t rgbaStride = kCheckWidth * 4;
+  const uint32_t uvWidth = (kCheckWidth + 1) / 2;
+  const uint32_t uvHeight = (kCheckHeight + 1) / 2;
+
+  std::vector<uint8_t> unpremultiplied(rgbaStride * kCheckHeight);
+  sparkyuv::RGBAUnpremultiplyAlpha(rgba.data(), rgbaStride, unpremultiplied.data(), rgbaStride,
+                                   kCheckWidth, kCheckHeight);
+
+  std::vector<uint8_t> y444(kCheckWidth * kCheckHeight);
+  std::vector<uint8_t> u444(kCheckWidth * kCheckHeight);
+  std::vector<uint8_t> v444(kCheckWidth * kCheckHeight);
+  sparkyuv::RGBA8ToYcCbcCrc444P8(unpremultiplied.data(), rgbaStride, kCheckWidth, kCheckHeight,
+                                 y444.data(), kCheckWidth, u444.data(), kCheckWidth, v444.data(), kCheckWidth,
+                                 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferSRGB);
+  std::vector<uint8_t> rgba444(rgbaStride * kCheckHeight);
+  sparkyuv::YcCbcCrc444P8ToRGBA8(rgba444.data(), rgbaStride, kCheckWidth, kCheckHeight,
+                                 y444.data(), kCheckWidth, u444.data(), kCheckWidth, v444.data(), kCheckWidth,
+                                 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferSRGB);
+
+  std::vector<uint8_t> y420(kCheckWidth * kCheckHeight);
+  std::vector<uint8_t> u420(uvWidth * uvHeight);
+  std::vector<uint8_t> v420(uvWidth * uvHeight);
+  sparkyuv::RGBA8ToYcCbcCrc420P8(unpremultiplied.data(), rgbaStride, kCheckWidth, kCheckHeight,
+                                 y420.data(), kCheckWidth, u420.data(), uvWidth, v420.data(), uvWidth,
+                                 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferSRGB);
+  std::vector<uint8_t> rgba420(rgbaStride * kCheckHeight);
+  sparkyuv::YcCbcCrc420P8ToRGBA8(rgba420.data(), rgbaStride, kCheckWidth, kCheckHeight,
+                                 y420.data(), kCheckWidth, u420.data(), uvWidth, v420.data(), uvWidth,
+                                 0.2627f, 0.0593f, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferSRGB);
+
+  return {unpremultiplied, y444, u444, v444, rgba444, y420, u420, v420, rgba420};
+}
+
+static const char *const kPlaneNames[] = {
+    "RGBAUnpremultiplyAlpha",
+    "RGBA8ToYcCbcCrc444P8 Y", "RGBA8ToYcCbcCrc444P8 Cb", "RGBA8ToYcCbcCrc444P8 Cr", "YcCbcCrc444P8ToRGBA8",
+    "RGBA8ToYcCbcCrc420P8 Y", "RGBA8ToYcCbcCrc420P8 Cb", "RGBA8ToYcCbcCrc420P8 Cr", "YcCbcCrc420P8ToRGBA8",
+};
+
+/**
+ * 4:2:0 decoding must be the same whether it runs the wide kernel or the generic one,
+ * every width up to `kCheckWidth` is decoded so each possible row tail is covered,
+ * luma goes through every code, so the footroom below TV range bias is exercised as well
+ */
+static bool CheckWide420Kernel(const int64_t target) {
+  const uint32_t height = 5;
+  const uint32_t uvWidth = (kCheckWidth + 1) / 2;
+  const uint32_t uvHeight = (height + 1) / 2;
+  std::vector<uint8_t> yPlane(kCheckWidth * height);
+  std::vector<uint8_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint8_t> vPlane(uvWidth * uvHeight);
+  for (size_t i = 0; i < yPlane.size(); ++i) {
+    yPlane[i] = static_cast<uint8_t>(i * 7);
+  }
+  for (size_t i = 0; i < uPlane.size(); ++i) {
+    uPlane[i] = static_cast<uint8_t>(i * 11 + 64);
+    vPlane[i] = static_cast<uint8_t>(i * 13 + 32);
+  }
+
+  const uint32_t rgbaStride = kCheckWidth * 4;
+  std::vector<uint8_t> dispatched(rgbaStride * height);
+  std::vector<uint8_t> generic(rgbaStride * height);
+  for (uint32_t width = 1; width <= kCheckWidth; ++width) {
+    std::fill(dispatched.begin(), dispatched.end(), 0);
+    std::fill(generic.begin(), generic.end(), 0);
+    sparkyuv::YCbCr420ToRGBA(dispatched.data(), rgbaStride, width, height,
+                             yPlane.data(), kCheckWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                             0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+    sparkyuv::YCbCr420ToRGBAGeneric(generic.data(), rgbaStride, width, height,
+                                    yPlane.data(), kCheckWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                                    0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+    if (dispatched != generic) {
+      std::cout << "YCbCr420ToRGBA on " << hwy::TargetName(target) << " differs from generic kernel at width "
+                << width << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool IsSveTarget(const int64_t target) {
+#if HWY_ARCH_ARM_A64
+  return target == HWY_SVE || target == HWY_SVE2 || target == HWY_SVE_256 || target == HWY_SVE2_128;
+#else
+  (void) target;
+  return false;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+  const bool requireSve = argc > 1 && std::strcmp(argv[1], "sve") == 0;
+
+  const std::vector<uint8_t> rgba = MakeCheckImage();
+  std::vector<TargetOutput> outputs;
+  bool sveExecuted = false;
+  bool passed = true;
+  for (const int64_t target : hwy::SupportedAndGeneratedTargets()) {
+    hwy::SetSupportedTargetsForTest(target);
+    outputs.push_back({target, RunConversions(rgba)});
+    passed &= CheckWide420Kernel(target);
+    hwy::SetSupportedTargetsForTest(0);
+    sveExecuted |= IsSveTarget(target);
+    std::cout << "Executed " << hwy::TargetName(target) << std::endl;
+  }
+
+  if (outputs.empty()) {
+    std::cout << "No compiled target is supported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Highway target bits grow toward the baseline, so the largest one is the least specialized path
+  const auto baseline = std::max_element(outputs.begin(), outputs.end(),
+                                         [](const TargetOutput &a, const TargetOutput &b) {
+                                           return a.target < b.target;
+                                         });
+
+  for (const TargetOutput &output : outputs) {
+    for (size_t plane = 0; plane < output.planes.size(); ++plane) {
+      const std::vector<uint8_t> &expected = baseline->planes[plane];
+      const std::vector<uint8_t> &actual = output.planes[plane];
+      int maxError = 0;
+      for (size_t i = 0; i < expected.size(); ++i) {
+        maxError = std::max(maxError, std::abs(static_cast<int>(expected[i]) - static_cast<int>(actual[i])));
+      }
+      if (maxError > kCheckTolerance) {
+        std::cout << kPlaneNames[plane] << " on " << hwy::TargetName(output.target) << " differs from "
+                  << hwy::TargetName(baseline->target) << " by " << maxError << std::endl;
+        passed = false;
+      }
+    }
+  }
+
+  if (requireSve && !sveExecuted) {
+    std::cout << "No SVE target was compiled and supported" << std::endl;
+    passed = false;
+  }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
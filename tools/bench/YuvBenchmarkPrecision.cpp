@@ -0,0 +1,297 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "YuvBenchmarkPrecision.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "sparkyuv.h"
+#include "../JPEGDecoder.h"
+#include <benchmark/benchmark.h>
+
+static std::string filename = "filirovska.jpeg";
+
+static constexpr float kPrecisionKr = 0.2126f;
+static constexpr float kPrecisionKb = 0.0722f;
+
+static double PrecisionPSNR(const double squaredError, const double samples, const double maxColors) {
+  const double mse = squaredError / samples;
+  if (mse == 0.) {
+    return 99.;
+  }
+  return 10. * std::log10(maxColors * maxColors / mse);
+}
+
+/**
+ * PSNR of decoded RGB against double precision decode of the same 4:2:0 planes,
+ * so only decoder rounding is measured and encoder error is excluded. `maxError` receives the largest difference
+ */
+template<typename T>
+static double YCbCr420DecodePSNR(const std::vector<T> &rgba, const int width, const int height,
+                                 const std::vector<T> &yPlane, const std::vector<T> &uPlane,
+                                 const std::vector<T> &vPlane, const int bitDepth, double &maxError) {
+  const double maxColors = static_cast<double>((1 << bitDepth) - 1);
+  const double scale = static_cast<double>(1 << (bitDepth - 8));
+  const double biasY = 16. * scale;
+  const double biasUV = 128. * scale;
+  const double rangeY = 219. * scale;
+  const double rangeUV = 224. * scale;
+  const double kr = kPrecisionKr;
+  const double kb = kPrecisionKb;
+  const double kg = 1. - kr - kb;
+  const int uvWidth = (width + 1) / 2;
+
+  double squaredError = 0.;
+  maxError = 0.;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const double Y = (static_cast<double>(yPlane[y * width + x]) - biasY) / rangeY;
+      const double Cb = (static_cast<double>(uPlane[(y / 2) * uvWidth + x / 2]) - biasUV) / rangeUV;
+      const double Cr = (static_cast<double>(vPlane[(y / 2) * uvWidth + x / 2]) - biasUV) / rangeUV;
+      const double R = Y + 2. * (1. - kr) * Cr;
+      const double B = Y + 2. * (1. - kb) * Cb;
+      const double G = Y - 2. * (1. - kr) * kr / kg * Cr - 2. * (1. - kb) * kb / kg * Cb;
+      const double reference[3] = {R, G, B};
+      for (int c = 0; c < 3; ++c) {
+        const double expected = std::clamp(std::round(reference[c] * maxColors), 0., maxColors);
+        const double difference = expected - static_cast<double>(rgba[(y * width + x) * 4 + c]);
+        squaredError += difference * difference;
+        maxError = std::max(maxError, std::abs(difference));
+      }
+    }
+  }
+  return PrecisionPSNR(squaredError, static_cast<double>(width) * static_cast<double>(height) * 3., maxColors);
+}
+
+/**
+ * PSNR of 4:2:0 planes against double precision encode of the same RGBA,
+ * chroma reference is taken from 2x2 average of RGB, odd edge pixels are paired with themselves
+ */
+template<typename T>
+static double YCbCr420EncodePSNR(const std::vector<T> &rgba, const int width, const int height,
+                                 const std::vector<T> &yPlane, const std::vector<T> &uPlane,
+                                 const std::vector<T> &vPlane, const int bitDepth, double &maxError) {
+  const double maxColors = static_cast<double>((1 << bitDepth) - 1);
+  const double scale = static_cast<double>(1 << (bitDepth - 8));
+  const double biasY = 16. * scale;
+  const double biasUV = 128. * scale;
+  const double rangeY = 219. * scale / maxColors;
+  const double rangeUV = 224. * scale / maxColors;
+  const double kr = kPrecisionKr;
+  const double kb = kPrecisionKb;
+  const double kg = 1. - kr - kb;
+  const int uvWidth = (width + 1) / 2;
+  const int uvHeight = (height + 1) / 2;
+
+  double squaredError = 0.;
+  maxError = 0.;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const T *pixel = rgba.data() + (y * width + x) * 4;
+      const double luma = kr * pixel[0] + kg * pixel[1] + kb * pixel[2];
+      const double difference = std::round(biasY + rangeY * luma) - static_cast<double>(yPlane[y * width + x]);
+      squaredError += difference * difference;
+      maxError = std::max(maxError, std::abs(difference));
+    }
+  }
+  for (int y = 0; y < uvHeight; ++y) {
+    for (int x = 0; x < uvWidth; ++x) {
+      double R = 0., G = 0., B = 0.;
+      for (int i = 0; i < 4; ++i) {
+        const int px = std::min(x * 2 + (i & 1), width - 1);
+        const int py = std::min(y * 2 + (i >> 1), height - 1);
+        const T *pixel = rgba.data() + (py * width + px) * 4;
+        R += pixel[0] * 0.25;
+        G += pixel[1] * 0.25;
+        B += pixel[2] * 0.25;
+      }
+      const double luma = kr * R + kg * G + kb * B;
+      const double Cb = std::round(biasUV + rangeUV * (B - luma) / (2. * (1. - kb)));
+      const double Cr = std::round(biasUV + rangeUV * (R - luma) / (2. * (1. - kr)));
+      const double cbDifference = Cb - static_cast<double>(uPlane[y * uvWidth + x]);
+      const double crDifference = Cr - static_cast<double>(vPlane[y * uvWidth + x]);
+      squaredError += cbDifference * cbDifference + crDifference * crDifference;
+      maxError = std::max(maxError, std::max(std::abs(cbDifference), std::abs(crDifference)));
+    }
+  }
+  const double samples = static_cast<double>(width) * static_cast<double>(height)
+      + 2. * static_cast<double>(uvWidth) * static_cast<double>(uvHeight);
+  return PrecisionPSNR(squaredError, samples, maxColors);
+}
+
+static void SparkyuvYCbCr420ToRGBA8Precision(benchmark::State &state, const sparkyuv::SparkYuvPrecision precision) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvWidth = (inWidth + 1) / 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint8_t> yPlane(inWidth * inHeight);
+  std::vector<uint8_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint8_t> vPlane(uvWidth * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+
+  sparkyuv::RGBAToYCbCr420(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                           yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                           kPrecisionKr, kPrecisionKb, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::YCbCr420ToRGBA(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                             yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                             kPrecisionKr, kPrecisionKb, sparkyuv::YUV_RANGE_TV, precision);
+  }
+  double maxError;
+  state.counters["PSNR"] = YCbCr420DecodePSNR(rgbaData, inWidth, inHeight, yPlane, uPlane, vPlane, 8, maxError);
+  state.counters["MaxError"] = maxError;
+}
+
+static void SparkyuvYCbCr420P10ToRGBA10Precision(benchmark::State &state,
+                                                 const sparkyuv::SparkYuvPrecision precision) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvWidth = (inWidth + 1) / 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint16_t> yPlane(inWidth * inHeight);
+  std::vector<uint16_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint16_t> vPlane(uvWidth * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+  const int rgba16Stride = sizeof(uint16_t) * inWidth * 4;
+  std::vector<uint16_t> rgba16Data(inWidth * 4 * inHeight);
+  sparkyuv::WideRGBA8To10(rgbaData.data(), rgbaStride, rgba16Data.data(), rgba16Stride, inWidth, inHeight);
+
+  sparkyuv::RGBA10ToYCbCr420P10(rgba16Data.data(), rgba16Stride, inWidth, inHeight,
+                                yPlane.data(), inWidth * sizeof(uint16_t),
+                                uPlane.data(), uvWidth * sizeof(uint16_t),
+                                vPlane.data(), uvWidth * sizeof(uint16_t),
+                                kPrecisionKr, kPrecisionKb, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::YCbCr420P10ToRGBA10(rgba16Data.data(), rgba16Stride, inWidth, inHeight,
+                                  yPlane.data(), inWidth * sizeof(uint16_t),
+                                  uPlane.data(), uvWidth * sizeof(uint16_t),
+                                  vPlane.data(), uvWidth * sizeof(uint16_t),
+                                  kPrecisionKr, kPrecisionKb, sparkyuv::YUV_RANGE_TV, precision);
+  }
+  double maxError;
+  state.counters["PSNR"] = YCbCr420DecodePSNR(rgba16Data, inWidth, inHeight, yPlane, uPlane, vPlane, 10, maxError);
+  state.counters["MaxError"] = maxError;
+}
+
+void SparkyuvYCbCr420ToRGBA8Fast(benchmark::State &state) {
+  SparkyuvYCbCr420ToRGBA8Precision(state, sparkyuv::YUV_PRECISION_FAST);
+}
+
+void SparkyuvYCbCr420ToRGBA8High(benchmark::State &state) {
+  SparkyuvYCbCr420ToRGBA8Precision(state, sparkyuv::YUV_PRECISION_HIGH);
+}
+
+void SparkyuvYCbCr420P10ToRGBA10Fast(benchmark::State &state) {
+  SparkyuvYCbCr420P10ToRGBA10Precision(state, sparkyuv::YUV_PRECISION_FAST);
+}
+
+void SparkyuvYCbCr420P10ToRGBA10High(benchmark::State &state) {
+  SparkyuvYCbCr420P10ToRGBA10Precision(state, sparkyuv::YUV_PRECISION_HIGH);
+}
+
+/**
+ * Counters report how far the encoder tier is from double precision encode
+ */
+static void SparkyuvRGBA8ToYCbCr420Precision(benchmark::State &state, const sparkyuv::SparkYuvPrecision precision) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvWidth = (inWidth + 1) / 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint8_t> yPlane(inWidth * inHeight);
+  std::vector<uint8_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint8_t> vPlane(uvWidth * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+
+  for (auto _ : state) {
+    sparkyuv::RGBAToYCbCr420(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                             yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                             kPrecisionKr, kPrecisionKb, sparkyuv::YUV_RANGE_TV, precision);
+  }
+  double maxError;
+  state.counters["PSNR"] = YCbCr420EncodePSNR(rgbaData, inWidth, inHeight, yPlane, uPlane, vPlane, 8, maxError);
+  state.counters["MaxError"] = maxError;
+}
+
+static void SparkyuvRGBA10ToYCbCr420P10Precision(benchmark::State &state,
+                                                 const sparkyuv::SparkYuvPrecision precision) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvWidth = (inWidth + 1) / 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint16_t> yPlane(inWidth * inHeight);
+  std::vector<uint16_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint16_t> vPlane(uvWidth * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+  const int rgba16Stride = sizeof(uint16_t) * inWidth * 4;
+  std::vector<uint16_t> rgba16Data(inWidth * 4 * inHeight);
+  sparkyuv::WideRGBA8To10(rgbaData.data(), rgbaStride, rgba16Data.data(), rgba16Stride, inWidth, inHeight);
+
+  for (auto _ : state) {
+    sparkyuv::RGBA10ToYCbCr420P10(rgba16Data.data(), rgba16Stride, inWidth, inHeight,
+                                  yPlane.data(), inWidth * sizeof(uint16_t),
+                                  uPlane.data(), uvWidth * sizeof(uint16_t),
+                                  vPlane.data(), uvWidth * sizeof(uint16_t),
+                                  kPrecisionKr, kPrecisionKb, sparkyuv::YUV_RANGE_TV, precision);
+  }
+  double maxError;
+  state.counters["PSNR"] = YCbCr420EncodePSNR(rgba16Data, inWidth, inHeight, yPlane, uPlane, vPlane, 10, maxError);
+  state.counters["MaxError"] = maxError;
+}
+
+void SparkyuvRGBA8ToYCbCr420Fast(benchmark::State &state) {
+  SparkyuvRGBA8ToYCbCr420Precision(state, sparkyuv::YUV_PRECISION_FAST);
+}
+
+void SparkyuvRGBA8ToYCbCr420High(benchmark::State &state) {
+  SparkyuvRGBA8ToYCbCr420Precision(state, sparkyuv::YUV_PRECISION_HIGH);
+}
+
+void SparkyuvRGBA10ToYCbCr420P10Fast(benchmark::State &state) {
+  SparkyuvRGBA10ToYCbCr420P10Precision(state, sparkyuv::YUV_PRECISION_FAST);
+}
+
+void SparkyuvRGBA10ToYCbCr420P10High(benchmark::State &state) {
+  SparkyuvRGBA10ToYCbCr420P10Precision(state, sparkyuv::YUV_PRECISION_HIGH);
+}
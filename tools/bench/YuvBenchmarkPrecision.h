@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YUV_TOOLS_BENCH_YUVBENCHMARKPRECISION_H_
+#define YUV_TOOLS_BENCH_YUVBENCHMARKPRECISION_H_
+
+#include <benchmark/benchmark.h>
+
+void SparkyuvYCbCr420ToRGBA8Fast(benchmark::State &state);
+void SparkyuvYCbCr420ToRGBA8High(benchmark::State &state);
+void SparkyuvYCbCr420P10ToRGBA10Fast(benchmark::State &state);
+void SparkyuvYCbCr420P10ToRGBA10High(benchmark::State &state);
+void SparkyuvRGBA8ToYCbCr420Fast(benchmark::State &state);
+void SparkyuvRGBA8ToYCbCr420High(benchmark::State &state);
+void SparkyuvRGBA10ToYCbCr420P10Fast(benchmark::State &state);
+void SparkyuvRGBA10ToYCbCr420P10High(benchmark::State &state);
+
+#endif //YUV_TOOLS_BENCH_YUVBENCHMARKPRECISION_H_
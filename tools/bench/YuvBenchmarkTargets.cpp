@@ -0,0 +1,132 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "YuvBenchmarkTargets.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include "sparkyuv.h"
+#include "src/sparkyuv-internal.h"
+#include "../JPEGDecoder.h"
+#include "hwy/targets.h"
+#include <benchmark/benchmark.h>
+
+static std::string filename = "filirovska.jpeg";
+
+void SparkyuvYCbCr420ToRGBA8Target(benchmark::State &state) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvWidth = (inWidth + 1) / 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint8_t> yPlane(inWidth * inHeight);
+  std::vector<uint8_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint8_t> vPlane(uvWidth * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+
+  sparkyuv::RGBAToYCbCr420(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                           yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                           0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::YCbCr420ToRGBA(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                             yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                             0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+  }
+}
+
+/**
+ * Same decoding as `SparkyuvYCbCr420ToRGBA8Target` but always through the generic kernel,
+ * on AVX3 and SVE targets pair of them measures the wide kernel against the generic one on the same target
+ */
+void SparkyuvYCbCr420ToRGBA8GenericTarget(benchmark::State &state) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvWidth = (inWidth + 1) / 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint8_t> yPlane(inWidth * inHeight);
+  std::vector<uint8_t> uPlane(uvWidth * uvHeight);
+  std::vector<uint8_t> vPlane(uvWidth * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+
+  sparkyuv::RGBAToYCbCr420(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                           yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                           0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::YCbCr420ToRGBAGeneric(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                                    yPlane.data(), inWidth, uPlane.data(), uvWidth, vPlane.data(), uvWidth,
+                                    0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+  }
+}
+
+void SparkyuvNV12ToRGBA8Target(benchmark::State &state) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int uvStride = ((inWidth + 1) / 2) * 2;
+  const int uvHeight = (inHeight + 1) / 2;
+  std::vector<uint8_t> yPlane(inWidth * inHeight);
+  std::vector<uint8_t> uvPlane(uvStride * uvHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+
+  sparkyuv::RGBAToNV12(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                       yPlane.data(), inWidth, uvPlane.data(), uvStride,
+                       0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::NV12ToRGBA(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                         yPlane.data(), inWidth, uvPlane.data(), uvStride,
+                         0.299f, 0.114f, sparkyuv::YUV_RANGE_TV);
+  }
+}
+
+/**
+ * Restricts dynamic dispatch to a single target for the duration of benchmark
+ */
+static void RegisterPerTarget(const char *name, void (*function)(benchmark::State &)) {
+  for (const int64_t target : hwy::SupportedAndGeneratedTargets()) {
+    const std::string benchmarkName = std::string(name) + "/" + hwy::TargetName(target);
+    benchmark::RegisterBenchmark(benchmarkName.c_str(), [function, target](benchmark::State &state) {
+      hwy::SetSupportedTargetsForTest(target);
+      function(state);
+      hwy::SetSupportedTargetsForTest(0);
+    });
+  }
+}
+
+static const bool kPerTargetBenchmarksRegistered = []() {
+  RegisterPerTarget("SparkyuvYCbCr420ToRGBA8Target", SparkyuvYCbCr420ToRGBA8Target);
+  RegisterPerTarget("SparkyuvYCbCr420ToRGBA8GenericTarget", SparkyuvYCbCr420ToRGBA8GenericTarget);
+  RegisterPerTarget("SparkyuvNV12ToRGBA8Target", SparkyuvNV12ToRGBA8Target);
+  return true;
+}();
@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YUV_TOOLS_BENCH_YUVBENCHMARKTARGETS_H_
+#define YUV_TOOLS_BENCH_YUVBENCHMARKTARGETS_H_
+
+#include <benchmark/benchmark.h>
+
+/**
+ * 4:2:0 decoding benchmarks registered once per compiled and supported SIMD target
+ * as SparkyuvYCbCr420ToRGBA8Target/<target>, SparkyuvYCbCr420ToRGBA8GenericTarget/<target>
+ * and SparkyuvNV12ToRGBA8Target/<target>
+ */
+void SparkyuvYCbCr420ToRGBA8Target(benchmark::State &state);
+void SparkyuvYCbCr420ToRGBA8GenericTarget(benchmark::State &state);
+void SparkyuvNV12ToRGBA8Target(benchmark::State &state);
+
+#endif //YUV_TOOLS_BENCH_YUVBENCHMARKTARGETS_H_
@@ -0,0 +1,230 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "YuvBenchmarkTransfer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "sparkyuv.h"
+#include <benchmark/benchmark.h>
+
+static constexpr int kTransferBitDepth = 12;
+static constexpr int kTransferWidth = 1 << kTransferBitDepth;
+static constexpr int kTransferHeight = 256;
+
+/**
+ * Every row holds every 12-bit code once, so the whole range of the curve is covered
+ */
+static std::vector<uint16_t> MakeTransferRamp() {
+  std::vector<uint16_t> ramp(kTransferWidth * 4 * kTransferHeight);
+  for (int y = 0; y < kTransferHeight; ++y) {
+    uint16_t *row = ramp.data() + y * kTransferWidth * 4;
+    for (int x = 0; x < kTransferWidth; ++x) {
+      row[x * 4] = static_cast<uint16_t>(x);
+      row[x * 4 + 1] = static_cast<uint16_t>(x);
+      row[x * 4 + 2] = static_cast<uint16_t>(x);
+      row[x * 4 + 3] = static_cast<uint16_t>(kTransferWidth - 1);
+    }
+  }
+  return ramp;
+}
+
+/**
+ * Linear light between neighbouring codes, row `y` is at y / height of the way to the next code,
+ * so interpolated OETF is sampled between the table entries as well as on them
+ */
+static std::vector<float> MakeLinearRamp(const sparkyuv::SparkYuvTransferFunction transferFunction) {
+  const std::vector<uint16_t> ramp = MakeTransferRamp();
+  std::vector<float> codes(kTransferWidth * 4);
+  sparkyuv::LinearizeRGBA16ToRGBAF32(ramp.data(), kTransferWidth * 4 * sizeof(uint16_t),
+                                     codes.data(), kTransferWidth * 4 * sizeof(float),
+                                     kTransferWidth, 1, kTransferBitDepth,
+                                     transferFunction, sparkyuv::TRANSFER_ACCURACY_EXACT);
+  std::vector<float> linear(kTransferWidth * 4 * kTransferHeight);
+  for (int y = 0; y < kTransferHeight; ++y) {
+    const float fraction = static_cast<float>(y) / static_cast<float>(kTransferHeight);
+    float *row = linear.data() + y * kTransferWidth * 4;
+    for (int x = 0; x < kTransferWidth * 4; ++x) {
+      const int next = std::min(x + 4, kTransferWidth * 4 - 4 + x % 4);
+      row[x] = codes[x] + (codes[next] - codes[x]) * fraction;
+    }
+  }
+  return linear;
+}
+
+static int DelinearizeMaxCodeError(const sparkyuv::SparkYuvTransferFunction transferFunction,
+                                   const sparkyuv::SparkYuvTransferAccuracy accuracy) {
+  const std::vector<float> linear = MakeLinearRamp(transferFunction);
+  const uint32_t srcStride = kTransferWidth * 4 * sizeof(float);
+  const uint32_t dstStride = kTransferWidth * 4 * sizeof(uint16_t);
+  std::vector<uint16_t> reference(kTransferWidth * 4 * kTransferHeight);
+  std::vector<uint16_t> encoded(kTransferWidth * 4 * kTransferHeight);
+  sparkyuv::DelinearizeRGBAF32ToRGBA16(linear.data(), srcStride, reference.data(), dstStride,
+                                       kTransferWidth, kTransferHeight, kTransferBitDepth,
+                                       transferFunction, sparkyuv::TRANSFER_ACCURACY_EXACT);
+  sparkyuv::DelinearizeRGBAF32ToRGBA16(linear.data(), srcStride, encoded.data(), dstStride,
+                                       kTransferWidth, kTransferHeight, kTransferBitDepth,
+                                       transferFunction, accuracy);
+  int maxError = 0;
+  for (size_t i = 0; i < reference.size(); ++i) {
+    maxError = std::max(maxError, std::abs(static_cast<int>(reference[i]) - static_cast<int>(encoded[i])));
+  }
+  return maxError;
+}
+
+static void SparkyuvLinearizeRGBA12(benchmark::State &state, const sparkyuv::SparkYuvTransferAccuracy accuracy) {
+  const std::vector<uint16_t> ramp = MakeTransferRamp();
+  std::vector<float> linear(kTransferWidth * 4 * kTransferHeight);
+  for (auto _ : state) {
+    sparkyuv::LinearizeRGBA16ToRGBAF32(ramp.data(), kTransferWidth * 4 * sizeof(uint16_t),
+                                       linear.data(), kTransferWidth * 4 * sizeof(float),
+                                       kTransferWidth, kTransferHeight, kTransferBitDepth,
+                                       sparkyuv::TransferPQ, accuracy);
+  }
+}
+
+/**
+ * Times PQ encode, `MaxCodeError` is the largest difference to libm encode of the same values,
+ * `WorstCurveCodeError` is the largest one across every transfer function
+ */
+static void SparkyuvDelinearizeRGBA12(benchmark::State &state, const sparkyuv::SparkYuvTransferAccuracy accuracy) {
+  const std::vector<float> linear = MakeLinearRamp(sparkyuv::TransferPQ);
+  std::vector<uint16_t> encoded(kTransferWidth * 4 * kTransferHeight);
+  for (auto _ : state) {
+    sparkyuv::DelinearizeRGBAF32ToRGBA16(linear.data(), kTransferWidth * 4 * sizeof(float),
+                                         encoded.data(), kTransferWidth * 4 * sizeof(uint16_t),
+                                         kTransferWidth, kTransferHeight, kTransferBitDepth,
+                                         sparkyuv::TransferPQ, accuracy);
+  }
+  state.counters["MaxCodeError"] = DelinearizeMaxCodeError(sparkyuv::TransferPQ, accuracy);
+  int worstError = 0;
+  for (int transfer = sparkyuv::TransferBT709; transfer <= sparkyuv::TransferHLG; ++transfer) {
+    worstError = std::max(worstError,
+                          DelinearizeMaxCodeError(static_cast<sparkyuv::SparkYuvTransferFunction>(transfer), accuracy));
+  }
+  state.counters["WorstCurveCodeError"] = worstError;
+}
+
+void SparkyuvLinearizeRGBA12PQExact(benchmark::State &state) {
+  SparkyuvLinearizeRGBA12(state, sparkyuv::TRANSFER_ACCURACY_EXACT);
+}
+
+void SparkyuvLinearizeRGBA12PQFast(benchmark::State &state) {
+  SparkyuvLinearizeRGBA12(state, sparkyuv::TRANSFER_ACCURACY_FAST);
+}
+
+void SparkyuvLinearizeRGBA12PQLUT(benchmark::State &state) {
+  SparkyuvLinearizeRGBA12(state, sparkyuv::TRANSFER_ACCURACY_LUT);
+}
+
+void SparkyuvDelinearizeRGBA12PQExact(benchmark::State &state) {
+  SparkyuvDelinearizeRGBA12(state, sparkyuv::TRANSFER_ACCURACY_EXACT);
+}
+
+void SparkyuvDelinearizeRGBA12PQFast(benchmark::State &state) {
+  SparkyuvDelinearizeRGBA12(state, sparkyuv::TRANSFER_ACCURACY_FAST);
+}
+
+void SparkyuvDelinearizeRGBA12PQLUT(benchmark::State &state) {
+  SparkyuvDelinearizeRGBA12(state, sparkyuv::TRANSFER_ACCURACY_LUT);
+}
+
+static constexpr uint32_t kPairWidth = 1920;
+static constexpr uint32_t kPairHeight = 1080;
+static constexpr float kPairKr = 0.2627f;
+static constexpr float kPairKb = 0.0593f;
+
+/**
+ * Same 8-bit frame for YcCbcCrc and matrix YCbCr 4:2:0, so the pairs below differ only by the transform
+ */
+struct TransferPairFrame {
+  std::vector<uint8_t> rgba;
+  std::vector<uint8_t> yPlane;
+  std::vector<uint8_t> uPlane;
+  std::vector<uint8_t> vPlane;
+  uint32_t rgbaStride = kPairWidth * 4;
+  uint32_t uvStride = (kPairWidth + 1) / 2;
+};
+
+static TransferPairFrame MakeTransferPairFrame() {
+  TransferPairFrame frame;
+  frame.rgba.resize(static_cast<size_t>(frame.rgbaStride) * kPairHeight);
+  uint32_t seed = 0x9E3779B9u;
+  for (uint32_t y = 0; y < kPairHeight; ++y) {
+    uint8_t *row = frame.rgba.data() + static_cast<size_t>(y) * frame.rgbaStride;
+    for (uint32_t x = 0; x < kPairWidth; ++x) {
+      seed = seed * 1664525u + 1013904223u;
+      // Smooth gradients with a little noise, so chroma isn't flat and every code of a curve is touched
+      row[x * 4] = static_cast<uint8_t>(x * 255 / kPairWidth + (seed >> 29));
+      row[x * 4 + 1] = static_cast<uint8_t>(y * 255 / kPairHeight + ((seed >> 26) & 7));
+      row[x * 4 + 2] = static_cast<uint8_t>((x + y) * 255 / (kPairWidth + kPairHeight) + ((seed >> 23) & 7));
+      row[x * 4 + 3] = 255;
+    }
+  }
+  const size_t uvHeight = (kPairHeight + 1) / 2;
+  frame.yPlane.resize(static_cast<size_t>(kPairWidth) * kPairHeight);
+  frame.uPlane.resize(frame.uvStride * uvHeight);
+  frame.vPlane.resize(frame.uvStride * uvHeight);
+  return frame;
+}
+
+void SparkyuvRGBA8ToYcCbcCrc420PairBT2020(benchmark::State &state) {
+  TransferPairFrame frame = MakeTransferPairFrame();
+  for (auto _ : state) {
+    sparkyuv::RGBA8ToYcCbcCrc420P8(frame.rgba.data(), frame.rgbaStride, kPairWidth, kPairHeight,
+                                   frame.yPlane.data(), kPairWidth, frame.uPlane.data(), frame.uvStride,
+                                   frame.vPlane.data(), frame.uvStride,
+                                   kPairKr, kPairKb, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferBT709);
+  }
+}
+
+void SparkyuvRGBA8ToYCbCr420PairBT2020(benchmark::State &state) {
+  TransferPairFrame frame = MakeTransferPairFrame();
+  for (auto _ : state) {
+    sparkyuv::RGBAToYCbCr420(frame.rgba.data(), frame.rgbaStride, kPairWidth, kPairHeight,
+                             frame.yPlane.data(), kPairWidth, frame.uPlane.data(), frame.uvStride,
+                             frame.vPlane.data(), frame.uvStride,
+                             kPairKr, kPairKb, sparkyuv::YUV_RANGE_TV);
+  }
+}
+
+void SparkyuvYcCbcCrc420ToRGBA8PairBT2020(benchmark::State &state) {
+  TransferPairFrame frame = MakeTransferPairFrame();
+  sparkyuv::RGBA8ToYcCbcCrc420P8(frame.rgba.data(), frame.rgbaStride, kPairWidth, kPairHeight,
+                                 frame.yPlane.data(), kPairWidth, frame.uPlane.data(), frame.uvStride,
+                                 frame.vPlane.data(), frame.uvStride,
+                                 kPairKr, kPairKb, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferBT709);
+  for (auto _ : state) {
+    sparkyuv::YcCbcCrc420P8ToRGBA8(frame.rgba.data(), frame.rgbaStride, kPairWidth, kPairHeight,
+                                   frame.yPlane.data(), kPairWidth, frame.uPlane.data(), frame.uvStride,
+                                   frame.vPlane.data(), frame.uvStride,
+                                   kPairKr, kPairKb, sparkyuv::YUV_RANGE_TV, sparkyuv::TransferBT709);
+  }
+}
+
+void SparkyuvYCbCr420ToRGBA8PairBT2020(benchmark::State &state) {
+  TransferPairFrame frame = MakeTransferPairFrame();
+  sparkyuv::RGBAToYCbCr420(frame.rgba.data(), frame.rgbaStride, kPairWidth, kPairHeight,
+                           frame.yPlane.data(), kPairWidth, frame.uPlane.data(), frame.uvStride,
+                           frame.vPlane.data(), frame.uvStride,
+                           kPairKr, kPairKb, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::YCbCr420ToRGBA(frame.rgba.data(), frame.rgbaStride, kPairWidth, kPairHeight,
+                             frame.yPlane.data(), kPairWidth, frame.uPlane.data(), frame.uvStride,
+                             frame.vPlane.data(), frame.uvStride,
+                             kPairKr, kPairKb, sparkyuv::YUV_RANGE_TV);
+  }
+}
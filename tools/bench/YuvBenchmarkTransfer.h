@@ -0,0 +1,33 @@
+// Copyright (C) 2024 Radzivon Bartoshyk
+//
+// This file belongs to sparkyuv project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YUV_TOOLS_BENCH_YUVBENCHMARKTRANSFER_H_
+#define YUV_TOOLS_BENCH_YUVBENCHMARKTRANSFER_H_
+
+#include <benchmark/benchmark.h>
+
+void SparkyuvLinearizeRGBA12PQExact(benchmark::State &state);
+void SparkyuvLinearizeRGBA12PQFast(benchmark::State &state);
+void SparkyuvLinearizeRGBA12PQLUT(benchmark::State &state);
+void SparkyuvDelinearizeRGBA12PQExact(benchmark::State &state);
+void SparkyuvDelinearizeRGBA12PQFast(benchmark::State &state);
+void SparkyuvDelinearizeRGBA12PQLUT(benchmark::State &state);
+void SparkyuvRGBA8ToYcCbcCrc420PairBT2020(benchmark::State &state);
+void SparkyuvRGBA8ToYCbCr420PairBT2020(benchmark::State &state);
+void SparkyuvYcCbcCrc420ToRGBA8PairBT2020(benchmark::State &state);
+void SparkyuvYCbCr420ToRGBA8PairBT2020(benchmark::State &state);
+
+#endif //YUV_TOOLS_BENCH_YUVBENCHMARKTRANSFER_H_
@@ -144,6 +144,43 @@ void SparkyuvYDbDr420ToRGBA8(benchmark::State &state) {
   }
 }
 
+static void SparkyuvYDbDr420ToRGBA8Precision(benchmark::State &state, const sparkyuv::SparkYuvPrecision precision) {
+  std::vector<uint8_t> inSrcData;
+  int inWidth, inHeight;
+  if (!sparkyuv::decompressJPEG(filename, inSrcData, inWidth, inHeight)) {
+    std::cout << "Cannot read file (((" << std::endl;
+    return;
+  }
+
+  const int yPlaneStride = inWidth;
+  const int uvPlaneStride = (inWidth + 1) / 2;
+  const int uvPlaneHeight = (inHeight + 1) / 2;
+  std::vector<uint8_t> yPlane(yPlaneStride * inHeight);
+  std::vector<uint8_t> uPlane(uvPlaneStride * uvPlaneHeight);
+  std::vector<uint8_t> vPlane(uvPlaneStride * uvPlaneHeight);
+  const int rgbaStride = sizeof(uint8_t) * inWidth * 4;
+  std::vector<uint8_t> rgbaData(rgbaStride * inHeight);
+  sparkyuv::RGBToRGBA(inSrcData.data(), inWidth * sizeof(uint8_t) * 3, rgbaData.data(), rgbaStride, inWidth, inHeight);
+  sparkyuv::RGBA8ToYDbDr420P8(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                              yPlane.data(), yPlaneStride,
+                              uPlane.data(), uvPlaneStride,
+                              vPlane.data(), uvPlaneStride, sparkyuv::YUV_RANGE_TV);
+  for (auto _ : state) {
+    sparkyuv::YDbDr420P8ToRGBA8(rgbaData.data(), rgbaStride, inWidth, inHeight,
+                                yPlane.data(), yPlaneStride,
+                                uPlane.data(), uvPlaneStride,
+                                vPlane.data(), uvPlaneStride, sparkyuv::YUV_RANGE_TV, precision);
+  }
+}
+
+void SparkyuvYDbDr420ToRGBA8Fast(benchmark::State &state) {
+  SparkyuvYDbDr420ToRGBA8Precision(state, sparkyuv::YUV_PRECISION_FAST);
+}
+
+void SparkyuvYDbDr420ToRGBA8High(benchmark::State &state) {
+  SparkyuvYDbDr420ToRGBA8Precision(state, sparkyuv::YUV_PRECISION_HIGH);
+}
+
 void SparkyuvRGBA8ToYDbDr420(benchmark::State &state) {
   std::vector<uint8_t> inSrcData;
   int inWidth, inHeight;
@@ -22,6 +22,8 @@
 void SparkyuvYDbDr444ToRGBA8(benchmark::State &state);
 void SparkyuvYDbDr422ToRGBA8(benchmark::State &state);
 void SparkyuvYDbDr420ToRGBA8(benchmark::State &state);
+void SparkyuvYDbDr420ToRGBA8Fast(benchmark::State &state);
+void SparkyuvYDbDr420ToRGBA8High(benchmark::State &state);
 void SparkyuvRGBA8ToYDbDr420(benchmark::State &state);
 void SparkyuvRGBA8ToYDbDr422(benchmark::State &state);
 void SparkyuvRGBA8ToYDbDr444(benchmark::State &state);